@@ -34,6 +34,7 @@
 #include "cAVS/System.hpp"
 #include "Rest/Server.hpp"
 #include "Util/Locker.hpp"
+#include "Util/SharedSnapshot.hpp"
 #include "ParameterSerializer/ParameterSerializer.hpp"
 #include <inttypes.h>
 #include <memory>
@@ -47,10 +48,12 @@ namespace core
 class DebugAgent final
 {
 public:
-    /** @throw DebugAgent::Exception */
+    /** @param incrementalRefresh if true, the instance model refreshes reuse the module
+     *                           instances of unchanged pipelines and tasks
+     * @throw DebugAgent::Exception */
     DebugAgent(const cavs::DriverFactory &driverFactory, uint32_t port,
                const std::string &pfwConfig, bool serverIsVerbose = false,
-               bool validationRequested = false);
+               bool validationRequested = false, bool incrementalRefresh = false);
     ~DebugAgent();
 
     struct Exception : std::logic_error
@@ -64,7 +67,7 @@ private:
 
     std::shared_ptr<TypeModel> createTypeModel();
     static std::shared_ptr<ifdk_objects::instance::System> createSystemInstance();
-    std::unique_ptr<rest::Dispatcher> createDispatcher();
+    std::unique_ptr<rest::Dispatcher> createDispatcher(bool incrementalRefresh);
     static std::vector<std::shared_ptr<ParameterApplier>> createParamAppliers(
         cavs::System &system,
         util::Locker<parameter_serializer::ParameterSerializer> &paramSerializer);
@@ -72,7 +75,7 @@ private:
     cavs::System mSystem;
     std::shared_ptr<TypeModel> mTypeModel;
     std::shared_ptr<ifdk_objects::instance::System> mSystemInstance;
-    util::Locker<std::shared_ptr<InstanceModel>> mInstanceModel;
+    util::SharedSnapshot<const InstanceModel> mInstanceModel;
     util::Locker<parameter_serializer::ParameterSerializer> mParameterSerializer;
     ParameterDispatcher mParamDispatcher;
     rest::Server mRestServer;
@@ -72,13 +72,33 @@ private:
     void dumpPins(HtmlHelper &html, const std::vector<cavs::dsp_fw::PinProps> &pins);
 };
 
+/** This debug resource dumps the overflow statistics of the log and probe extraction queues and
+ * the resynchronizations of the probe extraction */
+class QueueDiagnosticsResource : public SystemResource
+{
+public:
+    QueueDiagnosticsResource(cavs::System &system) : SystemResource(system) {}
+protected:
+    virtual ResponsePtr handleGet(const rest::Request &request) override;
+};
+
+/** This debug resource dumps the scheduling statistics of the firmware IPCs, the core power
+ * commands saved by the IPCs and the IPC cost of the topology refreshes */
+class IpcDiagnosticsResource : public SystemResource
+{
+public:
+    IpcDiagnosticsResource(cavs::System &system) : SystemResource(system) {}
+protected:
+    virtual ResponsePtr handleGet(const rest::Request &request) override;
+};
+
 /** This debug resource dumps model cache to the fdk tool mock format */
 class ModelDumpDebugResource : public rest::Resource
 {
 public:
     ModelDumpDebugResource(const TypeModel &typeModel,
                            const ifdk_objects::instance::System &systemInstance,
-                           ExclusiveInstanceModel &instanceModel)
+                           SharedInstanceModel &instanceModel)
         : mTypeModel(typeModel), mSystemInstance(systemInstance), mInstanceModel(instanceModel)
     {
     }
@@ -89,7 +109,7 @@ protected:
 private:
     const TypeModel &mTypeModel;
     const ifdk_objects::instance::System &mSystemInstance;
-    ExclusiveInstanceModel &mInstanceModel;
+    SharedInstanceModel &mInstanceModel;
 };
 
 /** This resource returns general information about a Debug Agent's instance */
@@ -31,6 +31,8 @@
 #pragma once
 
 #include "IfdkObjects/Xml/InstanceTraits.hpp"
+#include <atomic>
+#include <cstdint>
 #include <map>
 #include <string>
 #include <memory>
@@ -48,7 +50,10 @@ public:
 
     using CollectionMap = std::map<std::string, CollectionPtr>;
 
-    InstanceModel(const CollectionMap &collectionMap) : mCollectionMap(collectionMap) {}
+    InstanceModel(const CollectionMap &collectionMap)
+        : mCollectionMap(collectionMap), mGeneration(nextGeneration())
+    {
+    }
 
     /** @return a collection by its name, or nullptr if not found */
     const CollectionPtr getCollection(const std::string &typeName) const
@@ -72,11 +77,22 @@ public:
 
     const CollectionMap &getCollectionMap() const { return mCollectionMap; }
 
+    /** @return the generation of this model, which is greater than the ones of the models built
+     * before it */
+    uint64_t getGeneration() const { return mGeneration; }
+
 private:
     InstanceModel(const InstanceModel &) = delete;
     InstanceModel &operator=(const InstanceModel &) = delete;
 
+    static uint64_t nextGeneration()
+    {
+        static std::atomic<uint64_t> generation(0);
+        return ++generation;
+    }
+
     CollectionMap mCollectionMap;
+    const uint64_t mGeneration;
 };
 }
 }
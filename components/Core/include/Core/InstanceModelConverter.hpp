@@ -50,7 +50,16 @@ public:
     static std::shared_ptr<ifdk_objects::instance::System> createSystem();
     std::shared_ptr<InstanceModel> createModel();
 
+    /** Create the model from a topology refreshed incrementally
+     * @param[in,out] topology the topology of the previous call, which is refreshed
+     * @see cavs::System::refreshTopology()
+     */
+    std::shared_ptr<InstanceModel> createModel(cavs::Topology &topology);
+
 private:
+    /** Create the model from mTopology */
+    std::shared_ptr<InstanceModel> convertTopology();
+
     std::shared_ptr<ifdk_objects::instance::BaseCollection> createSubsystem();
     std::shared_ptr<ifdk_objects::instance::BaseCollection> createPipe();
     std::shared_ptr<ifdk_objects::instance::BaseCollection> createTask();
@@ -34,15 +34,18 @@
 #include "Core/InstanceModel.hpp"
 #include "Core/ParameterDispatcher.hpp"
 #include "Rest/Resource.hpp"
+#include "Rest/ResponseCache.hpp"
 #include "cAVS/System.hpp"
-#include "Util/Locker.hpp"
+#include "Util/SharedSnapshot.hpp"
+#include "Util/SingleFlight.hpp"
 
 namespace debug_agent
 {
 namespace core
 {
 
-using ExclusiveInstanceModel = util::Locker<std::shared_ptr<InstanceModel>>;
+/** The instance model, rebuilt by refreshes and read without waiting for them */
+using SharedInstanceModel = util::SharedSnapshot<const InstanceModel>;
 
 class SystemResource : public rest::Resource
 {
@@ -62,6 +65,7 @@ protected:
 
 private:
     TypeModel &mTypeModel;
+    rest::ResponseCache mResponseCache;
 };
 
 /** This resource returns the System instance, containing Subsystem instances (XML) */
@@ -90,23 +94,25 @@ protected:
 
 private:
     TypeModel &mTypeModel;
+    rest::ResponseCache mResponseCache;
 };
 
 class InstanceResource : public rest::Resource
 {
 public:
-    InstanceResource(ExclusiveInstanceModel &instanceModel) : mInstanceModel(instanceModel) {}
+    InstanceResource(SharedInstanceModel &instanceModel) : mInstanceModel(instanceModel) {}
 protected:
     virtual ResponsePtr handleGet(const rest::Request &request) override;
 
 private:
-    ExclusiveInstanceModel &mInstanceModel;
+    SharedInstanceModel &mInstanceModel;
+    rest::ResponseCache mResponseCache;
 };
 
 class InstanceCollectionResource : public rest::Resource
 {
 public:
-    InstanceCollectionResource(ExclusiveInstanceModel &instanceModel)
+    InstanceCollectionResource(SharedInstanceModel &instanceModel)
         : mInstanceModel(instanceModel)
     {
     }
@@ -115,14 +121,22 @@ protected:
     virtual ResponsePtr handleGet(const rest::Request &request) override;
 
 private:
-    ExclusiveInstanceModel &mInstanceModel;
+    SharedInstanceModel &mInstanceModel;
+    rest::ResponseCache mResponseCache;
 };
 
+/** This resource rebuilds the instance model from the firmware
+ *
+ * The new model is published once complete: meanwhile readers keep getting the previous one.
+ */
 class RefreshSubsystemResource : public SystemResource
 {
 public:
-    RefreshSubsystemResource(cavs::System &system, ExclusiveInstanceModel &instanceModel)
-        : SystemResource(system), mInstanceModel(instanceModel)
+    /** @param incremental if true, the topology of the previous refresh is kept and refreshed
+     *                    incrementally, see cavs::System::refreshTopology() */
+    RefreshSubsystemResource(cavs::System &system, SharedInstanceModel &instanceModel,
+                             bool incremental = false)
+        : SystemResource(system), mInstanceModel(instanceModel), mIncremental(incremental)
     {
     }
 
@@ -130,7 +144,13 @@ protected:
     virtual ResponsePtr handlePost(const rest::Request &request) override;
 
 private:
-    ExclusiveInstanceModel &mInstanceModel;
+    SharedInstanceModel &mInstanceModel;
+    const bool mIncremental;
+    /** Merges concurrent refresh requests into one rebuild: all refreshes share the same key,
+     * so at most one rebuild is in flight */
+    util::SingleFlight<int, std::shared_ptr<const InstanceModel>> mRefreshes;
+    /** The topology of the previous refresh, only accessed by the rebuild in flight */
+    cavs::Topology mTopology;
 };
 
 class ParameterStructureResource : public SystemResource
@@ -71,7 +71,7 @@ std::shared_ptr<ifdk_objects::instance::System> DebugAgent::createSystemInstance
     }
 }
 
-std::unique_ptr<rest::Dispatcher> DebugAgent::createDispatcher()
+std::unique_ptr<rest::Dispatcher> DebugAgent::createDispatcher(bool incrementalRefresh)
 {
     assert(mTypeModel != nullptr);
     assert(mSystemInstance != nullptr);
@@ -115,12 +115,16 @@ std::unique_ptr<rest::Dispatcher> DebugAgent::createDispatcher()
 
     /* Refresh special case*/
     dispatcher->addResource("/instance/cavs/0/refreshed",
-                            std::make_shared<RefreshSubsystemResource>(mSystem, mInstanceModel));
+                            std::make_shared<RefreshSubsystemResource>(mSystem, mInstanceModel,
+                                                                       incrementalRefresh));
 
     /* Debug resources */
     dispatcher->addResource("/internal/modules",
                             std::make_shared<ModuleListDebugResource>(mSystem));
     dispatcher->addResource("/internal/topology", std::make_shared<TopologyDebugResource>(mSystem));
+    dispatcher->addResource("/internal/queues",
+                            std::make_shared<QueueDiagnosticsResource>(mSystem));
+    dispatcher->addResource("/internal/ipc", std::make_shared<IpcDiagnosticsResource>(mSystem));
     dispatcher->addResource("/internal/model", std::make_shared<ModelDumpDebugResource>(
                                                    *mTypeModel, *mSystemInstance, mInstanceModel));
 
@@ -144,7 +148,8 @@ std::vector<std::shared_ptr<ParameterApplier>> DebugAgent::createParamAppliers(
 }
 
 DebugAgent::DebugAgent(const cavs::DriverFactory &driverFactory, uint32_t port,
-                       const std::string &pfwConfig, bool isVerbose, bool validationRequested) try :
+                       const std::string &pfwConfig, bool isVerbose, bool validationRequested,
+                       bool incrementalRefresh) try :
     /* Order is important! */
     mSystem(driverFactory),
     mTypeModel(createTypeModel()),
@@ -152,7 +157,7 @@ DebugAgent::DebugAgent(const cavs::DriverFactory &driverFactory, uint32_t port,
     mInstanceModel(nullptr),
     mParameterSerializer(pfwConfig, validationRequested),
     mParamDispatcher(createParamAppliers(mSystem, mParameterSerializer)),
-    mRestServer(createDispatcher(), port, isVerbose) {
+    mRestServer(createDispatcher(incrementalRefresh), port, isVerbose) {
     assert(mTypeModel != nullptr);
     assert(mSystemInstance != nullptr);
 } catch (rest::Dispatcher::InvalidUriException &e) {
@@ -422,10 +422,109 @@ void TopologyDebugResource::dumpPins(HtmlHelper &html,
     }
 }
 
+Resource::ResponsePtr QueueDiagnosticsResource::handleGet(const Request &)
+{
+    static const std::vector<std::string> columns = {
+        "queue", "max_byte_size", "dropped_element_count", "dropped_byte_count",
+        "high_water_mark"};
+
+    /* Statistics are read without locking the queues, doesn't throw exception */
+    std::vector<std::pair<std::string, QueueStatistics>> queues;
+    queues.emplace_back("log", mSystem.getLogQueueStatistics());
+
+    std::size_t probeIndex = 0;
+    for (auto &statistics : mSystem.getProbeExtractionQueueStatistics()) {
+        queues.emplace_back("probe extraction " + std::to_string(probeIndex++), statistics);
+    }
+
+    HtmlHelper html;
+    html.title("Queue diagnostics");
+    html.beginTable(columns);
+
+    for (auto &queue : queues) {
+        html.beginRow();
+        html.cell(queue.first);
+        html.cell(queue.second.maxByteSize);
+        html.cell(queue.second.droppedElementCount);
+        html.cell(queue.second.droppedByteCount);
+        html.cell(queue.second.highWaterMark);
+        html.endRow();
+    }
+
+    html.endTable();
+
+    static const std::vector<std::string> resyncColumns = {"origin", "resync_count",
+                                                           "discarded_byte_count"};
+
+    auto resync = mSystem.getProbeService().getExtractionResyncStatistics();
+    std::vector<std::pair<std::string, Prober::ResyncStatistics>> origins;
+    std::size_t resyncProbeIndex = 0;
+    for (auto &statistics : resync.probes) {
+        origins.emplace_back("probe " + std::to_string(resyncProbeIndex++), statistics);
+    }
+    origins.emplace_back("unknown probe", resync.unattributed);
+
+    html.title("Probe extraction resynchronization");
+    html.beginTable(resyncColumns);
+
+    for (auto &origin : origins) {
+        html.beginRow();
+        html.cell(origin.first);
+        html.cell(origin.second.resyncCount);
+        html.cell(origin.second.discardedByteCount);
+        html.endRow();
+    }
+
+    html.endTable();
+
+    return std::make_unique<Response>(ContentTypeHtml, html.getHtmlContent());
+}
+
+Resource::ResponsePtr IpcDiagnosticsResource::handleGet(const Request &)
+{
+    static const std::vector<std::string> columns = {
+        "ipc_class",      "request_count", "queue_depth", "max_queue_depth",
+        "promoted_count", "mean_wait_us",  "max_wait_us"};
+
+    HtmlHelper html;
+    html.title("Firmware IPC scheduling");
+    html.beginTable(columns);
+
+    for (std::size_t classIndex = 0; classIndex < IpcScheduler::classCount; ++classIndex) {
+        auto ipcClass = static_cast<IpcClass>(classIndex);
+        IpcClassStatistics statistics = mSystem.getModuleHandler().getIpcStatistics(ipcClass);
+
+        html.beginRow();
+        html.cell(IpcScheduler::ipcClassHelper().toString(ipcClass));
+        html.cell(statistics.requestCount);
+        html.cell(statistics.queueDepth);
+        html.cell(statistics.maxQueueDepth);
+        html.cell(statistics.promotedCount);
+        html.cell(statistics.requestCount == 0
+                      ? 0
+                      : statistics.totalWait.count() / statistics.requestCount);
+        html.cell(statistics.maxWait.count());
+        html.endRow();
+    }
+
+    html.endTable();
+
+    html.paragraph("Core power commands saved by coalescing the votes of the IPCs: " +
+                   std::to_string(mSystem.getSavedCorePowerToggleCount()));
+
+    auto refreshStatistics = mSystem.getTopologyRefreshStatistics();
+    html.title("Topology refreshes");
+    html.paragraph("Refresh count: " + std::to_string(refreshStatistics.refreshCount) +
+                   ", IPC count: " + std::to_string(refreshStatistics.ipcCount) +
+                   ", IPCs saved by incremental refreshes: " +
+                   std::to_string(refreshStatistics.savedIpcCount));
+
+    return std::make_unique<Response>(ContentTypeHtml, html.getHtmlContent());
+}
+
 Resource::ResponsePtr ModelDumpDebugResource::handleGet(const Request &)
 {
-    auto guard = mInstanceModel.lock();
-    auto handle = guard->get();
+    auto handle = mInstanceModel.get();
     if (handle == nullptr) {
         throw Response::HttpError(Response::ErrorStatus::InternalError,
                                   "Instance model is undefined.");
@@ -37,7 +37,7 @@
 #include <Poco/Zip/Compress.h>
 #include <Poco/Zip/ZipException.h>
 #include <Poco/MemoryStream.h>
-#include <sstream>
+#include <ostream>
 #include <stdexcept>
 
 namespace debug_agent
@@ -116,19 +116,22 @@ private:
     {
         std::string filePath("model" + url + ".xml");
 
-        std::istringstream stream(content);
+        Poco::MemoryInputStream stream(content.data(), content.size());
         mCompress.addFile(stream, Poco::DateTime(), filePath);
     }
 
     template <class Serializer, class Value>
     void writeValue(Value &value, const std::string &uri)
     {
-        Serializer serializer;
+        Serializer serializer(mXmlBuffer);
         value.accept(serializer);
-        writeUrlContent(uri, serializer.getXml());
+        writeUrlContent(uri, mXmlBuffer);
     }
 
     Poco::Zip::Compress mCompress;
+
+    /** Serialization buffer, reused across the archive files */
+    std::string mXmlBuffer;
 };
 }
 }
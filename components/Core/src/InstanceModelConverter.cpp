@@ -49,6 +49,23 @@ std::shared_ptr<InstanceModel> InstanceModelConverter::createModel()
         throw Exception("Cannot get topology from fw: " + std::string(e.what()));
     }
 
+    return convertTopology();
+}
+
+std::shared_ptr<InstanceModel> InstanceModelConverter::createModel(cavs::Topology &topology)
+{
+    try {
+        mSystem.refreshTopology(topology);
+    } catch (cavs::System::Exception &e) {
+        throw Exception("Cannot refresh topology from fw: " + std::string(e.what()));
+    }
+    mTopology = topology;
+
+    return convertTopology();
+}
+
+std::shared_ptr<InstanceModel> InstanceModelConverter::convertTopology()
+{
     initializeIntermediateStructures();
 
     InstanceModel::CollectionMap collectionMap;
@@ -61,6 +61,10 @@ static const std::string ContentTypeXml("text/xml");
 */
 static const std::string ContentTypeIfdkFile("application/vnd.ifdk-file");
 
+/** The type model is built at startup and never changes: its serialized responses are cached for
+ * this single generation */
+static const uint64_t typeModelGeneration = 1;
+
 /** This method returns the value of a node part of an XML document, based on an XPath expression
  *
  *  @param const Poco::XML::Document* the XML document to parse
@@ -82,12 +86,14 @@ inline static const std::string getNodeValueFromXPath(const Poco::XML::Document
     }
 }
 
-Resource::ResponsePtr SystemTypeResource::handleGet(const Request &)
+Resource::ResponsePtr SystemTypeResource::handleGet(const Request &request)
 {
-    xml::TypeSerializer serializer;
-    mTypeModel.getSystem()->accept(serializer);
-
-    return std::make_unique<Response>(ContentTypeXml, serializer.getXml());
+    return mResponseCache.getResponse(request, typeModelGeneration, ContentTypeXml, [this] {
+        std::string content;
+        xml::TypeSerializer serializer(content);
+        mTypeModel.getSystem()->accept(serializer);
+        return content;
+    });
 }
 
 Resource::ResponsePtr SystemInstanceResource::handleGet(const Request &)
@@ -107,87 +113,95 @@ Resource::ResponsePtr TypeResource::handleGet(const Request &request)
         throw Response::HttpError(Response::ErrorStatus::BadRequest, "Unknown type: " + typeName);
     }
 
-    xml::TypeSerializer serializer;
-    typePtr->accept(serializer);
-
-    return std::make_unique<Response>(ContentTypeXml, serializer.getXml());
+    return mResponseCache.getResponse(request, typeModelGeneration, ContentTypeXml, [&] {
+        std::string content;
+        xml::TypeSerializer serializer(content);
+        typePtr->accept(serializer);
+        return content;
+    });
 }
 
 Resource::ResponsePtr InstanceCollectionResource::handleGet(const Request &request)
 {
-    xml::InstanceSerializer serializer;
     std::string typeName = request.getIdentifierValue("type_name");
 
-    {
-        const auto guard = mInstanceModel.lock();
-        auto handle = guard->get();
-        if (handle == nullptr) {
-            throw Response::HttpError(Response::ErrorStatus::InternalError,
-                                      "Instance model is undefined.");
-        }
-        std::shared_ptr<const instance::BaseCollection> collection =
-            handle->getCollection(typeName);
-
-        /* check nullptr using get() to avoid any KW error */
-        if (collection.get() == nullptr) {
-            throw Response::HttpError(Response::ErrorStatus::BadRequest,
-                                      "Unknown type: " + typeName);
-        }
+    auto handle = mInstanceModel.get();
+    if (handle == nullptr) {
+        throw Response::HttpError(Response::ErrorStatus::InternalError,
+                                  "Instance model is undefined.");
+    }
+    std::shared_ptr<const instance::BaseCollection> collection = handle->getCollection(typeName);
 
-        collection->accept(serializer);
+    /* check nullptr using get() to avoid any KW error */
+    if (collection.get() == nullptr) {
+        throw Response::HttpError(Response::ErrorStatus::BadRequest, "Unknown type: " + typeName);
     }
 
-    return std::make_unique<Response>(ContentTypeXml, serializer.getXml());
+    return mResponseCache.getResponse(request, handle->getGeneration(), ContentTypeXml, [&] {
+        std::string content;
+        xml::InstanceSerializer serializer(content);
+        collection->accept(serializer);
+        return content;
+    });
 }
 
 Resource::ResponsePtr InstanceResource::handleGet(const Request &request)
 {
-    xml::InstanceSerializer serializer;
     std::string typeName = request.getIdentifierValue("type_name");
     std::string instanceId = request.getIdentifierValue("instance_id");
 
-    {
-        auto guard = mInstanceModel.lock();
-        auto handle = guard->get();
-        if (handle == nullptr) {
-            throw Response::HttpError(Response::ErrorStatus::InternalError,
-                                      "Instance model is undefined.");
-        }
-        std::shared_ptr<const instance::Instance> instancePtr =
-            handle->getInstance(typeName, instanceId);
-
-        /* check nullptr using get() to avoid any KW error */
-        if (instancePtr.get() == nullptr) {
-            throw Response::HttpError(Response::ErrorStatus::BadRequest,
-                                      "Unknown instance: type=" + typeName + " instance_id=" +
-                                          instanceId);
-        }
+    auto handle = mInstanceModel.get();
+    if (handle == nullptr) {
+        throw Response::HttpError(Response::ErrorStatus::InternalError,
+                                  "Instance model is undefined.");
+    }
+    std::shared_ptr<const instance::Instance> instancePtr =
+        handle->getInstance(typeName, instanceId);
 
-        instancePtr->accept(serializer);
+    /* check nullptr using get() to avoid any KW error */
+    if (instancePtr.get() == nullptr) {
+        throw Response::HttpError(Response::ErrorStatus::BadRequest,
+                                  "Unknown instance: type=" + typeName + " instance_id=" +
+                                      instanceId);
     }
 
-    return std::make_unique<Response>(ContentTypeXml, serializer.getXml());
+    return mResponseCache.getResponse(request, handle->getGeneration(), ContentTypeXml, [&] {
+        std::string content;
+        xml::InstanceSerializer serializer(content);
+        instancePtr->accept(serializer);
+        return content;
+    });
 }
 
 Resource::ResponsePtr RefreshSubsystemResource::handlePost(const Request &)
 {
-    std::shared_ptr<InstanceModel> instanceModel;
-    auto guard = mInstanceModel.lock();
+    std::shared_ptr<const InstanceModel> instanceModel;
 
     try {
-        InstanceModelConverter converter(mSystem);
-        instanceModel = converter.createModel();
+        /* A request issued while a rebuild is in flight is served by this rebuild */
+        mRefreshes.run(0, instanceModel, [this](std::shared_ptr<const InstanceModel> &model) {
+            try {
+                InstanceModelConverter converter(mSystem);
+                if (mIncremental) {
+                    model = converter.createModel(mTopology);
+                } else {
+                    model = converter.createModel();
+                }
+            } catch (BaseModelConverter::Exception &) {
+                /* Topology retrieving has failed: invalidate the previous one */
+                mInstanceModel.publish(nullptr);
+                mTopology.clear();
+                throw;
+            }
+
+            /* Apply new topology: readers holding the previous one keep it until they are done */
+            mInstanceModel.publish(model);
+        });
     } catch (BaseModelConverter::Exception &e) {
-        /* Topology retrieving has failed: invalidate the previous one */
-        guard->reset();
-
         throw Response::HttpError(Response::ErrorStatus::InternalError,
                                   "Cannot refresh instance model: " + std::string(e.what()));
     }
 
-    /* Apply new topology */
-    *guard.get() = instanceModel;
-
     return std::make_unique<Response>();
 }
 
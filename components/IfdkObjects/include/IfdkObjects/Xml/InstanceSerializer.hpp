@@ -48,7 +48,7 @@ namespace xml
 class InstanceSerializer final : public Serializer<InstanceTraits>, public instance::ConstVisitor
 {
 public:
-    InstanceSerializer() = default;
+    using Serializer<InstanceTraits>::Serializer;
 
 private:
     /* ConstVisitor interface implementation */
@@ -30,16 +30,10 @@
 
 #pragma once
 
-#include <Poco/AutoPtr.h>
-#include <Poco/DOM/Document.h>
-#include <Poco/DOM/Element.h>
-#include <Poco/XML/XMLWriter.h>
-#include <Poco/DOM/DOMWriter.h>
-#include <Poco/DOM/Text.h>
-#include <stack>
+#include "IfdkObjects/Xml/XmlWriter.hpp"
+#include <ostream>
 #include <string>
 #include <type_traits>
-#include <sstream>
 
 namespace debug_agent
 {
@@ -54,30 +48,34 @@ namespace xml
  * This base serializer use type meta data (for instance xml tag name) from a trait class
  * supplied as template parameter.
  *
+ * The xml is written while the model is visited, no DOM is built. Depending on the constructor,
+ * it is written to a buffer owned by the serializer, to a caller buffer or to an output stream.
+ *
  * For more information about the traits format, see the Deserialize class.
  */
 template <template <class> class Traits>
 class Serializer
 {
 public:
-    /* The usage of operator new cannot be avoided since needed with Poco::AutoPtr. */
-    Serializer() : mDocument(new Poco::XML::Document()) {}
+    /** The xml is written to an internal buffer, see getXml() */
+    Serializer() : mWriter(mOwnBuffer) {}
 
-    /** Return the serialized xml */
-    std::string getXml() const
+    /** The xml is written to a caller buffer, which is cleared first but keeps its capacity:
+     * a buffer can be reused across several serializations without reallocation.
+     */
+    explicit Serializer(std::string &buffer) : mBuffer(&buffer), mWriter(buffer)
     {
-        Poco::XML::DOMWriter writer;
-        writer.setNewLine("\n");
-        writer.setOptions(Poco::XML::XMLWriter::PRETTY_PRINT);
-        writer.setIndent("    ");
-
-        std::stringstream output;
-        writer.writeNode(output, mDocument);
-        return output.str();
+        buffer.clear();
     }
 
+    /** The xml is streamed to an output stream, see XmlWriter */
+    explicit Serializer(std::ostream &output) : mBuffer(nullptr), mWriter(mOwnBuffer, output) {}
+
+    /** Return the serialized xml, which is empty if the xml is streamed to an output stream */
+    std::string getXml() const { return mBuffer != nullptr ? *mBuffer : std::string(); }
+
 protected:
-    /** Create a DOM element and push it on the stack. This element becomes the current element.
+    /** Open an element, which becomes the current element.
      *
      * The xml tag name is deduced from the type using traits.
      */
@@ -86,53 +84,28 @@ protected:
     {
         using NonConstC = typename std::remove_const<C>::type;
 
-        Poco::AutoPtr<Poco::XML::Element> element =
-            mDocument->createElement(Traits<NonConstC>::tag);
-
-        if (mElementStack.empty()) {
-            mDocument->appendChild(element);
-        } else {
-            topElement().appendChild(element);
-        }
-
-        mElementStack.push(element);
+        mWriter.startElement(Traits<NonConstC>::tag);
     }
 
-    /** Pop a DOM element */
-    void popElement()
-    {
-        assert(!mElementStack.empty());
-        mElementStack.pop();
-    }
-
-    /** Return the current DOM element, which is at the top of the stack */
-    Poco::XML::Element &topElement()
-    {
-        assert(!mElementStack.empty());
-        return *mElementStack.top();
-    }
+    /** Close the current element */
+    void popElement() { mWriter.endElement(); }
 
     /* Helper class to set a xml attribute to the current node */
     void setAttribute(const std::string &name, const std::string &value)
     {
-        topElement().setAttribute(name, value);
+        mWriter.setAttribute(name, value);
     }
 
     /* Helper class to set text content to the current node */
-    void setText(const std::string &txt)
-    {
-        Poco::AutoPtr<Poco::XML::Text> textNode(mDocument->createTextNode(txt));
-        topElement().appendChild(textNode);
-    }
+    void setText(const std::string &txt) { mWriter.characters(txt); }
 
 private:
-    using ElementStack = std::stack<Poco::XML::Element *>;
-
     Serializer(const Serializer &) = delete;
     Serializer &operator=(const Serializer &) = delete;
 
-    Poco::AutoPtr<Poco::XML::Document> mDocument;
-    ElementStack mElementStack;
+    std::string mOwnBuffer;
+    std::string *mBuffer = &mOwnBuffer;
+    XmlWriter mWriter;
 };
 }
 }
@@ -48,7 +48,7 @@ namespace xml
 class TypeSerializer final : public Serializer<TypeTraits>, public type::ConstVisitor
 {
 public:
-    TypeSerializer() = default;
+    using Serializer<TypeTraits>::Serializer;
 
 private:
     /* ConstVisitor interface implementation */
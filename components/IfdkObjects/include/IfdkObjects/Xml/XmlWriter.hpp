@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2016, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace debug_agent
+{
+namespace ifdk_objects
+{
+namespace xml
+{
+
+/** Streaming XML writer
+ *
+ * Elements are written while they are opened and closed, without building a document tree. The
+ * output is the one of the Poco DOMWriter with the PRETTY_PRINT option, which was used before:
+ * - a "\n" new line and a four spaces indentation per level,
+ * - attributes sorted by name,
+ * - elements without content closed by "/>",
+ * - text content on the line of its element.
+ *
+ * The attributes of an element can be set until its first child or text is written.
+ */
+class XmlWriter final
+{
+public:
+    struct Exception : std::logic_error
+    {
+        using std::logic_error::logic_error;
+    };
+
+    /** The XML is appended to a buffer */
+    explicit XmlWriter(std::string &buffer) : mBuffer(buffer), mOutput(nullptr) {}
+
+    /** The XML is written to an output stream, by chunks gathered in the buffer. The stream is
+     * flushed once the root element is closed. */
+    XmlWriter(std::string &buffer, std::ostream &output) : mBuffer(buffer), mOutput(&output) {}
+
+    XmlWriter(const XmlWriter &) = delete;
+    XmlWriter &operator=(const XmlWriter &) = delete;
+
+    void startElement(const std::string &tag);
+
+    /** @throw XmlWriter::Exception if the start tag of the current element is already written */
+    void setAttribute(const std::string &name, const std::string &value);
+
+    /** @throw XmlWriter::Exception if the text contains a control character */
+    void characters(const std::string &text);
+
+    void endElement();
+
+private:
+    using Attribute = std::pair<std::string, std::string>;
+
+    /** Write the start tag of the current element, with its attributes */
+    void writeStartTag();
+
+    /** Go to a new indented line if the current element has no text content */
+    void prettyPrint();
+
+    void writeNewLine();
+    void writeIndent();
+    void flushOutput();
+
+    /** Buffered size above which the buffer is written to the output stream */
+    static const std::size_t outputChunkSize = 16 * 1024;
+
+    std::string &mBuffer;
+    std::ostream *mOutput;
+
+    /** Tags of the open elements. The vector is not shrunk, so that tag strings are reused. */
+    std::vector<std::string> mTags;
+    std::size_t mDepth = 0;
+
+    /** Attributes of the current element, while its start tag is not written yet */
+    std::vector<Attribute> mAttributes;
+    std::size_t mAttributeCount = 0;
+    bool mStartTagPending = false;
+
+    /** True once text content is written in the current element, or at document start */
+    bool mContentWritten = true;
+};
+}
+}
+}
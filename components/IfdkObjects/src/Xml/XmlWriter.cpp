@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2016, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "IfdkObjects/Xml/XmlWriter.hpp"
+#include <algorithm>
+#include <cassert>
+
+namespace debug_agent
+{
+namespace ifdk_objects
+{
+namespace xml
+{
+
+void XmlWriter::startElement(const std::string &tag)
+{
+    if (mStartTagPending) {
+        writeStartTag();
+        mBuffer += '>';
+    }
+    prettyPrint();
+
+    if (mDepth < mTags.size()) {
+        mTags[mDepth].assign(tag);
+    } else {
+        mTags.push_back(tag);
+    }
+    ++mDepth;
+    mAttributeCount = 0;
+    mStartTagPending = true;
+    mContentWritten = false;
+}
+
+void XmlWriter::setAttribute(const std::string &name, const std::string &value)
+{
+    if (!mStartTagPending) {
+        throw Exception("Cannot set attribute '" + name + "': start tag already written");
+    }
+
+    /* Setting an attribute twice replaces its value, as in a DOM element */
+    auto begin = mAttributes.begin();
+    auto end = begin + mAttributeCount;
+    auto it = std::find_if(begin, end, [&](const Attribute &a) { return a.first == name; });
+    if (it != end) {
+        it->second.assign(value);
+    } else if (mAttributeCount < mAttributes.size()) {
+        mAttributes[mAttributeCount].first.assign(name);
+        mAttributes[mAttributeCount].second.assign(value);
+        ++mAttributeCount;
+    } else {
+        mAttributes.emplace_back(name, value);
+        ++mAttributeCount;
+    }
+}
+
+void XmlWriter::characters(const std::string &text)
+{
+    if (text.empty()) {
+        return;
+    }
+    if (mStartTagPending) {
+        writeStartTag();
+        mBuffer += '>';
+    }
+    mContentWritten = true;
+
+    for (char c : text) {
+        switch (c) {
+        case '"':
+            mBuffer += "&quot;";
+            break;
+        case '\'':
+            mBuffer += "&apos;";
+            break;
+        case '&':
+            mBuffer += "&amp;";
+            break;
+        case '<':
+            mBuffer += "&lt;";
+            break;
+        case '>':
+            mBuffer += "&gt;";
+            break;
+        default:
+            if (static_cast<unsigned char>(c) < 32 && c != '\t' && c != '\r' && c != '\n') {
+                throw Exception("Invalid character token.");
+            }
+            mBuffer += c;
+        }
+    }
+}
+
+void XmlWriter::endElement()
+{
+    assert(mDepth > 0);
+
+    if (mStartTagPending) {
+        writeStartTag();
+        mBuffer += "/>";
+        --mDepth;
+    } else {
+        --mDepth;
+        prettyPrint();
+        mBuffer += "</";
+        mBuffer += mTags[mDepth];
+        mBuffer += '>';
+    }
+    mContentWritten = false;
+
+    if (mDepth == 0) {
+        writeNewLine();
+        flushOutput();
+    } else if (mOutput != nullptr && mBuffer.size() >= outputChunkSize) {
+        flushOutput();
+    }
+}
+
+void XmlWriter::writeStartTag()
+{
+    mBuffer += '<';
+    mBuffer += mTags[mDepth - 1];
+    std::sort(mAttributes.begin(), mAttributes.begin() + mAttributeCount,
+              [](const Attribute &a, const Attribute &b) { return a.first < b.first; });
+
+    for (std::size_t index = 0; index < mAttributeCount; ++index) {
+        mBuffer += ' ';
+        mBuffer += mAttributes[index].first;
+        mBuffer += "=\"";
+        for (char c : mAttributes[index].second) {
+            switch (c) {
+            case '"':
+                mBuffer += "&quot;";
+                break;
+            case '\'':
+                mBuffer += "&apos;";
+                break;
+            case '&':
+                mBuffer += "&amp;";
+                break;
+            case '<':
+                mBuffer += "&lt;";
+                break;
+            case '>':
+                mBuffer += "&gt;";
+                break;
+            case '\t':
+                mBuffer += "&#9;";
+                break;
+            case '\r':
+                mBuffer += "&#xD;";
+                break;
+            case '\n':
+                mBuffer += "&#xA;";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 32) {
+                    throw Exception("Invalid character token.");
+                }
+                mBuffer += c;
+            }
+        }
+        mBuffer += '"';
+    }
+    mStartTagPending = false;
+}
+
+void XmlWriter::prettyPrint()
+{
+    if (!mContentWritten) {
+        writeNewLine();
+        writeIndent();
+    }
+}
+
+void XmlWriter::writeNewLine()
+{
+    mBuffer += '\n';
+}
+
+void XmlWriter::writeIndent()
+{
+    for (std::size_t level = 0; level < mDepth; ++level) {
+        mBuffer += "    ";
+    }
+}
+
+void XmlWriter::flushOutput()
+{
+    if (mOutput != nullptr) {
+        mOutput->write(mBuffer.data(), static_cast<std::streamsize>(mBuffer.size()));
+        mBuffer.clear();
+    }
+}
+}
+}
+}
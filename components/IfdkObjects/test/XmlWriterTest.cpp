@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2015-2016, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "IfdkObjects/Xml/XmlWriter.hpp"
+#include "IfdkObjects/Xml/InstanceSerializer.hpp"
+#include "IfdkObjects/Xml/TypeSerializer.hpp"
+#include "catch.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <streambuf>
+#include <string>
+
+using namespace debug_agent::ifdk_objects;
+using namespace debug_agent::ifdk_objects::xml;
+
+TEST_CASE("Xml writer: pretty print")
+{
+    std::string xml;
+    XmlWriter writer(xml);
+
+    writer.startElement("root");
+    writer.setAttribute("b", "2");
+    writer.setAttribute("a", "1");
+    writer.setAttribute("b", "3");
+    writer.startElement("empty");
+    writer.endElement();
+    writer.startElement("parent");
+    writer.startElement("text");
+    writer.characters("value");
+    writer.endElement();
+    writer.startElement("no_text");
+    writer.characters("");
+    writer.endElement();
+    writer.endElement();
+    writer.endElement();
+
+    CHECK(xml == "<root a=\"1\" b=\"3\">\n"
+                 "    <empty/>\n"
+                 "    <parent>\n"
+                 "        <text>value</text>\n"
+                 "        <no_text/>\n"
+                 "    </parent>\n"
+                 "</root>\n");
+}
+
+TEST_CASE("Xml writer: escaping")
+{
+    std::string xml;
+    XmlWriter writer(xml);
+
+    writer.startElement("root");
+    writer.setAttribute("name", "\"a\" & 'b' <c>\t\r\n");
+    writer.characters("\"a\" & 'b' <c>\t");
+    writer.endElement();
+
+    CHECK(xml == "<root name=\"&quot;a&quot; &amp; &apos;b&apos; &lt;c&gt;&#9;&#xD;&#xA;\">"
+                 "&quot;a&quot; &amp; &apos;b&apos; &lt;c&gt;\t</root>\n");
+}
+
+TEST_CASE("Xml writer: errors")
+{
+    std::string xml;
+    XmlWriter writer(xml);
+
+    writer.startElement("root");
+    CHECK_THROWS_AS(writer.characters(std::string(1, '\x01')), XmlWriter::Exception);
+
+    writer.startElement("child");
+    writer.endElement();
+    CHECK_THROWS_AS(writer.setAttribute("late", "value"), XmlWriter::Exception);
+}
+
+/** Synthetic instance model, similar to the one of a big topology */
+static void populateInstances(instance::InstanceCollection &collection, std::size_t instanceCount)
+{
+    for (std::size_t index = 0; index < instanceCount; ++index) {
+        std::string id = std::to_string(index);
+        auto instance = std::make_shared<instance::Instance>("cavs.module-copier", id);
+
+        instance->getParents().add(std::make_shared<instance::ServiceRef>("cavs.fwlogs", "0"));
+        instance->getParents().add(std::make_shared<instance::InstanceRef>("cavs.pipe", id));
+
+        auto children = std::make_shared<instance::InstanceRefCollection>("cavs.pins");
+        children->add(instance::InstanceRef("cavs.pin", id + ".0"));
+        children->add(instance::InstanceRef("cavs.pin", id + ".1"));
+        instance->getChildren().add(children);
+
+        collection.add(instance);
+    }
+}
+
+/** Stream buffer that only counts the written bytes */
+class CountingStreamBuf : public std::streambuf
+{
+public:
+    std::size_t getCount() const { return mCount; }
+
+private:
+    int_type overflow(int_type c) override
+    {
+        if (!traits_type::eq_int_type(c, traits_type::eof())) {
+            ++mCount;
+        }
+        return traits_type::not_eof(c);
+    }
+
+    std::streamsize xsputn(const char *, std::streamsize count) override
+    {
+        mCount += static_cast<std::size_t>(count);
+        return count;
+    }
+
+    std::size_t mCount = 0;
+};
+
+TEST_CASE("Xml serializer: buffer and stream outputs")
+{
+    instance::InstanceCollection collection;
+    populateInstances(collection, 1000);
+
+    InstanceSerializer serializer;
+    collection.accept(serializer);
+    std::string expectedXml = serializer.getXml();
+
+    /* Reused buffer: the previous content is discarded */
+    std::string buffer = "previous content";
+    for (int iteration = 0; iteration < 2; ++iteration) {
+        InstanceSerializer bufferSerializer(buffer);
+        collection.accept(bufferSerializer);
+        CHECK(buffer == expectedXml);
+        CHECK(bufferSerializer.getXml() == expectedXml);
+    }
+
+    /* Stream: the xml is written by chunks */
+    std::ostringstream stream;
+    InstanceSerializer streamSerializer(stream);
+    collection.accept(streamSerializer);
+    CHECK(stream.str() == expectedXml);
+    CHECK(streamSerializer.getXml().empty());
+
+    type::Description description("a < b");
+    std::ostringstream typeStream;
+    TypeSerializer typeSerializer(typeStream);
+    description.accept(typeSerializer);
+    CHECK(typeStream.str() == "<description>a &lt; b</description>\n");
+}
+
+template <typename Serialize>
+static double measureSerialization(std::size_t iterations, Serialize serialize)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t iteration = 0; iteration < iterations; ++iteration) {
+        serialize();
+    }
+    std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+    return duration.count() * 1e3 / iterations;
+}
+
+TEST_CASE("Xml serializer: instance collection benchmark", "[.][benchmark]")
+{
+    for (std::size_t instanceCount : {1000, 5000, 20000}) {
+        instance::InstanceCollection collection;
+        populateInstances(collection, instanceCount);
+        const std::size_t iterations = std::max<std::size_t>(100000 / instanceCount, 1);
+
+        std::size_t xmlSize = 0;
+        double copyDuration = measureSerialization(iterations, [&] {
+            InstanceSerializer serializer;
+            collection.accept(serializer);
+            xmlSize = serializer.getXml().size();
+        });
+
+        std::string buffer;
+        double bufferDuration = measureSerialization(iterations, [&] {
+            InstanceSerializer serializer(buffer);
+            collection.accept(serializer);
+        });
+        CHECK(buffer.size() == xmlSize);
+
+        CountingStreamBuf streamBuf;
+        std::ostream stream(&streamBuf);
+        double streamDuration = measureSerialization(iterations, [&] {
+            InstanceSerializer serializer(stream);
+            collection.accept(serializer);
+        });
+        CHECK(streamBuf.getCount() == iterations * xmlSize);
+
+        /* Memory: the buffered serialization holds the whole xml, the streamed one holds the
+         * chunks only (the stream is flushed each time a chunk is complete) */
+        std::cout << instanceCount << " instances, " << xmlSize << " bytes of xml: copied "
+                  << copyDuration << " ms, reused buffer " << bufferDuration
+                  << " ms (holding " << buffer.capacity() << " bytes), streamed "
+                  << streamDuration << " ms\n";
+    }
+}
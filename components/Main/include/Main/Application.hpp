@@ -30,6 +30,7 @@
 
 #pragma once
 
+#include "cAVS/SystemDriverFactory.hpp"
 #include <Poco/Util/ServerApplication.h>
 #include <Poco/Util/OptionSet.h>
 #include <inttypes.h>
@@ -58,6 +59,11 @@ private:
     void handlePort(const std::string &name, const std::string &value);
     void handlePfwConfig(const std::string &name, const std::string &value);
     void handleLogControlOnly(const std::string &name, const std::string &value);
+    void handlePersistentDebugFs(const std::string &name, const std::string &value);
+    void handleRecordIpcTrace(const std::string &name, const std::string &value);
+    void handleSimulateFirmware(const std::string &name, const std::string &value);
+    void handleCorePowerIdleTimeout(const std::string &name, const std::string &value);
+    void handleIncrementalRefresh(const std::string &name, const std::string &value);
     void handleVerbose(const std::string &name, const std::string &value);
     void handleValidation(const std::string &name, const std::string &value);
     void handleVersion(const std::string &name, const std::string &value);
@@ -68,11 +74,18 @@ private:
         uint32_t serverPort;
         std::string pfwConfig;
         bool logControlOnly;
+        bool persistentDebugFs;
+        std::string ipcTraceFileName;
+        std::string simulatedFirmwareConfig;
+        uint32_t corePowerIdleTimeoutMs;
+        bool incrementalRefresh;
         bool serverIsVerbose;
         bool validationRequested;
         Config()
-            : helpRequested(false), serverPort(9090), logControlOnly(false), serverIsVerbose(false),
-              validationRequested(false){};
+            : helpRequested(false), serverPort(9090), logControlOnly(false),
+              persistentDebugFs(false),
+              corePowerIdleTimeoutMs(cavs::SystemDriverFactory::defaultCorePowerIdleTimeoutMs),
+              incrementalRefresh(false), serverIsVerbose(false), validationRequested(false){};
     };
 
     Config mConfig;
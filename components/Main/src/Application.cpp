@@ -85,6 +85,33 @@ void Application::handleLogControlOnly(const std::string &, const std::string &)
     mConfig.logControlOnly = true;
 }
 
+void Application::handlePersistentDebugFs(const std::string &, const std::string &)
+{
+    mConfig.persistentDebugFs = true;
+}
+
+void Application::handleRecordIpcTrace(const std::string &, const std::string &value)
+{
+    mConfig.ipcTraceFileName = value;
+}
+
+void Application::handleSimulateFirmware(const std::string &, const std::string &value)
+{
+    mConfig.simulatedFirmwareConfig = value;
+}
+
+void Application::handleCorePowerIdleTimeout(const std::string &, const std::string &value)
+{
+    std::stringstream ss(value);
+    ss >> mConfig.corePowerIdleTimeoutMs;
+    assert((!ss.fail()) && (!ss.bad()));
+}
+
+void Application::handleIncrementalRefresh(const std::string &, const std::string &)
+{
+    mConfig.incrementalRefresh = true;
+}
+
 void Application::handleVerbose(const std::string &, const std::string &)
 {
     mConfig.serverIsVerbose = true;
@@ -133,6 +160,54 @@ void Application::defineOptions(OptionSet &options)
             .repeatable(false)
             .callback(OptionCallback<Application>(this, &Application::handleLogControlOnly)));
 
+    options.addOption(
+        Option("persistentDebugFs", "pd", "Keep the debugfs entries open for the DebugAgent "
+                                          "lifetime (Linux only)")
+            .required(false)
+            .repeatable(false)
+            .callback(OptionCallback<Application>(this, &Application::handlePersistentDebugFs)));
+
+    options.addOption(
+        Option("recordIpcTrace", "rt", "Record all the driver accesses into the given IPC trace "
+                                       "file (Linux only)")
+            .required(false)
+            .repeatable(false)
+            .argument("file")
+            .callback(OptionCallback<Application>(this, &Application::handleRecordIpcTrace)));
+
+    options.addOption(
+        Option("simulateFirmware", "sf", "Simulate the firmware instead of accessing the audio "
+                                         "driver, e.g. \"cores=4,pipelines=16,logRate=200\" "
+                                         "(Linux only)")
+            .required(false)
+            .repeatable(false)
+            .argument("config")
+            .callback(OptionCallback<Application>(this, &Application::handleSimulateFirmware)));
+
+    options.addOption(
+        Option("corePowerIdleTimeout", "pt",
+               "Set the delay in milliseconds during which the DSP core is kept awake after a "
+               "module command, so that command bursts share a single core power vote "
+               "(Linux only, default: " +
+                   std::to_string(SystemDriverFactory::defaultCorePowerIdleTimeoutMs) + ")")
+            .required(false)
+            .repeatable(false)
+            .argument("ms")
+
+            /* Poco forces us to use operator new here: the Option takes the ownership
+             * of the IntValidator.
+             */
+            .validator(new IntValidator(0, 60000))
+            .callback(OptionCallback<Application>(this, &Application::handleCorePowerIdleTimeout)));
+
+    options.addOption(
+        Option("incrementalRefresh", "ir", "Refresh the instance model incrementally: only the "
+                                           "module instances of changed pipelines and tasks are "
+                                           "queried again")
+            .required(false)
+            .repeatable(false)
+            .callback(OptionCallback<Application>(this, &Application::handleIncrementalRefresh)));
+
     options.addOption(
         Option("verbose", "v", "Enable verbose logging")
             .required(false)
@@ -158,9 +233,13 @@ int Application::main(const std::vector<std::string> &)
     }
 
     try {
-        SystemDriverFactory driverFactory(mConfig.logControlOnly);
+        SystemDriverFactory driverFactory(mConfig.logControlOnly, mConfig.persistentDebugFs,
+                                          mConfig.ipcTraceFileName,
+                                          mConfig.simulatedFirmwareConfig,
+                                          mConfig.corePowerIdleTimeoutMs);
         DebugAgent debugAgent(driverFactory, mConfig.serverPort, mConfig.pfwConfig,
-                              mConfig.serverIsVerbose, mConfig.validationRequested);
+                              mConfig.serverIsVerbose, mConfig.validationRequested,
+                              mConfig.incrementalRefresh);
 
         std::cout << "DebugAgent started" << std::endl;
 
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2016, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include "Rest/Response.hpp"
+#include <functional>
+#include <memory>
+#include <sstream>
+#include <string>
+
+namespace debug_agent
+{
+namespace rest
+{
+
+/**
+ * Describe a REST HTTP response whose body has been serialized beforehand, typically by a
+ * ResponseCache.
+ * The body is sent with a Content-Length instead of chunks, along with its entity tag (ETag). If
+ * the client already has this body, only a "304 Not Modified" header is sent.
+ */
+class CachedResponse final : public Response
+{
+public:
+    using base = Response;
+
+    /** A serialized response body, which is shared by the responses and never modified */
+    struct Body
+    {
+        Body(const std::string &contentType, std::string content)
+            : contentType(contentType), content(std::move(content)),
+              entityTag(computeEntityTag(this->content))
+        {
+        }
+
+        const std::string contentType;
+        const std::string content;
+        /** The quoted HTTP entity tag, which only depends on the content bytes */
+        const std::string entityTag;
+
+    private:
+        static std::string computeEntityTag(const std::string &content)
+        {
+            std::ostringstream tag;
+            tag << '"' << std::hex << std::hash<std::string>()(content) << '-' << content.size()
+                << '"';
+            return tag.str();
+        }
+    };
+
+    /**
+     * @param[in] body the body to be sent
+     * @param[in] notModified true if the client already has this body: the body is not sent
+     */
+    CachedResponse(std::shared_ptr<const Body> body, bool notModified)
+        : base(body->contentType), mBody(std::move(body)), mNotModified(notModified)
+    {
+    }
+
+    void sendHttpHeader(Poco::Net::HTTPServerResponse &serverResponse) override
+    {
+        serverResponse.setKeepAlive(true);
+        serverResponse.setContentType(mContentType);
+
+        /* A 304 response may only carry the length of the body a 200 response would have */
+        serverResponse.setContentLength(static_cast<std::streamsize>(mBody->content.size()));
+        serverResponse.set("ETag", mBody->entityTag);
+        serverResponse.setStatus(mNotModified
+                                     ? Poco::Net::HTTPResponse::HTTPStatus::HTTP_NOT_MODIFIED
+                                     : Poco::Net::HTTPResponse::HTTPStatus::HTTP_OK);
+
+        mOut = &serverResponse.send();
+    }
+
+    void sendHttpBody() override
+    {
+        ASSERT_ALWAYS(mOut != nullptr);
+
+        if (!mNotModified) {
+            mOut->write(mBody->content.data(),
+                        static_cast<std::streamsize>(mBody->content.size()));
+        }
+    }
+
+private:
+    std::shared_ptr<const Body> mBody;
+    const bool mNotModified;
+};
+}
+}
@@ -33,6 +33,7 @@
 #include <Util/AssertAlways.hpp>
 #include <Poco/StreamCopier.h>
 #include <Poco/Net/HTTPRequest.h>
+#include <Poco/Net/NameValueCollection.h>
 #include <iostream>
 #include <map>
 #include <cassert>
@@ -48,6 +49,7 @@ namespace rest
  * - a verb (Get, Post..)
  * - a request content (as an input stream)
  * - the identifier values (ex: "account-id=12")
+ * - the HTTP header fields
  */
 class Request final
 {
@@ -95,12 +97,20 @@ public:
         return it->second;
     }
 
+    /** @return the value of an HTTP header field, or an empty string if the field is missing.
+     * Field names are case insensitive. */
+    std::string getHeaderValue(const std::string &name) const
+    {
+        return mHeaders.get(name, std::string());
+    }
+
 private:
     friend class RestResourceRequestHandler;
 
     /* Constructor is called by the RestResourceRequestHandler class */
-    Request(Verb verb, std::istream &requestStream, const Identifiers &identifiers)
-        : mVerb(verb), mRequestStream(requestStream), mIdentifiers(identifiers)
+    Request(Verb verb, std::istream &requestStream, const Identifiers &identifiers,
+            const Poco::Net::NameValueCollection &headers)
+        : mVerb(verb), mRequestStream(requestStream), mIdentifiers(identifiers), mHeaders(headers)
     {
     }
 
@@ -110,6 +120,7 @@ private:
     Verb mVerb;
     std::istream &mRequestStream;
     Identifiers mIdentifiers;
+    const Poco::Net::NameValueCollection &mHeaders;
 };
 }
 }
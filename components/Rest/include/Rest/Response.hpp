@@ -144,7 +144,7 @@ public:
      * @param[in] serverResponse the Poco HTTP server response object through which the Response
      * has to be sent out.
      */
-    void sendHttpHeader(Poco::Net::HTTPServerResponse &serverResponse)
+    virtual void sendHttpHeader(Poco::Net::HTTPServerResponse &serverResponse)
     {
         setCommonProperties(serverResponse);
         serverResponse.setContentType(mContentType);
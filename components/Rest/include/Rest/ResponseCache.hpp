@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2016, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include "Rest/CachedResponse.hpp"
+#include "Rest/Request.hpp"
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace debug_agent
+{
+namespace rest
+{
+
+/**
+ * Cache of the serialized responses of a resource whose content only changes with the
+ * generation of its model.
+ *
+ * Responses are cached by request identifiers, i.e. by resource path, for the latest model
+ * generation: a newer generation drops the cached responses of the previous ones. Cached
+ * responses carry an entity tag, so that the clients polling a resource with If-None-Match get a
+ * "304 Not Modified" response without body as long as the content is unchanged.
+ */
+class ResponseCache final
+{
+public:
+    /** Serialize the body of the requested resource
+     * @throw Response::HttpError, which is not cached */
+    using Serializer = std::function<std::string()>;
+
+    ResponseCache() = default;
+
+    /**
+     * @param[in] request the GET request of the resource
+     * @param[in] generation the generation of the model the body is serialized from, which shall
+     *                       increase each time the model changes
+     * @param[in] contentType MIME type corresponding to body type
+     * @param[in] serialize called to serialize the body if it is not cached yet
+     * @return the response to be sent to the client
+     * @throw Response::HttpError
+     */
+    std::unique_ptr<Response> getResponse(const Request &request, uint64_t generation,
+                                          const std::string &contentType,
+                                          const Serializer &serialize);
+
+private:
+    using BodyPtr = std::shared_ptr<const CachedResponse::Body>;
+
+    ResponseCache(const ResponseCache &) = delete;
+    ResponseCache &operator=(const ResponseCache &) = delete;
+
+    /** @return the body of the request, from the cache or serialized */
+    BodyPtr getBody(const std::string &path, uint64_t generation, const std::string &contentType,
+                    const Serializer &serialize);
+
+    /** @return true if the If-None-Match header of the request matches the entity tag */
+    static bool matchesEntityTag(const Request &request, const std::string &entityTag);
+
+    std::mutex mMutex;
+    uint64_t mGeneration = 0;
+    std::map<std::string, BodyPtr> mBodies;
+};
+}
+}
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2016, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Rest/ResponseCache.hpp"
+#include "Util/StringHelper.hpp"
+
+namespace debug_agent
+{
+namespace rest
+{
+
+std::unique_ptr<Response> ResponseCache::getResponse(const Request &request,
+                                                     uint64_t generation,
+                                                     const std::string &contentType,
+                                                     const Serializer &serialize)
+{
+    /* The identifiers of a resource request locate the requested item */
+    std::string path;
+    for (auto &identifier : request.getIdentifiers()) {
+        path += "/" + identifier.first + "=" + identifier.second;
+    }
+
+    BodyPtr body = getBody(path, generation, contentType, serialize);
+    return std::make_unique<CachedResponse>(body, matchesEntityTag(request, body->entityTag));
+}
+
+ResponseCache::BodyPtr ResponseCache::getBody(const std::string &path, uint64_t generation,
+                                              const std::string &contentType,
+                                              const Serializer &serialize)
+{
+    {
+        std::lock_guard<std::mutex> locker(mMutex);
+        if (generation > mGeneration) {
+            /* The model has changed: the cached bodies are outdated */
+            mBodies.clear();
+            mGeneration = generation;
+        }
+        auto it = mBodies.find(path);
+        if (generation == mGeneration && it != mBodies.end()) {
+            return it->second;
+        }
+    }
+
+    /* Serializing out of the lock, so that the cached bodies are still served meanwhile */
+    auto body = std::make_shared<const CachedResponse::Body>(contentType, serialize());
+
+    std::lock_guard<std::mutex> locker(mMutex);
+    /* Bodies of an older model generation, still used by a late request, are not cached */
+    if (generation == mGeneration) {
+        mBodies[path] = body;
+    }
+    return body;
+}
+
+bool ResponseCache::matchesEntityTag(const Request &request, const std::string &entityTag)
+{
+    /* If-None-Match holds "*" or a comma separated list of entity tags, which may be weak */
+    std::string tags = request.getHeaderValue("If-None-Match");
+    std::size_t begin = 0;
+    while (begin < tags.size()) {
+        std::size_t end = tags.find(',', begin);
+        if (end == std::string::npos) {
+            end = tags.size();
+        }
+        std::string tag = util::StringHelper::trim(tags.substr(begin, end - begin));
+        if (util::StringHelper::startWith(tag, "W/")) {
+            tag.erase(0, 2);
+        }
+        if (tag == "*" || tag == entityTag) {
+            return true;
+        }
+        begin = end + 1;
+    }
+    return false;
+}
+}
+}
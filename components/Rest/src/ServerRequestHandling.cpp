@@ -58,7 +58,7 @@ void RestResourceRequestHandler::handleRequest(HTTPServerRequest &req, HTTPServe
     }
 
     /* Forwarding the request to the resource, that will handle it. */
-    Request request(verb, req.stream(), *mIdentifiers);
+    Request request(verb, req.stream(), *mIdentifiers, req);
 
     Resource::ResponsePtr response;
 
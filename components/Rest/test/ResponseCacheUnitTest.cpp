@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2016, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Rest/Server.hpp"
+#include "Rest/ResponseCache.hpp"
+#include "TestCommon/HttpClientSimulator.hpp"
+#include <Poco/Net/HTTPClientSession.h>
+#include <Poco/Net/HTTPRequest.h>
+#include <Poco/Net/HTTPResponse.h>
+#include <Poco/StreamCopier.h>
+#include "catch.hpp"
+#include <atomic>
+#include <memory>
+
+using namespace debug_agent::rest;
+using namespace debug_agent::test_common;
+using namespace Poco::Net;
+
+/* This resource serves "<item>@<generation>" bodies through a response cache, and counts the
+ * serializations */
+class CachedItemResource : public Resource
+{
+public:
+    std::atomic<uint64_t> generation{1};
+    std::atomic<std::size_t> serializationCount{0};
+
+protected:
+    virtual std::unique_ptr<Response> handleGet(const Request &request) override
+    {
+        std::string item = request.getIdentifierValue("item");
+        uint64_t currentGeneration = generation;
+        return mResponseCache.getResponse(request, currentGeneration, "text/plain", [&] {
+            ++serializationCount;
+            if (item == "unknown") {
+                throw Response::HttpError(Response::ErrorStatus::BadRequest, "Unknown item");
+            }
+            return item + "@" + std::to_string(currentGeneration);
+        });
+    }
+
+private:
+    ResponseCache mResponseCache;
+};
+
+/** The HTTP response fields checked by these tests */
+struct ReceivedResponse
+{
+    HTTPResponse::HTTPStatus status;
+    std::string entityTag;
+    bool chunked;
+    std::streamsize contentLength;
+    std::string content;
+};
+
+static ReceivedResponse get(const std::string &uri, const std::string &ifNoneMatch = "")
+{
+    HTTPClientSession session("localhost", HttpClientSimulator::DefaultPort);
+    HTTPRequest request(HTTPRequest::HTTP_GET, uri);
+    if (!ifNoneMatch.empty()) {
+        request.set("If-None-Match", ifNoneMatch);
+    }
+    session.sendRequest(request);
+
+    HTTPResponse response;
+    std::istream &responseStream = session.receiveResponse(response);
+    ReceivedResponse received{response.getStatus(), response.get("ETag", ""),
+                              response.getChunkedTransferEncoding(),
+                              response.getContentLength(), ""};
+    Poco::StreamCopier::copyToString(responseStream, received.content);
+    return received;
+}
+
+TEST_CASE("Response cache", "[Server]")
+{
+    std::unique_ptr<Dispatcher> dispatcher = std::make_unique<Dispatcher>();
+    auto resource = std::make_shared<CachedItemResource>();
+    dispatcher->addResource("/item/${item}", resource);
+    Server server(std::move(dispatcher), HttpClientSimulator::DefaultPort);
+
+    ReceivedResponse first = get("/item/a");
+    CHECK(first.status == HTTPResponse::HTTP_OK);
+    CHECK(first.content == "a@1");
+    CHECK_FALSE(first.chunked);
+    CHECK(first.contentLength == 3);
+    CHECK_FALSE(first.entityTag.empty());
+    CHECK(resource->serializationCount == 1);
+
+    SECTION ("Cached bodies are not serialized again") {
+        ReceivedResponse second = get("/item/a");
+        CHECK(second.content == "a@1");
+        CHECK(second.entityTag == first.entityTag);
+
+        CHECK(get("/item/b").content == "b@1");
+        CHECK(resource->serializationCount == 2);
+    }
+
+    SECTION ("A known entity tag gets a 304 response without body") {
+        for (auto &tags : {first.entityTag, "\"other\", " + first.entityTag,
+                           "W/" + first.entityTag, std::string("*")}) {
+            ReceivedResponse notModified = get("/item/a", tags);
+            CHECK(notModified.status == HTTPResponse::HTTP_NOT_MODIFIED);
+            CHECK(notModified.entityTag == first.entityTag);
+            CHECK(notModified.content.empty());
+        }
+
+        ReceivedResponse modified = get("/item/a", "\"other\"");
+        CHECK(modified.status == HTTPResponse::HTTP_OK);
+        CHECK(modified.content == "a@1");
+        CHECK(resource->serializationCount == 1);
+    }
+
+    SECTION ("A new model generation invalidates the cached bodies") {
+        resource->generation = 2;
+        ReceivedResponse refreshed = get("/item/a", first.entityTag);
+        CHECK(refreshed.status == HTTPResponse::HTTP_OK);
+        CHECK(refreshed.content == "a@2");
+        CHECK(refreshed.entityTag != first.entityTag);
+        CHECK(resource->serializationCount == 2);
+    }
+
+    SECTION ("Errors are not cached") {
+        CHECK(get("/item/unknown").status == HTTPResponse::HTTP_BAD_REQUEST);
+        CHECK(get("/item/unknown").status == HTTPResponse::HTTP_BAD_REQUEST);
+        CHECK(resource->serializationCount == 3);
+    }
+}
@@ -54,6 +54,24 @@ public:
      */
     virtual TlvWrapperInterface *getTlvWrapperForTag(unsigned int tag) const noexcept = 0;
 
+    /**
+     * Read the value of a tag from a binary source and reflect it to its shadow runtime variable.
+     * The default implementation uses the TlvWrapperInterface of the tag.
+     * @param[in] tag the tag of the value
+     * @param[in] binarySource the memory from which the value will be read
+     * @return false if the tag is unknown
+     * @throw TlvWrapperInterface::Exception
+     */
+    virtual bool readValue(unsigned int tag, const util::BufferView &binarySource) const
+    {
+        TlvWrapperInterface *tlvWrapper = getTlvWrapperForTag(tag);
+        if (tlvWrapper == nullptr) {
+            return false;
+        }
+        tlvWrapper->readFrom(binarySource);
+        return true;
+    }
+
     /**
      * Invalidate the entire collection of TlvWrapperInterface
      * @see TlvWrapperInterface
@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2016, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#pragma once
+
+#include "Tlv/TlvResponseHandlerInterface.hpp"
+#include "Tlv/TlvWrapper.hpp"
+#include "Tlv/TlvVectorWrapper.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+namespace debug_agent
+{
+namespace tlv
+{
+/**
+ * Compile-time alternative to TlvDictionary, for a response handler whose TLV are known at
+ * compile time.
+ *
+ * Each tag is bound to members of the response handler class (Owner) by a field type: Field for
+ * a simple value and its valid flag, VectorField for a vector value and VoidField for an ignored
+ * tag. A Table of fields is a constant tag table, sorted by tag, with a statically typed reader
+ * per tag: no map lookup nor wrapper object is involved. If the tags are 0, 1, ... N-1 the tag
+ * is directly used as table index, otherwise it is searched by dichotomy.
+ *
+ * Since fields are bound to member pointers instead of references, a copied response handler
+ * stays consistent.
+ *
+ * @tparam Owner the response handler type
+ * @tparam TagsEnumClass the type of the enum class defining the TLV tag list
+ * @see TlvStaticResponseHandler
+ */
+template <typename Owner, typename TagsEnumClass>
+struct TlvStaticDictionary
+{
+    /** Binds a tag to a simple value and its valid flag */
+    template <TagsEnumClass tagValue, typename ValueType, ValueType Owner::*value,
+              bool Owner::*valid>
+    struct Field
+    {
+        static constexpr TagsEnumClass tag = tagValue;
+
+        static void readFrom(Owner &owner, const util::BufferView &binarySource)
+        {
+            TlvWrapper<ValueType>::readValue(owner.*value, owner.*valid, binarySource);
+        }
+
+        static void invalidate(Owner &owner) noexcept { owner.*valid = false; }
+    };
+
+    /** Binds a tag to a vector value, which is valid unless it is empty */
+    template <TagsEnumClass tagValue, typename ValueType, std::vector<ValueType> Owner::*values>
+    struct VectorField
+    {
+        static constexpr TagsEnumClass tag = tagValue;
+
+        static void readFrom(Owner &owner, const util::BufferView &binarySource)
+        {
+            TlvVectorWrapper<ValueType>::readValues(owner.*values, binarySource);
+        }
+
+        static void invalidate(Owner &owner) noexcept { (owner.*values).clear(); }
+    };
+
+    /** Ignores a tag, as a TlvVoidWrapper */
+    template <TagsEnumClass tagValue>
+    struct VoidField
+    {
+        static constexpr TagsEnumClass tag = tagValue;
+
+        static void readFrom(Owner &, const util::BufferView &) {}
+
+        static void invalidate(Owner &) noexcept {}
+    };
+
+    /** Tag table of a field list, which shall be sorted by tag */
+    template <typename... Fields>
+    class Table
+    {
+    public:
+        /**
+         * Read the value of a tag from a binary source.
+         * @return false if the tag is unknown
+         * @throw TlvWrapperInterface::Exception
+         */
+        static bool readValue(Owner &owner, unsigned int tag, const util::BufferView &binarySource)
+        {
+            static_assert(isSorted(), "The fields shall be sorted by tag");
+
+            std::size_t index;
+            if (isDense()) {
+                index = tag;
+            } else {
+                index = std::lower_bound(std::begin(tags), std::end(tags), tag) - std::begin(tags);
+                if (index != fieldCount && tags[index] != tag) {
+                    index = fieldCount;
+                }
+            }
+            if (index >= fieldCount) {
+                return false;
+            }
+            readers[index](owner, binarySource);
+            return true;
+        }
+
+        /** Invalidate all fields, without any lookup */
+        static void invalidateAll(Owner &owner) noexcept
+        {
+            /* Calling the invalidate() method of each field in turn */
+            int expander[] = {(Fields::invalidate(owner), 0)...};
+            (void)expander;
+        }
+
+    private:
+        using Reader = void (*)(Owner &, const util::BufferView &);
+
+        static constexpr std::size_t fieldCount = sizeof...(Fields);
+        static_assert(fieldCount > 0, "A tag table shall contain at least one field");
+
+        static constexpr unsigned int tags[] = {static_cast<unsigned int>(Fields::tag)...};
+        static constexpr Reader readers[] = {&Fields::readFrom...};
+
+        static constexpr bool isSorted()
+        {
+            for (std::size_t i = 1; i < fieldCount; ++i) {
+                if (tags[i - 1] >= tags[i]) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        static constexpr bool isDense()
+        {
+            for (std::size_t i = 0; i < fieldCount; ++i) {
+                if (tags[i] != i) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+};
+
+template <typename Owner, typename TagsEnumClass>
+template <typename... Fields>
+constexpr unsigned int TlvStaticDictionary<Owner, TagsEnumClass>::Table<Fields...>::tags[];
+
+template <typename Owner, typename TagsEnumClass>
+template <typename... Fields>
+constexpr typename TlvStaticDictionary<Owner, TagsEnumClass>::template Table<Fields...>::Reader
+    TlvStaticDictionary<Owner, TagsEnumClass>::Table<Fields...>::readers[];
+
+/**
+ * Base class of a response handler using a TlvStaticDictionary. The response handler is its own
+ * TlvDictionaryInterface, which reads values through the table declared by the Owner class as
+ * TlvTable.
+ *
+ * @tparam Owner the response handler type (CRTP), which declares the TlvTable type
+ */
+template <typename Owner>
+class TlvStaticResponseHandler : public TlvResponseHandlerInterface,
+                                 private TlvDictionaryInterface
+{
+public:
+    const TlvDictionaryInterface &getTlvDictionary() const noexcept override { return *this; }
+
+private:
+    /** Values are read using readValue(), no wrapper is available */
+    TlvWrapperInterface *getTlvWrapperForTag(unsigned int) const noexcept override
+    {
+        return nullptr;
+    }
+
+    /* As for TlvDictionary, the dictionary is constant but the shadow runtime variables are
+     * not. */
+    bool readValue(unsigned int tag, const util::BufferView &binarySource) const override
+    {
+        return Owner::TlvTable::readValue(getOwner(), tag, binarySource);
+    }
+
+    void invalidateAll() const noexcept override { Owner::TlvTable::invalidateAll(getOwner()); }
+
+    Owner &getOwner() const { return const_cast<Owner &>(static_cast<const Owner &>(*this)); }
+};
+}
+}
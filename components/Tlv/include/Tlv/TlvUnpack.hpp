@@ -56,11 +56,14 @@ public:
      * of the TlvResponseHandlerInterface is reset: each of its TLV wrapper valid flag is cleared
      * unless exception is raised.
      *
+     * TLV values are not copied: wrappers read them from the TLV list buffer, which must outlive
+     * the TlvUnpack.
+     *
      * @param[in] responseHandler The TlvResponseHandlerInterface which describe the handled TLV
      * @param[in] buffer The TLV list buffer
      * @throw TlvUnpack::Exception
      */
-    TlvUnpack(const TlvResponseHandlerInterface &responseHandler, const util::Buffer &buffer);
+    TlvUnpack(const TlvResponseHandlerInterface &responseHandler, const util::BufferView &buffer);
 
     /**
      * Read the next value in the TLV buffer. This method should be called until it returns false.
@@ -74,7 +77,7 @@ public:
 
 private:
     const TlvResponseHandlerInterface &mResponseHandler;
-    util::MemoryByteStreamReader mBufferReader;
+    util::BufferViewByteStreamReader mBufferReader;
 };
 }
 }
@@ -54,23 +54,33 @@ public:
      */
     TlvVectorWrapper(std::vector<ValueType> &values) : mValues(values) { invalidate(); }
 
-    void readFrom(const util::Buffer &binarySource) override
+    void readFrom(const util::BufferView &binarySource) override
     {
-        mValues.clear();
+        readValues(mValues, binarySource);
+    }
+
+    virtual void invalidate() noexcept override { mValues.clear(); }
+
+    /**
+     * Statically typed implementation of readFrom(), which does not need a TlvVectorWrapper
+     * instance.
+     * @see TlvStaticDictionary
+     */
+    static void readValues(std::vector<ValueType> &values, const util::BufferView &binarySource)
+    {
+        values.clear();
         try {
-            util::MemoryByteStreamReader reader(binarySource);
+            util::BufferViewByteStreamReader reader(binarySource);
             while (!reader.isEOS()) {
                 ValueType value;
                 reader.read(value);
-                mValues.push_back(value);
+                values.push_back(value);
             }
         } catch (util::ByteStreamReader::Exception &e) {
             throw Exception("Can not read array element: " + std::string(e.what()));
         }
     }
 
-    virtual void invalidate() noexcept override { mValues.clear(); }
-
 private:
     std::vector<ValueType> &mValues;
 };
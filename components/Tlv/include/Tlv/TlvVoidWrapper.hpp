@@ -47,7 +47,7 @@ class TlvVoidWrapper final : public TlvWrapperInterface
 public:
     TlvVoidWrapper() {}
 
-    void readFrom(const util::Buffer &) override {}
+    void readFrom(const util::BufferView &) override {}
 
     virtual void invalidate() noexcept override {}
 };
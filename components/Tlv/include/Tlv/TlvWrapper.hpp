@@ -53,23 +53,32 @@ public:
      */
     TlvWrapper(ValueType &value, bool &valid) : mValue(value), mValid(valid) { invalidate(); }
 
-    void readFrom(const util::Buffer &binarySource) override
+    void readFrom(const util::BufferView &binarySource) override
+    {
+        readValue(mValue, mValid, binarySource);
+    }
+
+    virtual void invalidate() noexcept override { mValid = false; }
+
+    /**
+     * Statically typed implementation of readFrom(), which does not need a TlvWrapper instance.
+     * @see TlvStaticDictionary
+     */
+    static void readValue(ValueType &value, bool &valid, const util::BufferView &binarySource)
     {
         try {
-            util::MemoryByteStreamReader reader(binarySource);
-            reader.read(mValue);
+            util::BufferViewByteStreamReader reader(binarySource);
+            reader.read(value);
 
             if (!reader.isEOS()) {
                 throw Exception("The value buffer has not been fully consumed");
             }
-            mValid = true;
+            valid = true;
         } catch (util::ByteStreamReader::Exception &e) {
             throw Exception("Can not read tlv value: " + std::string(e.what()));
         }
     }
 
-    virtual void invalidate() noexcept override { mValid = false; }
-
 private:
     ValueType &mValue;
     bool &mValid;
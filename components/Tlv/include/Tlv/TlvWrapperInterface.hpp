@@ -28,7 +28,7 @@
  * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #pragma once
-#include "Util/Buffer.hpp"
+#include "Util/BufferView.hpp"
 #include <cstddef>
 #include <stdexcept>
 
@@ -60,10 +60,11 @@ public:
     /**
      * Read the value from the binary source provided and reflect it to the shadow runtime variable.
      * The caller must ensure there are enough chars from binarySource to read the complete value.
-     * @param[in] binarySource the memory buffer from which the value will be read
+     * @param[in] binarySource the memory from which the value will be read, which is not copied.
+     *                         A util::Buffer can be given as well.
      * @throw TlvWrapperInterface::Exception
      */
-    virtual void readFrom(const util::Buffer &binarySource) = 0;
+    virtual void readFrom(const util::BufferView &binarySource) = 0;
 
     /**
      * Invalidate the shadow variable.
@@ -35,7 +35,8 @@ namespace debug_agent
 namespace tlv
 {
 
-TlvUnpack::TlvUnpack(const TlvResponseHandlerInterface &responseHandler, const util::Buffer &buffer)
+TlvUnpack::TlvUnpack(const TlvResponseHandlerInterface &responseHandler,
+                     const util::BufferView &buffer)
     : mResponseHandler(responseHandler), mBufferReader(buffer)
 {
     mResponseHandler.getTlvDictionary().invalidateAll();
@@ -47,7 +48,7 @@ bool TlvUnpack::readNext()
         return false;
     }
 
-    util::Buffer valueBuffer;
+    util::BufferView valueView;
     uint32_t tagFromBuffer;
 
     try {
@@ -55,39 +56,26 @@ bool TlvUnpack::readNext()
         mBufferReader.read(tagFromBuffer);
         mBufferReader.read(lengthFromBuffer);
 
-        /* It is dangerous to resize the buffer to "lengthFromBuffer", because this size is
-         * provided by an external component, and if this size is huge this will lead to memory
-         * allocation failure.
-         *
-         * To avoid this allocation, reading one byte at time, in this way end of stream
-         * will be reached before memory saturation.
-         */
-        for (std::size_t i = 0; i < lengthFromBuffer; i++) {
-            uint8_t byte;
-            mBufferReader.read(byte);
-            valueBuffer.push_back(byte);
-        }
+        /* The length is provided by an external component: it is checked against the remaining
+         * buffer size, then the value is read in place. */
+        valueView = mBufferReader.readView(lengthFromBuffer);
     } catch (util::ByteStreamReader::Exception &e) {
         throw Exception("Unable to read tlv: " + std::string(e.what()));
     }
 
-    // Is Tag in the dictionary ?
-    TlvWrapperInterface *tlvWrapper =
-        mResponseHandler.getTlvDictionary().getTlvWrapperForTag(tagFromBuffer);
-    if (tlvWrapper == nullptr) {
-
-        // Tag is unknown
-        throw Exception("Cannot parse unknown tag " + std::to_string(tagFromBuffer));
-    }
-
-    // Read value
+    // Read value, if the tag is in the dictionary
+    bool isTagKnown;
     try {
-        tlvWrapper->readFrom(valueBuffer);
+        isTagKnown = mResponseHandler.getTlvDictionary().readValue(tagFromBuffer, valueView);
     } catch (TlvWrapperInterface::Exception &e) {
         throw Exception("Error reading value for tag " + std::to_string(tagFromBuffer) + ": " +
                         std::string(e.what()));
     }
 
+    if (!isTagKnown) {
+        throw Exception("Cannot parse unknown tag " + std::to_string(tagFromBuffer));
+    }
+
     return true;
 }
 }
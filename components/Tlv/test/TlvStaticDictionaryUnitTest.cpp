@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2016, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "Tlv/TlvStaticDictionary.hpp"
+#include "Tlv/TlvUnpack.hpp"
+#include "TlvTestLanguage.hpp"
+#include "TestCommon/TestHelpers.hpp"
+#include "catch.hpp"
+
+/** Same language as TlvTestLanguage, using a compile-time dictionary */
+class TlvStaticTestLanguage final : public TlvStaticResponseHandler<TlvStaticTestLanguage>
+{
+public:
+    HelloValueType hello;
+    bool isHelloValid;
+
+    std::vector<TheValueType> the;
+
+    WorldValueType world;
+    bool isWorldValid;
+
+    using Tags = TlvTestLanguage::Tags;
+
+    TlvStaticTestLanguage() { getTlvDictionary().invalidateAll(); }
+
+private:
+    friend class TlvStaticResponseHandler<TlvStaticTestLanguage>;
+
+    using Dictionary = TlvStaticDictionary<TlvStaticTestLanguage, Tags>;
+    using TlvTable = Dictionary::Table<
+        Dictionary::VectorField<Tags::The, TheValueType, &TlvStaticTestLanguage::the>,
+        Dictionary::Field<Tags::Hello, HelloValueType, &TlvStaticTestLanguage::hello,
+                          &TlvStaticTestLanguage::isHelloValid>,
+        Dictionary::Field<Tags::World, WorldValueType, &TlvStaticTestLanguage::world,
+                          &TlvStaticTestLanguage::isWorldValid>,
+        Dictionary::VoidField<Tags::BadTag>>;
+};
+
+/** A language whose tags are 0, 1, 2 */
+class DenseTestLanguage final : public TlvStaticResponseHandler<DenseTestLanguage>
+{
+public:
+    uint32_t first;
+    bool isFirstValid;
+
+    std::vector<uint16_t> second;
+
+    uint8_t third;
+    bool isThirdValid;
+
+    enum class Tags
+    {
+        First,
+        Second,
+        Third
+    };
+
+    DenseTestLanguage() { getTlvDictionary().invalidateAll(); }
+
+private:
+    friend class TlvStaticResponseHandler<DenseTestLanguage>;
+
+    using Dictionary = TlvStaticDictionary<DenseTestLanguage, Tags>;
+    using TlvTable = Dictionary::Table<
+        Dictionary::Field<Tags::First, uint32_t, &DenseTestLanguage::first,
+                          &DenseTestLanguage::isFirstValid>,
+        Dictionary::VectorField<Tags::Second, uint16_t, &DenseTestLanguage::second>,
+        Dictionary::Field<Tags::Third, uint8_t, &DenseTestLanguage::third,
+                          &DenseTestLanguage::isThirdValid>>;
+};
+
+TEST_CASE("TlvStaticDictionary", "[Dictionary]")
+{
+    TlvStaticTestLanguage testTlvLanguage;
+
+    const TlvDictionaryInterface &dictionary = testTlvLanguage.getTlvDictionary();
+
+    SECTION ("Check all value are invalidated by default") {
+
+        CHECK(testTlvLanguage.isHelloValid == false);
+        CHECK(testTlvLanguage.the.size() == 0);
+        CHECK(testTlvLanguage.isWorldValid == false);
+    }
+
+    SECTION ("Check values are read using their tag") {
+
+        Buffer helloBuffer{0xAD, 0xDE, 0x00, 0x00, 0xEF, 0xBE, 0x00, 0x00};
+        Buffer theBuffer{42, 0, 0, 0, 43, 0, 0, 0};
+        HelloValueType helloValue{0xDEAD, 0xBEEF};
+        std::vector<TheValueType> theValue{{42}, {43}};
+
+        CHECK(dictionary.readValue(static_cast<unsigned int>(TlvTestLanguage::Tags::Hello),
+                                   helloBuffer));
+        CHECK(dictionary.readValue(static_cast<unsigned int>(TlvTestLanguage::Tags::The),
+                                   theBuffer));
+        CHECK(dictionary.readValue(static_cast<unsigned int>(TlvTestLanguage::Tags::BadTag),
+                                   theBuffer));
+
+        CHECK(testTlvLanguage.isHelloValid == true);
+        CHECK(testTlvLanguage.hello == helloValue);
+        CHECK(testTlvLanguage.the == theValue);
+        CHECK(testTlvLanguage.isWorldValid == false);
+
+        // Check that unknown tag is not read
+        CHECK_FALSE(dictionary.readValue(TlvTestLanguage::aTagIdWhichIsNotInTheLanguageTagsList,
+                                         helloBuffer));
+
+        // Check that a bad value is reported
+        CHECK_THROWS_AS(
+            dictionary.readValue(static_cast<unsigned int>(TlvTestLanguage::Tags::World),
+                                 helloBuffer),
+            TlvWrapperInterface::Exception);
+        CHECK(testTlvLanguage.isWorldValid == false);
+
+        dictionary.invalidateAll();
+        CHECK(testTlvLanguage.isHelloValid == false);
+        CHECK(testTlvLanguage.the.size() == 0);
+        CHECK(testTlvLanguage.isWorldValid == false);
+    }
+
+    SECTION ("Check a copied language is read") {
+
+        Buffer buffer{
+            54,   0x00, 0x00, 0x00,                        // HelloValueType tag
+            8,    0x00, 0x00, 0x00,                        // HelloValueType size
+            0xAD, 0xDE, 0x00, 0x00, 0xEF, 0xBE, 0x00, 0x00 // HelloValueType value
+        };
+        HelloValueType helloValue{0xDEAD, 0xBEEF};
+
+        TlvStaticTestLanguage copy(testTlvLanguage);
+        TlvUnpack unpacker(copy, buffer);
+        CHECK(unpacker.readNext() == true);
+        CHECK(unpacker.readNext() == false);
+
+        CHECK(copy.isHelloValid == true);
+        CHECK(copy.hello == helloValue);
+        CHECK(testTlvLanguage.isHelloValid == false);
+    }
+}
+
+TEST_CASE("TlvStaticDictionary with dense tags", "[Dictionary]")
+{
+    DenseTestLanguage language;
+
+    Buffer buffer{
+        2, 0, 0, 0, // Third tag
+        1, 0, 0, 0, // Third size
+        7,          // Third value
+        1, 0, 0, 0, // Second tag
+        4, 0, 0, 0, // Second size
+        1, 0, 2, 0, // Second value
+        3, 0, 0, 0, // Unknown tag
+        0, 0, 0, 0, // Unknown size
+    };
+
+    TlvUnpack unpacker(language, buffer);
+    CHECK(unpacker.readNext() == true);
+    CHECK(unpacker.readNext() == true);
+    CHECK_THROWS_AS_MSG(unpacker.readNext(), TlvUnpack::Exception, "Cannot parse unknown tag 3");
+    CHECK(unpacker.readNext() == false);
+
+    CHECK(language.isFirstValid == false);
+    CHECK(language.second == std::vector<uint16_t>({1, 2}));
+    CHECK(language.isThirdValid == true);
+    CHECK(language.third == 7);
+}
@@ -380,4 +380,20 @@ TEST_CASE("TlvUnpack", "[ReadBuffer]")
         CHECK(testTlvLanguage.the.size() == 0);
         CHECK(testTlvLanguage.isWorldValid == false);
     }
-}
\ No newline at end of file
+    SECTION ("Read from buffer with huge length") {
+        Buffer buffer{
+            54,   0x00, 0x00, 0x00,                         // HelloValueType tag
+            0xFF, 0xFF, 0xFF, 0xFF,                         // HelloValueType wrong size
+            0xAD, 0xDE, 0x00, 0x00, 0xEF, 0xBE, 0x00, 0x00, // HelloValueType value
+        };
+
+        // The length is checked against the buffer size, without allocating
+        TlvUnpack unpacker(testTlvLanguage, buffer);
+
+        CHECK_THROWS_AS_MSG(unpacker.readNext(), TlvUnpack::Exception,
+                            "Unable to read tlv: Read failed: end of stream reached");
+        CHECK(unpacker.readNext() == false);
+
+        CHECK(testTlvLanguage.isHelloValid == false);
+    }
+}
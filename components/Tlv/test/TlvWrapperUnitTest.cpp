@@ -72,4 +72,10 @@ TEST_CASE("TlvWrapper", "[WrapperRead]")
 
     tlvWrapper.invalidate();
     CHECK(testValueIsValid == false);
+
+    /* Reading from a part of a bigger buffer */
+    Buffer tlvList{0xFF, 0xFF, 210, 4, 0, 0, 56, 21, 3, 0xFF};
+    tlvWrapper.readFrom(BufferView(tlvList).subView(2, 7));
+    CHECK(testValue == valueToBeRead);
+    CHECK(testValueIsValid == true);
 }
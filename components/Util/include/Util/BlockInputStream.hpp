@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2016, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include "Util/Stream.hpp"
+#include "Util/Buffer.hpp"
+
+namespace debug_agent
+{
+namespace util
+{
+/** Block input stream class is a stream whose content is produced as a sequence of blocks (for
+ * instance compress device fragments). In addition to the byte-oriented read() method, it allows
+ * the client to retrieve whole blocks and to process them in place.
+ */
+class BlockInputStream : public InputStream
+{
+public:
+    /**
+     * This method blocks until a block is available.
+     *
+     * The supplied buffer is swapped with the internal block buffer, so no copy is performed and
+     * the supplied buffer memory is reused by the stream for the next block. If a block has been
+     * partially consumed by read(), only its remaining bytes are returned.
+     *
+     * @param[out] block the buffer that receives the block content
+     * @return false if end of stream is reached.
+     * @throw InputStream::Exception
+     */
+    virtual bool readBlock(Buffer &block) = 0;
+};
+}
+}
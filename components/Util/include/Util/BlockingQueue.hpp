@@ -30,6 +30,8 @@
 #pragma once
 
 #include <vector>
+#include <chrono>
+#include <limits>
 #include <functional>
 #include <mutex>
 #include <condition_variable>
@@ -38,12 +40,45 @@
 #include <string>
 #include <cassert>
 #include <memory>
+#include <atomic>
 
 namespace debug_agent
 {
 namespace util
 {
 
+/** Defines what happens when an element is added to a full BlockingQueue */
+enum class QueueOverflowPolicy
+{
+    /** The added element is dropped */
+    RejectNewest,
+    /** The oldest elements are dropped to make room for the added one (flight recorder) */
+    DropOldest,
+    /** The producer is blocked until there is room, in the limit of a timeout after which the
+     * added element is dropped */
+    BlockProducer
+};
+
+/** Overflow statistics of a BlockingQueue */
+struct QueueStatistics
+{
+    /** The maximum memory size allocated to the queue */
+    std::size_t maxByteSize;
+    /** The count of elements dropped due to queue overflow */
+    std::size_t droppedElementCount;
+    /** The memory size of elements dropped due to queue overflow */
+    std::size_t droppedByteCount;
+    /** The highest memory size reached by the queue */
+    std::size_t highWaterMark;
+};
+
+/** Recycling policy of a BlockingQueue that frees the dropped and cleared elements */
+template <typename T>
+struct FreeElement
+{
+    void operator()(std::unique_ptr<T>) const {}
+};
+
 /**
  * This class provides a blocking queue that stores elements using std::unique_ptr.
  *
@@ -52,38 +87,59 @@ namespace util
  * - an element is added
  * - the close() method is called
  *
- * A maximum memory size is specified, adding an element can fail if the maximum size
- * is reached.
+ * The removeAll() and removeUpTo() methods behave the same way but retrieve several elements
+ * under a single lock acquisition. The removeFor() method stops waiting after a timeout.
+ *
+ * A maximum memory size is specified. When it is reached, the overflow policy tells if the
+ * added element or the oldest elements are dropped, or if the producer waits for some room.
+ * Dropped elements are accounted in the queue statistics, which can be read without locking.
+ *
+ * The dropped and cleared elements are handed to the recycling policy, which may for instance
+ * give them back to a pool instead of freeing them.
  *
  * This class supports multiple producer threads and multiple consumer threads.
  *
  * @tparam T the type handled by the std::unique_ptr
+ * @tparam Recycler the recycling policy, a copyable function object taking a std::unique_ptr<T>
  */
-template <typename T>
+template <typename T, typename Recycler = FreeElement<T>>
 class BlockingQueue final
 {
 
 public:
+    using Elements = std::vector<std::unique_ptr<T>>;
+
     /*
      * @param[in] maxByteSize The maximum memory size allocated to this queue
      * @param[in] elementSizeFunction A function that provides the memory size of one queue
      *                                element.
+     * @param[in] overflowPolicy What happens when an element is added to the full queue
+     * @param[in] blockTimeout The maximum time a producer waits for room, used by the
+     *                         QueueOverflowPolicy::BlockProducer policy only.
      */
     BlockingQueue(std::size_t maxByteSize,
-                  std::function<std::size_t(const T &)> elementSizeFunction)
-        : mMaxByteSize(maxByteSize), mElementSizeFunction(elementSizeFunction), mCurrentSize(0),
+                  std::function<std::size_t(const T &)> elementSizeFunction,
+                  QueueOverflowPolicy overflowPolicy = QueueOverflowPolicy::RejectNewest,
+                  std::chrono::milliseconds blockTimeout = std::chrono::milliseconds(0))
+        : mMaxByteSize(maxByteSize), mElementSizeFunction(elementSizeFunction),
+          mOverflowPolicy(overflowPolicy), mBlockTimeout(blockTimeout), mCurrentSize(0),
           mOpen(false)
     {
     }
     BlockingQueue(BlockingQueue &&other)
         : mMaxByteSize(other.mMaxByteSize),
-          mElementSizeFunction(std::move(other.mElementSizeFunction))
+          mElementSizeFunction(std::move(other.mElementSizeFunction)),
+          mOverflowPolicy(other.mOverflowPolicy), mBlockTimeout(other.mBlockTimeout)
     {
         std::lock_guard<std::mutex> locker(other.mMembersMutex);
 
         mQueue = std::move(other.mQueue);
         mCurrentSize = other.mCurrentSize;
         mOpen = other.mOpen;
+        mRecycler = other.mRecycler;
+        mDroppedElementCount = other.mDroppedElementCount.load();
+        mDroppedByteCount = other.mDroppedByteCount.load();
+        mHighWaterMark = other.mHighWaterMark.load();
 
         other.clearLocked();
     }
@@ -91,6 +147,12 @@ public:
     BlockingQueue &operator=(const BlockingQueue &) = delete;
     ~BlockingQueue() { close(); }
 
+    /** Set the recycling policy instance that receives the dropped and cleared elements
+     *
+     * Must be called before using the queue.
+     */
+    void setRecycler(const Recycler &recycler) { mRecycler = recycler; }
+
     /** Open the queue (items can be enqueued) */
     void open()
     {
@@ -113,20 +175,33 @@ public:
         if (mOpen) {
             mOpen = false;
             mCondVar.notify_all();
+            mRoomCondVar.notify_all();
         }
     }
 
     /**
      * Add an element.
-     * @return true if the element has been successfully added.
+     *
+     * Note: with the QueueOverflowPolicy::BlockProducer policy, this method blocks while the
+     *       queue is full, in the limit of the block timeout.
+     *
+     * @return true if the element has been successfully added, false if it has been dropped
+     *         or if the queue is closed.
      */
     bool add(std::unique_ptr<T> elementPtr)
     {
         assert(elementPtr != nullptr);
 
-        std::lock_guard<std::mutex> locker(mMembersMutex);
+        std::unique_lock<std::mutex> locker(mMembersMutex);
 
         if (!mOpen) {
+            recycle(std::move(elementPtr));
+            return false;
+        }
+
+        std::size_t elementSize = mElementSizeFunction(*elementPtr);
+        if (elementSize + mCurrentSize > mMaxByteSize && !makeRoomLocked(locker, elementSize)) {
+            recycle(std::move(elementPtr));
             return false;
         }
 
@@ -178,6 +253,65 @@ public:
         return removeLocked();
     }
 
+    /**
+     * @return an element, or nullptr if the queue is closed or if the timeout has expired.
+     *
+     * Note: This method blocks until an element is returned, the queue is closed or the timeout
+     *       has expired. Use isOpen() to tell a timeout from a closing.
+     */
+    template <class Rep, class Period>
+    std::unique_ptr<T> removeFor(const std::chrono::duration<Rep, Period> &timeout)
+    {
+        std::unique_lock<std::mutex> locker(mMembersMutex);
+
+        if (!mCondVar.wait_for(locker, timeout, [this] { return !mQueue.empty() || !mOpen; }) ||
+            mQueue.empty()) {
+            /* Timeout, or queue closed and all elements consumed */
+            return nullptr;
+        }
+        return removeLocked();
+    }
+
+    /**
+     * @return the first elements whose cumulated memory size does not exceed maxByteSize, in
+     *         the limit of maxCount elements. At least one element is returned, even if its
+     *         size exceeds maxByteSize, unless the queue is closed: in this case an empty
+     *         collection is returned.
+     *
+     * Note: This method blocks until at least one element is available or if the queue is
+     *       closed.
+     */
+    Elements removeUpTo(std::size_t maxByteSize, std::size_t maxCount)
+    {
+        std::unique_lock<std::mutex> locker(mMembersMutex);
+
+        mCondVar.wait(locker, [this] { return !mQueue.empty() || !mOpen; });
+
+        Elements elements;
+        std::size_t byteSize = 0;
+        while (!mQueue.empty() && elements.size() < maxCount) {
+            std::size_t elementSize = mElementSizeFunction(*mQueue.front());
+            if (!elements.empty() && byteSize + elementSize > maxByteSize) {
+                break;
+            }
+            byteSize += elementSize;
+            elements.push_back(removeLocked());
+        }
+        return elements;
+    }
+
+    /**
+     * @return all the queued elements, or an empty collection if the queue is closed.
+     *
+     * Note: This method blocks until at least one element is available or if the queue is
+     *       closed.
+     */
+    Elements removeAll()
+    {
+        return removeUpTo(std::numeric_limits<std::size_t>::max(),
+                          std::numeric_limits<std::size_t>::max());
+    }
+
     /** Clear the queue.
      *
      * All elements are deleted from memory.
@@ -194,6 +328,12 @@ public:
         return mQueue.size();
     }
 
+    /** @return the overflow statistics, without locking the queue */
+    QueueStatistics getStatistics() const
+    {
+        return {mMaxByteSize, mDroppedElementCount, mDroppedByteCount, mHighWaterMark};
+    }
+
     std::size_t getMemorySize() const
     {
         std::unique_lock<std::mutex> locker(mMembersMutex);
@@ -210,12 +350,12 @@ public:
     class AutoOpenClose
     {
     public:
-        AutoOpenClose(BlockingQueue<T> &queue) : mQueue(queue) { mQueue.open(); }
+        AutoOpenClose(BlockingQueue &queue) : mQueue(queue) { mQueue.open(); }
 
         ~AutoOpenClose() { mQueue.close(); }
 
     private:
-        BlockingQueue<T> &mQueue;
+        BlockingQueue &mQueue;
     };
 
 private:
@@ -237,6 +377,9 @@ private:
 
         mCurrentSize += mElementSizeFunction(*elementPtr);
         assert(mCurrentSize <= mMaxByteSize);
+        if (mCurrentSize > mHighWaterMark) {
+            mHighWaterMark = mCurrentSize;
+        }
 
         mQueue.push(std::move(elementPtr));
 
@@ -261,26 +404,86 @@ private:
 
         mQueue.pop();
 
+        if (mOverflowPolicy == QueueOverflowPolicy::BlockProducer) {
+            mRoomCondVar.notify_one();
+        }
         return ptr;
     }
 
+    /** Make room for an element according to the overflow policy, accounting dropped elements
+     *
+     * Must be called in a locked context, when the element does not fit in the queue.
+     *
+     * @return true if the element can now be added
+     */
+    bool makeRoomLocked(std::unique_lock<std::mutex> &locker, std::size_t elementSize)
+    {
+        if (elementSize <= mMaxByteSize) {
+            switch (mOverflowPolicy) {
+            case QueueOverflowPolicy::RejectNewest:
+                break;
+            case QueueOverflowPolicy::DropOldest:
+                while (elementSize + mCurrentSize > mMaxByteSize) {
+                    std::unique_ptr<T> oldest = removeLocked();
+                    accountDroppedLocked(mElementSizeFunction(*oldest));
+                    recycle(std::move(oldest));
+                }
+                return true;
+            case QueueOverflowPolicy::BlockProducer:
+                if (mRoomCondVar.wait_for(locker, mBlockTimeout, [&] {
+                        return !mOpen || elementSize + mCurrentSize <= mMaxByteSize;
+                    })) {
+                    /* A queue closed meanwhile is not an overflow */
+                    return mOpen;
+                }
+                break;
+            }
+        }
+        accountDroppedLocked(elementSize);
+        return false;
+    }
+
+    void recycle(std::unique_ptr<T> elementPtr) { mRecycler(std::move(elementPtr)); }
+
+    /** Must be called in a locked context */
+    void accountDroppedLocked(std::size_t elementSize)
+    {
+        ++mDroppedElementCount;
+        mDroppedByteCount += elementSize;
+    }
+
     /** Must be called in a locked context */
     void clearLocked()
     {
         QueueType empty;
         std::swap(mQueue, empty);
+        while (!empty.empty()) {
+            recycle(std::move(empty.front()));
+            empty.pop();
+        }
         mCurrentSize = 0;
+        mRoomCondVar.notify_all();
     }
 
     const std::size_t mMaxByteSize;
     const std::function<std::size_t(const T &)> mElementSizeFunction;
+    const QueueOverflowPolicy mOverflowPolicy;
+    const std::chrono::milliseconds mBlockTimeout;
 
     mutable std::mutex mMembersMutex;
     std::condition_variable mCondVar;
+    /** Producers blocked by the QueueOverflowPolicy::BlockProducer policy wait on it */
+    std::condition_variable mRoomCondVar;
 
     QueueType mQueue;
     std::size_t mCurrentSize;
     bool mOpen;
+    Recycler mRecycler;
+
+    /* Statistics are only modified in a locked context but can be read without locking */
+    std::atomic<std::size_t> mDroppedElementCount{0};
+    std::atomic<std::size_t> mDroppedByteCount{0};
+    std::atomic<std::size_t> mHighWaterMark{0};
 };
 }
 }
@@ -0,0 +1,389 @@
+/*
+ * Copyright (c) 2016, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include "Util/Buffer.hpp"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace debug_agent
+{
+namespace util
+{
+
+/** Allocation statistics of a BufferPool */
+struct BufferPoolStatistics
+{
+    /** The count of elements allocated on the heap because the pool had none to provide */
+    std::size_t allocationCount;
+    /** The count of elements provided by the pool without allocation */
+    std::size_t reuseCount;
+    /** The count of released elements that have been freed, because the pool was full or because
+     * their capacity does not match any size class */
+    std::size_t discardCount;
+};
+
+/** Thread-safe pool of buffer-like elements, sorted by capacity into power-of-two size classes
+ *
+ * Acquiring an element of a given size returns a released element of the matching size class
+ * if any, otherwise a new element of the class capacity. Producers and consumers of streamed
+ * data usually are different threads: to avoid taking the pool lock for each element, each
+ * thread has its own cache per size class (a "magazine"). Released elements are moved to the
+ * shared depot, and acquired from it, by whole magazines.
+ *
+ * Elements whose capacity is larger than the biggest size class are not pooled. The memory
+ * kept by the depot is bounded, the memory kept by the thread caches is bounded by
+ * 2 * magazineByteSize per size class and per thread.
+ *
+ * The thread caches of a destroyed pool are freed at thread exit, or as soon as the thread uses
+ * another pool of the same element type.
+ *
+ * @tparam T the element type, for instance util::Buffer
+ */
+template <typename T>
+class BufferPool
+{
+public:
+    using ElementPtr = std::unique_ptr<T>;
+
+    /** Gives the deleted element back to the pool */
+    class Releaser
+    {
+    public:
+        explicit Releaser(BufferPool &pool) : mPool(&pool) {}
+
+        void operator()(T *element) const { mPool->release(ElementPtr(element)); }
+
+    private:
+        BufferPool *mPool;
+    };
+
+    /** An element that goes back to its pool when destroyed, including by stack unwinding */
+    using PooledElementPtr = std::unique_ptr<T, Releaser>;
+
+    /** Provides the capacity of an element, i.e. the size it can hold without allocation */
+    using CapacityFunction = std::function<std::size_t(const T &)>;
+
+    /** Allocates an element able to hold the given capacity */
+    using AllocateFunction = std::function<ElementPtr(std::size_t)>;
+
+    /** Capacity of the smallest size class */
+    static const std::size_t minClassCapacity = 64;
+
+    /** Size classes from 64 bytes to 1 MiB */
+    static const std::size_t classCount = 15;
+
+    /** Byte size of the elements transferred at once between a thread cache and the depot */
+    static const std::size_t magazineByteSize = 64 * 1024;
+
+    /**
+     * @param[in] maxCachedByteSize The maximum cumulated capacity of the elements kept by the
+     *                              depot.
+     * @param[in] capacityFunction A function that provides the capacity of one element.
+     * @param[in] allocateFunction A function that allocates one element.
+     */
+    BufferPool(std::size_t maxCachedByteSize, CapacityFunction capacityFunction,
+               AllocateFunction allocateFunction)
+        : mMaxCachedByteSize(maxCachedByteSize), mCapacityFunction(capacityFunction),
+          mAllocateFunction(allocateFunction), mAliveToken(std::make_shared<char>())
+    {
+    }
+
+    /**
+     * Acquire an element whose capacity is at least the requested size
+     *
+     * Note: the content of a reused element is left as is, the caller is in charge of resetting
+     *       it.
+     */
+    ElementPtr acquire(std::size_t size)
+    {
+        std::size_t sizeClass;
+        if (!findAcquireClass(size, sizeClass)) {
+            ++mAllocationCount;
+            return mAllocateFunction(size);
+        }
+
+        auto &magazine = getThreadCache().magazines[sizeClass];
+        if (magazine.empty()) {
+            refill(sizeClass, magazine);
+        }
+        if (magazine.empty()) {
+            ++mAllocationCount;
+            return mAllocateFunction(getClassCapacity(sizeClass));
+        }
+
+        ElementPtr element = std::move(magazine.back());
+        magazine.pop_back();
+        ++mReuseCount;
+        return element;
+    }
+
+    /** Acquire an element that is given back to the pool when the returned pointer is destroyed
+     *
+     * The pool shall outlive the returned pointer.
+     */
+    PooledElementPtr acquirePooled(std::size_t size) { return makePooled(acquire(size)); }
+
+    /** Give an element back to the pool */
+    void release(ElementPtr element)
+    {
+        if (element == nullptr) {
+            return;
+        }
+
+        std::size_t sizeClass;
+        if (!findReleaseClass(mCapacityFunction(*element), sizeClass)) {
+            ++mDiscardCount;
+            return;
+        }
+
+        auto &magazine = getThreadCache().magazines[sizeClass];
+        magazine.push_back(std::move(element));
+        if (magazine.size() >= 2 * getMagazineCount(sizeClass)) {
+            flush(sizeClass, magazine);
+        }
+    }
+
+    /** Give several elements back to the pool */
+    void release(std::vector<ElementPtr> &elements)
+    {
+        for (auto &element : elements) {
+            release(std::move(element));
+        }
+        elements.clear();
+    }
+
+    /** @return the allocation statistics, without locking the pool */
+    BufferPoolStatistics getStatistics() const
+    {
+        return {mAllocationCount, mReuseCount, mDiscardCount};
+    }
+
+protected:
+    PooledElementPtr makePooled(ElementPtr element)
+    {
+        return PooledElementPtr(element.release(), Releaser(*this));
+    }
+
+private:
+    using Magazine = std::vector<ElementPtr>;
+
+    struct ThreadCache
+    {
+        const BufferPool *pool;
+        /** Expires when the pool is destroyed */
+        std::weak_ptr<char> aliveToken;
+        std::array<Magazine, classCount> magazines;
+    };
+
+    BufferPool(const BufferPool &) = delete;
+    BufferPool &operator=(const BufferPool &) = delete;
+
+    static std::size_t getClassCapacity(std::size_t sizeClass)
+    {
+        return minClassCapacity << sizeClass;
+    }
+
+    /** @return the count of elements of a magazine of this size class */
+    static std::size_t getMagazineCount(std::size_t sizeClass)
+    {
+        std::size_t count = magazineByteSize / getClassCapacity(sizeClass);
+        return count > 0 ? count : 1;
+    }
+
+    /** Find the smallest size class able to hold 'size' bytes */
+    static bool findAcquireClass(std::size_t size, std::size_t &sizeClass)
+    {
+        for (sizeClass = 0; sizeClass < classCount; ++sizeClass) {
+            if (size <= getClassCapacity(sizeClass)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /** Find the biggest size class whose requests an element of this capacity can serve */
+    static bool findReleaseClass(std::size_t capacity, std::size_t &sizeClass)
+    {
+        if (capacity < minClassCapacity || capacity >= 2 * getClassCapacity(classCount - 1)) {
+            return false;
+        }
+        sizeClass = 0;
+        while (sizeClass + 1 < classCount && getClassCapacity(sizeClass + 1) <= capacity) {
+            ++sizeClass;
+        }
+        return true;
+    }
+
+    /** @return the cache of the calling thread for this pool */
+    ThreadCache &getThreadCache()
+    {
+        static thread_local std::vector<std::unique_ptr<ThreadCache>> threadCaches;
+
+        ThreadCache *found = nullptr;
+        for (auto it = threadCaches.begin(); it != threadCaches.end();) {
+            if ((*it)->aliveToken.expired()) {
+                /* The pool of this cache has been destroyed */
+                it = threadCaches.erase(it);
+            } else {
+                if ((*it)->pool == this) {
+                    found = it->get();
+                }
+                ++it;
+            }
+        }
+        if (found != nullptr) {
+            return *found;
+        }
+
+        /* First use of this pool by the calling thread */
+        auto cache = std::make_unique<ThreadCache>();
+        cache->pool = this;
+        cache->aliveToken = mAliveToken;
+        for (std::size_t sizeClass = 0; sizeClass < classCount; ++sizeClass) {
+            cache->magazines[sizeClass].reserve(2 * getMagazineCount(sizeClass));
+        }
+        threadCaches.push_back(std::move(cache));
+        return *threadCaches.back();
+    }
+
+    /** Move one magazine of elements from the depot to a thread cache */
+    void refill(std::size_t sizeClass, Magazine &magazine)
+    {
+        std::lock_guard<std::mutex> locker(mDepotMutex);
+
+        auto &depot = mDepot[sizeClass];
+        std::size_t count = getMagazineCount(sizeClass);
+        while (count-- > 0 && !depot.empty()) {
+            mCachedByteSize -= mCapacityFunction(*depot.back());
+            magazine.push_back(std::move(depot.back()));
+            depot.pop_back();
+        }
+    }
+
+    /** Move one magazine of elements from a thread cache to the depot, freeing the elements that
+     * exceed the depot capacity */
+    void flush(std::size_t sizeClass, Magazine &magazine)
+    {
+        std::lock_guard<std::mutex> locker(mDepotMutex);
+
+        auto &depot = mDepot[sizeClass];
+        std::size_t count = getMagazineCount(sizeClass);
+        while (count-- > 0) {
+            std::size_t capacity = mCapacityFunction(*magazine.back());
+            if (mCachedByteSize + capacity <= mMaxCachedByteSize) {
+                mCachedByteSize += capacity;
+                depot.push_back(std::move(magazine.back()));
+            } else {
+                ++mDiscardCount;
+            }
+            magazine.pop_back();
+        }
+    }
+
+    const std::size_t mMaxCachedByteSize;
+    const CapacityFunction mCapacityFunction;
+    const AllocateFunction mAllocateFunction;
+    const std::shared_ptr<char> mAliveToken;
+
+    std::mutex mDepotMutex;
+    std::array<Magazine, classCount> mDepot;
+    std::size_t mCachedByteSize = 0;
+
+    std::atomic<std::size_t> mAllocationCount{0};
+    std::atomic<std::size_t> mReuseCount{0};
+    std::atomic<std::size_t> mDiscardCount{0};
+};
+
+/** BlockingQueue recycling policy that gives the dropped and cleared elements back to a pool */
+template <typename T>
+class PoolRecycler
+{
+public:
+    /** Without pool, the elements are freed */
+    PoolRecycler() = default;
+
+    /** The pool shall outlive the recycler and its copies */
+    explicit PoolRecycler(BufferPool<T> &pool) : mPool(&pool) {}
+
+    void operator()(std::unique_ptr<T> element) const
+    {
+        if (mPool != nullptr) {
+            mPool->release(std::move(element));
+        }
+    }
+
+private:
+    BufferPool<T> *mPool = nullptr;
+};
+
+/** Pool of byte buffers, sorted by buffer capacity */
+class ByteBufferPool final : public BufferPool<Buffer>
+{
+public:
+    /**
+     * @param[in] maxCachedByteSize The maximum cumulated capacity of the buffers kept by the
+     *                              depot.
+     */
+    ByteBufferPool(std::size_t maxCachedByteSize)
+        : BufferPool<Buffer>(maxCachedByteSize, &ByteBufferPool::getCapacity,
+                             &ByteBufferPool::allocate)
+    {
+    }
+
+    /** @return an empty buffer whose capacity is at least the requested one */
+    std::unique_ptr<Buffer> acquire(std::size_t capacity)
+    {
+        auto buffer = BufferPool<Buffer>::acquire(capacity);
+        buffer->clear();
+        return buffer;
+    }
+
+    /** @return an empty buffer, given back to the pool when the returned pointer is destroyed */
+    PooledElementPtr acquirePooled(std::size_t capacity) { return makePooled(acquire(capacity)); }
+
+private:
+    static std::size_t getCapacity(const Buffer &buffer) { return buffer.capacity(); }
+
+    static std::unique_ptr<Buffer> allocate(std::size_t capacity)
+    {
+        auto buffer = std::make_unique<Buffer>();
+        buffer->reserve(capacity);
+        return buffer;
+    }
+};
+}
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2016, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include "Util/Buffer.hpp"
+#include "Util/AssertAlways.hpp"
+#include <cstddef>
+#include <inttypes.h>
+
+namespace debug_agent
+{
+namespace util
+{
+
+/** Non-owning read only view of contiguous bytes, for instance a part of a Buffer.
+ *
+ * The viewed memory must outlive the view.
+ */
+class BufferView
+{
+public:
+    BufferView() = default;
+
+    BufferView(const uint8_t *data, std::size_t size) : mData(data), mSize(size) {}
+
+    /** Implicit conversion: a whole buffer can be used where a view is expected */
+    BufferView(const Buffer &buffer) : mData(buffer.data()), mSize(buffer.size()) {}
+
+    const uint8_t *data() const { return mData; }
+    std::size_t size() const { return mSize; }
+    bool empty() const { return mSize == 0; }
+
+    const uint8_t *begin() const { return mData; }
+    const uint8_t *end() const { return mData + mSize; }
+
+    /** @return the view of 'size' bytes starting at 'offset', which must be in this view */
+    BufferView subView(std::size_t offset, std::size_t size) const
+    {
+        ASSERT_ALWAYS(offset <= mSize && size <= mSize - offset);
+        return {mData + offset, size};
+    }
+
+private:
+    const uint8_t *mData = nullptr;
+    std::size_t mSize = 0;
+};
+}
+}
@@ -50,9 +50,70 @@ struct IsSimpleSerializableType
     static const bool value = std::is_integral<T>::value || std::is_pointer<T>::value;
 };
 
+/** The "value" member of this structure is true if the supplied compound type is serialized as its
+ * memory representation.
+ *
+ * A compound type declares it using a "static const bool hasSerializableMemoryLayout = true"
+ * member. It shall be trivially copyable, and its fromStream()/toStream() methods shall read and
+ * write its memory representation, as for instance an union read through its uint32_t member.
+ */
+template <typename T, typename = void>
+struct HasSerializableMemoryLayout : std::false_type
+{
+};
+
+template <typename T>
+struct HasSerializableMemoryLayout<T, std::enable_if_t<T::hasSerializableMemoryLayout>>
+    : std::true_type
+{
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "A type serialized as its memory representation shall be trivially copyable");
+};
+
 /** Enums are encoded on 32 bits */
 using EnumEncodingType = uint32_t;
 
+/** The "value" member of this structure is true if the supplied type is an enum whose memory
+ * representation is its encoding, i.e. whose underlying type is 32 bits wide */
+template <typename T, bool = std::is_enum<T>::value>
+struct IsBulkSerializableEnum : std::false_type
+{
+};
+
+template <typename T>
+struct IsBulkSerializableEnum<T, true>
+    : std::integral_constant<bool, sizeof(std::underlying_type_t<T>) == sizeof(EnumEncodingType)>
+{
+};
+
+/** The "value" member of this structure is true if the supplied type is serialized as its memory
+ * representation, so that several values of this type can be serialized using one memory copy.
+ *
+ * It is the case of "simple serializable" types (except bool whose std::vector specialization
+ * does not provide a contiguous storage), of enums with a 32 bits underlying type, of compound
+ * types having a serializable memory layout and of fixed arrays of such types. The other enums
+ * are not, since they are encoded on 32 bits whatever their size is.
+ */
+template <typename T>
+struct IsBulkSerializableType
+{
+    static const bool value =
+        (IsSimpleSerializableType<T>::value && !std::is_same<T, bool>::value) ||
+        IsBulkSerializableEnum<T>::value || HasSerializableMemoryLayout<T>::value;
+};
+
+template <typename T, std::size_t N>
+struct IsBulkSerializableType<T[N]> : IsBulkSerializableType<T>
+{
+};
+
+template <typename T, std::size_t N>
+struct IsBulkSerializableType<std::array<T, N>>
+{
+    static const bool value =
+        IsBulkSerializableType<T>::value && sizeof(std::array<T, N>) == N * sizeof(T);
+};
+
 /** The "value" member of this structure is true if the supplied type is an enum and should be
  * serialized using the type "EnumEncodingType"
  */
@@ -39,6 +39,7 @@
 #include <cassert>
 #include <inttypes.h>
 #include <type_traits>
+#include <string>
 
 namespace debug_agent
 {
@@ -136,15 +137,76 @@ public:
         /* Reading the size */
         read(size);
 
+        readVectorElements(vector, size);
+    }
+
+    /** Read contiguous "bulk serializable" values using one memory copy.
+     *
+     * @param[out] dest the memory representation of the values
+     * @param[in] byteCount the size of the values
+     * @throw ByteStreamReader::Exception if the end of stream is reached
+     */
+    void readMemoryLayout(void *dest, std::size_t byteCount)
+    {
+        readUsingMemoryCopy(static_cast<StreamByte *>(dest), byteCount);
+    }
+
+private:
+    /** When the stream size is unknown, bulk serializable vector elements are read by chunks of
+     * this size */
+    static const std::size_t maxChunkByteSize = 64 * 1024;
+
+    /** Read "bulk serializable type" vector elements using memory copies
+     *
+     * The size read from the stream is checked against the stream size if it is known, so that an
+     * erroneous size cannot make the allocation fail. Otherwise the elements are read by chunks:
+     * the end of stream will be reached before saturating the memory.
+     */
+    template <typename T>
+    typename std::enable_if_t<IsBulkSerializableType<T>::value> readVectorElements(
+        std::vector<T> &vector, std::size_t count)
+    {
+        std::size_t maxChunkCount = maxChunkByteSize / sizeof(T);
+        std::size_t remainingSize;
+        if (mInput.getRemainingSize(remainingSize)) {
+            if (count > remainingSize / sizeof(T)) {
+                throw EOSException("Read failed: vector size " + std::to_string(count) +
+                                   " exceeds the end of stream");
+            }
+            maxChunkCount = count;
+        }
+
+        while (count > 0) {
+            std::size_t chunkCount = count < maxChunkCount ? count : maxChunkCount;
+            std::size_t offset = vector.size();
+            vector.resize(offset + chunkCount);
+            readUsingMemoryCopy(reinterpret_cast<StreamByte *>(vector.data() + offset),
+                                chunkCount * sizeof(T));
+            count -= chunkCount;
+        }
+    }
+
+    /** Read vector elements one by one */
+    template <typename T>
+    typename std::enable_if_t<!IsBulkSerializableType<T>::value> readVectorElements(
+        std::vector<T> &vector, std::size_t count)
+    {
         /* Do not resize the vector to the read size: if the size is erroneous, it may make the
          * allocation fail.
          *
          * It's safer to use the "auto-growth" feature of the std::vector. In this way the
          * end of stream will be reached before saturating the memory.
+         *
+         * Nevertheless each element is at least one byte long, so the memory can be reserved at
+         * once if the stream is known to be big enough.
          */
+        std::size_t remainingSize;
+        if (mInput.getRemainingSize(remainingSize) && count <= remainingSize) {
+            vector.reserve(vector.size() + count);
+        }
 
         /* Reading each element */
-        for (std::size_t i = 0; i < size; ++i) {
+        for (std::size_t i = 0; i < count; ++i) {
             /* Initializing element with default values because otherwise klocwork believes that
              * uninitialized values are used, which is a false positive */
             T element;
@@ -153,15 +215,17 @@ public:
         }
     }
 
-private:
     template <typename T>
     void readUsingMemoryCopy(T &value)
     {
-        std::size_t elementSize = sizeof(T);
+        readUsingMemoryCopy(reinterpret_cast<StreamByte *>(&value), sizeof(T));
+    }
 
+    void readUsingMemoryCopy(StreamByte *dest, std::size_t byteCount)
+    {
         try {
-            auto read = mInput.read(reinterpret_cast<StreamByte *>(&value), elementSize);
-            if (read < elementSize) {
+            auto read = mInput.read(dest, byteCount);
+            if (read < byteCount) {
                 throw EOSException("Read failed: end of stream reached");
             }
         } catch (InputStream::Exception &e) {
@@ -193,5 +257,34 @@ private:
     const Buffer &mBuffer;
     MemoryInputStream mInput;
 };
+
+/* Read values from a memory view, allowing to read sub views without copy */
+class BufferViewByteStreamReader : public ByteStreamReader
+{
+public:
+    /** The viewed memory must outlive the reader */
+    BufferViewByteStreamReader(const BufferView &view) : ByteStreamReader(mInput), mInput(view) {}
+
+    /** Read a view of the next 'size' bytes, without copying them.
+     * @throw ByteStreamReader::EOSException if the stream contains less than 'size' bytes; in
+     *        this case the stream is fully consumed, as when reading values */
+    BufferView readView(std::size_t size)
+    {
+        BufferView view = mInput.readView(size);
+        if (view.size() != size) {
+            throw EOSException("Read failed: end of stream reached");
+        }
+        return view;
+    }
+
+    /** @return true if stream is fully consumed, i.e. end of stream is reached */
+    bool isEOS() const { return mInput.isEOS(); }
+
+    /** @return the current stream pointer index */
+    std::size_t getPointerOffset() const { return mInput.getPointerOffset(); }
+
+private:
+    BufferViewInputStream mInput;
+};
 }
 }
@@ -50,7 +50,7 @@ class ByteStreamWriter
 public:
     using Exception = util::Exception<ByteStreamWriter>;
 
-    ByteStreamWriter(OutputStream &os) : mOutput(os) {}
+    ByteStreamWriter(OutputStream &os) : ByteStreamWriter(os, nullptr) {}
     ByteStreamWriter(const ByteStreamWriter &) = delete;
     ByteStreamWriter &operator=(const ByteStreamWriter &) = delete;
 
@@ -139,32 +139,79 @@ public:
         /* Writing the size */
         write(size);
 
-        /* Writing the elements*/
-        for (auto &element : vector) {
+        writeVectorElements(vector);
+    }
+
+    /** Write contiguous "bulk serializable" values using one memory copy.
+     *
+     * @param[in] src the memory representation of the values
+     * @param[in] byteCount the size of the values
+     */
+    void writeMemoryLayout(const void *src, std::size_t byteCount)
+    {
+        writeUsingMemoryCopy(static_cast<const StreamByte *>(src), byteCount);
+    }
+
+protected:
+    /** @param[in] os the output stream
+     * @param[in] memory if not null, the buffer the output stream appends to: values are then
+     *                   appended directly to it, saving a virtual call per value
+     */
+    ByteStreamWriter(OutputStream &os, Buffer *memory) : mOutput(os), mMemory(memory) {}
+
+private:
+    /** Write "bulk serializable type" vector elements using one memory copy */
+    template <typename T>
+    typename std::enable_if_t<IsBulkSerializableType<T>::value> writeVectorElements(
+        const std::vector<T> &vector)
+    {
+        writeUsingMemoryCopy(reinterpret_cast<const StreamByte *>(vector.data()),
+                             vector.size() * sizeof(T));
+    }
+
+    /** Write vector elements one by one */
+    template <typename T>
+    typename std::enable_if_t<!IsBulkSerializableType<T>::value> writeVectorElements(
+        const std::vector<T> &vector)
+    {
+        for (const auto &element : vector) {
             write(element);
         }
     }
 
-private:
     template <typename T>
     void writeUsingMemoryCopy(const T &value)
     {
-        std::size_t elementSize = sizeof(T);
+        writeUsingMemoryCopy(reinterpret_cast<const StreamByte *>(&value), sizeof(T));
+    }
 
+    void writeUsingMemoryCopy(const StreamByte *src, std::size_t byteCount)
+    {
+        if (mMemory != nullptr) {
+            /* The byte count of a value is known at compile time: once inlined, this is a
+             * capacity check followed by a store */
+            mMemory->insert(mMemory->end(), src, src + byteCount);
+            return;
+        }
         try {
-            mOutput.write(reinterpret_cast<const StreamByte *>(&value), elementSize);
+            mOutput.write(src, byteCount);
         } catch (InputStream::Exception &e) {
             throw Exception("Write failed: " + std::string(e.what()));
         }
     }
 
     OutputStream &mOutput;
+    Buffer *const mMemory;
 };
 
 class MemoryByteStreamWriter : public ByteStreamWriter
 {
 public:
-    MemoryByteStreamWriter() : ByteStreamWriter(mOutput), mOutput(mBuffer) {}
+    /** @param[in] capacityHint the expected written size, allocated at once */
+    MemoryByteStreamWriter(std::size_t capacityHint = 0)
+        : ByteStreamWriter(mOutput, &mBuffer), mOutput(mBuffer, capacityHint)
+    {
+    }
 
     /** @return the underlying buffer */
     const Buffer &getBuffer() const { return mBuffer; }
@@ -173,5 +220,29 @@ private:
     Buffer mBuffer;
     MemoryOutputStream mOutput;
 };
+
+/* Write values to a caller-owned buffer.
+ *
+ * The buffer is cleared but keeps its capacity, so that a scratch buffer reused to build
+ * successive messages is allocated only once.
+ */
+class BufferByteStreamWriter : public ByteStreamWriter
+{
+public:
+    /** @param[in] buffer the written buffer, ownership is not transferred
+     * @param[in] capacityHint the expected written size, reserved at once
+     */
+    BufferByteStreamWriter(Buffer &buffer, std::size_t capacityHint = 0)
+        : ByteStreamWriter(mOutput, &buffer), mBuffer(buffer), mOutput(buffer, capacityHint)
+    {
+    }
+
+    /** @return the underlying buffer */
+    const Buffer &getBuffer() const { return mBuffer; }
+
+private:
+    Buffer &mBuffer;
+    MemoryOutputStream mOutput;
+};
 }
 }
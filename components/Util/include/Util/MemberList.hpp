@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2016, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include "Util/ByteStreamReader.hpp"
+#include "Util/ByteStreamWriter.hpp"
+#include <cstddef>
+#include <vector>
+
+namespace debug_agent
+{
+namespace util
+{
+
+/** Serialized member of a structure
+ *
+ * @tparam Class the structure type
+ * @tparam Type the member type
+ * @tparam member the member pointer
+ */
+template <typename Class, typename Type, Type Class::*member>
+struct Member
+{
+    /** true if the member is serialized as its memory representation */
+    static const bool hasMemoryLayout = IsBulkSerializableType<Type>::value;
+    static const std::size_t size = sizeof(Type);
+
+    static const uint8_t *address(const Class &object)
+    {
+        return reinterpret_cast<const uint8_t *>(&(object.*member));
+    }
+
+    static void read(Class &object, ByteStreamReader &reader) { reader.read(object.*member); }
+
+    static void write(const Class &object, ByteStreamWriter &writer)
+    {
+        writer.write(object.*member);
+    }
+};
+
+/** Serialized vector member of a structure, preceded by its size
+ *
+ * @tparam SizeType the type of the vector size in the stream
+ * @tparam Class the structure type
+ * @tparam Type the vector element type
+ * @tparam member the member pointer
+ */
+template <typename SizeType, typename Class, typename Type, std::vector<Type> Class::*member>
+struct VectorMember
+{
+    static const bool hasMemoryLayout = false;
+    static const std::size_t size = sizeof(std::vector<Type>);
+
+    static const uint8_t *address(const Class &object)
+    {
+        return reinterpret_cast<const uint8_t *>(&(object.*member));
+    }
+
+    static void read(Class &object, ByteStreamReader &reader)
+    {
+        reader.readVector<SizeType>(object.*member);
+    }
+
+    static void write(const Class &object, ByteStreamWriter &writer)
+    {
+        writer.writeVector<SizeType>(object.*member);
+    }
+};
+
+/** Declares a member of the "Class" structure for a MemberList */
+#define SERIALIZED_MEMBER(Class, member)                                                           \
+    debug_agent::util::Member<Class, decltype(Class::member), &Class::member>
+
+/** Declares a vector member of the "Class" structure for a MemberList */
+#define SERIALIZED_VECTOR_MEMBER(SizeType, Class, member)                                          \
+    debug_agent::util::VectorMember<SizeType, Class, decltype(Class::member)::value_type,         \
+                                    &Class::member>
+
+/** Serializer of a structure, generated from the ordered list of its serialized members.
+ *
+ * Consecutive members which are serialized as their memory representation and which are
+ * contiguous in the structure (i.e. not separated by padding) are read or written using one
+ * memory copy. As member addresses are compile-time offsets, this grouping is resolved by the
+ * compiler.
+ *
+ * @code
+ * struct Foo
+ * {
+ *     uint32_t a;
+ *     uint32_t b;
+ *     std::vector<uint32_t> c;
+ *
+ *     using Members = util::MemberList<SERIALIZED_MEMBER(Foo, a), SERIALIZED_MEMBER(Foo, b),
+ *                                      SERIALIZED_VECTOR_MEMBER(uint32_t, Foo, c)>;
+ *
+ *     void fromStream(util::ByteStreamReader &reader) { Members::fromStream(*this, reader); }
+ *     void toStream(util::ByteStreamWriter &writer) const { Members::toStream(*this, writer); }
+ * };
+ * @endcode
+ *
+ * @tparam Members the member list, using the SERIALIZED_MEMBER and SERIALIZED_VECTOR_MEMBER
+ *                 macros, in stream order
+ */
+template <typename... Members>
+struct MemberList;
+
+template <>
+struct MemberList<>
+{
+    template <typename Class>
+    static void fromStream(Class &, ByteStreamReader &)
+    {
+    }
+
+    template <typename Class>
+    static void toStream(const Class &, ByteStreamWriter &)
+    {
+    }
+
+    /* Pending memory copies are flushed once all members are visited */
+
+    template <typename Class>
+    static void read(Class &, ByteStreamReader &reader, uint8_t *pending, std::size_t pendingSize)
+    {
+        if (pendingSize != 0) {
+            reader.readMemoryLayout(pending, pendingSize);
+        }
+    }
+
+    template <typename Class>
+    static void write(const Class &, ByteStreamWriter &writer, const uint8_t *pending,
+                      std::size_t pendingSize)
+    {
+        if (pendingSize != 0) {
+            writer.writeMemoryLayout(pending, pendingSize);
+        }
+    }
+};
+
+template <typename First, typename... Others>
+struct MemberList<First, Others...>
+{
+    template <typename Class>
+    static void fromStream(Class &object, ByteStreamReader &reader)
+    {
+        read(object, reader, nullptr, 0);
+    }
+
+    template <typename Class>
+    static void toStream(const Class &object, ByteStreamWriter &writer)
+    {
+        write(object, writer, nullptr, 0);
+    }
+
+    /** Visit the members, accumulating contiguous memory representations in the 'pending'
+     * memory area, which is read once a member cannot be appended to it. */
+    template <typename Class>
+    static void read(Class &object, ByteStreamReader &reader, uint8_t *pending,
+                     std::size_t pendingSize)
+    {
+        uint8_t *address = const_cast<uint8_t *>(First::address(object));
+        if (First::hasMemoryLayout && pendingSize != 0 && address == pending + pendingSize) {
+            MemberList<Others...>::read(object, reader, pending, pendingSize + First::size);
+            return;
+        }
+
+        MemberList<>::read(object, reader, pending, pendingSize);
+        if (First::hasMemoryLayout) {
+            MemberList<Others...>::read(object, reader, address, First::size);
+        } else {
+            First::read(object, reader);
+            MemberList<Others...>::read(object, reader, nullptr, 0);
+        }
+    }
+
+    /** @see read() */
+    template <typename Class>
+    static void write(const Class &object, ByteStreamWriter &writer, const uint8_t *pending,
+                      std::size_t pendingSize)
+    {
+        const uint8_t *address = First::address(object);
+        if (First::hasMemoryLayout && pendingSize != 0 && address == pending + pendingSize) {
+            MemberList<Others...>::write(object, writer, pending, pendingSize + First::size);
+            return;
+        }
+
+        MemberList<>::write(object, writer, pending, pendingSize);
+        if (First::hasMemoryLayout) {
+            MemberList<Others...>::write(object, writer, address, First::size);
+        } else {
+            First::write(object, writer);
+            MemberList<Others...>::write(object, writer, nullptr, 0);
+        }
+    }
+};
+}
+}
@@ -32,6 +32,7 @@
 
 #include "Util/Stream.hpp"
 #include "Util/Buffer.hpp"
+#include "Util/BufferView.hpp"
 #include "Util/AssertAlways.hpp"
 #include "Util/Iterator.hpp"
 #include <algorithm>
@@ -62,6 +63,14 @@ public:
         return toRead;
     }
 
+    bool getRemainingSize(std::size_t &remainingSize) const override
+    {
+        ASSERT_ALWAYS(mIndex <= mBuffer.size());
+
+        remainingSize = mBuffer.size() - mIndex;
+        return true;
+    }
+
     /** @return true if stream is fully consumed, i.e. end of stream is reached */
     bool isEOS() const { return mIndex == mBuffer.size(); }
 
@@ -75,19 +84,73 @@ private:
     std::size_t mIndex = 0;
 };
 
+/** Input stream that reads from a memory view, allowing to get sub views without copy */
+class BufferViewInputStream : public InputStream
+{
+public:
+    /** The viewed memory must outlive the stream. */
+    BufferViewInputStream(const BufferView &view) : mView(view) {}
+
+    std::size_t read(StreamByte *dest, std::size_t byteCount) override
+    {
+        BufferView source = readView(byteCount);
+        std::copy(source.begin(), source.end(), MAKE_ARRAY_ITERATOR(dest, source.size()));
+        return source.size();
+    }
+
+    bool getRemainingSize(std::size_t &remainingSize) const override
+    {
+        ASSERT_ALWAYS(mIndex <= mView.size());
+
+        remainingSize = mView.size() - mIndex;
+        return true;
+    }
+
+    /** Consume up to byteCount bytes without copying them.
+     * @return the view of the consumed bytes, which is smaller than byteCount if the end of
+     *         stream is reached */
+    BufferView readView(std::size_t byteCount)
+    {
+        ASSERT_ALWAYS(mIndex <= mView.size());
+
+        std::size_t toRead = std::min(byteCount, mView.size() - mIndex);
+        BufferView consumed = mView.subView(mIndex, toRead);
+        mIndex += toRead;
+        return consumed;
+    }
+
+    /** @return true if stream is fully consumed, i.e. end of stream is reached */
+    bool isEOS() const { return mIndex == mView.size(); }
+
+    /** @return the current stream pointer index */
+    std::size_t getPointerOffset() const { return mIndex; }
+
+private:
+    BufferView mView;
+    std::size_t mIndex = 0;
+};
+
 /** Output stream that writes to a memory buffer */
 class MemoryOutputStream : public OutputStream
 {
 public:
-    /** Buffer is cleared */
-    MemoryOutputStream(Buffer &buffer) : mBuffer(buffer) { buffer.clear(); }
+    /** Buffer is cleared, but its capacity is kept: a buffer can be reused across several
+     * streams without reallocation.
+     *
+     * @param[in] buffer the written buffer, ownership is not taken
+     * @param[in] capacityHint the expected written size, reserved at once
+     */
+    MemoryOutputStream(Buffer &buffer, std::size_t capacityHint = 0) : mBuffer(buffer)
+    {
+        buffer.clear();
+        buffer.reserve(capacityHint);
+    }
 
     void write(const StreamByte *src, std::size_t byteCount) override
     {
-        std::size_t currentIndex = mBuffer.size();
-        mBuffer.resize(mBuffer.size() + byteCount);
-
-        std::copy(src, src + byteCount, mBuffer.begin() + currentIndex);
+        /* Appending without zero-filling the new elements first, the capacity grows
+         * geometrically */
+        mBuffer.insert(mBuffer.end(), src, src + byteCount);
     }
 
 private:
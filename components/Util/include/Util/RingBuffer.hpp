@@ -30,6 +30,7 @@
 #pragma once
 
 #include "Util/Buffer.hpp"
+#include "Util/RingBufferSpan.hpp"
 #include "Util/AssertAlways.hpp"
 #include "Util/Iterator.hpp"
 #include <condition_variable>
@@ -43,6 +44,10 @@ namespace util
 {
 
 /** Implements a ring buffer with blocking/non blocking read/write methods
+ *
+ * The acquireRead()/commitRead() and acquireWrite()/commitWrite() methods give access to the
+ * ring buffer storage without copy. They require that only one thread reads and only one thread
+ * writes at a time.
  *
  * This class guarantees that underflow/overflow will not happen
  */
@@ -50,6 +55,8 @@ class RingBuffer
 {
 public:
     using Byte = uint8_t;
+    using ReadSpan = RingBufferSpan<const Byte>;
+    using WriteSpan = RingBufferSpan<Byte>;
 
     RingBuffer(std::size_t size) : mBuffer(size) {}
 
@@ -172,6 +179,61 @@ public:
         return current == end;
     }
 
+    /** Give access to the stored data without copying it.
+     *
+     * The returned span stays valid until commitRead() or clear() is called.
+     * @param[in] maxCount the maximum byte count to acquire
+     * @return up to maxCount stored bytes, empty if the ring buffer is empty.
+     */
+    ReadSpan acquireRead(std::size_t maxCount)
+    {
+        std::lock_guard<std::mutex> locker(mMemberLock);
+        std::size_t count = std::min(getAvailableConsumption(), maxCount);
+        if (count == 0) {
+            return {};
+        }
+        return ReadSpan(mBuffer.data(), mBuffer.size(), mConsumerPosition % mBuffer.size(), count);
+    }
+
+    /** Release the first 'count' bytes of the last acquired read span */
+    void commitRead(std::size_t count)
+    {
+        std::lock_guard<std::mutex> locker(mMemberLock);
+        ASSERT_ALWAYS(count <= getAvailableConsumption());
+        mConsumerPosition += count;
+
+        mProducerVar.notify_one();
+    }
+
+    /** Give access to the free space in order to produce data in place.
+     *
+     * The returned span stays valid until commitWrite() or clear() is called.
+     * @param[in] maxCount the maximum byte count to acquire
+     * @return up to maxCount free bytes, empty if the ring buffer is full or closed.
+     */
+    WriteSpan acquireWrite(std::size_t maxCount)
+    {
+        std::lock_guard<std::mutex> locker(mMemberLock);
+        if (!mOpen) {
+            return {};
+        }
+        std::size_t count = std::min(getAvailableProduction(), maxCount);
+        if (count == 0) {
+            return {};
+        }
+        return WriteSpan(mBuffer.data(), mBuffer.size(), mProducerPosition % mBuffer.size(), count);
+    }
+
+    /** Publish the first 'count' bytes of the last acquired write span */
+    void commitWrite(std::size_t count)
+    {
+        std::lock_guard<std::mutex> locker(mMemberLock);
+        ASSERT_ALWAYS(count <= getAvailableProduction());
+        mProducerPosition += count;
+
+        mConsumerVar.notify_one();
+    }
+
     /** Return stored data size in the buffer */
     std::size_t getUsedSize() const
     {
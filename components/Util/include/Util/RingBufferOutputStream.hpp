@@ -31,6 +31,7 @@
 #pragma once
 
 #include "Util/Stream.hpp"
+#include "Util/Buffer.hpp"
 
 namespace debug_agent
 {
@@ -71,6 +72,12 @@ public:
      * @return the size of the ring buffer output stream.
      */
     virtual std::size_t getSize() const = 0;
+
+    /**
+     * Write a whole block. Unlike write(), the block may be handed as is to the underlying
+     * device, without intermediate copy.
+     */
+    virtual void writeBlock(const Buffer &block) { write(block.data(), block.size()); }
 };
 }
 }
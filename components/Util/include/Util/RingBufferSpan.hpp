@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2016, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include "Util/AssertAlways.hpp"
+#include "Util/Iterator.hpp"
+#include <array>
+#include <algorithm>
+#include <cstddef>
+
+namespace debug_agent
+{
+namespace util
+{
+
+/** Contiguous regions of a ring buffer, as returned by its acquireRead()/acquireWrite() methods.
+ *
+ * A ring buffer range wraps around the buffer end at most once, so it is made of one or two
+ * parts. The second part is empty unless the range wraps.
+ *
+ * @tparam T the ring buffer element type, const qualified for read regions.
+ */
+template <typename T>
+struct RingBufferSpan
+{
+    struct Part
+    {
+        T *data;
+        std::size_t size;
+    };
+
+    std::array<Part, 2> parts{{{nullptr, 0}, {nullptr, 0}}};
+
+    RingBufferSpan() = default;
+
+    /** @param[in] buffer the ring buffer storage start
+     * @param[in] bufferSize the ring buffer storage size
+     * @param[in] index the range start index in the storage, must be lesser than bufferSize
+     * @param[in] count the range size, must not exceed bufferSize
+     */
+    RingBufferSpan(T *buffer, std::size_t bufferSize, std::size_t index, std::size_t count)
+    {
+        ASSERT_ALWAYS(count <= bufferSize);
+        if (count == 0) {
+            return;
+        }
+        ASSERT_ALWAYS(index < bufferSize);
+        std::size_t firstPartSize = std::min(count, bufferSize - index);
+        parts[0] = {buffer + index, firstPartSize};
+        if (firstPartSize != count) {
+            parts[1] = {buffer, count - firstPartSize};
+        }
+    }
+
+    std::size_t size() const { return parts[0].size + parts[1].size; }
+
+    bool empty() const { return size() == 0; }
+
+    /** Copy the first 'count' elements of the span.
+     * @return the destination iterator past the last copied element
+     */
+    template <typename OutputIt>
+    OutputIt copyTo(OutputIt dest, std::size_t count) const
+    {
+        ASSERT_ALWAYS(count <= size());
+        std::size_t firstPartSize = std::min(count, parts[0].size);
+        dest = std::copy_n(parts[0].data, firstPartSize, dest);
+        if (count != firstPartSize) {
+            dest = std::copy_n(parts[1].data, count - firstPartSize, dest);
+        }
+        return dest;
+    }
+
+    /** Fill the first 'count' elements of the span by copying them from 'source'. */
+    void copyFrom(const T *source, std::size_t count) const
+    {
+        ASSERT_ALWAYS(count <= size());
+        std::size_t firstPartSize = std::min(count, parts[0].size);
+        std::copy_n(source, firstPartSize, MAKE_ARRAY_ITERATOR(parts[0].data, parts[0].size));
+        if (count != firstPartSize) {
+            std::copy_n(source + firstPartSize, count - firstPartSize,
+                        MAKE_ARRAY_ITERATOR(parts[1].data, parts[1].size));
+        }
+    }
+};
+}
+}
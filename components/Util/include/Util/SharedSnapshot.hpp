@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2016, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <memory>
+#include <utility>
+
+namespace debug_agent
+{
+namespace util
+{
+
+/** Publishes immutable snapshots of an object to concurrent readers (read-copy-update)
+ *
+ * A writer builds a new object aside and publishes it with an atomic pointer swap. Readers get
+ * a shared pointer to the current snapshot without waiting for the writer, and the snapshot
+ * they hold stays valid and unchanged until they release it, even if a newer one has been
+ * published meanwhile.
+ *
+ * Usage example:
+ *
+ *     SharedSnapshot<Model> model;
+ *
+ *     // Reader
+ *     auto current = model.get();
+ *     if (current != nullptr) {
+ *         current->read();
+ *     }
+ *
+ *     // Writer
+ *     model.publish(std::make_shared<Model>(...));
+ *
+ * @tparam T The snapshot type, which shall not be modified once published
+ */
+template <class T>
+class SharedSnapshot final
+{
+public:
+    explicit SharedSnapshot(std::shared_ptr<T> initial = nullptr) : mCurrent(std::move(initial))
+    {
+    }
+
+    SharedSnapshot(const SharedSnapshot &) = delete;
+    SharedSnapshot &operator=(const SharedSnapshot &) = delete;
+
+    /** @return the current snapshot, which may be nullptr */
+    std::shared_ptr<T> get() const { return std::atomic_load(&mCurrent); }
+
+    /** Replace the current snapshot, atomically
+     * @return the replaced snapshot */
+    std::shared_ptr<T> publish(std::shared_ptr<T> snapshot)
+    {
+        return std::atomic_exchange(&mCurrent, std::move(snapshot));
+    }
+
+private:
+    std::shared_ptr<T> mCurrent;
+};
+}
+}
@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2016, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace debug_agent
+{
+namespace util
+{
+
+/** Call statistics of a SingleFlight */
+struct SingleFlightStatistics
+{
+    /** The count of calls actually performed */
+    std::size_t callCount;
+    /** The count of requests served by the call of another concurrent request */
+    std::size_t mergedCount;
+};
+
+/** The default context of the SingleFlight calls, which holds nothing */
+struct SingleFlightNoContext
+{
+};
+
+/** Merges concurrent identical requests into a single call ("single flight")
+ *
+ * The first request of a key performs the call, the requests of the same key issued while this
+ * call is in flight wait for it and receive a copy of its result, or of its exception. A request
+ * issued once the call has completed performs a new call: results are not cached.
+ *
+ * This is intended for idempotent queries, such as firmware parameter reads, that several
+ * clients poll at the same time.
+ *
+ * @tparam Key the request key, shall be less-than comparable
+ * @tparam Value the result type, shall be copy assignable
+ * @tparam Context a default constructible state shared by the requests merged into a call, for
+ *                 instance the priority of this call
+ */
+template <typename Key, typename Value, typename Context = SingleFlightNoContext>
+class SingleFlight
+{
+public:
+    SingleFlight() = default;
+    SingleFlight(const SingleFlight &) = delete;
+    SingleFlight &operator=(const SingleFlight &) = delete;
+
+    /** Perform a request
+     *
+     * @param[in] key the request key
+     * @param[out] value the result of the request
+     * @param[in] call a void(Value &) function performing the request, invoked only if no
+     *                 request of the same key is in flight
+     * @throw the exception thrown by the call
+     */
+    template <typename Call>
+    void run(const Key &key, Value &value, Call &&call)
+    {
+        run(key, value, [&](Value &result, Context &) { call(result); }, [](Context &) {});
+    }
+
+    /** Perform a request, sharing a context with the requests merged into the same call
+     *
+     * @param[in] key the request key
+     * @param[out] value the result of the request
+     * @param[in] call a void(Value &, Context &) function performing the request, invoked only
+     *                 if no request of the same key is in flight
+     * @param[in] join a void(Context &) function invoked, with the SingleFlight lock held, when
+     *                 the request is merged into the call in flight
+     * @throw the exception thrown by the call or by join
+     */
+    template <typename Call, typename Join>
+    void run(const Key &key, Value &value, Call &&call, Join &&join)
+    {
+        std::shared_ptr<Flight> flight;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            auto it = mFlights.find(key);
+            if (it != mFlights.end()) {
+                flight = it->second;
+                join(flight->context);
+                ++flight->waiterCount;
+                ++mStatistics.mergedCount;
+                flight->condition.wait(lock, [&] { return flight->done; });
+                if (flight->error != nullptr) {
+                    std::rethrow_exception(flight->error);
+                }
+                value = flight->value;
+                return;
+            }
+            flight = std::make_shared<Flight>();
+            mFlights.emplace(key, flight);
+            ++mStatistics.callCount;
+        }
+
+        try {
+            call(value, flight->context);
+        } catch (...) {
+            land(key, *flight, nullptr, std::current_exception());
+            throw;
+        }
+        land(key, *flight, &value, nullptr);
+    }
+
+    /** Prevent the next requests from joining the calls currently in flight, for instance
+     * because the requested data has been modified. These calls still serve their current
+     * waiters. */
+    void forget()
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mFlights.clear();
+    }
+
+    SingleFlightStatistics getStatistics() const
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mStatistics;
+    }
+
+private:
+    struct Flight
+    {
+        std::condition_variable condition;
+        bool done = false;
+        std::size_t waiterCount = 0;
+        Value value;
+        std::exception_ptr error;
+        Context context;
+    };
+
+    /** Publish the outcome of a call to its waiters */
+    void land(const Key &key, Flight &flight, const Value *value, std::exception_ptr error)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        auto it = mFlights.find(key);
+        if (it != mFlights.end() && it->second.get() == &flight) {
+            mFlights.erase(it);
+        }
+        /* The result is copied only if another request is waiting for it */
+        if (flight.waiterCount > 0) {
+            if (value != nullptr) {
+                flight.value = *value;
+            }
+            flight.error = error;
+        }
+        flight.done = true;
+        flight.condition.notify_all();
+    }
+
+    mutable std::mutex mMutex;
+    std::map<Key, std::shared_ptr<Flight>> mFlights;
+    SingleFlightStatistics mStatistics{0, 0};
+};
+}
+}
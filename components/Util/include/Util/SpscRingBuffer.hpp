@@ -0,0 +1,403 @@
+/*
+ * Copyright (c) 2016, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include "Util/Buffer.hpp"
+#include "Util/RingBufferSpan.hpp"
+#include "Util/AssertAlways.hpp"
+#include "Util/Iterator.hpp"
+#include <condition_variable>
+#include <mutex>
+#include <atomic>
+#include <algorithm>
+#include <cstdint>
+
+namespace debug_agent
+{
+namespace util
+{
+
+/** Implements a lock-free single-producer/single-consumer ring buffer with the same
+ * blocking/non blocking read/write methods as util::RingBuffer.
+ *
+ * Only one thread may call the write methods and only one thread may call the read methods
+ * (and clear()) at a time. Producer and consumer positions are published with atomics: a
+ * write or a read that does not need to wait neither takes a lock nor notifies a condition
+ * variable. The internal mutex is only used to put a starving side asleep, and the other side
+ * only signals it once, when it has announced itself as waiting.
+ *
+ * This class guarantees that underflow/overflow will not happen
+ */
+class SpscRingBuffer
+{
+public:
+    using Byte = uint8_t;
+    using ReadSpan = RingBufferSpan<const Byte>;
+    using WriteSpan = RingBufferSpan<Byte>;
+
+    SpscRingBuffer(std::size_t size) : mBuffer(size) {}
+
+    /** Move constructor.
+     *
+     * Must not be called while the other ring buffer is being used by another thread.
+     */
+    SpscRingBuffer(SpscRingBuffer &&other)
+        : mProducerPosition(other.mProducerPosition.load()),
+          mCachedConsumerPosition(other.mCachedConsumerPosition),
+          mConsumerPosition(other.mConsumerPosition.load()),
+          mCachedProducerPosition(other.mCachedProducerPosition), mOpen(other.mOpen.load()),
+          mBuffer(std::move(other.mBuffer))
+    {
+        other.mBuffer.clear();
+        other.mProducerPosition = 0;
+        other.mCachedConsumerPosition = 0;
+        other.mConsumerPosition = 0;
+        other.mCachedProducerPosition = 0;
+        other.mOpen = false;
+    }
+
+    SpscRingBuffer(const SpscRingBuffer &) = delete;
+    SpscRingBuffer &operator=(const SpscRingBuffer &) = delete;
+
+    ~SpscRingBuffer() { close(); }
+
+    /** Open the queue and allows production */
+    void open() { mOpen = true; }
+
+    /** Close the queue:
+     * - production is no more enabled
+     * - consumption is still enabled until the buffer is empty
+     *
+     * Note: this method makes wakup any waiting thread blocked on a write/ReadBlocking() method
+     */
+    void close()
+    {
+        if (mOpen.exchange(false)) {
+            std::lock_guard<std::mutex> locker(mWaitLock);
+            mProducerVar.notify_all();
+            mConsumerVar.notify_all();
+        }
+    }
+
+    /** Write content to the ring buffer and returns immediately
+     *
+     * @return the count of written bytes. If it less than the "count" parameter then the
+     * ring buffer is full.
+     */
+    std::size_t writeNonBlocking(const Byte *content, std::size_t count)
+    {
+        if (!mOpen) {
+            return 0;
+        }
+        std::size_t toWrite = std::min(getProducerAvailability(count), count);
+        produce(content, toWrite);
+        return toWrite;
+    }
+
+    /** This method blocks until the whole content is written in the ring buffer.
+     * @return false if the writing has failed due to ring buffer closing
+     */
+    bool writeBlocking(const Byte *content, std::size_t count)
+    {
+        auto current = content;
+        auto end = content + count;
+        while (mOpen && current != end) {
+            std::size_t remaining = end - current;
+            std::size_t toWrite = std::min(getProducerAvailability(remaining), remaining);
+            if (toWrite == 0) {
+                waitForProduction();
+            } else {
+                produce(current, toWrite);
+            }
+        }
+        return mOpen;
+    }
+
+    /** Read content from the ring buffer and returns immediately
+     *
+     * @return the count of read bytes. If it less than the "count" parameter then the
+     * ring buffer is empty.
+     */
+    std::size_t readNonBlocking(Byte *target, std::size_t count)
+    {
+        std::size_t toRead = std::min(getConsumerAvailability(count), count);
+        consume(target, toRead);
+        return toRead;
+    }
+
+    /** This method blocks until the whole content is read from the ring buffer.
+     *
+     * @return false if the reading has failed because the ring buffer is closed and empty.
+     */
+    bool readBlocking(Byte *target, std::size_t count)
+    {
+        if (!mOpen) {
+            return false;
+        }
+
+        auto current = target;
+        auto end = target + count;
+        while (current != end && !isClosedForConsumer()) {
+            std::size_t remaining = end - current;
+            std::size_t toRead = std::min(getConsumerAvailability(remaining), remaining);
+            if (toRead == 0) {
+                waitForConsumption();
+            } else {
+                consume(current, toRead);
+            }
+        }
+        return current == end;
+    }
+
+    /** Give access to the stored data without copying it. Consumer side only.
+     *
+     * The returned span stays valid until commitRead() or clear() is called.
+     * @param[in] maxCount the maximum byte count to acquire
+     * @return up to maxCount stored bytes, empty if the ring buffer is empty.
+     */
+    ReadSpan acquireRead(std::size_t maxCount)
+    {
+        std::size_t count = std::min(getConsumerAvailability(maxCount), maxCount);
+        if (count == 0) {
+            return {};
+        }
+        std::size_t consumerPosition = mConsumerPosition.load(std::memory_order_relaxed);
+        return ReadSpan(mBuffer.data(), mBuffer.size(), consumerPosition % mBuffer.size(), count);
+    }
+
+    /** Release the first 'count' bytes of the last acquired read span */
+    void commitRead(std::size_t count)
+    {
+        std::size_t consumerPosition = mConsumerPosition.load(std::memory_order_relaxed);
+        ASSERT_ALWAYS(count <= mCachedProducerPosition - consumerPosition);
+        publishConsumerPosition(consumerPosition + count);
+    }
+
+    /** Give access to the free space in order to produce data in place. Producer side only.
+     *
+     * The returned span stays valid until commitWrite() is called.
+     * @param[in] maxCount the maximum byte count to acquire
+     * @return up to maxCount free bytes, empty if the ring buffer is full or closed.
+     */
+    WriteSpan acquireWrite(std::size_t maxCount)
+    {
+        if (!mOpen) {
+            return {};
+        }
+        std::size_t count = std::min(getProducerAvailability(maxCount), maxCount);
+        if (count == 0) {
+            return {};
+        }
+        std::size_t producerPosition = mProducerPosition.load(std::memory_order_relaxed);
+        return WriteSpan(mBuffer.data(), mBuffer.size(), producerPosition % mBuffer.size(), count);
+    }
+
+    /** Publish the first 'count' bytes of the last acquired write span */
+    void commitWrite(std::size_t count)
+    {
+        std::size_t producerPosition = mProducerPosition.load(std::memory_order_relaxed);
+        ASSERT_ALWAYS(count <= mBuffer.size() - (producerPosition - mCachedConsumerPosition));
+        publishProducerPosition(producerPosition + count);
+    }
+
+    /** Return stored data size in the buffer */
+    std::size_t getUsedSize() const
+    {
+        std::size_t consumerPosition = mConsumerPosition.load(std::memory_order_acquire);
+        std::size_t producerPosition = mProducerPosition.load(std::memory_order_acquire);
+        ASSERT_ALWAYS(producerPosition >= consumerPosition);
+        ASSERT_ALWAYS((producerPosition - consumerPosition) <= mBuffer.size());
+        return producerPosition - consumerPosition;
+    }
+
+    /** Return free data size in the buffer */
+    std::size_t getAvailableSize() const { return mBuffer.size() - getUsedSize(); }
+
+    bool isOpen() const { return mOpen; }
+
+    /** Discard the stored data.
+     *
+     * Belongs to the consumer side: must not be called concurrently with a read method.
+     */
+    void clear()
+    {
+        mCachedProducerPosition = mProducerPosition.load(std::memory_order_acquire);
+        publishConsumerPosition(mCachedProducerPosition);
+    }
+
+private:
+    static const std::size_t mCacheLineSize = 64;
+
+    /** @return the free byte count, refreshing the cached consumer position only if the
+     * last known one does not allow to write 'wanted' bytes. Producer side only. */
+    std::size_t getProducerAvailability(std::size_t wanted)
+    {
+        std::size_t producerPosition = mProducerPosition.load(std::memory_order_relaxed);
+        std::size_t available = mBuffer.size() - (producerPosition - mCachedConsumerPosition);
+        if (available < wanted) {
+            mCachedConsumerPosition = mConsumerPosition.load();
+            available = mBuffer.size() - (producerPosition - mCachedConsumerPosition);
+        }
+        ASSERT_ALWAYS(available <= mBuffer.size());
+        return available;
+    }
+
+    /** @return the stored byte count, refreshing the cached producer position only if the
+     * last known one does not allow to read 'wanted' bytes. Consumer side only. */
+    std::size_t getConsumerAvailability(std::size_t wanted)
+    {
+        std::size_t consumerPosition = mConsumerPosition.load(std::memory_order_relaxed);
+        std::size_t available = mCachedProducerPosition - consumerPosition;
+        if (available < wanted) {
+            mCachedProducerPosition = mProducerPosition.load();
+            available = mCachedProducerPosition - consumerPosition;
+        }
+        ASSERT_ALWAYS(available <= mBuffer.size());
+        return available;
+    }
+
+    /** Write bytes to the ring buffer.
+     *
+     * @param[in,out] source The source buffer pointer. Will be incremented according to the
+     *                written byte count.
+     * @param[in] count the byte amount to write, must be available
+     */
+    void produce(const Byte *&source, std::size_t count)
+    {
+        if (count == 0) {
+            return;
+        }
+        std::size_t producerPosition = mProducerPosition.load(std::memory_order_relaxed);
+        WriteSpan(mBuffer.data(), mBuffer.size(), producerPosition % mBuffer.size(), count)
+            .copyFrom(source, count);
+        source += count;
+
+        publishProducerPosition(producerPosition + count);
+    }
+
+    /** Read bytes from the ring buffer.
+     *
+     * @param[in,out] dest The destination buffer pointer. Will be incremented according to the
+     *                read byte count.
+     * @param[in] count the byte amount to read, must be available
+     */
+    void consume(Byte *&dest, std::size_t count)
+    {
+        if (count == 0) {
+            return;
+        }
+        std::size_t consumerPosition = mConsumerPosition.load(std::memory_order_relaxed);
+        ReadSpan(mBuffer.data(), mBuffer.size(), consumerPosition % mBuffer.size(), count)
+            .copyTo(MAKE_ARRAY_ITERATOR(dest, count), count);
+        dest += count;
+
+        publishConsumerPosition(consumerPosition + count);
+    }
+
+    void publishProducerPosition(std::size_t position)
+    {
+        // Sequentially consistent with waitForConsumption(): either the consumer sees the new
+        // position or this thread sees that the consumer is waiting.
+        mProducerPosition.store(position);
+        if (mConsumerWaiting) {
+            std::lock_guard<std::mutex> locker(mWaitLock);
+            // The consumer announces itself again if it has to wait more
+            mConsumerWaiting = false;
+            mConsumerVar.notify_one();
+        }
+    }
+
+    void publishConsumerPosition(std::size_t position)
+    {
+        // Sequentially consistent with waitForProduction()
+        mConsumerPosition.store(position);
+        if (mProducerWaiting) {
+            std::lock_guard<std::mutex> locker(mWaitLock);
+            mProducerWaiting = false;
+            mProducerVar.notify_one();
+        }
+    }
+
+    /** Block until some free space is available or the buffer is closed */
+    void waitForProduction()
+    {
+        std::unique_lock<std::mutex> locker(mWaitLock);
+        while (true) {
+            mProducerWaiting = true;
+            if (!mOpen || getProducerAvailability(1) != 0) {
+                break;
+            }
+            mProducerVar.wait(locker);
+        }
+        mProducerWaiting = false;
+    }
+
+    /** Block until some data is available or the buffer is closed */
+    void waitForConsumption()
+    {
+        std::unique_lock<std::mutex> locker(mWaitLock);
+        while (true) {
+            mConsumerWaiting = true;
+            if (!mOpen || getConsumerAvailability(1) != 0) {
+                break;
+            }
+            mConsumerVar.wait(locker);
+        }
+        mConsumerWaiting = false;
+    }
+
+    /** The buffer is closed for the consumer when it is closed AND empty.
+     * This allows the consumer to retrieve data after buffer closing.
+     */
+    bool isClosedForConsumer() { return !mOpen && getConsumerAvailability(1) == 0; }
+
+    /* Producer side: written by the producer only, the position is read by the consumer */
+    std::atomic<std::size_t> mProducerPosition{0};
+    std::size_t mCachedConsumerPosition = 0;
+    Byte mProducerPadding[mCacheLineSize];
+
+    /* Consumer side: written by the consumer only, the position is read by the producer */
+    std::atomic<std::size_t> mConsumerPosition{0};
+    std::size_t mCachedProducerPosition = 0;
+    Byte mConsumerPadding[mCacheLineSize];
+
+    /* Rarely written members, read by both sides */
+    std::atomic<bool> mOpen{false};
+    std::atomic<bool> mProducerWaiting{false};
+    std::atomic<bool> mConsumerWaiting{false};
+    Buffer mBuffer;
+
+    std::mutex mWaitLock;
+    std::condition_variable mConsumerVar;
+    std::condition_variable mProducerVar;
+};
+}
+}
@@ -65,6 +65,15 @@ public:
      *         stream is reached.
      * @throw InputStream::Exception */
     virtual std::size_t read(StreamByte *dest, std::size_t byteCount) = 0;
+
+    /**
+     * Get the count of bytes left in the stream, if the stream is able to tell it. For instance
+     * it allows to check a size read from the stream before allocating memory.
+     *
+     * @param[out] remainingSize the count of bytes left in the stream
+     * @return false if the stream size is unknown, which is the default.
+     */
+    virtual bool getRemainingSize(std::size_t & /*remainingSize*/) const { return false; }
 };
 
 /** Base output stream class */
@@ -66,6 +66,9 @@ public:
     /** Default initialization is needed for deserialization. */
     explicit WrappedRaw() : mValue{} {}
 
+    /** Serialized as the raw value memory representation, if it is the case of the raw type */
+    static const bool hasSerializableMemoryLayout = IsBulkSerializableType<RawType>::value;
+
     bool operator==(const WrappedRaw left) const { return mValue == left.mValue; }
     bool operator<(const WrappedRaw left) const { return mValue < left.mValue; }
 
@@ -30,6 +30,8 @@
 #include "Util/BlockingQueue.hpp"
 #include <catch.hpp>
 #include <future>
+#include <chrono>
+#include <thread>
 
 using namespace debug_agent::util;
 
@@ -104,6 +106,110 @@ TEST_CASE("blocking queue: dropping")
     CHECK(queue.getMemorySize() == 10);
 }
 
+TEST_CASE("blocking queue: statistics")
+{
+    TestQueue queue(10, &sizeTest);
+
+    queue.open();
+
+    CHECK(queue.add(makeTest(4)));
+    CHECK(queue.add(makeTest(5)));
+    CHECK(queue.remove()->mSize == 4);
+    CHECK(queue.add(makeTest(3)));
+
+    /* Dropped by the default reject newest policy */
+    CHECK_FALSE(queue.add(makeTest(3)));
+    CHECK_FALSE(queue.add(makeTest(11)));
+
+    /* Not accounted as dropped since the queue is closed */
+    queue.close();
+    CHECK_FALSE(queue.add(makeTest(1)));
+
+    QueueStatistics statistics = queue.getStatistics();
+    CHECK(statistics.maxByteSize == 10);
+    CHECK(statistics.droppedElementCount == 2);
+    CHECK(statistics.droppedByteCount == 14);
+    CHECK(statistics.highWaterMark == 9);
+}
+
+TEST_CASE("blocking queue: drop oldest overflow policy")
+{
+    TestQueue queue(10, &sizeTest, QueueOverflowPolicy::DropOldest);
+
+    queue.open();
+
+    CHECK(queue.add(makeTest(2)));
+    CHECK(queue.add(makeTest(5)));
+    CHECK(queue.add(makeTest(3)));
+
+    /* The 2 and 5 bytes elements are dropped to make room for the new one */
+    CHECK(queue.add(makeTest(6)));
+    CHECK(queue.getElementCount() == 2);
+    CHECK(queue.getMemorySize() == 9);
+
+    /* An element bigger than the queue is dropped without affecting the queue content */
+    CHECK_FALSE(queue.add(makeTest(11)));
+    CHECK(queue.getElementCount() == 2);
+
+    QueueStatistics statistics = queue.getStatistics();
+    CHECK(statistics.droppedElementCount == 3);
+    CHECK(statistics.droppedByteCount == 18);
+    CHECK(statistics.highWaterMark == 10);
+
+    CHECK(queue.remove()->mSize == 3);
+    CHECK(queue.remove()->mSize == 6);
+}
+
+TEST_CASE("blocking queue: block producer overflow policy")
+{
+    TestQueue queue(10, &sizeTest, QueueOverflowPolicy::BlockProducer,
+                    std::chrono::milliseconds(20));
+
+    queue.open();
+
+    CHECK(queue.add(makeTest(8)));
+
+    /* No consumer: the producer is dropped after the timeout */
+    CHECK_FALSE(queue.add(makeTest(5)));
+    CHECK(queue.getStatistics().droppedElementCount == 1);
+    CHECK(queue.getStatistics().droppedByteCount == 5);
+
+    SECTION ("Unblocked by a consumer") {
+        TestQueue consumedQueue(10, &sizeTest, QueueOverflowPolicy::BlockProducer,
+                                std::chrono::milliseconds(10000));
+        consumedQueue.open();
+        CHECK(consumedQueue.add(makeTest(8)));
+
+        std::future<bool> result(std::async(std::launch::async, [&]() {
+            /* Blocked until the first element is removed */
+            return consumedQueue.add(makeTest(5));
+        }));
+
+        TestPtr element(consumedQueue.remove());
+        REQUIRE(element != nullptr);
+        CHECK(element->mSize == 8);
+
+        CHECK(result.get());
+        CHECK(consumedQueue.getElementCount() == 1);
+        CHECK(consumedQueue.getStatistics().droppedElementCount == 0);
+    }
+
+    SECTION ("Unblocked by closing") {
+        TestQueue closedQueue(10, &sizeTest, QueueOverflowPolicy::BlockProducer,
+                              std::chrono::milliseconds(10000));
+        closedQueue.open();
+        CHECK(closedQueue.add(makeTest(8)));
+
+        std::future<bool> result(
+            std::async(std::launch::async, [&]() { return closedQueue.add(makeTest(5)); }));
+
+        closedQueue.close();
+
+        CHECK_FALSE(result.get());
+        CHECK(closedQueue.getStatistics().droppedElementCount == 0);
+    }
+}
+
 TEST_CASE("blocking queue: clearing")
 {
     TestQueue queue(10, &sizeTest);
@@ -175,6 +281,122 @@ TEST_CASE("blocking queue: multi theading usage")
     CHECK(futureResult.get());
 }
 
+TEST_CASE("blocking queue: removing several elements")
+{
+    TestQueue queue(20, &sizeTest);
+
+    queue.open();
+
+    CHECK(queue.add(makeTest(2)));
+    CHECK(queue.add(makeTest(5)));
+    CHECK(queue.add(makeTest(3)));
+    CHECK(queue.add(makeTest(8)));
+
+    // removing up to 8 bytes: the 4th element does not fit
+    auto elements = queue.removeUpTo(8, 10);
+    REQUIRE(elements.size() == 2);
+    CHECK(elements[0]->mSize == 2);
+    CHECK(elements[1]->mSize == 5);
+    CHECK(queue.getMemorySize() == 11);
+
+    // the first element is always returned, even if it exceeds the byte size
+    elements = queue.removeUpTo(1, 10);
+    REQUIRE(elements.size() == 1);
+    CHECK(elements[0]->mSize == 3);
+
+    // the element count is limited too
+    CHECK(queue.add(makeTest(1)));
+    CHECK(queue.add(makeTest(1)));
+    elements = queue.removeUpTo(20, 2);
+    REQUIRE(elements.size() == 2);
+    CHECK(elements[0]->mSize == 8);
+    CHECK(elements[1]->mSize == 1);
+
+    // removing all the remaining elements
+    CHECK(queue.add(makeTest(4)));
+    queue.close();
+    elements = queue.removeAll();
+    REQUIRE(elements.size() == 2);
+    CHECK(elements[0]->mSize == 1);
+    CHECK(elements[1]->mSize == 4);
+    CHECK(queue.getElementCount() == 0);
+    CHECK(queue.getMemorySize() == 0);
+
+    // removing again: queue is closed (returns an empty collection)
+    CHECK(queue.removeAll().empty());
+    CHECK(queue.removeUpTo(20, 10).empty());
+}
+
+TEST_CASE("blocking queue: removing several elements from multiple threads")
+{
+    TestQueue queue(10, &sizeTest);
+
+    queue.open();
+
+    /* Performing add in another thread, retrying when the queue is full */
+    std::future<bool> futureResult(std::async(std::launch::async, [&]() {
+        for (std::size_t i = 1; i <= 100; ++i) {
+            while (!queue.add(makeTest(i % 3 + 1))) {
+                if (!queue.isOpen()) {
+                    return false;
+                }
+                std::this_thread::yield();
+            }
+        }
+        queue.close();
+        return true;
+    }));
+
+    /* Consuming elements in the current thread */
+    std::size_t count = 0;
+    while (true) {
+        auto elements = queue.removeUpTo(4, 3);
+        if (elements.empty()) {
+            break;
+        }
+        CHECK(elements.size() <= 3);
+        for (auto &element : elements) {
+            ++count;
+            CHECK(element->mSize == count % 3 + 1);
+        }
+    }
+    CHECK(count == 100);
+
+    /* Checking that adding elements is successful */
+    CHECK(futureResult.get());
+}
+
+TEST_CASE("blocking queue: removing with a timeout")
+{
+    TestQueue queue(10, &sizeTest);
+
+    queue.open();
+
+    // empty queue: the timeout expires
+    CHECK(queue.removeFor(std::chrono::milliseconds(10)) == nullptr);
+    CHECK(queue.isOpen());
+
+    // an element is available
+    CHECK(queue.add(makeTest(2)));
+    auto element = queue.removeFor(std::chrono::milliseconds(10));
+    REQUIRE(element != nullptr);
+    CHECK(element->mSize == 2);
+
+    /* Adding an element in another thread while waiting */
+    std::future<bool> futureResult(
+        std::async(std::launch::async, [&]() { return queue.add(makeTest(3)); }));
+    element = queue.removeFor(std::chrono::seconds(10));
+    REQUIRE(element != nullptr);
+    CHECK(element->mSize == 3);
+    CHECK(futureResult.get());
+
+    /* Closing in another thread while waiting */
+    std::future<void> result(std::async(std::launch::async, [&]() { queue.close(); }));
+    CHECK(queue.removeFor(std::chrono::seconds(10)) == nullptr);
+    result.get();
+    CHECK_FALSE(queue.isOpen());
+}
+
 TEST_CASE("blocking queue: opening/closing two times")
 {
     TestQueue queue(5, &sizeTest);
@@ -242,3 +464,21 @@ TEST_CASE("blocking queue: auto open close")
     // should be closed
     CHECK_FALSE(queue.isOpen());
 }
+
+/** A recycler other than the default one */
+struct DiscardingRecycler
+{
+    void operator()(TestPtr) const {}
+};
+
+TEST_CASE("blocking queue: auto open close with a recycler")
+{
+    using RecyclingQueue = BlockingQueue<Test, DiscardingRecycler>;
+    RecyclingQueue queue(5, &sizeTest);
+
+    {
+        RecyclingQueue::AutoOpenClose closer(queue);
+        CHECK(queue.isOpen());
+    }
+    CHECK_FALSE(queue.isOpen());
+}
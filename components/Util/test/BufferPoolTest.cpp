@@ -0,0 +1,265 @@
+/*
+ * Copyright (c) 2016, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "Util/BufferPool.hpp"
+#include "Util/BlockingQueue.hpp"
+#include <catch.hpp>
+#include <chrono>
+#include <future>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+
+using namespace debug_agent::util;
+
+static const std::size_t maxCachedByteSize = 1024 * 1024;
+
+using PooledQueue = BlockingQueue<Buffer, PoolRecycler<Buffer>>;
+
+static std::size_t getBufferSize(const Buffer &buffer)
+{
+    return buffer.size();
+}
+
+TEST_CASE("BufferPool: reusing a released buffer")
+{
+    ByteBufferPool pool(maxCachedByteSize);
+
+    auto buffer = pool.acquire(100);
+    REQUIRE(buffer != nullptr);
+    CHECK(buffer->empty());
+    /* Capacity of the matching size class */
+    CHECK(buffer->capacity() == 128);
+
+    buffer->resize(100, 0xA5);
+    auto data = buffer->data();
+    pool.release(std::move(buffer));
+
+    /* The released buffer serves the requests of its size class */
+    auto reused = pool.acquire(65);
+    CHECK(reused->data() == data);
+    CHECK(reused->empty());
+    CHECK(reused->capacity() == 128);
+
+    /* But not the requests of the other size classes */
+    auto other = pool.acquire(129);
+    CHECK(other->data() != data);
+    CHECK(other->capacity() == 256);
+
+    BufferPoolStatistics statistics = pool.getStatistics();
+    CHECK(statistics.allocationCount == 2);
+    CHECK(statistics.reuseCount == 1);
+    CHECK(statistics.discardCount == 0);
+}
+
+TEST_CASE("BufferPool: pooled pointers")
+{
+    ByteBufferPool pool(maxCachedByteSize);
+
+    const Buffer::value_type *data = nullptr;
+    try {
+        auto buffer = pool.acquirePooled(100);
+        CHECK(buffer->empty());
+        buffer->resize(100);
+        data = buffer->data();
+        throw std::runtime_error("failure");
+    } catch (std::runtime_error &) {
+    }
+
+    /* The buffer has been given back during the stack unwinding */
+    auto reused = pool.acquirePooled(100);
+    CHECK(reused->data() == data);
+    CHECK(reused->empty());
+
+    BufferPoolStatistics statistics = pool.getStatistics();
+    CHECK(statistics.allocationCount == 1);
+    CHECK(statistics.reuseCount == 1);
+}
+
+TEST_CASE("BufferPool: buffers out of the size classes are not pooled")
+{
+    ByteBufferPool pool(maxCachedByteSize);
+
+    /* Bigger than the biggest size class */
+    auto big = pool.acquire(4 * 1024 * 1024);
+    CHECK(big->capacity() >= 4 * 1024 * 1024);
+    pool.release(std::move(big));
+
+    /* Smaller than the smallest size class */
+    auto tiny = std::make_unique<Buffer>(1);
+    tiny->shrink_to_fit();
+    pool.release(std::move(tiny));
+
+    CHECK(pool.acquire(4 * 1024 * 1024) != nullptr);
+
+    BufferPoolStatistics statistics = pool.getStatistics();
+    CHECK(statistics.allocationCount == 2);
+    CHECK(statistics.reuseCount == 0);
+    CHECK(statistics.discardCount == 2);
+}
+
+TEST_CASE("BufferPool: depot capacity")
+{
+    /* With a 2 KiB size class, a magazine holds 32 buffers, and a thread cache holds up to 2
+     * magazines before moving one of them to the depot. */
+    static const std::size_t bufferSize = 2048;
+    static const std::size_t magazineCount = 32;
+
+    /* The depot is able to keep one buffer only */
+    ByteBufferPool pool(bufferSize);
+
+    std::vector<std::unique_ptr<Buffer>> buffers;
+    for (std::size_t i = 0; i < 2 * magazineCount; ++i) {
+        buffers.push_back(pool.acquire(bufferSize));
+    }
+    pool.release(buffers);
+    CHECK(buffers.empty());
+
+    BufferPoolStatistics statistics = pool.getStatistics();
+    CHECK(statistics.allocationCount == 2 * magazineCount);
+    CHECK(statistics.discardCount == magazineCount - 1);
+}
+
+TEST_CASE("BufferPool: buffers released by another thread")
+{
+    static const std::size_t bufferCount = 4 * 32;
+    static const std::size_t bufferSize = 2048;
+    ByteBufferPool pool(maxCachedByteSize);
+
+    std::vector<std::unique_ptr<Buffer>> buffers;
+    for (std::size_t i = 0; i < bufferCount; ++i) {
+        buffers.push_back(pool.acquire(bufferSize));
+    }
+
+    /* The thread cache of the releasing thread moves them to the depot by magazines */
+    std::async(std::launch::async, [&] { pool.release(buffers); }).get();
+
+    for (std::size_t i = 0; i < bufferCount; ++i) {
+        buffers.push_back(pool.acquire(bufferSize));
+    }
+
+    BufferPoolStatistics statistics = pool.getStatistics();
+    CHECK(statistics.allocationCount + statistics.reuseCount == 2 * bufferCount);
+    /* Only the last magazine is still in the cache of the releasing thread */
+    CHECK(statistics.reuseCount == bufferCount - 32);
+}
+
+TEST_CASE("BufferPool: blocking queue recycling")
+{
+    ByteBufferPool pool(maxCachedByteSize);
+    PooledQueue queue(100, &getBufferSize);
+    queue.setRecycler(PoolRecycler<Buffer>(pool));
+    queue.open();
+
+    auto buffer = pool.acquire(100);
+    buffer->resize(100);
+    CHECK(queue.add(std::move(buffer)));
+
+    /* Dropped and cleared buffers are given back to the pool */
+    buffer = pool.acquire(100);
+    buffer->resize(100);
+    CHECK_FALSE(queue.add(std::move(buffer)));
+    queue.clear();
+
+    CHECK(pool.acquire(100) != nullptr);
+    CHECK(pool.acquire(100) != nullptr);
+
+    BufferPoolStatistics statistics = pool.getStatistics();
+    CHECK(statistics.allocationCount == 2);
+    CHECK(statistics.reuseCount == 2);
+}
+
+/** Streams 'bufferCount' buffers through a blocking queue, from a producer thread to the calling
+ * thread, the buffers being pooled or not
+ * @return the buffer allocation count */
+static std::size_t streamBuffers(std::size_t bufferCount, std::size_t bufferSize, bool pooled,
+                                 std::chrono::duration<double> &duration)
+{
+    /* The depot is able to keep all the buffers of a full queue */
+    ByteBufferPool pool(maxCachedByteSize + 64 * bufferSize);
+    PooledQueue queue(64 * bufferSize, &getBufferSize, QueueOverflowPolicy::BlockProducer,
+                      std::chrono::milliseconds(10000));
+    queue.setRecycler(PoolRecycler<Buffer>(pool));
+    queue.open();
+
+    auto start = std::chrono::steady_clock::now();
+    auto future = std::async(std::launch::async, [&] {
+        for (std::size_t i = 0; i < bufferCount; ++i) {
+            auto buffer = pooled ? pool.acquire(bufferSize) : std::make_unique<Buffer>();
+            buffer->resize(bufferSize);
+            if (!queue.add(std::move(buffer))) {
+                throw std::runtime_error("add: expected true as returned value");
+            }
+        }
+        queue.close();
+    });
+
+    while (true) {
+        auto buffers = queue.removeUpTo(16 * bufferSize, std::numeric_limits<std::size_t>::max());
+        if (buffers.empty()) {
+            break;
+        }
+        if (pooled) {
+            pool.release(buffers);
+        }
+    }
+    future.get();
+    duration = std::chrono::steady_clock::now() - start;
+
+    return pooled ? pool.getStatistics().allocationCount : bufferCount;
+}
+
+TEST_CASE("BufferPool: steady streaming does not allocate")
+{
+    static const std::size_t bufferCount = 10000;
+    std::chrono::duration<double> duration;
+
+    std::size_t allocationCount = streamBuffers(bufferCount, 2048, true, duration);
+
+    /* Buffers are only allocated while filling the queue and the caches */
+    CHECK(allocationCount < bufferCount / 10);
+}
+
+TEST_CASE("BufferPool: streaming benchmark", "[.][benchmark]")
+{
+    static const std::size_t bufferCount = 1000000;
+
+    std::cout << "Streaming " << bufferCount << " buffers through a blocking queue\n";
+    for (std::size_t bufferSize : {256, 2048, 16384}) {
+        std::chrono::duration<double> allocatedDuration;
+        std::chrono::duration<double> pooledDuration;
+        streamBuffers(bufferCount, bufferSize, false, allocatedDuration);
+        std::size_t allocationCount = streamBuffers(bufferCount, bufferSize, true, pooledDuration);
+
+        std::cout << "buffer size " << bufferSize << ": allocated "
+                  << bufferCount / allocatedDuration.count() << " buffers/s, pooled "
+                  << bufferCount / pooledDuration.count() << " buffers/s with " << allocationCount
+                  << " allocations\n";
+    }
+}
@@ -30,6 +30,8 @@
 #include "Util/ByteStreamReader.hpp"
 #include "Util/ByteStreamWriter.hpp"
 #include <array>
+#include <chrono>
+#include <iostream>
 #include <type_traits>
 #include <catch.hpp>
 
@@ -94,6 +96,36 @@ TEST_CASE("Byte stream writer")
     CHECK(writer.getBuffer() == expectedBuffer);
 }
 
+TEST_CASE("Byte stream writer : caller-owned buffer")
+{
+    Buffer scratch{9, 9};
+
+    SECTION ("The buffer is cleared and the capacity hint is reserved") {
+        BufferByteStreamWriter writer(scratch, 128);
+        CHECK(scratch.empty());
+        CHECK(scratch.capacity() >= 128);
+
+        writer.write(static_cast<uint8_t>(1));
+        writer.write(static_cast<uint32_t>(2));
+        CHECK(&writer.getBuffer() == &scratch);
+        CHECK((scratch == Buffer{1, 2, 0, 0, 0}));
+    }
+
+    SECTION ("The buffer is reused without reallocation") {
+        const uint8_t *storage = nullptr;
+        for (uint32_t i = 0; i < 4; ++i) {
+            BufferByteStreamWriter writer(scratch);
+            writer.write(i);
+            writer.writeVector<uint32_t>(std::vector<uint32_t>(16, i));
+            CHECK(scratch.size() == 4 + 4 + 16 * 4);
+            if (i == 0) {
+                storage = scratch.data();
+            }
+            CHECK(scratch.data() == storage);
+        }
+    }
+}
+
 TEST_CASE("Byte stream reader")
 {
     MemoryByteStreamReader reader(expectedBuffer);
@@ -129,6 +161,121 @@ TEST_CASE("Byte stream reader : end of stream")
     CHECK(reader.isEOS());
 }
 
+/** Input stream that does not tell its size, as a socket stream */
+class UnknownSizeInputStream : public InputStream
+{
+public:
+    UnknownSizeInputStream(const Buffer &buffer) : mInput(buffer) {}
+
+    std::size_t read(StreamByte *dest, std::size_t byteCount) override
+    {
+        return mInput.read(dest, byteCount);
+    }
+
+private:
+    MemoryInputStream mInput;
+};
+
+TEST_CASE("Byte stream reader : views")
+{
+    const Buffer buffer = {
+        3, 0, 0, 0, // view size
+        1, 2, 3,    // view content
+        4, 0, 0, 0, // too big view size
+        5, 6,       // remaining bytes
+    };
+    BufferViewByteStreamReader reader(buffer);
+
+    uint32_t size;
+    reader.read(size);
+    BufferView view = reader.readView(size);
+    CHECK(view.data() == buffer.data() + sizeof(size));
+    CHECK(Buffer(view.begin(), view.end()) == Buffer({1, 2, 3}));
+
+    reader.read(size);
+    CHECK_THROWS_AS(reader.readView(size), ByteStreamReader::EOSException);
+    CHECK(reader.isEOS());
+}
+
+TEST_CASE("Byte stream reader : vectors of simple types")
+{
+    /* Bigger than the chunks used to read from streams of unknown size */
+    std::vector<uint16_t> values(100000);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        values[i] = static_cast<uint16_t>(i);
+    }
+    std::vector<bool> flags{true, false, true};
+
+    MemoryByteStreamWriter writer;
+    writer.writeVector<uint32_t>(values);
+    writer.writeVector<uint8_t>(flags);
+    CHECK(writer.getBuffer().size() ==
+          sizeof(uint32_t) + values.size() * sizeof(uint16_t) + sizeof(uint8_t) + flags.size());
+
+    WHEN ("Reading from a stream of known size") {
+        MemoryByteStreamReader reader(writer.getBuffer());
+
+        /* Elements are appended */
+        std::vector<uint16_t> readValues{42};
+        reader.readVector<uint32_t>(readValues);
+        REQUIRE(readValues.size() == values.size() + 1);
+        CHECK(readValues.front() == 42);
+        CHECK(std::equal(values.begin(), values.end(), readValues.begin() + 1));
+
+        std::vector<bool> readFlags;
+        reader.readVector<uint8_t>(readFlags);
+        CHECK(readFlags == flags);
+        CHECK(reader.isEOS());
+    }
+    WHEN ("Reading from a stream of unknown size") {
+        UnknownSizeInputStream input(writer.getBuffer());
+        ByteStreamReader reader(input);
+
+        std::vector<uint16_t> readValues;
+        reader.readVector<uint32_t>(readValues);
+        CHECK(readValues == values);
+
+        std::vector<bool> readFlags;
+        reader.readVector<uint8_t>(readFlags);
+        CHECK(readFlags == flags);
+    }
+}
+
+TEST_CASE("Byte stream reader : erroneous vector size")
+{
+    /* The size announces much more elements than the stream contains */
+    const Buffer buffer = {
+        0xFF, 0xFF, 0xFF, 0x7F, // array size
+        1,    0,    0,    0,    // #0 array element
+        2,    0,    0,    0,    // #1 array element
+    };
+
+    WHEN ("Reading from a stream of known size") {
+        MemoryByteStreamReader reader(buffer);
+
+        /* The size is checked before allocating the vector */
+        std::vector<uint32_t> values;
+        CHECK_THROWS_AS(reader.readVector<uint32_t>(values),
+                        MemoryByteStreamReader::EOSException);
+        CHECK(values.empty());
+    }
+    WHEN ("Reading from a stream of unknown size") {
+        UnknownSizeInputStream input(buffer);
+        ByteStreamReader reader(input);
+
+        std::vector<uint32_t> values;
+        CHECK_THROWS_AS(reader.readVector<uint32_t>(values), ByteStreamReader::EOSException);
+    }
+    WHEN ("Reading compound elements") {
+        MemoryByteStreamReader reader(buffer);
+
+        std::vector<TestStruct> structs;
+        CHECK_THROWS_AS(reader.readVector<uint32_t>(structs),
+                        MemoryByteStreamReader::EOSException);
+        CHECK(structs == std::vector<TestStruct>({{1, 2}}));
+    }
+}
+
 TEST_CASE("Byte stream reader : enums")
 {
     enum class Enum8 : uint8_t
@@ -176,6 +323,71 @@ TEST_CASE("Byte stream reader : enums")
     CHECK(enum32Value == Enum32::val3);
 }
 
+/** Output stream that counts its write calls, i.e. the performed memory copies */
+class WriteCountingOutputStream : public OutputStream
+{
+public:
+    void write(const StreamByte *src, std::size_t byteCount) override
+    {
+        mBuffer.insert(mBuffer.end(), src, src + byteCount);
+        ++mWriteCount;
+    }
+
+    Buffer mBuffer;
+    std::size_t mWriteCount = 0;
+};
+
+TEST_CASE("Byte stream reader : vectors of enums")
+{
+    enum class Enum8 : uint8_t
+    {
+        val1,
+        val2
+    };
+    enum class Enum32 : uint32_t
+    {
+        val1,
+        val2,
+        val3
+    };
+
+    /* Only the enums whose memory representation is their encoding are copied at once */
+    CHECK_FALSE(IsBulkSerializableType<Enum8>::value);
+    CHECK(IsBulkSerializableType<Enum32>::value);
+    CHECK(IsBulkSerializableType<std::array<Enum32, 2>>::value);
+
+    const std::vector<Enum8> values8{Enum8::val2, Enum8::val1};
+    const std::vector<Enum32> values32{Enum32::val3, Enum32::val1, Enum32::val2};
+
+    WriteCountingOutputStream output;
+    ByteStreamWriter writer(output);
+    writer.writeVector<uint32_t>(values8);
+    CHECK(output.mWriteCount == 1 + values8.size());
+    writer.writeVector<uint32_t>(values32);
+    CHECK(output.mWriteCount == 1 + values8.size() + 2);
+
+    /* The encoding is the same as element by element */
+    MemoryByteStreamWriter elementWriter;
+    elementWriter.write(static_cast<uint32_t>(values8.size()));
+    for (auto value : values8) {
+        elementWriter.write(value);
+    }
+    elementWriter.write(static_cast<uint32_t>(values32.size()));
+    for (auto value : values32) {
+        elementWriter.write(value);
+    }
+    CHECK(output.mBuffer == elementWriter.getBuffer());
+
+    MemoryByteStreamReader reader(output.mBuffer);
+    std::vector<Enum8> read8;
+    std::vector<Enum32> read32;
+    reader.readVector<uint32_t>(read8);
+    reader.readVector<uint32_t>(read32);
+    CHECK(read8 == values8);
+    CHECK(read32 == values32);
+    CHECK(reader.isEOS());
+}
+
 TEST_CASE("Byte Stream reader/writer: arrays")
 {
     uint8_t simpleArray[5] = {1, 2, 3, 4, 5};
@@ -233,3 +445,58 @@ TEST_CASE("Byte Stream reader/writer: arrays")
     reader.read(back);
     CHECK(back == stdArray);
 }
+
+/** Reads 'count' elements one by one, as readVector() did before using memory copies */
+template <typename T>
+static void readElementByElement(ByteStreamReader &reader, std::vector<T> &vector)
+{
+    uint32_t count;
+    reader.read(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        T element;
+        reader.read(element);
+        vector.push_back(element);
+    }
+}
+
+/** Measures the decoding of a vector of 'count' elements, 'iterations' times */
+template <typename T>
+static void measureVectorReading(const std::string &name, std::size_t count,
+                                 std::size_t iterations)
+{
+    MemoryByteStreamWriter writer;
+    writer.writeVector<uint32_t>(std::vector<T>(count, 0x5A));
+
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; ++i) {
+        MemoryByteStreamReader reader(writer.getBuffer());
+        std::vector<T> vector;
+        readElementByElement(reader, vector);
+    }
+    std::chrono::duration<double> elementDuration = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; ++i) {
+        MemoryByteStreamReader reader(writer.getBuffer());
+        std::vector<T> vector;
+        reader.readVector<uint32_t>(vector);
+    }
+    std::chrono::duration<double> bulkDuration = std::chrono::steady_clock::now() - start;
+
+    std::cout << name << " (" << count << " elements): element by element "
+              << elementDuration.count() * 1e9 / iterations << " ns, bulk "
+              << bulkDuration.count() * 1e9 / iterations << " ns\n";
+}
+
+TEST_CASE("Byte stream reader : vector benchmark", "[.][benchmark]")
+{
+    /* Pipeline id list of a typical topology */
+    measureVectorReading<uint32_t>("pipeline ids", 16, 1000000);
+    /* Module instance ids of a scheduler task */
+    measureVectorReading<uint16_t>("module instance ids", 64, 1000000);
+    /* Probe packet payloads */
+    measureVectorReading<uint8_t>("probe payload", 4096, 100000);
+    measureVectorReading<uint8_t>("probe payload", 65536, 10000);
+    /* Memory page allocation map */
+    measureVectorReading<uint32_t>("page allocation", 1024, 100000);
+}
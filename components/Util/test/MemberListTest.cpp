@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2016, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "Util/MemberList.hpp"
+#include <catch.hpp>
+
+using namespace debug_agent::util;
+
+/* A 32 bits register serialized as its memory representation */
+union Register
+{
+    uint32_t value;
+    struct
+    {
+        uint32_t low : 16;
+        uint32_t high : 16;
+    } bits;
+
+    static const bool hasSerializableMemoryLayout = true;
+
+    bool operator==(const Register &other) const { return value == other.value; }
+
+    void fromStream(ByteStreamReader &reader) { reader.read(value); }
+    void toStream(ByteStreamWriter &writer) const { writer.write(value); }
+};
+
+enum class Color : uint8_t
+{
+    Red,
+    Green
+};
+
+/* A structure containing padding, an enum, a fixed array and a vector */
+struct Packed
+{
+    uint8_t a;
+    /* 3 bytes of padding */
+    uint32_t b;
+    Register c;
+    uint16_t d[2];
+    Color e;
+    uint32_t f;
+    std::vector<uint16_t> g;
+
+    using Members = MemberList<SERIALIZED_MEMBER(Packed, a), SERIALIZED_MEMBER(Packed, b),
+                               SERIALIZED_MEMBER(Packed, c), SERIALIZED_MEMBER(Packed, d),
+                               SERIALIZED_MEMBER(Packed, e), SERIALIZED_MEMBER(Packed, f),
+                               SERIALIZED_VECTOR_MEMBER(uint32_t, Packed, g)>;
+
+    bool operator==(const Packed &other) const
+    {
+        return a == other.a && b == other.b && c == other.c && d[0] == other.d[0] &&
+               d[1] == other.d[1] && e == other.e && f == other.f && g == other.g;
+    }
+
+    void fromStream(ByteStreamReader &reader) { Members::fromStream(*this, reader); }
+    void toStream(ByteStreamWriter &writer) const { Members::toStream(*this, writer); }
+};
+
+static const Buffer packedBuffer = {
+    1,                      // a
+    2, 0, 0, 0,             // b
+    3, 0, 4, 0,             // c
+    5, 0, 6, 0,             // d
+    1, 0, 0, 0,             // e, encoded on 32 bits
+    7, 0, 0, 0,             // f
+    2, 0, 0, 0, 8, 0, 9, 0, // g
+};
+
+static Packed makePacked()
+{
+    Packed packed;
+    packed.a = 1;
+    packed.b = 2;
+    packed.c.bits.low = 3;
+    packed.c.bits.high = 4;
+    packed.d[0] = 5;
+    packed.d[1] = 6;
+    packed.e = Color::Green;
+    packed.f = 7;
+    packed.g = {8, 9};
+    return packed;
+}
+
+/* Counts the memory copies performed on a memory stream */
+class CountingInputStream : public InputStream
+{
+public:
+    CountingInputStream(const Buffer &buffer) : mInput(buffer) {}
+
+    std::size_t read(StreamByte *dest, std::size_t byteCount) override
+    {
+        ++readCount;
+        return mInput.read(dest, byteCount);
+    }
+
+    std::size_t readCount = 0;
+
+private:
+    MemoryInputStream mInput;
+};
+
+class CountingOutputStream : public OutputStream
+{
+public:
+    CountingOutputStream(Buffer &buffer) : mOutput(buffer) {}
+
+    void write(const StreamByte *src, std::size_t byteCount) override
+    {
+        ++writeCount;
+        mOutput.write(src, byteCount);
+    }
+
+    std::size_t writeCount = 0;
+
+private:
+    MemoryOutputStream mOutput;
+};
+
+TEST_CASE("Member list: serializable memory layouts")
+{
+    CHECK(IsBulkSerializableType<Register>::value);
+    CHECK(IsBulkSerializableType<Register[4]>::value);
+    CHECK(IsBulkSerializableType<uint16_t[2]>::value);
+    CHECK(IsBulkSerializableType<std::array<uint32_t, 3>>::value);
+    CHECK_FALSE(IsBulkSerializableType<bool>::value);
+    CHECK_FALSE(IsBulkSerializableType<Color>::value);
+    CHECK_FALSE(IsBulkSerializableType<Packed>::value);
+}
+
+TEST_CASE("Member list: serialization")
+{
+    SECTION ("Writing") {
+        Buffer buffer;
+        CountingOutputStream output(buffer);
+        ByteStreamWriter writer(output);
+        writer.write(makePacked());
+        CHECK(buffer == packedBuffer);
+
+        /* a, then b + c + d, then e, f, the vector size and the vector elements */
+        CHECK(output.writeCount == 6);
+    }
+
+    SECTION ("Reading") {
+        CountingInputStream input(packedBuffer);
+        ByteStreamReader reader(input);
+        Packed packed;
+        reader.read(packed);
+        CHECK(packed == makePacked());
+        CHECK(input.readCount == 6);
+    }
+
+    SECTION ("Reading a truncated stream") {
+        for (std::size_t size = 0; size < packedBuffer.size(); ++size) {
+            Buffer truncated(packedBuffer.begin(), packedBuffer.begin() + size);
+            MemoryByteStreamReader reader(truncated);
+            Packed packed;
+            CHECK_THROWS_AS(reader.read(packed), ByteStreamReader::EOSException);
+        }
+    }
+}
@@ -103,6 +103,33 @@ SCENARIO("MemoryInputStream")
     }
 }
 
+SCENARIO("BufferViewInputStream")
+{
+    Buffer source{0, 1, 2, 3, 4, 5};
+
+    GIVEN ("A view on the middle of a source buffer") {
+        BufferViewInputStream is(BufferView(source).subView(1, 4));
+        WHEN ("Reading a 3 bytes view") {
+            BufferView view = is.readView(3);
+            THEN ("The view points to the source buffer") {
+                CHECK(view.data() == source.data() + 1);
+                CHECK(view.size() == 3);
+                CHECK(is.getPointerOffset() == 3);
+                WHEN ("Reading 2 bytes more") {
+                    Buffer output(2);
+                    auto read = is.read(output.data(), output.size());
+                    THEN ("The last byte of the view is read") {
+                        CHECK(read == 1);
+                        CHECK(startsWith(output, {4}));
+                        CHECK(is.isEOS());
+                        CHECK(is.readView(1).empty());
+                    }
+                }
+            }
+        }
+    }
+}
+
 SCENARIO("MemoryOutputStream")
 {
     Buffer output;
@@ -130,3 +157,16 @@ SCENARIO("MemoryOutputStream")
         }
     }
 }
+
+SCENARIO("MemoryOutputStream capacity hint")
+{
+    Buffer output{0, 1};
+
+    WHEN ("Creating a stream with a capacity hint") {
+        MemoryOutputStream os(output, 64);
+        THEN ("The buffer is cleared and the capacity is reserved") {
+            CHECK(output.empty());
+            CHECK(output.capacity() >= 64);
+        }
+    }
+}
@@ -89,6 +89,66 @@ TEST_CASE("RingBuffer: non blocking")
     REQUIRE(buffer.getUsedSize() == 0);
 }
 
+TEST_CASE("RingBuffer: span access")
+{
+    RingBuffer buffer(5);
+
+    INFO("Nothing can be acquired for writing while the buffer is closed");
+    CHECK(buffer.acquireWrite(5).empty());
+
+    buffer.open();
+
+    INFO("Nothing can be acquired for reading while the buffer is empty");
+    CHECK(buffer.acquireRead(5).empty());
+
+    INFO("Producing 3 bytes in place");
+    auto writeSpan = buffer.acquireWrite(3);
+    REQUIRE(writeSpan.size() == 3);
+    CHECK(writeSpan.parts[1].size == 0);
+    std::array<uint8_t, 3> content{{0, 1, 2}};
+    writeSpan.copyFrom(content.data(), content.size());
+    buffer.commitWrite(3);
+    REQUIRE(buffer.getUsedSize() == 3);
+
+    INFO("Acquiring more than the free space gives the free space only");
+    CHECK(buffer.acquireWrite(10).size() == 2);
+
+    INFO("Reading the 3 bytes in place, committing them in two steps");
+    auto readSpan = buffer.acquireRead(10);
+    REQUIRE(readSpan.size() == 3);
+    Buffer out(3);
+    readSpan.copyTo(out.begin(), 3);
+    REQUIRE(out == (Buffer{0, 1, 2}));
+    buffer.commitRead(1);
+    buffer.commitRead(2);
+    REQUIRE(buffer.getUsedSize() == 0);
+
+    INFO("Acquiring a write span that wraps around the buffer end");
+    writeSpan = buffer.acquireWrite(4);
+    REQUIRE(writeSpan.size() == 4);
+    CHECK(writeSpan.parts[0].size == 2);
+    CHECK(writeSpan.parts[1].size == 2);
+    std::array<uint8_t, 4> wrapping{{3, 4, 5, 6}};
+    writeSpan.copyFrom(wrapping.data(), wrapping.size());
+    buffer.commitWrite(4);
+
+    INFO("The wrapped content is read in two parts");
+    readSpan = buffer.acquireRead(4);
+    REQUIRE(readSpan.parts[0].size == 2);
+    REQUIRE(readSpan.parts[1].size == 2);
+    CHECK(Buffer(readSpan.parts[0].data, readSpan.parts[0].data + 2) == (Buffer{3, 4}));
+    CHECK(Buffer(readSpan.parts[1].data, readSpan.parts[1].data + 2) == (Buffer{5, 6}));
+    buffer.commitRead(4);
+
+    INFO("Span access and copying access can be mixed");
+    REQUIRE(buffer.writeNonBlocking(ARR(2, 7, 8)) == 2);
+    readSpan = buffer.acquireRead(2);
+    readSpan.copyTo(out.begin(), 2);
+    REQUIRE(startsWith(out, Buffer{7, 8}));
+    buffer.commitRead(2);
+    REQUIRE(buffer.getUsedSize() == 0);
+}
+
 TEST_CASE("RingBuffer: blocking and multithreading")
 {
     RingBuffer buffer(5);
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2016, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Util/SharedSnapshot.hpp"
+#include <catch.hpp>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace debug_agent::util;
+
+TEST_CASE("SharedSnapshot: publishing replaces the current snapshot")
+{
+    SharedSnapshot<int> snapshot;
+    CHECK(snapshot.get() == nullptr);
+
+    auto first = std::make_shared<int>(1);
+    CHECK(snapshot.publish(first) == nullptr);
+    CHECK(snapshot.get() == first);
+
+    /* A reader keeps the snapshot it got, even once replaced */
+    auto held = snapshot.get();
+    CHECK(snapshot.publish(std::make_shared<int>(2)) == first);
+    CHECK(*held == 1);
+    CHECK(*snapshot.get() == 2);
+
+    CHECK(*snapshot.publish(nullptr) == 2);
+    CHECK(snapshot.get() == nullptr);
+}
+
+TEST_CASE("SharedSnapshot: readers always see a consistent snapshot")
+{
+    /* Each snapshot holds a sequence of equal values: a reader seeing different values would
+     * read a snapshot while it is written */
+    using Values = std::vector<std::size_t>;
+    static const std::size_t valueCount = 64;
+    static const std::size_t publishCount = 2000;
+
+    SharedSnapshot<const Values> snapshot(std::make_shared<const Values>(valueCount, 0));
+    std::atomic<bool> done(false);
+    std::atomic<std::size_t> inconsistentCount(0);
+
+    std::vector<std::thread> readers;
+    for (std::size_t reader = 0; reader < 4; ++reader) {
+        readers.emplace_back([&] {
+            std::size_t lastSeen = 0;
+            while (!done) {
+                auto values = snapshot.get();
+                for (std::size_t value : *values) {
+                    if (value != values->front() || value < lastSeen) {
+                        ++inconsistentCount;
+                    }
+                }
+                lastSeen = values->front();
+            }
+        });
+    }
+
+    for (std::size_t version = 1; version <= publishCount; ++version) {
+        snapshot.publish(std::make_shared<const Values>(valueCount, version));
+    }
+    done = true;
+    for (auto &reader : readers) {
+        reader.join();
+    }
+
+    CHECK(inconsistentCount == 0);
+    CHECK(snapshot.get()->front() == publishCount);
+}
@@ -0,0 +1,244 @@
+/*
+ * Copyright (c) 2016, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Util/SingleFlight.hpp"
+#include "TestCommon/TestHelpers.hpp"
+#include <catch.hpp>
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace debug_agent::util;
+
+using Flights = SingleFlight<int, std::string>;
+
+/** Wait until 'count' requests are waiting for an in-flight call */
+static void waitMerged(const Flights &flights, std::size_t count)
+{
+    while (flights.getStatistics().mergedCount < count) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+TEST_CASE("SingleFlight: sequential requests are not merged")
+{
+    Flights flights;
+    std::size_t callCount = 0;
+
+    for (int i = 0; i < 3; ++i) {
+        std::string value;
+        flights.run(1, value, [&](std::string &result) {
+            ++callCount;
+            result = "value" + std::to_string(callCount);
+        });
+        CHECK(value == "value" + std::to_string(i + 1));
+    }
+
+    CHECK(callCount == 3);
+    SingleFlightStatistics statistics = flights.getStatistics();
+    CHECK(statistics.callCount == 3);
+    CHECK(statistics.mergedCount == 0);
+}
+
+TEST_CASE("SingleFlight: concurrent identical requests are merged")
+{
+    static const std::size_t waiterCount = 4;
+    Flights flights;
+    std::promise<void> release;
+    std::shared_future<void> released(release.get_future());
+
+    auto leader = std::async(std::launch::async, [&] {
+        std::string value;
+        flights.run(1, value, [&](std::string &result) {
+            released.wait();
+            result = "shared";
+        });
+        return value;
+    });
+    /* Waiting for the leader call to be in flight */
+    while (flights.getStatistics().callCount == 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    std::vector<std::future<std::string>> waiters;
+    for (std::size_t i = 0; i < waiterCount; ++i) {
+        waiters.push_back(std::async(std::launch::async, [&] {
+            std::string value;
+            flights.run(1, value, [](std::string &) {
+                throw std::logic_error("Merged request performed a call");
+            });
+            return value;
+        }));
+    }
+    waitMerged(flights, waiterCount);
+
+    /* A request of another key is not merged */
+    std::string other;
+    flights.run(2, other, [](std::string &result) { result = "other"; });
+    CHECK(other == "other");
+
+    release.set_value();
+    CHECK(leader.get() == "shared");
+    for (auto &waiter : waiters) {
+        CHECK(waiter.get() == "shared");
+    }
+
+    SingleFlightStatistics statistics = flights.getStatistics();
+    CHECK(statistics.callCount == 2);
+    CHECK(statistics.mergedCount == waiterCount);
+}
+
+TEST_CASE("SingleFlight: the call exception is delivered to every merged request")
+{
+    Flights flights;
+    std::promise<void> release;
+    std::shared_future<void> released(release.get_future());
+
+    auto leader = std::async(std::launch::async, [&] {
+        std::string value;
+        flights.run(1, value, [&](std::string &) {
+            released.wait();
+            throw std::runtime_error("call failed");
+        });
+    });
+    while (flights.getStatistics().callCount == 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    auto waiter = std::async(std::launch::async, [&] {
+        std::string value;
+        flights.run(1, value, [](std::string &) {});
+    });
+    waitMerged(flights, 1);
+
+    release.set_value();
+    CHECK_THROWS_AS_MSG(leader.get(), std::runtime_error, "call failed");
+    CHECK_THROWS_AS_MSG(waiter.get(), std::runtime_error, "call failed");
+
+    /* The failure is not kept: the next request performs a new call */
+    std::string value;
+    flights.run(1, value, [](std::string &result) { result = "recovered"; });
+    CHECK(value == "recovered");
+}
+
+TEST_CASE("SingleFlight: forgotten calls are not joined")
+{
+    Flights flights;
+    std::promise<void> release;
+    std::shared_future<void> released(release.get_future());
+
+    auto leader = std::async(std::launch::async, [&] {
+        std::string value;
+        flights.run(1, value, [&](std::string &result) {
+            released.wait();
+            result = "stale";
+        });
+        return value;
+    });
+    while (flights.getStatistics().callCount == 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    flights.forget();
+
+    std::string value;
+    flights.run(1, value, [](std::string &result) { result = "fresh"; });
+    CHECK(value == "fresh");
+
+    release.set_value();
+    CHECK(leader.get() == "stale");
+
+    SingleFlightStatistics statistics = flights.getStatistics();
+    CHECK(statistics.callCount == 2);
+    CHECK(statistics.mergedCount == 0);
+}
+
+TEST_CASE("SingleFlight: merged requests share the context of the call")
+{
+    /** The lowest priority value of the merged requests */
+    struct Priority
+    {
+        int value = 100;
+    };
+    SingleFlight<int, std::string, Priority> flights;
+    std::promise<void> release;
+    std::shared_future<void> released(release.get_future());
+
+    auto leader = std::async(std::launch::async, [&] {
+        std::string value;
+        flights.run(1, value,
+                    [&](std::string &result, Priority &priority) {
+                        released.wait();
+                        result = std::to_string(priority.value);
+                    },
+                    [](Priority &) { throw std::logic_error("Leader request joined"); });
+        return value;
+    });
+    while (flights.getStatistics().callCount == 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    std::vector<std::future<std::string>> waiters;
+    for (int requestPriority : {7, 3, 5}) {
+        waiters.push_back(std::async(std::launch::async, [&flights, requestPriority] {
+            std::string value;
+            flights.run(1, value,
+                        [](std::string &, Priority &) {
+                            throw std::logic_error("Merged request performed a call");
+                        },
+                        [requestPriority](Priority &priority) {
+                            priority.value = std::min(priority.value, requestPriority);
+                        });
+            return value;
+        }));
+        while (flights.getStatistics().mergedCount < waiters.size()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    /* The call sees the joins performed while it was in flight */
+    release.set_value();
+    CHECK(leader.get() == "3");
+    for (auto &waiter : waiters) {
+        CHECK(waiter.get() == "3");
+    }
+
+    /* A new call starts with a new context */
+    std::string value;
+    flights.run(1, value,
+                [](std::string &result, Priority &priority) {
+                    result = std::to_string(priority.value);
+                },
+                [](Priority &) {});
+    CHECK(value == "100");
+}
@@ -0,0 +1,333 @@
+/*
+ * Copyright (c) 2016, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "Util/SpscRingBuffer.hpp"
+#include "Util/RingBuffer.hpp"
+#include "Util/AssertAlways.hpp"
+#include <catch.hpp>
+#include <future>
+#include <thread>
+#include <array>
+#include <chrono>
+#include <iostream>
+#include <algorithm>
+#include <stdexcept>
+
+using namespace debug_agent::util;
+
+// This macro writes parameters (Byte *src, std::size_ count) for method write() or
+// writeNonBlocking() of a ring buffer class
+#define ARR(count, ...) std::array<uint8_t, count>{__VA_ARGS__}.data(), count
+
+static bool startsWith(const Buffer &buffer, const Buffer &prefix)
+{
+    ASSERT_ALWAYS(buffer.size() >= prefix.size());
+    return std::equal(prefix.begin(), prefix.end(), buffer.begin());
+}
+
+TEST_CASE("SpscRingBuffer: non blocking")
+{
+    SpscRingBuffer buffer(5);
+
+    INFO("Writing to a closed buffer: nothing is written");
+    REQUIRE(buffer.writeNonBlocking(ARR(3, 0, 1, 2)) == 0);
+
+    buffer.open();
+
+    INFO("Writing 3 bytes: all are written");
+    REQUIRE(buffer.writeNonBlocking(ARR(3, 0, 1, 2)) == 3);
+
+    INFO("Writing 3 bytes more: only 2 are written, the buffer is full");
+    REQUIRE(buffer.writeNonBlocking(ARR(3, 3, 4, 5)) == 2);
+    REQUIRE(buffer.getUsedSize() == 5);
+    REQUIRE(buffer.getAvailableSize() == 0);
+
+    INFO("Cannot write more data");
+    REQUIRE(buffer.writeNonBlocking(ARR(1, 6)) == 0);
+
+    Buffer out(10);
+
+    INFO("Reading 3 bytes : ok");
+    REQUIRE(buffer.readNonBlocking(out.data(), 3) == 3);
+    REQUIRE(startsWith(out, Buffer{0, 1, 2}));
+
+    INFO("Reading 3 bytes more: only 2 are read (buffer is empty)");
+    REQUIRE(buffer.readNonBlocking(out.data(), 3) == 2);
+    REQUIRE(startsWith(out, Buffer{3, 4}));
+
+    INFO("Reading again: no byte read");
+    REQUIRE(buffer.readNonBlocking(out.data(), 2) == 0);
+
+    INFO("Making wrap the producer producer position");
+    REQUIRE(buffer.writeNonBlocking(ARR(3, 5, 6, 7)) == 3);
+
+    INFO("Making wrap the consumer position");
+    REQUIRE(buffer.readNonBlocking(out.data(), 3) == 3);
+    REQUIRE(startsWith(out, Buffer{5, 6, 7}));
+
+    INFO("Checking that the buffer is empty");
+    REQUIRE(buffer.getUsedSize() == 0);
+}
+
+TEST_CASE("SpscRingBuffer: clear and move")
+{
+    SpscRingBuffer buffer(5);
+    buffer.open();
+    REQUIRE(buffer.writeNonBlocking(ARR(4, 0, 1, 2, 3)) == 4);
+
+    INFO("Moving the buffer keeps its content");
+    SpscRingBuffer moved(std::move(buffer));
+    CHECK_FALSE(buffer.isOpen());
+    CHECK(buffer.getUsedSize() == 0);
+    REQUIRE(moved.isOpen());
+    REQUIRE(moved.getUsedSize() == 4);
+
+    INFO("Clearing discards the stored data");
+    moved.clear();
+    REQUIRE(moved.getUsedSize() == 0);
+    REQUIRE(moved.getAvailableSize() == 5);
+
+    INFO("The buffer is still usable after clearing");
+    REQUIRE(moved.writeNonBlocking(ARR(5, 4, 5, 6, 7, 8)) == 5);
+    Buffer out(5);
+    REQUIRE(moved.readNonBlocking(out.data(), out.size()) == 5);
+    REQUIRE(out == (Buffer{4, 5, 6, 7, 8}));
+}
+
+TEST_CASE("SpscRingBuffer: span access")
+{
+    SpscRingBuffer buffer(5);
+
+    INFO("Nothing can be acquired for writing while the buffer is closed");
+    CHECK(buffer.acquireWrite(5).empty());
+
+    buffer.open();
+
+    INFO("Nothing can be acquired for reading while the buffer is empty");
+    CHECK(buffer.acquireRead(5).empty());
+
+    INFO("Producing 3 bytes in place");
+    auto writeSpan = buffer.acquireWrite(3);
+    REQUIRE(writeSpan.size() == 3);
+    CHECK(writeSpan.parts[1].size == 0);
+    std::array<uint8_t, 3> content{{0, 1, 2}};
+    writeSpan.copyFrom(content.data(), content.size());
+    buffer.commitWrite(3);
+    REQUIRE(buffer.getUsedSize() == 3);
+
+    INFO("Acquiring more than the free space gives the free space only");
+    CHECK(buffer.acquireWrite(10).size() == 2);
+
+    INFO("Reading the 3 bytes in place, committing them in two steps");
+    auto readSpan = buffer.acquireRead(10);
+    REQUIRE(readSpan.size() == 3);
+    Buffer out(3);
+    readSpan.copyTo(out.begin(), 3);
+    REQUIRE(out == (Buffer{0, 1, 2}));
+    buffer.commitRead(1);
+    buffer.commitRead(2);
+    REQUIRE(buffer.getUsedSize() == 0);
+
+    INFO("Acquiring a write span that wraps around the buffer end");
+    writeSpan = buffer.acquireWrite(4);
+    REQUIRE(writeSpan.size() == 4);
+    CHECK(writeSpan.parts[0].size == 2);
+    CHECK(writeSpan.parts[1].size == 2);
+    std::array<uint8_t, 4> wrapping{{3, 4, 5, 6}};
+    writeSpan.copyFrom(wrapping.data(), wrapping.size());
+    buffer.commitWrite(4);
+
+    INFO("The wrapped content is read in two parts");
+    readSpan = buffer.acquireRead(4);
+    REQUIRE(readSpan.parts[0].size == 2);
+    REQUIRE(readSpan.parts[1].size == 2);
+    CHECK(Buffer(readSpan.parts[0].data, readSpan.parts[0].data + 2) == (Buffer{3, 4}));
+    CHECK(Buffer(readSpan.parts[1].data, readSpan.parts[1].data + 2) == (Buffer{5, 6}));
+    buffer.commitRead(4);
+
+    INFO("Span access and copying access can be mixed");
+    REQUIRE(buffer.writeNonBlocking(ARR(2, 7, 8)) == 2);
+    readSpan = buffer.acquireRead(2);
+    readSpan.copyTo(out.begin(), 2);
+    REQUIRE(startsWith(out, Buffer{7, 8}));
+    buffer.commitRead(2);
+    REQUIRE(buffer.getUsedSize() == 0);
+}
+
+TEST_CASE("SpscRingBuffer: blocking and multithreading")
+{
+    SpscRingBuffer buffer(5);
+    buffer.open();
+
+    // Writing a lot of data into a small ring buffer in a dedicated thread
+    auto future = std::async(std::launch::async, [&buffer] {
+        for (uint8_t i = 0; i < 100; i++) {
+            Buffer in(i, i);
+            // Do not use catch macro outside the main test thread
+            if (!buffer.writeBlocking(in.data(), in.size())) {
+                throw std::runtime_error("writeBlocking: expected true as returned value");
+            }
+        }
+        buffer.close();
+    });
+
+    INFO("Reading written data in another thread and checking its validity");
+    for (uint8_t i = 0; i < 100; i++) {
+        Buffer out(i);
+        CHECK(buffer.readBlocking(out.data(), out.size()));
+        REQUIRE(out == Buffer(i, i));
+    }
+
+    INFO("Checking that the buffer is empty");
+    REQUIRE(buffer.getUsedSize() == 0);
+
+    INFO("Checking that producer thread has not thrown an exception");
+    future.get();
+}
+
+TEST_CASE("SpscRingBuffer: span production and multithreading")
+{
+    SpscRingBuffer buffer(5);
+    buffer.open();
+
+    // Producing a lot of data in place into a small ring buffer in a dedicated thread
+    auto future = std::async(std::launch::async, [&buffer] {
+        for (uint8_t i = 0; i < 100; i++) {
+            Buffer in(i, i);
+            std::size_t written = 0;
+            while (written < in.size()) {
+                auto span = buffer.acquireWrite(in.size() - written);
+                if (span.empty()) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                span.copyFrom(in.data() + written, span.size());
+                buffer.commitWrite(span.size());
+                written += span.size();
+            }
+        }
+        buffer.close();
+    });
+
+    INFO("Reading produced data in another thread and checking its validity");
+    for (uint8_t i = 0; i < 100; i++) {
+        Buffer out(i);
+        CHECK(buffer.readBlocking(out.data(), out.size()));
+        REQUIRE(out == Buffer(i, i));
+    }
+
+    INFO("Checking that producer thread has not thrown an exception");
+    future.get();
+}
+
+TEST_CASE("SpscRingBuffer: consumption is possible after closing")
+{
+    SpscRingBuffer buffer(5);
+    buffer.open();
+    REQUIRE(buffer.writeNonBlocking(ARR(2, 0, 1)) == 2);
+
+    // Note: the closing may happen before or during readBlocking() call
+    auto future = std::async(std::launch::async, [&buffer] { buffer.close(); });
+
+    Buffer out(3);
+    INFO("Reading more than the stored data fails");
+    CHECK_FALSE(buffer.readBlocking(out.data(), out.size()));
+    future.get();
+
+    INFO("Stored data can still be read once the buffer is closed");
+    std::size_t read = buffer.getUsedSize();
+    REQUIRE(buffer.readNonBlocking(out.data(), out.size()) == read);
+    REQUIRE(buffer.getUsedSize() == 0);
+}
+
+TEST_CASE("SpscRingBuffer: close stops blocking methods")
+{
+    SpscRingBuffer buffer(5);
+    buffer.open();
+
+    // Note: the closing may happen before or during xxxxBlocking() call
+    auto future = std::async(std::launch::async, [&buffer] { buffer.close(); });
+
+    WHEN ("Reading a RB while closing it") {
+        Buffer out(10);
+        CHECK_FALSE(buffer.readBlocking(out.data(), 5));
+        future.get();
+    }
+    WHEN ("Writing a RB while closing it") {
+        Buffer in(10, 0);
+        CHECK_FALSE(buffer.writeBlocking(in.data(), in.size()));
+        future.get();
+    }
+}
+
+/** Streams 'totalSize' bytes through the ring buffer, a producer thread writing blocks of
+ * 'blockSize' bytes and the calling thread reading them.
+ * @return the transfer duration */
+template <class RingBufferType>
+static std::chrono::duration<double> measureTransfer(std::size_t ringSize, std::size_t blockSize,
+                                                     std::size_t totalSize)
+{
+    RingBufferType buffer(ringSize);
+    buffer.open();
+
+    auto start = std::chrono::steady_clock::now();
+    auto future = std::async(std::launch::async, [&buffer, blockSize, totalSize] {
+        Buffer in(blockSize, 0xA5);
+        for (std::size_t written = 0; written < totalSize; written += blockSize) {
+            if (!buffer.writeBlocking(in.data(), in.size())) {
+                throw std::runtime_error("writeBlocking: expected true as returned value");
+            }
+        }
+        buffer.close();
+    });
+
+    Buffer out(blockSize);
+    while (buffer.readBlocking(out.data(), out.size())) {
+    }
+    future.get();
+    return std::chrono::steady_clock::now() - start;
+}
+
+TEST_CASE("SpscRingBuffer: contention benchmark", "[.][benchmark]")
+{
+    static const std::size_t ringSize = 64 * 1024;
+    static const std::size_t totalSize = 256 * 1024 * 1024;
+
+    std::cout << "Transferring " << totalSize / (1024 * 1024) << " MiB through a " << ringSize
+              << " bytes ring buffer\n";
+    for (std::size_t blockSize : {16, 64, 256, 1024, 4096}) {
+        auto locked = measureTransfer<RingBuffer>(ringSize, blockSize, totalSize);
+        auto lockFree = measureTransfer<SpscRingBuffer>(ringSize, blockSize, totalSize);
+
+        std::cout << "block size " << blockSize << ": RingBuffer "
+                  << totalSize / locked.count() / (1024 * 1024) << " MiB/s, SpscRingBuffer "
+                  << totalSize / lockFree.count() / (1024 * 1024) << " MiB/s\n";
+    }
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2016, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include "cAVS/Linux/IpcTrace.hpp"
+#include "cAVS/DriverFactory.hpp"
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace debug_agent
+{
+namespace cavs
+{
+namespace linux
+{
+
+/** This driver factory replays an IPC trace recorded by the SystemDriverFactory.
+ *
+ * The created driver is built on the mocked devices: the recorded accesses are expected in
+ * the same order, with the same arguments, and return the recorded replies. Each access is
+ * delayed until its recorded timestamp, divided by the speed factor.
+ *
+ * newDriver() can be called several times, each driver replays the whole trace.
+ */
+class TraceReplayDriverFactory : public DriverFactory
+{
+public:
+    /** @param[in] records the recorded driver accesses
+     * @param[in] speedFactor 1 to replay at the original speed, 2 twice as fast, etc.
+     *                        0 replays without any delay.
+     * @param[in] leftoverCallback A void(void) function that will be called if some recorded
+     *                             accesses have not been replayed when the driver is destroyed.
+     */
+    TraceReplayDriverFactory(const std::vector<IpcTraceRecord> &records, double speedFactor = 1.,
+                             std::function<void(void)> leftoverCallback = [] {})
+        : mRecords(records), mSpeedFactor(speedFactor), mLeftoverCallback(leftoverCallback)
+    {
+    }
+
+    /** @throw DriverFactory::Exception if the trace file cannot be read */
+    TraceReplayDriverFactory(const std::string &traceFileName, double speedFactor = 1.,
+                             std::function<void(void)> leftoverCallback = [] {});
+
+    std::unique_ptr<cavs::Driver> newDriver() const override;
+
+private:
+    std::vector<IpcTraceRecord> mRecords;
+    double mSpeedFactor;
+    std::function<void(void)> mLeftoverCallback;
+};
+}
+}
+}
@@ -0,0 +1,514 @@
+/*
+ * Copyright (c) 2016, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cAVS/Linux/TraceReplayDriverFactory.hpp"
+#include "cAVS/Linux/Driver.hpp"
+#include "cAVS/Linux/MockedDevice.hpp"
+#include "cAVS/Linux/MockedControlDevice.hpp"
+#include "cAVS/Linux/MockedCompressDevice.hpp"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <queue>
+#include <thread>
+
+namespace debug_agent
+{
+namespace cavs
+{
+namespace linux
+{
+
+namespace
+{
+
+/** Delays the replayed accesses until their recorded timestamp, divided by the speed factor */
+class ReplayClock
+{
+public:
+    ReplayClock(double speedFactor)
+        : mSpeedFactor(speedFactor), mStart(std::chrono::steady_clock::now())
+    {
+    }
+
+    void waitUntil(uint64_t timestamp) const
+    {
+        if (mSpeedFactor <= 0) {
+            return;
+        }
+        std::chrono::duration<double, std::micro> delay(timestamp / mSpeedFactor);
+        std::this_thread::sleep_until(
+            mStart + std::chrono::duration_cast<std::chrono::steady_clock::duration>(delay));
+    }
+
+private:
+    const double mSpeedFactor;
+    const std::chrono::steady_clock::time_point mStart;
+};
+
+/** The recorded timestamps of the accesses to a device, consumed in order */
+class ReplaySchedule
+{
+public:
+    ReplaySchedule(std::shared_ptr<const ReplayClock> clock) : mClock(clock) {}
+
+    void add(IpcTraceOperation operation, uint64_t timestamp)
+    {
+        mAccesses.push({operation, timestamp});
+    }
+
+    /** @return true if the next recorded access is of the given operation */
+    bool isNext(IpcTraceOperation operation)
+    {
+        std::lock_guard<std::mutex> locker(mMutex);
+        return !mAccesses.empty() && mAccesses.front().first == operation;
+    }
+
+    /** Wait for the next recorded access of the given operation. The preceding accesses of
+     * other operations are skipped, as a compress stop skips the pending ones. */
+    void pace(IpcTraceOperation operation)
+    {
+        uint64_t timestamp = 0;
+        {
+            std::lock_guard<std::mutex> locker(mMutex);
+            while (!mAccesses.empty() && mAccesses.front().first != operation) {
+                mAccesses.pop();
+            }
+            if (mAccesses.empty()) {
+                return;
+            }
+            timestamp = mAccesses.front().second;
+            mAccesses.pop();
+        }
+        mClock->waitUntil(timestamp);
+    }
+
+private:
+    std::shared_ptr<const ReplayClock> mClock;
+    std::mutex mMutex;
+    std::queue<std::pair<IpcTraceOperation, uint64_t>> mAccesses;
+};
+
+class ReplayDevice final : public Device
+{
+public:
+    ReplayDevice(std::unique_ptr<MockedDevice> device, std::shared_ptr<ReplaySchedule> schedule)
+        : mDevice(std::move(device)), mSchedule(schedule)
+    {
+    }
+
+    ssize_t commandWrite(const std::string &name, const util::Buffer &bufferInput) override
+    {
+        mSchedule->pace(IpcTraceOperation::CommandWrite);
+        return mDevice->commandWrite(name, bufferInput);
+    }
+
+    void commandRead(const std::string &name, const util::Buffer &bufferInput,
+                     util::Buffer &bufferOutput) override
+    {
+        mSchedule->pace(IpcTraceOperation::CommandRead);
+        mDevice->commandRead(name, bufferInput, bufferOutput);
+    }
+
+private:
+    std::unique_ptr<MockedDevice> mDevice;
+    std::shared_ptr<ReplaySchedule> mSchedule;
+};
+
+class ReplayControlDevice final : public ControlDevice
+{
+public:
+    ReplayControlDevice(std::unique_ptr<MockedControlDevice> device,
+                        std::shared_ptr<ReplaySchedule> schedule,
+                        const std::map<std::string, size_t> &controlCounts)
+        : ControlDevice(device->getCardName()), mDevice(std::move(device)),
+          mSchedule(schedule), mControlCounts(controlCounts)
+    {
+    }
+
+    void ctlRead(const std::string &name, util::Buffer &bufferOutput) override
+    {
+        mSchedule->pace(IpcTraceOperation::ControlRead);
+        mDevice->ctlRead(name, bufferOutput);
+    }
+
+    void ctlWrite(const std::string &name, const util::Buffer &bufferInput) override
+    {
+        mSchedule->pace(IpcTraceOperation::ControlWrite);
+        mDevice->ctlWrite(name, bufferInput);
+    }
+
+    /** Counts are constant: the recorded ones are returned without pacing */
+    size_t getControlCountByTag(const std::string &name) const override
+    {
+        auto it = mControlCounts.find(name);
+        return it != mControlCounts.end() ? it->second : 0;
+    }
+
+private:
+    std::unique_ptr<MockedControlDevice> mDevice;
+    std::shared_ptr<ReplaySchedule> mSchedule;
+    std::map<std::string, size_t> mControlCounts;
+};
+
+class ReplayCompressDevice final : public CompressDevice
+{
+public:
+    ReplayCompressDevice(std::unique_ptr<MockedCompressDevice> device,
+                         std::shared_ptr<ReplaySchedule> schedule)
+        : CompressDevice(device->getInfo()), mDevice(std::move(device)), mSchedule(schedule)
+    {
+    }
+
+    void open(Mode mode, compress::Role role, compress::Config &config) override
+    {
+        mSchedule->pace(IpcTraceOperation::CompressOpen);
+        mDevice->open(mode, role, config);
+    }
+
+    bool isRunning() const noexcept override { return mDevice->isRunning(); }
+    bool isReady() const noexcept override { return mDevice->isReady(); }
+    void close() noexcept override { mDevice->close(); }
+
+    bool wait(int timeoutMs) override
+    {
+        if (!mSchedule->isNext(IpcTraceOperation::CompressWait)) {
+            /* The recorded device has been stopped before being waited: as the real device,
+             * blocking until the stop. The mock would fail as it expects the stop. */
+            std::unique_lock<std::mutex> locker(mStopMutex);
+            mStopCondition.wait(locker, [this] { return mStopped; });
+            throw IoException();
+        }
+        mSchedule->pace(IpcTraceOperation::CompressWait);
+        return mDevice->wait(timeoutMs);
+    }
+
+    void start() override
+    {
+        {
+            std::lock_guard<std::mutex> locker(mStopMutex);
+            mStopped = false;
+        }
+        mSchedule->pace(IpcTraceOperation::CompressStart);
+        mDevice->start();
+    }
+
+    void stop() override
+    {
+        {
+            std::lock_guard<std::mutex> locker(mStopMutex);
+            mStopped = true;
+        }
+        mStopCondition.notify_all();
+        mSchedule->pace(IpcTraceOperation::CompressStop);
+        mDevice->stop();
+    }
+
+    size_t write(const util::Buffer &inputBuffer) override
+    {
+        mSchedule->pace(IpcTraceOperation::CompressWrite);
+        return mDevice->write(inputBuffer);
+    }
+
+    size_t read(util::Buffer &outputBuffer) override
+    {
+        mSchedule->pace(IpcTraceOperation::CompressRead);
+        return mDevice->read(outputBuffer);
+    }
+
+    std::size_t getAvailable() override
+    {
+        mSchedule->pace(IpcTraceOperation::CompressAvailable);
+        return mDevice->getAvailable();
+    }
+
+    std::size_t getBufferSize() const override
+    {
+        mSchedule->pace(IpcTraceOperation::CompressBufferSize);
+        return mDevice->getBufferSize();
+    }
+
+private:
+    std::unique_ptr<MockedCompressDevice> mDevice;
+    std::shared_ptr<ReplaySchedule> mSchedule;
+
+    std::mutex mStopMutex;
+    std::condition_variable mStopCondition;
+    bool mStopped = false;
+};
+
+/** Returns the recorded device lists, and the replayed devices in their creation order */
+class ReplayCompressDeviceFactory final : public CompressDeviceFactory
+{
+public:
+    std::unique_ptr<CompressDevice> newCompressDevice(
+        const compress::DeviceInfo &info) const override
+    {
+        /* Log, probe and injection devices are created concurrently */
+        std::lock_guard<std::mutex> locker(mDevicesMutex);
+        auto &devices = mDevices[info.name()];
+        if (devices.empty()) {
+            throw Exception("No recorded creation of compress device " + info.name());
+        }
+        std::unique_ptr<CompressDevice> device = std::move(devices.front());
+        devices.pop();
+        if (device == nullptr) {
+            throw Exception("Recorded failure of compress device " + info.name() + " creation");
+        }
+        return device;
+    }
+
+    const compress::LoggersInfo getLoggerDeviceInfoList() const override
+    {
+        compress::LoggersInfo loggersInfo;
+        for (const auto &device : getDevices(IpcTraceOperation::LoggerDevices)) {
+            loggersInfo.emplace_back(device.cardId, device.deviceId, device.index);
+        }
+        return loggersInfo;
+    }
+
+    const compress::InjectionProbesInfo getInjectionProbeDeviceInfoList() const override
+    {
+        compress::InjectionProbesInfo probesInfo;
+        for (const auto &device : getDevices(IpcTraceOperation::InjectionProbeDevices)) {
+            probesInfo.emplace_back(device.cardId, device.deviceId, device.index);
+        }
+        return probesInfo;
+    }
+
+    const compress::ExtractionProbeInfo getExtractionProbeDeviceInfo() const override
+    {
+        const auto &devices = getDevices(IpcTraceOperation::ExtractionProbeDevice);
+        if (devices.empty()) {
+            throw Exception("No recorded extraction probe device");
+        }
+        return {devices[0].cardId, devices[0].deviceId};
+    }
+
+    /** The first recorded answer of each device list query is kept */
+    void setDevices(IpcTraceOperation query, const std::vector<IpcTraceDeviceInfo> &devices)
+    {
+        mDeviceLists.insert({query, devices});
+    }
+
+    /** @param[in] device the replayed device, or nullptr if its creation has failed */
+    void addDevice(const std::string &name, std::unique_ptr<CompressDevice> device)
+    {
+        std::lock_guard<std::mutex> locker(mDevicesMutex);
+        mDevices[name].push(std::move(device));
+    }
+
+private:
+    const std::vector<IpcTraceDeviceInfo> &getDevices(IpcTraceOperation query) const
+    {
+        static const std::vector<IpcTraceDeviceInfo> none;
+        auto it = mDeviceLists.find(query);
+        return it != mDeviceLists.end() ? it->second : none;
+    }
+
+    std::map<IpcTraceOperation, std::vector<IpcTraceDeviceInfo>> mDeviceLists;
+    mutable std::mutex mDevicesMutex;
+    mutable std::map<std::string, std::queue<std::unique_ptr<CompressDevice>>> mDevices;
+};
+
+/** A compress device being filled with its recorded operations */
+struct CompressReplay
+{
+    std::unique_ptr<MockedCompressDevice> device;
+    std::shared_ptr<ReplaySchedule> schedule;
+};
+
+void addCompressEntry(MockedCompressDevice &device, const IpcTraceRecord &record)
+{
+    bool successful = record.status == IpcTraceStatus::Succeeded;
+    auto size = static_cast<size_t>(record.result);
+    switch (record.operation) {
+    case IpcTraceOperation::CompressOpen:
+        successful ? device.addSuccessfulCompressDeviceEntryOpen()
+                   : device.addFailedCompressDeviceEntryOpen();
+        break;
+    case IpcTraceOperation::CompressStart:
+        successful ? device.addSuccessfulCompressDeviceEntryStart()
+                   : device.addFailedCompressDeviceEntryStart();
+        break;
+    case IpcTraceOperation::CompressStop:
+        successful ? device.addSuccessfulCompressDeviceEntryStop()
+                   : device.addFailedCompressDeviceEntryStop();
+        break;
+    case IpcTraceOperation::CompressWait:
+        if (record.status == IpcTraceStatus::Interrupted) {
+            /* Blocking until the device is stopped, then reporting no data */
+            device.addSuccessfulCompressDeviceEntryWait(CompressDevice::mInfiniteTimeout, false);
+        } else if (successful) {
+            /* The wait duration is reproduced by the pacing of the next operation */
+            device.addSuccessfulCompressDeviceEntryWait(0, record.result != 0);
+        } else {
+            device.addFailedCompressDeviceEntryWait(0, false);
+        }
+        break;
+    case IpcTraceOperation::CompressRead:
+        successful ? device.addSuccessfulCompressDeviceEntryRead(record.reply, size)
+                   : device.addFailedCompressDeviceEntryRead(record.reply, size);
+        break;
+    case IpcTraceOperation::CompressWrite:
+        successful ? device.addSuccessfulCompressDeviceEntryWrite(record.input, size)
+                   : device.addFailedCompressDeviceEntryWrite(record.input, size);
+        break;
+    case IpcTraceOperation::CompressAvailable:
+        /* The mock cannot fail this operation */
+        device.addSuccessfulCompressDeviceEntryAvail(size);
+        break;
+    case IpcTraceOperation::CompressBufferSize:
+        /* The mock cannot fail this operation */
+        device.addSuccessfulCompressDeviceEntryGetBufferSize(size);
+        break;
+    default:
+        break;
+    }
+}
+}
+
+TraceReplayDriverFactory::TraceReplayDriverFactory(const std::string &traceFileName,
+                                                   double speedFactor,
+                                                   std::function<void(void)> leftoverCallback)
+    : mSpeedFactor(speedFactor), mLeftoverCallback(leftoverCallback)
+{
+    try {
+        mRecords = IpcTraceReader(traceFileName).getRecords();
+    } catch (IpcTraceReader::Exception &e) {
+        throw Exception(e.what());
+    }
+}
+
+std::unique_ptr<cavs::Driver> TraceReplayDriverFactory::newDriver() const
+{
+    /* Records are written when their access is completed: replaying them in their start
+     * order, which is the order expected by the mocks */
+    std::vector<const IpcTraceRecord *> records;
+    for (const auto &record : mRecords) {
+        records.push_back(&record);
+    }
+    std::stable_sort(records.begin(), records.end(),
+                     [](const IpcTraceRecord *a, const IpcTraceRecord *b) {
+                         return a->timestamp < b->timestamp;
+                     });
+
+    auto clock = std::make_shared<const ReplayClock>(mSpeedFactor);
+    auto device = std::make_unique<MockedDevice>(mLeftoverCallback);
+    auto deviceSchedule = std::make_shared<ReplaySchedule>(clock);
+    auto controlDevice = std::make_unique<MockedControlDevice>("replay", mLeftoverCallback);
+    auto controlSchedule = std::make_shared<ReplaySchedule>(clock);
+    std::map<std::string, size_t> controlCounts;
+    auto compressDeviceFactory = std::make_unique<ReplayCompressDeviceFactory>();
+
+    /* Compress devices are filled until their next creation */
+    std::map<std::string, CompressReplay> compressDevices;
+    auto flushCompressDevice = [&](const std::string &name) {
+        auto it = compressDevices.find(name);
+        if (it != compressDevices.end()) {
+            compressDeviceFactory->addDevice(
+                name, std::make_unique<ReplayCompressDevice>(std::move(it->second.device),
+                                                             it->second.schedule));
+            compressDevices.erase(it);
+        }
+    };
+
+    for (const auto *record : records) {
+        bool successful = record->status == IpcTraceStatus::Succeeded;
+        switch (record->operation) {
+        case IpcTraceOperation::CommandWrite:
+            successful ? device->addCommandWriteOK(record->target, record->input, record->result)
+                       : device->addCommandWriteKO(record->target, record->input, record->result);
+            deviceSchedule->add(record->operation, record->timestamp);
+            break;
+        case IpcTraceOperation::CommandRead:
+            successful ? device->addCommandReadOK(record->target, record->input, record->output,
+                                                  record->reply)
+                       : device->addCommandReadKO(record->target, record->input, record->output,
+                                                  record->reply);
+            deviceSchedule->add(record->operation, record->timestamp);
+            break;
+        case IpcTraceOperation::ControlRead:
+            controlDevice->addControlReadEntry(successful, record->target, record->output,
+                                               record->reply);
+            controlSchedule->add(record->operation, record->timestamp);
+            break;
+        case IpcTraceOperation::ControlWrite:
+            controlDevice->addControlWriteEntry(successful, record->target, record->input);
+            controlSchedule->add(record->operation, record->timestamp);
+            break;
+        case IpcTraceOperation::ControlCount:
+            controlCounts.insert({record->target, static_cast<size_t>(record->result)});
+            break;
+        case IpcTraceOperation::LoggerDevices:
+        case IpcTraceOperation::InjectionProbeDevices:
+        case IpcTraceOperation::ExtractionProbeDevice:
+            if (successful) {
+                compressDeviceFactory->setDevices(record->operation, record->devices);
+            }
+            break;
+        case IpcTraceOperation::CompressCreate:
+            flushCompressDevice(record->target);
+            if (!successful || record->devices.empty()) {
+                compressDeviceFactory->addDevice(record->target, nullptr);
+            } else {
+                compress::DeviceInfo info(record->devices[0].cardId,
+                                          record->devices[0].deviceId);
+                compressDevices[record->target] = {
+                    std::make_unique<MockedCompressDevice>(info, mLeftoverCallback),
+                    std::make_shared<ReplaySchedule>(clock)};
+            }
+            break;
+        default: {
+            /* Compress device operation */
+            auto it = compressDevices.find(record->target);
+            if (it != compressDevices.end()) {
+                addCompressEntry(*it->second.device, *record);
+                it->second.schedule->add(record->operation, record->timestamp);
+            }
+            break;
+        }
+        }
+    }
+    while (!compressDevices.empty()) {
+        flushCompressDevice(compressDevices.begin()->first);
+    }
+
+    return std::make_unique<linux::Driver>(
+        std::make_unique<ReplayDevice>(std::move(device), deviceSchedule),
+        std::make_unique<ReplayControlDevice>(std::move(controlDevice), controlSchedule,
+                                              controlCounts),
+        std::move(compressDeviceFactory));
+}
+}
+}
+}
@@ -33,6 +33,7 @@
 #include "cAVS/DspFw/ExternalFirmwareHeaders.hpp"
 #include "Util/ByteStreamReader.hpp"
 #include "Util/ByteStreamWriter.hpp"
+#include "Util/MemberList.hpp"
 #include "Util/StructureChangeTracking.hpp"
 
 namespace debug_agent
@@ -57,27 +58,21 @@ struct FwVersion
     uint16_t hotfix;
     uint16_t build;
 
-    bool operator==(const FwVersion &other)
+    bool operator==(const FwVersion &other) const
     {
         return major == other.major && minor == other.minor && hotfix == other.hotfix &&
                build == other.build;
     }
 
-    void fromStream(util::ByteStreamReader &reader)
-    {
-        reader.read(major);
-        reader.read(minor);
-        reader.read(hotfix);
-        reader.read(build);
-    }
+    using Members = util::MemberList<
+        SERIALIZED_MEMBER(FwVersion, major),
+        SERIALIZED_MEMBER(FwVersion, minor),
+        SERIALIZED_MEMBER(FwVersion, hotfix),
+        SERIALIZED_MEMBER(FwVersion, build)>;
 
-    void toStream(util::ByteStreamWriter &writer) const
-    {
-        writer.write(major);
-        writer.write(minor);
-        writer.write(hotfix);
-        writer.write(build);
-    }
+    void fromStream(util::ByteStreamReader &reader) { Members::fromStream(*this, reader); }
+
+    void toStream(util::ByteStreamWriter &writer) const { Members::toStream(*this, writer); }
 };
 
 /* DmaBufferConfig */
@@ -91,22 +86,18 @@ struct DmaBufferConfig
     uint32_t min_size_bytes;
     uint32_t max_size_bytes;
 
-    bool operator==(const DmaBufferConfig &other)
+    bool operator==(const DmaBufferConfig &other) const
     {
         return min_size_bytes == other.min_size_bytes && max_size_bytes == other.max_size_bytes;
     }
 
-    void fromStream(util::ByteStreamReader &reader)
-    {
-        reader.read(min_size_bytes);
-        reader.read(max_size_bytes);
-    }
+    using Members = util::MemberList<
+        SERIALIZED_MEMBER(DmaBufferConfig, min_size_bytes),
+        SERIALIZED_MEMBER(DmaBufferConfig, max_size_bytes)>;
 
-    void toStream(util::ByteStreamWriter &writer) const
-    {
-        writer.write(min_size_bytes);
-        writer.write(max_size_bytes);
-    }
+    void fromStream(util::ByteStreamReader &reader) { Members::fromStream(*this, reader); }
+
+    void toStream(util::ByteStreamWriter &writer) const { Members::toStream(*this, writer); }
 };
 
 /* Importing FwConfigParams enum */
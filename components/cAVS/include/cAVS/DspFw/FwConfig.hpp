@@ -30,10 +30,7 @@
 #pragma once
 
 #include "cAVS/DspFw/ConfigTypes.hpp"
-#include "Tlv/TlvResponseHandlerInterface.hpp"
-#include "Tlv/TlvDictionary.hpp"
-#include "Tlv/TlvWrapper.hpp"
-#include "Tlv/TlvVectorWrapper.hpp"
+#include "Tlv/TlvStaticDictionary.hpp"
 
 namespace debug_agent
 {
@@ -50,7 +47,7 @@ namespace dsp_fw
  * returned by the cAVS FW thanks to the Tlv::TlvDictionaryInterface exposed by the FwConfig
  * instance.
  */
-class FwConfig final : public tlv::TlvResponseHandlerInterface
+class FwConfig final : public tlv::TlvStaticResponseHandler<FwConfig>
 {
 public:
     FwVersion fwVersion;
@@ -108,62 +105,52 @@ public:
     uint32_t maxLibsCount;
     bool isMaxLibsCountValid;
 
-    FwConfig() : mFwConfigTlvDictionary(mkMap()) {}
-
-    const tlv::TlvDictionaryInterface &getTlvDictionary() const noexcept override
-    {
-        return mFwConfigTlvDictionary;
-    }
+    FwConfig() { getTlvDictionary().invalidateAll(); }
 
 private:
-    using Dictionary = tlv::TlvDictionary<FwConfigParams>;
-
-    Dictionary::TlvMap mkMap()
-    {
-        using Tags = FwConfigParams;
-        using namespace tlv;
-
-        Dictionary::TlvMap tlvMap;
-        tlvMap[Tags::FW_VERSION_FW_CFG] =
-            std::make_unique<TlvWrapper<FwVersion>>(fwVersion, isFwVersionValid);
-        tlvMap[Tags::MEMORY_RECLAIMED_FW_CFG] =
-            std::make_unique<TlvWrapper<uint32_t>>(memoryReclaimed, isMemoryReclaimedValid);
-        tlvMap[Tags::SLOW_CLOCK_FREQ_HZ_FW_CFG] =
-            std::make_unique<TlvWrapper<uint32_t>>(slowClockFreqHz, isSlowClockFreqHzValid);
-        tlvMap[Tags::FAST_CLOCK_FREQ_HZ_FW_CFG] =
-            std::make_unique<TlvWrapper<uint32_t>>(fastClockFreqHz, isFastClockFreqHzValid);
-        tlvMap[Tags::DMA_BUFFER_CONFIG_FW_CFG] =
-            std::make_unique<TlvVectorWrapper<DmaBufferConfig>>(dmaBufferConfig);
-        tlvMap[Tags::ALH_SUPPORT_LEVEL_FW_CFG] =
-            std::make_unique<TlvWrapper<uint32_t>>(alhSupportLevel, isAlhSupportLevelValid);
-        tlvMap[Tags::IPC_DL_MAILBOX_BYTES_FW_CFG] =
-            std::make_unique<TlvWrapper<uint32_t>>(ipcDlMailboxBytes, isIpcDlMailboxBytesValid);
-        tlvMap[Tags::IPC_UL_MAILBOX_BYTES_FW_CFG] =
-            std::make_unique<TlvWrapper<uint32_t>>(ipcUlMailboxBytes, isIpcUlMailboxBytesValid);
-        tlvMap[Tags::TRACE_LOG_BYTES_FW_CFG] =
-            std::make_unique<TlvWrapper<uint32_t>>(traceLogBytes, isTraceLogBytesValid);
-        tlvMap[Tags::MAX_PPL_CNT_FW_CFG] =
-            std::make_unique<TlvWrapper<uint32_t>>(maxPplCount, isMaxPplCountValid);
-        tlvMap[Tags::MAX_ASTATE_COUNT_FW_CFG] =
-            std::make_unique<TlvWrapper<uint32_t>>(maxAstateCount, isMaxAstateCountValid);
-        tlvMap[Tags::MAX_MODULE_PIN_COUNT_FW_CFG] =
-            std::make_unique<TlvWrapper<uint32_t>>(maxModulePinCount, isMaxModulePinCountValid);
-        tlvMap[Tags::MODULES_COUNT_FW_CFG] =
-            std::make_unique<TlvWrapper<uint32_t>>(modulesCount, isModulesCountValid);
-        tlvMap[Tags::MAX_MOD_INST_COUNT_FW_CFG] =
-            std::make_unique<TlvWrapper<uint32_t>>(maxModInstCount, isMaxModInstCountValid);
-        tlvMap[Tags::MAX_LL_TASKS_PER_PRI_COUNT_FW_CFG] = std::make_unique<TlvWrapper<uint32_t>>(
-            maxLlTasksPerPriCount, isMaxLlTasksPerPriCountValid);
-        tlvMap[Tags::LL_PRI_COUNT] =
-            std::make_unique<TlvWrapper<uint32_t>>(llPriCount, isLlPriCountValid);
-        tlvMap[Tags::MAX_DP_TASKS_COUNT_FW_CFG] =
-            std::make_unique<TlvWrapper<uint32_t>>(maxDpTasksCount, isMaxDpTasksCountValid);
-        tlvMap[Tags::MAX_LIBS_COUNT_FW_CFG] =
-            std::make_unique<TlvWrapper<uint32_t>>(maxLibsCount, isMaxLibsCountValid);
-
-        return tlvMap;
-    }
-    Dictionary mFwConfigTlvDictionary;
+    friend class tlv::TlvStaticResponseHandler<FwConfig>;
+
+    /* Fields are sorted by tag */
+    using Tags = FwConfigParams;
+    using Dictionary = tlv::TlvStaticDictionary<FwConfig, Tags>;
+    using TlvTable = Dictionary::Table<
+        Dictionary::Field<Tags::FW_VERSION_FW_CFG, FwVersion, &FwConfig::fwVersion,
+                          &FwConfig::isFwVersionValid>,
+        Dictionary::Field<Tags::MEMORY_RECLAIMED_FW_CFG, uint32_t, &FwConfig::memoryReclaimed,
+                          &FwConfig::isMemoryReclaimedValid>,
+        Dictionary::Field<Tags::SLOW_CLOCK_FREQ_HZ_FW_CFG, uint32_t, &FwConfig::slowClockFreqHz,
+                          &FwConfig::isSlowClockFreqHzValid>,
+        Dictionary::Field<Tags::FAST_CLOCK_FREQ_HZ_FW_CFG, uint32_t, &FwConfig::fastClockFreqHz,
+                          &FwConfig::isFastClockFreqHzValid>,
+        Dictionary::VectorField<Tags::DMA_BUFFER_CONFIG_FW_CFG, DmaBufferConfig,
+                                &FwConfig::dmaBufferConfig>,
+        Dictionary::Field<Tags::ALH_SUPPORT_LEVEL_FW_CFG, uint32_t, &FwConfig::alhSupportLevel,
+                          &FwConfig::isAlhSupportLevelValid>,
+        Dictionary::Field<Tags::IPC_DL_MAILBOX_BYTES_FW_CFG, uint32_t, &FwConfig::ipcDlMailboxBytes,
+                          &FwConfig::isIpcDlMailboxBytesValid>,
+        Dictionary::Field<Tags::IPC_UL_MAILBOX_BYTES_FW_CFG, uint32_t, &FwConfig::ipcUlMailboxBytes,
+                          &FwConfig::isIpcUlMailboxBytesValid>,
+        Dictionary::Field<Tags::TRACE_LOG_BYTES_FW_CFG, uint32_t, &FwConfig::traceLogBytes,
+                          &FwConfig::isTraceLogBytesValid>,
+        Dictionary::Field<Tags::MAX_PPL_CNT_FW_CFG, uint32_t, &FwConfig::maxPplCount,
+                          &FwConfig::isMaxPplCountValid>,
+        Dictionary::Field<Tags::MAX_ASTATE_COUNT_FW_CFG, uint32_t, &FwConfig::maxAstateCount,
+                          &FwConfig::isMaxAstateCountValid>,
+        Dictionary::Field<Tags::MAX_MODULE_PIN_COUNT_FW_CFG, uint32_t, &FwConfig::maxModulePinCount,
+                          &FwConfig::isMaxModulePinCountValid>,
+        Dictionary::Field<Tags::MODULES_COUNT_FW_CFG, uint32_t, &FwConfig::modulesCount,
+                          &FwConfig::isModulesCountValid>,
+        Dictionary::Field<Tags::MAX_MOD_INST_COUNT_FW_CFG, uint32_t, &FwConfig::maxModInstCount,
+                          &FwConfig::isMaxModInstCountValid>,
+        Dictionary::Field<Tags::MAX_LL_TASKS_PER_PRI_COUNT_FW_CFG, uint32_t,
+                          &FwConfig::maxLlTasksPerPriCount,
+                          &FwConfig::isMaxLlTasksPerPriCountValid>,
+        Dictionary::Field<Tags::LL_PRI_COUNT, uint32_t, &FwConfig::llPriCount,
+                          &FwConfig::isLlPriCountValid>,
+        Dictionary::Field<Tags::MAX_DP_TASKS_COUNT_FW_CFG, uint32_t, &FwConfig::maxDpTasksCount,
+                          &FwConfig::isMaxDpTasksCountValid>,
+        Dictionary::Field<Tags::MAX_LIBS_COUNT_FW_CFG, uint32_t, &FwConfig::maxLibsCount,
+                          &FwConfig::isMaxLibsCountValid>>;
 };
 }
 }
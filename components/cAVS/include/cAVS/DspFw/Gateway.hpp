@@ -33,6 +33,7 @@
 #include "cAVS/DspFw/Common.hpp"
 #include "Util/ByteStreamReader.hpp"
 #include "Util/ByteStreamWriter.hpp"
+#include "Util/MemberList.hpp"
 #include "Util/StructureChangeTracking.hpp"
 
 namespace debug_agent
@@ -56,6 +57,9 @@ union GatewayAttributes
         uint32_t _rsvd : 31;
     } bits;
 
+    /** Serialized as its memory representation */
+    static const bool hasSerializableMemoryLayout = true;
+
     bool operator==(const GatewayAttributes &other) const { return dw == other.dw; }
 
     bool operator!=(const GatewayAttributes &other) const { return !(*this == other); }
@@ -81,22 +85,21 @@ struct GatewayProps
     */
     GatewayAttributes attribs;
 
+    /** Serialized as its memory representation */
+    static const bool hasSerializableMemoryLayout = true;
+
     bool operator==(const GatewayProps &other) const
     {
         return id == other.id && attribs == other.attribs;
     }
 
-    void fromStream(util::ByteStreamReader &reader)
-    {
-        reader.read(id);
-        reader.read(attribs);
-    }
+    using Members = util::MemberList<
+        SERIALIZED_MEMBER(GatewayProps, id),
+        SERIALIZED_MEMBER(GatewayProps, attribs)>;
 
-    void toStream(util::ByteStreamWriter &writer) const
-    {
-        writer.write(id);
-        writer.write(attribs);
-    }
+    void fromStream(util::ByteStreamReader &reader) { Members::fromStream(*this, reader); }
+
+    void toStream(util::ByteStreamWriter &writer) const { Members::toStream(*this, writer); }
 };
 
 /* GatewaysInfo */
@@ -115,12 +118,12 @@ struct GatewaysInfo
 
     bool operator==(const GatewaysInfo &other) const { return gateways == other.gateways; }
 
-    void fromStream(util::ByteStreamReader &reader) { reader.readVector<ArraySizeType>(gateways); }
+    using Members = util::MemberList<
+        SERIALIZED_VECTOR_MEMBER(ArraySizeType, GatewaysInfo, gateways)>;
 
-    void toStream(util::ByteStreamWriter &writer) const
-    {
-        writer.writeVector<ArraySizeType>(gateways);
-    }
+    void fromStream(util::ByteStreamReader &reader) { Members::fromStream(*this, reader); }
+
+    void toStream(util::ByteStreamWriter &writer) const { Members::toStream(*this, writer); }
 };
 }
 }
@@ -34,9 +34,7 @@
 #include "Util/ByteStreamReader.hpp"
 #include "Util/ByteStreamWriter.hpp"
 #include "Util/StructureChangeTracking.hpp"
-#include "Tlv/TlvResponseHandlerInterface.hpp"
-#include "Tlv/TlvDictionary.hpp"
-#include "Tlv/TlvWrapper.hpp"
+#include "Tlv/TlvStaticDictionary.hpp"
 #include <vector>
 #include <utility>
 
@@ -53,7 +51,7 @@ CHECK_MEMBER(private_fw::SramStateInfo, ebb_state_dword_count, 4, uint32_t);
 CHECK_MEMBER(private_fw::SramStateInfo, ebb_state, 8, uint32_t[1]);
 CHECK_MEMBER(private_fw::SramStateInfo, page_alloc_count, 12, uint32_t);
 CHECK_MEMBER(private_fw::SramStateInfo, page_alloc, 16, uint16_t[1]);
-class GlobalMemoryState : public tlv::TlvResponseHandlerInterface
+class GlobalMemoryState : public tlv::TlvStaticResponseHandler<GlobalMemoryState>
 {
 public:
     struct SramStateInfo
@@ -100,30 +98,18 @@ public:
     SramStateInfo hpsramState;
     bool isHpsramStateValid;
 
-    GlobalMemoryState() : mTlvDictionary(mkMap()) {}
-
-    const tlv::TlvDictionaryInterface &getTlvDictionary() const noexcept override
-    {
-        return mTlvDictionary;
-    }
+    GlobalMemoryState() { getTlvDictionary().invalidateAll(); }
 
 private:
-    using Dictionary = tlv::TlvDictionary<MemoryState>;
-
-    Dictionary::TlvMap mkMap()
-    {
-        using namespace tlv;
-
-        Dictionary::TlvMap tlvMap;
-        tlvMap[MemoryState::Lpsram] =
-            std::make_unique<TlvWrapper<SramStateInfo>>(lpsramState, isLpsramStateValid);
-        tlvMap[MemoryState::Hpsram] =
-            std::make_unique<TlvWrapper<SramStateInfo>>(hpsramState, isHpsramStateValid);
-
-        return tlvMap;
-    }
-
-    Dictionary mTlvDictionary;
+    friend class tlv::TlvStaticResponseHandler<GlobalMemoryState>;
+
+    /* Fields are sorted by tag */
+    using Dictionary = tlv::TlvStaticDictionary<GlobalMemoryState, MemoryState>;
+    using TlvTable = Dictionary::Table<
+        Dictionary::Field<MemoryState::Lpsram, SramStateInfo, &GlobalMemoryState::lpsramState,
+                          &GlobalMemoryState::isLpsramStateValid>,
+        Dictionary::Field<MemoryState::Hpsram, SramStateInfo, &GlobalMemoryState::hpsramState,
+                          &GlobalMemoryState::isHpsramStateValid>>;
 };
 } // dsp_fw
 } // cavs
@@ -33,6 +33,7 @@
 #include "cAVS/DspFw/Common.hpp"
 #include "Util/ByteStreamReader.hpp"
 #include "Util/ByteStreamWriter.hpp"
+#include "Util/MemberList.hpp"
 #include "Util/StructureChangeTracking.hpp"
 
 namespace debug_agent
@@ -124,12 +125,12 @@ struct GlobalPerfData
 
     bool operator==(const GlobalPerfData &other) const { return items == other.items; }
 
-    void fromStream(util::ByteStreamReader &reader) { reader.readVector<ArraySizeType>(items); }
+    using Members = util::MemberList<
+        SERIALIZED_VECTOR_MEMBER(ArraySizeType, GlobalPerfData, items)>;
 
-    void toStream(util::ByteStreamWriter &writer) const
-    {
-        writer.writeVector<ArraySizeType>(items);
-    }
+    void fromStream(util::ByteStreamReader &reader) { Members::fromStream(*this, reader); }
+
+    void toStream(util::ByteStreamWriter &writer) const { Members::toStream(*this, writer); }
 };
 }
 }
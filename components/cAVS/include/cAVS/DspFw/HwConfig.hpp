@@ -31,9 +31,7 @@
 
 #include "cAVS/DspFw/Common.hpp"
 #include "cAVS/DspFw/ConfigTypes.hpp"
-#include "Tlv/TlvResponseHandlerInterface.hpp"
-#include "Tlv/TlvDictionary.hpp"
-#include "Tlv/TlvWrapper.hpp"
+#include "Tlv/TlvStaticDictionary.hpp"
 #include "Util/StructureChangeTracking.hpp"
 #include <vector>
 #include <string>
@@ -56,7 +54,7 @@ namespace dsp_fw
  *
  * @todo this version ignores tag GPDMA_CAPS (5) since definition and FW types are not consistent
  */
-class HwConfig final : public tlv::TlvResponseHandlerInterface
+class HwConfig final : public tlv::TlvStaticResponseHandler<HwConfig>
 {
 public:
     /* GpdmaCapabilities */
@@ -140,47 +138,36 @@ public:
     uint32_t ebbSizeBytes;
     bool isEbbSizeBytesValid;
 
-    HwConfig() : mHwConfigTlvDictionary(mkMap()) {}
-
-    const tlv::TlvDictionaryInterface &getTlvDictionary() const noexcept override
-    {
-        return mHwConfigTlvDictionary;
-    }
+    HwConfig() { getTlvDictionary().invalidateAll(); }
 
 private:
-    using Dictionary = tlv::TlvDictionary<HwConfigParams>;
-
-    Dictionary::TlvMap mkMap()
-    {
-        using Tags = HwConfigParams;
-        using namespace tlv;
-
-        Dictionary::TlvMap tlvMap;
-        tlvMap[Tags::cAVS_VER_HW_CFG] =
-            std::make_unique<TlvWrapper<uint32_t>>(cavsVersion, isCavsVersionValid);
-        tlvMap[Tags::DSP_CORES_HW_CFG] =
-            std::make_unique<TlvWrapper<uint32_t>>(dspCoreCount, isDspCoreCountValid);
-        tlvMap[Tags::MEM_PAGE_BYTES_HW_CFG] =
-            std::make_unique<TlvWrapper<uint32_t>>(memPageSize, isMemPageSizeValid);
-        tlvMap[Tags::TOTAL_PHYS_MEM_PAGES_HW_CFG] = std::make_unique<TlvWrapper<uint32_t>>(
-            totalPhysicalMemoryPage, isTotalPhysicalMemoryPageValid);
-        tlvMap[Tags::I2S_CAPS_HW_CFG] =
-            std::make_unique<TlvWrapper<I2sCapabilities>>(i2sCaps, isI2sCapsValid);
-        tlvMap[Tags::GPDMA_CAPS_HW_CFG] =
-            std::make_unique<TlvWrapper<GpdmaCapabilities>>(gpdmaCaps, isGpdmaCapsValid);
-        tlvMap[Tags::GATEWAY_COUNT_HW_CFG] =
-            std::make_unique<TlvWrapper<uint32_t>>(gatewayCount, isGatewayCountValid);
-        tlvMap[Tags::LP_EBB_COUNT_HW_CFG] =
-            std::make_unique<TlvWrapper<uint32_t>>(lpEbbCount, isLpEbbCountValid);
-        tlvMap[Tags::HP_EBB_COUNT_HW_CFG] =
-            std::make_unique<TlvWrapper<uint32_t>>(hpEbbCount, isHpEbbCountValid);
-        tlvMap[Tags::EBB_SIZE_BYTES_HW_CFG] =
-            std::make_unique<TlvWrapper<uint32_t>>(ebbSizeBytes, isEbbSizeBytesValid);
-
-        return tlvMap;
-    }
-
-    Dictionary mHwConfigTlvDictionary;
+    friend class tlv::TlvStaticResponseHandler<HwConfig>;
+
+    /* Fields are sorted by tag */
+    using Tags = HwConfigParams;
+    using Dictionary = tlv::TlvStaticDictionary<HwConfig, Tags>;
+    using TlvTable = Dictionary::Table<
+        Dictionary::Field<Tags::cAVS_VER_HW_CFG, uint32_t, &HwConfig::cavsVersion,
+                          &HwConfig::isCavsVersionValid>,
+        Dictionary::Field<Tags::DSP_CORES_HW_CFG, uint32_t, &HwConfig::dspCoreCount,
+                          &HwConfig::isDspCoreCountValid>,
+        Dictionary::Field<Tags::MEM_PAGE_BYTES_HW_CFG, uint32_t, &HwConfig::memPageSize,
+                          &HwConfig::isMemPageSizeValid>,
+        Dictionary::Field<Tags::TOTAL_PHYS_MEM_PAGES_HW_CFG, uint32_t,
+                          &HwConfig::totalPhysicalMemoryPage,
+                          &HwConfig::isTotalPhysicalMemoryPageValid>,
+        Dictionary::Field<Tags::I2S_CAPS_HW_CFG, I2sCapabilities, &HwConfig::i2sCaps,
+                          &HwConfig::isI2sCapsValid>,
+        Dictionary::Field<Tags::GPDMA_CAPS_HW_CFG, GpdmaCapabilities, &HwConfig::gpdmaCaps,
+                          &HwConfig::isGpdmaCapsValid>,
+        Dictionary::Field<Tags::GATEWAY_COUNT_HW_CFG, uint32_t, &HwConfig::gatewayCount,
+                          &HwConfig::isGatewayCountValid>,
+        Dictionary::Field<Tags::HP_EBB_COUNT_HW_CFG, uint32_t, &HwConfig::hpEbbCount,
+                          &HwConfig::isHpEbbCountValid>,
+        Dictionary::Field<Tags::LP_EBB_COUNT_HW_CFG, uint32_t, &HwConfig::lpEbbCount,
+                          &HwConfig::isLpEbbCountValid>,
+        Dictionary::Field<Tags::EBB_SIZE_BYTES_HW_CFG, uint32_t, &HwConfig::ebbSizeBytes,
+                          &HwConfig::isEbbSizeBytesValid>>;
 };
 }
 }
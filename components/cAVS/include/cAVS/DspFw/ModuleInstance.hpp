@@ -34,6 +34,7 @@
 #include "cAVS/DspFw/AudioFormat.hpp"
 #include "Util/ByteStreamReader.hpp"
 #include "Util/ByteStreamWriter.hpp"
+#include "Util/MemberList.hpp"
 #include "Util/EnumHelper.hpp"
 #include "Util/StructureChangeTracking.hpp"
 #include <inttypes.h>
@@ -118,6 +119,9 @@ struct ConnectorNodeId
 
     inline uint32_t GetBareNodeId() const { return val.dw; }
 
+    /** Serialized as its memory representation */
+    static const bool hasSerializableMemoryLayout = true;
+
     bool operator==(const ConnectorNodeId &other) const { return val.dw == other.val.dw; }
 
     void fromStream(util::ByteStreamReader &reader) { reader.read(val.dw); }
@@ -146,19 +150,14 @@ struct PinProps
                stream_type == other.stream_type;
     }
 
-    void fromStream(util::ByteStreamReader &reader)
-    {
-        reader.read(stream_type);
-        reader.read(format);
-        reader.read(phys_queue_id);
-    }
+    using Members = util::MemberList<
+        SERIALIZED_MEMBER(PinProps, stream_type),
+        SERIALIZED_MEMBER(PinProps, format),
+        SERIALIZED_MEMBER(PinProps, phys_queue_id)>;
 
-    void toStream(util::ByteStreamWriter &writer) const
-    {
-        writer.write(stream_type);
-        writer.write(format);
-        writer.write(phys_queue_id);
-    }
+    void fromStream(util::ByteStreamReader &reader) { Members::fromStream(*this, reader); }
+
+    void toStream(util::ByteStreamWriter &writer) const { Members::toStream(*this, writer); }
 };
 
 /* PinListInfo */
@@ -172,12 +171,12 @@ struct PinListInfo
 
     bool operator==(const PinListInfo &other) const { return pin_info == other.pin_info; }
 
-    void fromStream(util::ByteStreamReader &reader) { reader.readVector<ArraySizeType>(pin_info); }
+    using Members = util::MemberList<
+        SERIALIZED_VECTOR_MEMBER(ArraySizeType, PinListInfo, pin_info)>;
 
-    void toStream(util::ByteStreamWriter &writer) const
-    {
-        writer.writeVector<ArraySizeType>(pin_info);
-    }
+    void fromStream(util::ByteStreamReader &reader) { Members::fromStream(*this, reader); }
+
+    void toStream(util::ByteStreamWriter &writer) const { Members::toStream(*this, writer); }
 };
 
 /* ModuleInstanceProps */
@@ -229,43 +228,26 @@ struct ModuleInstanceProps
                input_gateway == other.input_gateway && output_gateway == other.output_gateway;
     }
 
-    void fromStream(util::ByteStreamReader &reader)
-    {
-        reader.read(id);
-        reader.read(dp_queue_type);
-        reader.read(queue_alignment);
-        reader.read(cp_usage_mask);
-        reader.read(stack_bytes);
-        reader.read(bss_total_bytes);
-        reader.read(bss_used_bytes);
-        reader.read(ibs_bytes);
-        reader.read(obs_bytes);
-        reader.read(cpc);
-        reader.read(cpc_peak);
-        reader.read(input_pins);
-        reader.read(output_pins);
-        reader.read(input_gateway);
-        reader.read(output_gateway);
-    }
-
-    void toStream(util::ByteStreamWriter &writer) const
-    {
-        writer.write(id);
-        writer.write(dp_queue_type);
-        writer.write(queue_alignment);
-        writer.write(cp_usage_mask);
-        writer.write(stack_bytes);
-        writer.write(bss_total_bytes);
-        writer.write(bss_used_bytes);
-        writer.write(ibs_bytes);
-        writer.write(obs_bytes);
-        writer.write(cpc);
-        writer.write(cpc_peak);
-        writer.write(input_pins);
-        writer.write(output_pins);
-        writer.write(input_gateway);
-        writer.write(output_gateway);
-    }
+    using Members = util::MemberList<
+        SERIALIZED_MEMBER(ModuleInstanceProps, id),
+        SERIALIZED_MEMBER(ModuleInstanceProps, dp_queue_type),
+        SERIALIZED_MEMBER(ModuleInstanceProps, queue_alignment),
+        SERIALIZED_MEMBER(ModuleInstanceProps, cp_usage_mask),
+        SERIALIZED_MEMBER(ModuleInstanceProps, stack_bytes),
+        SERIALIZED_MEMBER(ModuleInstanceProps, bss_total_bytes),
+        SERIALIZED_MEMBER(ModuleInstanceProps, bss_used_bytes),
+        SERIALIZED_MEMBER(ModuleInstanceProps, ibs_bytes),
+        SERIALIZED_MEMBER(ModuleInstanceProps, obs_bytes),
+        SERIALIZED_MEMBER(ModuleInstanceProps, cpc),
+        SERIALIZED_MEMBER(ModuleInstanceProps, cpc_peak),
+        SERIALIZED_MEMBER(ModuleInstanceProps, input_pins),
+        SERIALIZED_MEMBER(ModuleInstanceProps, output_pins),
+        SERIALIZED_MEMBER(ModuleInstanceProps, input_gateway),
+        SERIALIZED_MEMBER(ModuleInstanceProps, output_gateway)>;
+
+    void fromStream(util::ByteStreamReader &reader) { Members::fromStream(*this, reader); }
+
+    void toStream(util::ByteStreamWriter &writer) const { Members::toStream(*this, writer); }
 };
 }
 }
@@ -33,6 +33,7 @@
 #include "cAVS/DspFw/Common.hpp"
 #include "Util/ByteStreamReader.hpp"
 #include "Util/ByteStreamWriter.hpp"
+#include "Util/MemberList.hpp"
 #include "Util/StructureChangeTracking.hpp"
 #include "Util/StringHelper.hpp"
 
@@ -69,6 +70,9 @@ union SegmentFlags
         uint32_t length : 16; // segment length in pages
     } r;
 
+    /** Serialized as its memory representation */
+    static const bool hasSerializableMemoryLayout = true;
+
     bool operator==(const SegmentFlags &other) const { return ul == other.ul; }
 
     void fromStream(util::ByteStreamReader &reader) { reader.read(ul); }
@@ -89,25 +93,23 @@ struct SegmentDesc
     uint32_t v_base_addr;
     uint32_t file_offset;
 
+    /** Serialized as its memory representation */
+    static const bool hasSerializableMemoryLayout = true;
+
     bool operator==(const SegmentDesc &other) const
     {
         return flags == other.flags && v_base_addr == other.v_base_addr &&
                file_offset == other.file_offset;
     }
 
-    void fromStream(util::ByteStreamReader &reader)
-    {
-        reader.read(flags);
-        reader.read(v_base_addr);
-        reader.read(file_offset);
-    }
+    using Members = util::MemberList<
+        SERIALIZED_MEMBER(SegmentDesc, flags),
+        SERIALIZED_MEMBER(SegmentDesc, v_base_addr),
+        SERIALIZED_MEMBER(SegmentDesc, file_offset)>;
 
-    void toStream(util::ByteStreamWriter &writer) const
-    {
-        writer.write(flags);
-        writer.write(v_base_addr);
-        writer.write(file_offset);
-    }
+    void fromStream(util::ByteStreamReader &reader) { Members::fromStream(*this, reader); }
+
+    void toStream(util::ByteStreamWriter &writer) const { Members::toStream(*this, writer); }
 };
 
 /* ModuleType */
@@ -127,6 +129,9 @@ union ModuleType
         uint32_t _rsvd : 25;
     } r;
 
+    /** Serialized as its memory representation */
+    static const bool hasSerializableMemoryLayout = true;
+
     bool operator==(const ModuleType &other) const { return ul == other.ul; }
 
     void fromStream(util::ByteStreamReader &reader) { reader.read(ul); }
@@ -182,45 +187,24 @@ public:
                isArrayEqual(segments, other.segments, segmentCount);
     }
 
-    void fromStream(util::ByteStreamReader &reader)
-    {
-        reader.read(module_id);
-        reader.read(state_flags);
-        reader.read(name);
-        reader.read(uuid);
-        reader.read(type);
-        reader.read(hash);
-        reader.read(entry_point);
-        reader.read(cfg_offset);
-        reader.read(cfg_count);
-        reader.read(affinity_mask);
-        reader.read(instance_max_count);
-        reader.read(instance_stack_size);
-
-        for (std::size_t i = 0; i < segmentCount; i++) {
-            reader.read(segments[i]);
-        }
-    }
-
-    void toStream(util::ByteStreamWriter &writer) const
-    {
-        writer.write(module_id);
-        writer.write(state_flags);
-        writer.write(name);
-        writer.write(uuid);
-        writer.write(type);
-        writer.write(hash);
-        writer.write(entry_point);
-        writer.write(cfg_offset);
-        writer.write(cfg_count);
-        writer.write(affinity_mask);
-        writer.write(instance_max_count);
-        writer.write(instance_stack_size);
-
-        for (std::size_t i = 0; i < segmentCount; i++) {
-            writer.write(segments[i]);
-        }
-    }
+    using Members = util::MemberList<
+        SERIALIZED_MEMBER(ModuleEntry, module_id),
+        SERIALIZED_MEMBER(ModuleEntry, state_flags),
+        SERIALIZED_MEMBER(ModuleEntry, name),
+        SERIALIZED_MEMBER(ModuleEntry, uuid),
+        SERIALIZED_MEMBER(ModuleEntry, type),
+        SERIALIZED_MEMBER(ModuleEntry, hash),
+        SERIALIZED_MEMBER(ModuleEntry, entry_point),
+        SERIALIZED_MEMBER(ModuleEntry, cfg_offset),
+        SERIALIZED_MEMBER(ModuleEntry, cfg_count),
+        SERIALIZED_MEMBER(ModuleEntry, affinity_mask),
+        SERIALIZED_MEMBER(ModuleEntry, instance_max_count),
+        SERIALIZED_MEMBER(ModuleEntry, instance_stack_size),
+        SERIALIZED_MEMBER(ModuleEntry, segments)>;
+
+    void fromStream(util::ByteStreamReader &reader) { Members::fromStream(*this, reader); }
+
+    void toStream(util::ByteStreamWriter &writer) const { Members::toStream(*this, writer); }
 
     std::string getName() const
     {
@@ -258,17 +242,14 @@ struct ModulesInfo
         return sizeof(ArraySizeType) + count * sizeof(ModuleEntry);
     }
 
-    bool operator==(const ModulesInfo &other) { return module_info == other.module_info; }
+    bool operator==(const ModulesInfo &other) const { return module_info == other.module_info; }
 
-    void fromStream(util::ByteStreamReader &reader)
-    {
-        reader.readVector<ArraySizeType>(module_info);
-    }
+    using Members = util::MemberList<
+        SERIALIZED_VECTOR_MEMBER(ArraySizeType, ModulesInfo, module_info)>;
 
-    void toStream(util::ByteStreamWriter &writer) const
-    {
-        writer.writeVector<ArraySizeType>(module_info);
-    }
+    void fromStream(util::ByteStreamReader &reader) { Members::fromStream(*this, reader); }
+
+    void toStream(util::ByteStreamWriter &writer) const { Members::toStream(*this, writer); }
 };
 }
 }
@@ -34,6 +34,7 @@
 #include "Util/WrappedRaw.hpp"
 #include "Util/ByteStreamReader.hpp"
 #include "Util/ByteStreamWriter.hpp"
+#include "Util/MemberList.hpp"
 #include "Util/StructureChangeTracking.hpp"
 
 namespace debug_agent
@@ -69,12 +70,12 @@ struct PipelinesListInfo
 
     bool operator==(const PipelinesListInfo &other) const { return ppl_id == other.ppl_id; }
 
-    void fromStream(util::ByteStreamReader &reader) { reader.readVector<ArraySizeType>(ppl_id); }
+    using Members = util::MemberList<
+        SERIALIZED_VECTOR_MEMBER(ArraySizeType, PipelinesListInfo, ppl_id)>;
 
-    void toStream(util::ByteStreamWriter &writer) const
-    {
-        writer.writeVector<ArraySizeType>(ppl_id);
-    }
+    void fromStream(util::ByteStreamReader &reader) { Members::fromStream(*this, reader); }
+
+    void toStream(util::ByteStreamWriter &writer) const { Members::toStream(*this, writer); }
 };
 
 /* ModInstListInfo */
@@ -124,31 +125,20 @@ struct PplProps
                ll_tasks == other.ll_tasks && ll_tasks == other.ll_tasks;
     }
 
-    void fromStream(util::ByteStreamReader &reader)
-    {
-        reader.read(id);
-        reader.read(priority);
-        reader.read(state);
-        reader.read(total_memory_bytes);
-        reader.read(used_memory_bytes);
-        reader.read(context_pages);
-        reader.readVector<ArraySizeType>(module_instances);
-        reader.readVector<ArraySizeType>(ll_tasks);
-        reader.readVector<ArraySizeType>(dp_tasks);
-    }
+    using Members = util::MemberList<
+        SERIALIZED_MEMBER(PplProps, id),
+        SERIALIZED_MEMBER(PplProps, priority),
+        SERIALIZED_MEMBER(PplProps, state),
+        SERIALIZED_MEMBER(PplProps, total_memory_bytes),
+        SERIALIZED_MEMBER(PplProps, used_memory_bytes),
+        SERIALIZED_MEMBER(PplProps, context_pages),
+        SERIALIZED_VECTOR_MEMBER(ArraySizeType, PplProps, module_instances),
+        SERIALIZED_VECTOR_MEMBER(ArraySizeType, PplProps, ll_tasks),
+        SERIALIZED_VECTOR_MEMBER(ArraySizeType, PplProps, dp_tasks)>;
 
-    void toStream(util::ByteStreamWriter &writer) const
-    {
-        writer.write(id);
-        writer.write(priority);
-        writer.write(state);
-        writer.write(total_memory_bytes);
-        writer.write(used_memory_bytes);
-        writer.write(context_pages);
-        writer.writeVector<ArraySizeType>(module_instances);
-        writer.writeVector<ArraySizeType>(ll_tasks);
-        writer.writeVector<ArraySizeType>(dp_tasks);
-    }
+    void fromStream(util::ByteStreamReader &reader) { Members::fromStream(*this, reader); }
+
+    void toStream(util::ByteStreamWriter &writer) const { Members::toStream(*this, writer); }
 };
 }
 }
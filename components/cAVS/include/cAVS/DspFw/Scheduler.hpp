@@ -34,6 +34,7 @@
 #include "Util/WrappedRaw.hpp"
 #include "Util/ByteStreamReader.hpp"
 #include "Util/ByteStreamWriter.hpp"
+#include "Util/MemberList.hpp"
 #include "Util/StructureChangeTracking.hpp"
 
 namespace debug_agent
@@ -68,17 +69,13 @@ struct TaskProps
         return task_id == other.task_id && module_instance_id == other.module_instance_id;
     }
 
-    void fromStream(util::ByteStreamReader &reader)
-    {
-        reader.read(task_id);
-        reader.readVector<ArraySizeType>(module_instance_id);
-    }
+    using Members = util::MemberList<
+        SERIALIZED_MEMBER(TaskProps, task_id),
+        SERIALIZED_VECTOR_MEMBER(ArraySizeType, TaskProps, module_instance_id)>;
 
-    void toStream(util::ByteStreamWriter &writer) const
-    {
-        writer.write(task_id);
-        writer.writeVector<ArraySizeType>(module_instance_id);
-    }
+    void fromStream(util::ByteStreamReader &reader) { Members::fromStream(*this, reader); }
+
+    void toStream(util::ByteStreamWriter &writer) const { Members::toStream(*this, writer); }
 };
 
 /* SchedulerProps */
@@ -100,19 +97,14 @@ struct SchedulerProps
                task_info == other.task_info;
     }
 
-    void fromStream(util::ByteStreamReader &reader)
-    {
-        reader.read(processing_domain);
-        reader.read(core_id);
-        reader.readVector<ArraySizeType>(task_info);
-    }
+    using Members = util::MemberList<
+        SERIALIZED_MEMBER(SchedulerProps, processing_domain),
+        SERIALIZED_MEMBER(SchedulerProps, core_id),
+        SERIALIZED_VECTOR_MEMBER(ArraySizeType, SchedulerProps, task_info)>;
 
-    void toStream(util::ByteStreamWriter &writer) const
-    {
-        writer.write(processing_domain);
-        writer.write(core_id);
-        writer.writeVector<ArraySizeType>(task_info);
-    }
+    void fromStream(util::ByteStreamReader &reader) { Members::fromStream(*this, reader); }
+
+    void toStream(util::ByteStreamWriter &writer) const { Members::toStream(*this, writer); }
 };
 
 /* SchedulersInfo */
@@ -130,15 +122,12 @@ struct SchedulersInfo
         return scheduler_info == other.scheduler_info;
     }
 
-    void fromStream(util::ByteStreamReader &reader)
-    {
-        reader.readVector<ArraySizeType>(scheduler_info);
-    }
+    using Members = util::MemberList<
+        SERIALIZED_VECTOR_MEMBER(ArraySizeType, SchedulersInfo, scheduler_info)>;
 
-    void toStream(util::ByteStreamWriter &writer) const
-    {
-        writer.writeVector<ArraySizeType>(scheduler_info);
-    }
+    void fromStream(util::ByteStreamReader &reader) { Members::fromStream(*this, reader); }
+
+    void toStream(util::ByteStreamWriter &writer) const { Members::toStream(*this, writer); }
 };
 }
 }
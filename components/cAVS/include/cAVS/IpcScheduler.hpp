@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2016, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include "Util/EnumHelper.hpp"
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <list>
+#include <mutex>
+
+namespace debug_agent
+{
+namespace cavs
+{
+
+/** Priority classes of the firmware IPCs, from the most to the least urgent */
+enum class IpcClass
+{
+    /** Commands issued on behalf of a client waiting for them, e.g. module parameter access */
+    InteractiveControl,
+    /** Commands starting, stopping or configuring a data stream (perf, probes) */
+    StreamingControl,
+    /** Bulk reads of the firmware state, e.g. topology */
+    BulkIntrospection,
+    /** Periodic reads, e.g. performance data */
+    BackgroundPolling
+};
+
+/** Scheduling statistics of an IPC class */
+struct IpcClassStatistics
+{
+    /** The count of IPCs granted */
+    std::size_t requestCount;
+    /** The count of IPCs currently waiting for the firmware */
+    std::size_t queueDepth;
+    /** The highest count of IPCs waiting at the same time */
+    std::size_t maxQueueDepth;
+    /** The count of IPCs granted before more urgent ones by the starvation protection */
+    std::size_t promotedCount;
+    /** The cumulated and highest delay between the request and the grant of an IPC */
+    std::chrono::microseconds totalWait;
+    std::chrono::microseconds maxWait;
+};
+
+/** Orders the firmware IPCs by priority class
+ *
+ * The firmware processes one IPC at a time. When the firmware is busy, the requested IPCs wait
+ * and are granted by priority class, in request order inside a class.
+ *
+ * Starvation protection: an IPC that has been overtaken maxOvertakeCount times by more urgent
+ * ones is granted next, whatever its class.
+ */
+class IpcScheduler
+{
+    struct Request;
+
+public:
+    static const std::size_t classCount = 4;
+    static const std::size_t defaultMaxOvertakeCount = 16;
+
+    static const util::EnumHelper<IpcClass> &ipcClassHelper()
+    {
+        static const util::EnumHelper<IpcClass> helper(
+            {{IpcClass::InteractiveControl, "interactive_control"},
+             {IpcClass::StreamingControl, "streaming_control"},
+             {IpcClass::BulkIntrospection, "bulk_introspection"},
+             {IpcClass::BackgroundPolling, "background_polling"}});
+        return helper;
+    }
+
+    /** The right to send an IPC to the firmware, which is released at destruction */
+    class Slot
+    {
+    public:
+        Slot(Slot &&other) noexcept : mScheduler(other.mScheduler) { other.mScheduler = nullptr; }
+        Slot(const Slot &) = delete;
+        Slot &operator=(const Slot &) = delete;
+        Slot &operator=(Slot &&) = delete;
+
+        ~Slot()
+        {
+            if (mScheduler != nullptr) {
+                mScheduler->release();
+            }
+        }
+
+    private:
+        friend class IpcScheduler;
+        Slot(IpcScheduler &scheduler) : mScheduler(&scheduler) {}
+
+        IpcScheduler *mScheduler;
+    };
+
+    /** The class of an IPC that may become more urgent while it waits, for instance because
+     * more urgent requests have been merged into it. It is guarded by the scheduler. */
+    class Urgency
+    {
+    public:
+        explicit Urgency(IpcClass ipcClass = IpcClass::BackgroundPolling) : mClass(ipcClass) {}
+        Urgency(const Urgency &) = delete;
+        Urgency &operator=(const Urgency &) = delete;
+
+    private:
+        friend class IpcScheduler;
+
+        IpcClass mClass;
+        /** The request waiting for the firmware, if any */
+        Request *mRequest = nullptr;
+    };
+
+    IpcScheduler(std::size_t maxOvertakeCount = defaultMaxOvertakeCount)
+        : mMaxOvertakeCount(maxOvertakeCount)
+    {
+    }
+    IpcScheduler(const IpcScheduler &) = delete;
+    IpcScheduler &operator=(const IpcScheduler &) = delete;
+
+    /** Wait until an IPC of the supplied class can be sent to the firmware */
+    Slot acquire(IpcClass ipcClass);
+
+    /** Wait until an IPC can be sent to the firmware, the IPC being scheduled at the class of
+     * the supplied urgency, which may be raised during the wait */
+    Slot acquire(Urgency &urgency);
+
+    /** Raise an urgency to the supplied class if it is more urgent, including when its IPC is
+     * already waiting for the firmware */
+    void raise(Urgency &urgency, IpcClass ipcClass);
+
+    IpcClassStatistics getStatistics(IpcClass ipcClass) const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Request
+    {
+        Request(IpcClass ipcClass) : ipcClass(ipcClass), requestTime(Clock::now()) {}
+
+        IpcClass ipcClass;
+        Clock::time_point requestTime;
+        std::size_t overtakeCount = 0;
+        bool granted = false;
+    };
+
+    /** Grant the firmware to the next waiting IPC, if any */
+    void release();
+
+    /** Account an IPC grant, mMutex shall be locked */
+    void grant(Request &request, bool promoted);
+
+    IpcClassStatistics &getClassStatistics(IpcClass ipcClass)
+    {
+        return mStatistics[static_cast<std::size_t>(ipcClass)];
+    }
+
+    const std::size_t mMaxOvertakeCount;
+
+    mutable std::mutex mMutex;
+    std::condition_variable mCondition;
+    bool mBusy = false;
+    /** Waiting IPCs, in request order */
+    std::list<Request *> mWaiting;
+    std::array<IpcClassStatistics, classCount> mStatistics{};
+};
+}
+}
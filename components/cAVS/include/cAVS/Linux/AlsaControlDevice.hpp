@@ -31,8 +31,11 @@
 #pragma once
 
 #include "cAVS/Linux/ControlDevice.hpp"
+#include "cAVS/Linux/AlsaControlElementCache.hpp"
 #include "Util/ByteStreamReader.hpp"
 #include "Util/ByteStreamWriter.hpp"
+#include <memory>
+#include <mutex>
 
 namespace private_driver
 {
@@ -47,6 +50,11 @@ namespace linux
 {
 
 /** This class abstracts a Linux ALSA Device for control operation (ctl read, ctl write)
+ *
+ * The control handle of the card is opened once for the device lifetime, and the resolved
+ * identifier and information of each accessed control element are cached by control name, as
+ * well as the element list used by getControlCountByTag(). The handle is subscribed to the card
+ * events: any element addition, removal or information change invalidates these caches.
  */
 class AlsaControlDevice final : public ControlDevice
 {
@@ -76,6 +84,7 @@ private:
 public:
     /** @throw Device::Exception if the device initialization has failed */
     AlsaControlDevice(const std::string &name);
+    ~AlsaControlDevice();
 
     void ctlRead(const std::string &name, util::Buffer &bufferOutput) override;
     void ctlWrite(const std::string &name, const util::Buffer &bufferInput) override;
@@ -83,16 +92,45 @@ public:
     size_t getControlCountByTag(const std::string &name) const override;
 
 private:
-    void getCtlHandle(const std::string &name, private_driver::snd_ctl_t *&handle,
-                      private_driver::snd_ctl_elem_id_t &id,
-                      private_driver::snd_ctl_elem_info_t &info,
-                      private_driver::snd_ctl_elem_value_t &control) const;
+    /** Control element resolved from its name */
+    struct Element
+    {
+        Element();
+
+        std::unique_ptr<private_driver::snd_ctl_elem_id_t,
+                        void (*)(private_driver::snd_ctl_elem_id_t *)>
+            id;
+        std::unique_ptr<private_driver::snd_ctl_elem_info_t,
+                        void (*)(private_driver::snd_ctl_elem_info_t *)>
+            info;
+    };
+
+    /** @return the element of the given control, resolved on first use
+     * @throw ControlDevice::Exception if the control can not be found
+     * @note mMutex shall be held by the caller
+     */
+    const Element &getElement(const std::string &name);
+
+    /** @return the element of the given control, resolved from the card
+     * @throw ControlDevice::Exception if the control can not be found
+     */
+    Element resolveElement(const std::string &name) const;
+
+    /** Read the pending card events and invalidate the caches if the element set has changed
+     * @note mMutex shall be held by the caller
+     */
+    void processCardEvents() const;
 
     static std::string getCtlName(const std::string &name)
     {
         return std::string{"name='" + name + "'"};
     }
     std::string mControl;
+    private_driver::snd_ctl_t *mHandle = nullptr;
+
+    /* Caches are shared by the clients of the device (logger, prober...) */
+    mutable std::mutex mMutex;
+    mutable AlsaControlElementCache<Element> mCache;
 };
 }
 }
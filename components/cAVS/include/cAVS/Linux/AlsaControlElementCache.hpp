@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2016, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <cerrno>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace private_driver
+{
+#include <alsa/asoundlib.h>
+}
+
+namespace debug_agent
+{
+namespace cavs
+{
+namespace linux
+{
+
+/** Cache of the control elements of a card, resolved from their names, and of the list of the
+ * card element identifiers.
+ *
+ * The cache is invalidated by the card events which change the element set, and an element is
+ * evicted when an access to it fails. It is not thread safe: the owning device serializes the
+ * calls.
+ *
+ * @tparam Element the resolved element type
+ */
+template <typename Element>
+class AlsaControlElementCache
+{
+public:
+    /** Read the pending card events and invalidate the cache if the element set has changed
+     *
+     * @param[in] readEvent reads the next pending event as snd_ctl_read() does, with the
+     *                      signature int(unsigned int &mask). It returns a positive value if an
+     *                      event has been read, 0 or -EAGAIN if none is pending and another
+     *                      negative value on error. 'mask' is set to the event mask of element
+     *                      events and to 0 for other events.
+     */
+    template <typename ReadEvent>
+    void processEvents(ReadEvent readEvent)
+    {
+        unsigned int mask = 0;
+        int error;
+        while ((error = readEvent(mask)) > 0) {
+            /* Value changes, including the ones of our own writes, do not affect the cache. */
+            if (mask == SND_CTL_EVENT_MASK_REMOVE ||
+                (mask & (SND_CTL_EVENT_MASK_ADD | SND_CTL_EVENT_MASK_INFO)) != 0) {
+                invalidate();
+            }
+        }
+        if (error < 0 && error != -EAGAIN) {
+            /* Events may have been lost: the cache can not be trusted anymore */
+            invalidate();
+        }
+    }
+
+    /** @return the element of the given control, resolved on first use
+     *
+     * @param[in] name the control name
+     * @param[in] resolve resolves an element from the control name, with the signature
+     *                    Element(const std::string &name). It shall throw on failure, in which
+     *                    case nothing is cached.
+     */
+    template <typename Resolve>
+    const Element &getElement(const std::string &name, Resolve resolve)
+    {
+        auto it = mElements.find(name);
+        if (it != mElements.end()) {
+            return it->second;
+        }
+        return mElements.emplace(name, resolve(name)).first->second;
+    }
+
+    /** Perform an access to the element of the given control, evicting it if the access fails,
+     * so that it will be resolved again on next use.
+     *
+     * @param[in] name the control name
+     * @param[in] access the access, returning an alsa-lib result: negative on failure
+     * @return the access result
+     */
+    template <typename Access>
+    int access(const std::string &name, Access access)
+    {
+        int result = access();
+        if (result < 0) {
+            mElements.erase(name);
+        }
+        return result;
+    }
+
+    /** @return the identifiers of the card elements, listed on first use
+     *
+     * @param[in] list lists the identifiers of the card elements, with the signature
+     *                 void(std::vector<std::string> &ids). It shall throw on failure, in which
+     *                 case they are listed again on next use.
+     */
+    template <typename List>
+    const std::vector<std::string> &getElementIds(List list)
+    {
+        if (!mElementIdsValid) {
+            mElementIds.clear();
+            list(mElementIds);
+            mElementIdsValid = true;
+        }
+        return mElementIds;
+    }
+
+    void invalidate()
+    {
+        mElements.clear();
+        mElementIdsValid = false;
+    }
+
+private:
+    std::map<std::string, Element> mElements;
+    std::vector<std::string> mElementIds;
+    bool mElementIdsValid = false;
+};
+}
+}
+}
@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2016, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include "cAVS/Linux/CorePower.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+namespace debug_agent
+{
+namespace cavs
+{
+namespace linux
+{
+
+/**
+ * Coalesces the core power votes of concurrent or back-to-back firmware commands.
+ *
+ * Each command holds a Vote during its execution. The first vote of a burst prevents the core from
+ * sleeping, and the core is allowed to sleep again once no vote has been held during the idle
+ * timeout. Commands issued in the meantime, from any thread, reuse the vote already cast instead of
+ * sending their own prevent/allow command pair to the driver.
+ *
+ * With a null idle timeout, the core is allowed to sleep as soon as the last vote is released,
+ * which behaves as a CorePower::Auto per burst of overlapping votes.
+ *
+ * @tparam Exception The type of exception to be thrown.
+ */
+template <class Exception>
+class CorePowerVoter
+{
+public:
+    /** Scope class that holds a vote during its lifetime */
+    class Vote
+    {
+    public:
+        Vote(CorePowerVoter<Exception> &voter) : mVoter(voter) { mVoter.acquire(); }
+        ~Vote() { mVoter.release(); }
+    private:
+        Vote(const Vote &) = delete;
+        Vote &operator=(const Vote &) = delete;
+
+        CorePowerVoter<Exception> &mVoter;
+    };
+
+    CorePowerVoter(Device &device,
+                   std::chrono::milliseconds idleTimeout = std::chrono::milliseconds(0))
+        : mCorePower(device), mIdleTimeout(idleTimeout)
+    {
+        if (mIdleTimeout > std::chrono::milliseconds(0)) {
+            mReleaseThread = std::thread(&CorePowerVoter::releaseOnIdle, this);
+        }
+    }
+
+    ~CorePowerVoter()
+    {
+        {
+            std::lock_guard<std::mutex> locker(mMutex);
+            mStopRequested = true;
+        }
+        mCondition.notify_one();
+        if (mReleaseThread.joinable()) {
+            mReleaseThread.join();
+        }
+        if (mCoreAwake) {
+            mCorePower.allowCoreToSleepNoExcept();
+        }
+    }
+
+    /** @return the number of core power commands saved by reusing a vote already cast, i.e. two
+     *          (prevent and allow) per reused vote.
+     */
+    uint64_t getSavedToggleCount() const
+    {
+        std::lock_guard<std::mutex> locker(mMutex);
+        return mSavedToggleCount;
+    }
+
+private:
+    CorePowerVoter(const CorePowerVoter &) = delete;
+    CorePowerVoter &operator=(const CorePowerVoter &) = delete;
+
+    void acquire()
+    {
+        std::lock_guard<std::mutex> locker(mMutex);
+        if (mCoreAwake) {
+            mSavedToggleCount += 2;
+        } else {
+            /* Throws if the vote can not be cast, the reference count is then left unchanged. */
+            mCorePower.preventCoreFromSleeping();
+            mCoreAwake = true;
+        }
+        ++mVoteCount;
+    }
+
+    void release() noexcept
+    {
+        std::lock_guard<std::mutex> locker(mMutex);
+        if (--mVoteCount > 0) {
+            return;
+        }
+        if (mReleaseThread.joinable()) {
+            mIdleDeadline = std::chrono::steady_clock::now() + mIdleTimeout;
+            mCondition.notify_one();
+        } else {
+            mCorePower.allowCoreToSleepNoExcept();
+            mCoreAwake = false;
+        }
+    }
+
+    /** Body of the thread allowing the core to sleep once the voter is idle */
+    void releaseOnIdle()
+    {
+        std::unique_lock<std::mutex> locker(mMutex);
+        while (!mStopRequested) {
+            if (!mCoreAwake || mVoteCount > 0) {
+                mCondition.wait(locker);
+            } else if (std::chrono::steady_clock::now() < mIdleDeadline) {
+                mCondition.wait_until(locker, mIdleDeadline);
+            } else {
+                mCorePower.allowCoreToSleepNoExcept();
+                mCoreAwake = false;
+            }
+        }
+    }
+
+    CorePower<Exception> mCorePower;
+    const std::chrono::milliseconds mIdleTimeout;
+
+    mutable std::mutex mMutex;
+    std::condition_variable mCondition;
+    std::size_t mVoteCount = 0;
+    bool mCoreAwake = false;
+    bool mStopRequested = false;
+    std::chrono::steady_clock::time_point mIdleDeadline;
+    uint64_t mSavedToggleCount = 0;
+    std::thread mReleaseThread;
+};
+}
+}
+}
@@ -39,6 +39,7 @@
 #include "cAVS/Linux/Perf.hpp"
 #include "cAVS/Linux/Prober.hpp"
 #include "Util/AssertAlways.hpp"
+#include <chrono>
 #include <utility>
 
 namespace debug_agent
@@ -54,13 +55,18 @@ namespace linux
 class Driver final : public cavs::Driver
 {
 public:
+    /** @param[in] corePowerIdleTimeout delay during which the core is kept awake after a module
+     *                                 command, in order to coalesce the core power votes of
+     *                                 command bursts
+     */
     Driver(std::unique_ptr<Device> device, std::unique_ptr<ControlDevice> controlDevice,
-           std::unique_ptr<CompressDeviceFactory> compressDeviceFactory)
+           std::unique_ptr<CompressDeviceFactory> compressDeviceFactory,
+           std::chrono::milliseconds corePowerIdleTimeout = std::chrono::milliseconds(0))
         : mDevice(std::move(device)), mControlDevice(std::move(controlDevice)),
           mCompressDeviceFactory(std::move(compressDeviceFactory)),
           mLogger(*mDevice, *mControlDevice, *mCompressDeviceFactory),
           mProber(*mControlDevice, *mCompressDeviceFactory),
-          mModuleHandler(std::make_unique<ModuleHandlerImpl>(*mDevice)),
+          mModuleHandler(std::make_unique<ModuleHandlerImpl>(*mDevice, corePowerIdleTimeout)),
           mPerf(*mDevice, mModuleHandler)
     {
         ASSERT_ALWAYS(mCompressDeviceFactory != nullptr);
@@ -146,6 +146,9 @@ struct MessageHeader
         writer.write(extendedWord);
     }
     virtual size_t getReplyPayloadSize() const { return extended.dataDize; }
+
+    /** @return the size written by toStream() */
+    virtual size_t getSerializedSize() const { return sizeof(primaryWord) + sizeof(extendedWord); }
 };
 
 struct TunneledMessageHeader : public MessageHeader
@@ -172,6 +175,12 @@ struct TunneledMessageHeader : public MessageHeader
 
     size_t getReplyPayloadSize() const override { return mTunneledHeader.mParamSize; }
 
+    size_t getSerializedSize() const override
+    {
+        return MessageHeader::getSerializedSize() + sizeof(mTunneledHeader.mParamId) +
+               sizeof(mTunneledHeader.mParamSize);
+    }
+
     TunneledHeader mTunneledHeader;
 };
 
@@ -209,6 +218,12 @@ public:
 
     size_t getReplyPayloadSize() const { return mHeader->getReplyPayloadSize(); }
 
+    /** @return the size written by toStream(), allowing to allocate the message at once */
+    size_t getSerializedSize() const
+    {
+        return sizeof(mSize) + mHeader->getSerializedSize() + mParameterPayload.size();
+    }
+
 private:
     uint32_t mSize;
     std::unique_ptr<MessageHeader> mHeader;
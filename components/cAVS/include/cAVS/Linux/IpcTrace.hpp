@@ -0,0 +1,213 @@
+/*
+ * Copyright (c) 2016, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include "Util/Buffer.hpp"
+#include "Util/ByteStreamReader.hpp"
+#include "Util/ByteStreamWriter.hpp"
+#include "Util/Exception.hpp"
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <inttypes.h>
+
+namespace debug_agent
+{
+namespace cavs
+{
+namespace linux
+{
+
+/** Driver access recorded in an IPC trace */
+enum class IpcTraceOperation : uint32_t
+{
+    CommandWrite,          /**< Device::commandWrite() */
+    CommandRead,           /**< Device::commandRead() */
+    ControlRead,           /**< ControlDevice::ctlRead() */
+    ControlWrite,          /**< ControlDevice::ctlWrite() */
+    ControlCount,          /**< ControlDevice::getControlCountByTag() */
+    LoggerDevices,         /**< CompressDeviceFactory::getLoggerDeviceInfoList() */
+    InjectionProbeDevices, /**< CompressDeviceFactory::getInjectionProbeDeviceInfoList() */
+    ExtractionProbeDevice, /**< CompressDeviceFactory::getExtractionProbeDeviceInfo() */
+    CompressCreate,        /**< CompressDeviceFactory::newCompressDevice() */
+    CompressOpen,
+    CompressStart,
+    CompressStop,
+    CompressWait,
+    CompressRead,
+    CompressWrite,
+    CompressAvailable,
+    CompressBufferSize
+};
+
+/** Outcome of a recorded driver access */
+enum class IpcTraceStatus : uint32_t
+{
+    Succeeded,
+    Failed,     /**< The access has thrown an exception */
+    Interrupted /**< The compress wait has been interrupted by a stop of the device */
+};
+
+/** Compress device description, as returned by the CompressDeviceFactory */
+struct IpcTraceDeviceInfo
+{
+    uint32_t cardId;
+    uint32_t deviceId;
+    /** Core id of a logger device, probe index of an injection device, 0 otherwise */
+    uint32_t index;
+
+    bool operator==(const IpcTraceDeviceInfo &other) const
+    {
+        return cardId == other.cardId && deviceId == other.deviceId && index == other.index;
+    }
+
+    void fromStream(util::ByteStreamReader &reader)
+    {
+        reader.read(cardId);
+        reader.read(deviceId);
+        reader.read(index);
+    }
+
+    void toStream(util::ByteStreamWriter &writer) const
+    {
+        writer.write(cardId);
+        writer.write(deviceId);
+        writer.write(index);
+    }
+};
+
+/** A driver access: its arguments, its outcome and what it has returned */
+struct IpcTraceRecord
+{
+    IpcTraceRecord() = default;
+    IpcTraceRecord(IpcTraceOperation operation, const std::string &target)
+        : operation(operation), target(target)
+    {
+    }
+
+    IpcTraceOperation operation = IpcTraceOperation::CommandWrite;
+    IpcTraceStatus status = IpcTraceStatus::Succeeded;
+
+    /** Start time of the access, in microseconds since the beginning of the recording */
+    uint64_t timestamp = 0;
+
+    /** Debugfs entry, control name or tag, or compress device name */
+    std::string target;
+
+    /** Written buffer */
+    util::Buffer input;
+
+    /** Content of the read buffer before the access, which may carry a command */
+    util::Buffer output;
+
+    /** Content of the read buffer after the access */
+    util::Buffer reply;
+
+    /** Timeout of a compress wait */
+    int64_t argument = 0;
+
+    /** Returned size or count, reply of a compress wait */
+    int64_t result = 0;
+
+    /** Compress devices returned or created by the CompressDeviceFactory */
+    std::vector<IpcTraceDeviceInfo> devices;
+
+    bool operator==(const IpcTraceRecord &other) const
+    {
+        return operation == other.operation && status == other.status &&
+               timestamp == other.timestamp && target == other.target && input == other.input &&
+               output == other.output && reply == other.reply && argument == other.argument &&
+               result == other.result && devices == other.devices;
+    }
+
+    /** Buffers are serialized without their trailing zeros: read buffers are zero filled
+     * before a debugfs command, and mostly hold a short reply. */
+    void fromStream(util::ByteStreamReader &reader);
+    void toStream(util::ByteStreamWriter &writer) const;
+};
+
+/** Writes the driver accesses to a binary trace file
+ *
+ * The file starts with a magic number and a format version, followed by the serialized
+ * records. Records are written when their access is completed: concurrent accesses may not be
+ * ordered by timestamp.
+ *
+ * This class is thread safe.
+ */
+class IpcTraceWriter
+{
+public:
+    using Exception = util::Exception<IpcTraceWriter>;
+
+    /** @throw IpcTraceWriter::Exception if the trace file cannot be created */
+    IpcTraceWriter(const std::string &fileName);
+
+    /** @return the current time, in microseconds since the beginning of the recording */
+    uint64_t getTimestamp() const;
+
+    /** Append a record to the trace.
+     *
+     * A write error does not fail the traced access: it is reported once, then the recording
+     * is stopped. */
+    void write(const IpcTraceRecord &record);
+
+private:
+    IpcTraceWriter(const IpcTraceWriter &) = delete;
+    IpcTraceWriter &operator=(const IpcTraceWriter &) = delete;
+
+    const std::chrono::steady_clock::time_point mStart;
+
+    std::mutex mMutex;
+    std::ofstream mFile;
+    util::Buffer mScratch;
+    bool mFailed = false;
+};
+
+/** Reads a binary trace file written by the IpcTraceWriter */
+class IpcTraceReader
+{
+public:
+    using Exception = util::Exception<IpcTraceReader>;
+
+    /** @throw IpcTraceReader::Exception if the file cannot be read or is not a valid trace */
+    IpcTraceReader(const std::string &fileName);
+
+    /** @return the records, in the order they have been written */
+    const std::vector<IpcTraceRecord> &getRecords() const { return mRecords; }
+
+private:
+    std::vector<IpcTraceRecord> mRecords;
+};
+}
+}
+}
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2016, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include "cAVS/Linux/IpcTrace.hpp"
+#include "cAVS/Linux/Device.hpp"
+#include "cAVS/Linux/ControlDevice.hpp"
+#include "cAVS/Linux/CompressDevice.hpp"
+#include "cAVS/Linux/CompressDeviceFactory.hpp"
+#include <memory>
+
+namespace debug_agent
+{
+namespace cavs
+{
+namespace linux
+{
+
+/** The following classes decorate the driver devices in order to record all their accesses
+ * into an IPC trace. Accesses are forwarded unchanged to the decorated devices, exceptions
+ * included.
+ *
+ * A trace can be replayed by the TraceReplayDriverFactory of the test framework.
+ */
+
+/** Records the debugfs commands */
+class RecordingDevice final : public Device
+{
+public:
+    RecordingDevice(std::unique_ptr<Device> device, std::shared_ptr<IpcTraceWriter> trace)
+        : mDevice(std::move(device)), mTrace(trace)
+    {
+    }
+
+    ssize_t commandWrite(const std::string &name, const util::Buffer &bufferInput) override;
+
+    void commandRead(const std::string &name, const util::Buffer &bufferInput,
+                     util::Buffer &bufferOutput) override;
+
+private:
+    std::unique_ptr<Device> mDevice;
+    std::shared_ptr<IpcTraceWriter> mTrace;
+};
+
+/** Records the ALSA control accesses */
+class RecordingControlDevice final : public ControlDevice
+{
+public:
+    RecordingControlDevice(std::unique_ptr<ControlDevice> device,
+                           std::shared_ptr<IpcTraceWriter> trace)
+        : ControlDevice(device->getCardName()), mDevice(std::move(device)), mTrace(trace)
+    {
+    }
+
+    void ctlRead(const std::string &name, util::Buffer &bufferOutput) override;
+    void ctlWrite(const std::string &name, const util::Buffer &bufferInput) override;
+    size_t getControlCountByTag(const std::string &name) const override;
+
+private:
+    std::unique_ptr<ControlDevice> mDevice;
+    std::shared_ptr<IpcTraceWriter> mTrace;
+};
+
+/** Records the compress device operations. The device state queries and close() are not
+ * recorded: they do not reach the driver, or cannot fail. */
+class RecordingCompressDevice final : public CompressDevice
+{
+public:
+    RecordingCompressDevice(std::unique_ptr<CompressDevice> device,
+                            std::shared_ptr<IpcTraceWriter> trace)
+        : CompressDevice({device->cardId(), device->deviceId()}), mDevice(std::move(device)),
+          mTrace(trace)
+    {
+    }
+
+    void open(Mode mode, compress::Role role, compress::Config &config) override;
+    bool isRunning() const noexcept override { return mDevice->isRunning(); }
+    bool isReady() const noexcept override { return mDevice->isReady(); }
+    void close() noexcept override { mDevice->close(); }
+    bool wait(int timeoutMs) override;
+    void start() override;
+    void stop() override;
+    size_t write(const util::Buffer &inputBuffer) override;
+    size_t read(util::Buffer &outputBuffer) override;
+    std::size_t getAvailable() override;
+    std::size_t getBufferSize() const override;
+
+private:
+    std::unique_ptr<CompressDevice> mDevice;
+    std::shared_ptr<IpcTraceWriter> mTrace;
+};
+
+/** Records the compress device queries and creations, and decorates the created devices */
+class RecordingCompressDeviceFactory final : public CompressDeviceFactory
+{
+public:
+    RecordingCompressDeviceFactory(std::unique_ptr<CompressDeviceFactory> factory,
+                                   std::shared_ptr<IpcTraceWriter> trace)
+        : mFactory(std::move(factory)), mTrace(trace)
+    {
+    }
+
+    std::unique_ptr<CompressDevice> newCompressDevice(
+        const compress::DeviceInfo &info) const override;
+    const compress::LoggersInfo getLoggerDeviceInfoList() const override;
+    const compress::InjectionProbesInfo getInjectionProbeDeviceInfoList() const override;
+    const compress::ExtractionProbeInfo getExtractionProbeDeviceInfo() const override;
+
+private:
+    std::unique_ptr<CompressDeviceFactory> mFactory;
+    std::shared_ptr<IpcTraceWriter> mTrace;
+};
+}
+}
+}
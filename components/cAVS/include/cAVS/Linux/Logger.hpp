@@ -59,8 +59,9 @@ public:
            CompressDeviceFactory &compressDeviceFactory)
         : mDevice(device), mControlDevice(controlDevice),
           mCompressDeviceFactory(compressDeviceFactory),
-          mLogEntryQueue(queueMaxMemoryBytes, logBlockSize)
+          mLogBlockPool(queueMaxMemoryBytes), mLogEntryQueue(queueMaxMemoryBytes, logBlockSize)
     {
+        mLogEntryQueue.setRecycler(util::PoolRecycler<LogBlock>(mLogBlockPool));
     }
 
     ~Logger()
@@ -74,10 +75,13 @@ public:
     Parameters getParameters() override;
 
     std::unique_ptr<LogBlock> readLogBlock() override;
+    std::vector<std::unique_ptr<LogBlock>> readLogBlocks(std::size_t maxByteSize) override;
+    void recycleLogBlocks(std::vector<std::unique_ptr<LogBlock>> &blocks) override;
+    util::QueueStatistics getQueueStatistics() const override;
     void stop() noexcept override;
 
 private:
-    using BlockingLogQueue = util::BlockingQueue<LogBlock>;
+    using BlockingLogQueue = util::BlockingQueue<LogBlock, util::PoolRecycler<LogBlock>>;
     using LogBlockPtr = std::unique_ptr<LogBlock>;
 
     /** This class handles the log producer thread */
@@ -85,8 +89,8 @@ private:
     {
     public:
         /* The constructor starts the log producer thread */
-        LogProducer(BlockingLogQueue &queue, unsigned int coreId, Device &device,
-                    std::unique_ptr<CompressDevice> logDevice);
+        LogProducer(BlockingLogQueue &queue, LogBlockPool &pool, unsigned int coreId,
+                    Device &device, std::unique_ptr<CompressDevice> logDevice);
 
         /** The destructor stops (and joins) the log producer thread */
         ~LogProducer();
@@ -121,6 +125,9 @@ private:
          */
         BlockingLogQueue &mQueue;
 
+        /** The pool that provides the log blocks, shared by all log producers */
+        LogBlockPool &mPool;
+
         /**
          * Each compress device for logging is providing to a given DSP core.
          * mCoreId stores the ID of the core corresponding to this device.
@@ -159,6 +166,8 @@ private:
     ControlDevice &mControlDevice;
 
     CompressDeviceFactory &mCompressDeviceFactory;
+    /** Log blocks are pooled, so that steady log production does not allocate memory */
+    LogBlockPool mLogBlockPool;
     BlockingLogQueue mLogEntryQueue;
 
     std::list<std::unique_ptr<LogProducer>> mLogProducers;
@@ -31,8 +31,10 @@
 #pragma once
 
 #include "cAVS/ModuleHandlerImpl.hpp"
-#include "cAVS/Linux/CorePower.hpp"
+#include "cAVS/Linux/CorePowerVoter.hpp"
 #include "cAVS/Linux/Device.hpp"
+#include <chrono>
+#include <mutex>
 
 namespace debug_agent
 {
@@ -45,17 +47,39 @@ namespace linux
 class ModuleHandlerImpl : public cavs::ModuleHandlerImpl
 {
 public:
-    ModuleHandlerImpl(Device &device) : mDevice(device), mCorePower(mDevice) {}
+    /** @param[in] device the device used to send the firmware commands
+     * @param[in] corePowerIdleTimeout delay after which the core is allowed to sleep once no
+     *                                 command is running, see CorePowerVoter
+     */
+    ModuleHandlerImpl(Device &device,
+                      std::chrono::milliseconds corePowerIdleTimeout = std::chrono::milliseconds(0))
+        : mDevice(device), mCorePowerVoter(mDevice, corePowerIdleTimeout)
+    {
+    }
+
+    uint64_t getSavedCorePowerToggleCount() const override
+    {
+        return mCorePowerVoter.getSavedToggleCount();
+    }
 
 private:
     util::Buffer configGet(uint16_t moduleId, uint16_t instanceId, dsp_fw::ParameterId parameterId,
                            size_t parameterSize) override;
 
+    void configGet(uint16_t moduleId, uint16_t instanceId, dsp_fw::ParameterId parameterId,
+                   size_t parameterSize, util::Buffer &parameterPayload) override;
+
     void configSet(uint16_t moduleId, uint16_t instanceId, dsp_fw::ParameterId parameterId,
                    const util::Buffer &parameterPayload) override;
 
     Device &mDevice;
-    CorePower<Exception> mCorePower;
+    CorePowerVoter<Exception> mCorePowerVoter;
+
+    /** The debugfs command and reply buffers, they are allocated once and reused by all
+     * commands */
+    util::Buffer mMessageBuffer;
+    util::Buffer mReplyBuffer;
+    std::mutex mCommandMutex;
 };
 }
 }
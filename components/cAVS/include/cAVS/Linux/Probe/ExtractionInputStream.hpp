@@ -31,6 +31,7 @@
 
 #include "cAVS/Linux/CompressDevice.hpp"
 
+#include "Util/BlockInputStream.hpp"
 #include "Util/MemoryStream.hpp"
 #include "Util/AssertAlways.hpp"
 #include "Util/BlockingQueue.hpp"
@@ -51,7 +52,7 @@ namespace linux
 /**
  * This input stream extracts data from the probe extraction device
  */
-class ExtractionInputStream : public util::InputStream
+class ExtractionInputStream : public util::BlockInputStream
 {
 public:
     ExtractionInputStream(std::unique_ptr<CompressDevice> extractionDevice)
@@ -104,6 +105,26 @@ public:
         return byteCount;
     }
 
+    bool readBlock(util::Buffer &block) override
+    {
+        if (mCurentBlockStream.isEOS()) {
+            if (not fetchNextBlock()) {
+                // end of stream is reached or underrun
+                return false;
+            }
+            block.swap(mCurrentBlock);
+        } else {
+            // the current block has been partially read, returning its remaining bytes
+            block.assign(mCurrentBlock.begin() + mCurentBlockStream.getPointerOffset(),
+                         mCurrentBlock.end());
+        }
+
+        // the current block is now consumed
+        mCurrentBlock.clear();
+        mCurentBlockStream.reset();
+        return true;
+    }
+
 private:
     /** Open the stream, i.e. open and start the probe compress device. */
     void open()
@@ -83,6 +83,11 @@ public:
     }
 
     void write(const util::StreamByte *src, std::size_t byteCount) override
+    {
+        writeBlock({src, src + byteCount});
+    }
+
+    void writeBlock(const util::Buffer &block) override
     {
         std::lock_guard<std::mutex> locker(mProbeDeviceMutex);
         if (not mProbeDevice->isReady()) {
@@ -92,7 +97,7 @@ public:
         }
         try {
             // writing the temporary buffer to the output ring buffer
-            mProbeDevice->write({src, src + byteCount});
+            mProbeDevice->write(block);
             if (not mProbeDevice->isRunning()) {
                 // As per design, shall start the device upon first write.
                 mProbeDevice->start();
@@ -39,6 +39,7 @@
 #include "cAVS/Prober.hpp"
 
 #include "Util/BlockingQueue.hpp"
+#include "Util/SpscRingBuffer.hpp"
 
 #include <mutex>
 
@@ -86,9 +87,17 @@ public:
     SessionProbes getProbesConfig() const;
 
     std::unique_ptr<util::Buffer> dequeueExtractionBlock(ProbeId probeIndex) override;
+    std::vector<std::unique_ptr<util::Buffer>> dequeueExtractionBlocks(
+        ProbeId probeIndex, std::size_t maxByteSize) override;
 
     bool enqueueInjectionBlock(ProbeId probeIndex, const util::Buffer &buffer) override;
 
+    void recycleExtractionBlocks(std::vector<std::unique_ptr<util::Buffer>> &blocks) override;
+
+    std::vector<util::QueueStatistics> getExtractionQueueStatistics() const override;
+
+    ExtractionResyncStatistics getExtractionResyncStatistics() const override;
+
     static ProbeConfig fromLinux(const mixer_ctl::ProbeControl &from);
     static mixer_ctl::ProbeControl toLinux(const ProbeConfig &from);
 
@@ -101,7 +110,7 @@ private:
 
     void stopNoThrow() noexcept;
 
-    using BlockingPacketQueue = util::BlockingQueue<util::Buffer>;
+    using BlockingPacketQueue = ProbeExtractor::BlockingPacketQueue;
     using BlockingExtractionQueues = std::vector<BlockingPacketQueue>;
 
     /** All probe streams will work with 5 meg Queues, aligned with windows adaptation layer. */
@@ -127,15 +136,19 @@ private:
     ProbeControlMap mInjectionProbeMap;
     InjectionSampleByteSizes mCachedInjectionSampleByteSizes;
 
+    /** Extracted packets are pooled, so that steady extraction does not allocate memory */
+    util::ByteBufferPool mPacketPool;
+
     /** Extraction of multiplexed probe points is performed by a compress device. */
     std::unique_ptr<ProbeExtractor> mProbeExtractor;
+    ProbeExtractor::ResyncCounters mResyncCounters;
     std::vector<ProbeInjector> mProbeInjectors;
 
     size_t mMaxInjectionProbes;
     size_t mMaxExtractionProbes;
 
     BlockingExtractionQueues mExtractionQueues;
-    std::vector<util::RingBuffer> mInjectionQueues;
+    std::vector<util::SpscRingBuffer> mInjectionQueues;
 
     bool mIsActiveState;
 
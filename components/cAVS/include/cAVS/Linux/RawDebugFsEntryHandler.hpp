@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2016, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include "cAVS/Linux/FileEntryHandler.hpp"
+#include <map>
+#include <string>
+
+namespace debug_agent
+{
+namespace cavs
+{
+namespace linux
+{
+
+/** This class implementation keeps the debugfs entries open for its whole lifetime.
+ *
+ * Each entry is opened once, on its first use, and its raw file descriptor is cached: open() and
+ * close() then only select and release the current entry. Commands are written with pwrite() and
+ * answers are read with pread() straight into the caller's buffer, both at offset 0, which saves
+ * the open/seek/close system calls and the iostream buffering of DebugFsEntryHandler.
+ *
+ * An entry whose read or write fails is evicted from the cache, so that it is reopened by the
+ * next command (for instance after a driver reload).
+ */
+class RawDebugFsEntryHandler final : public FileEntryHandler
+{
+public:
+    RawDebugFsEntryHandler() = default;
+    ~RawDebugFsEntryHandler();
+
+    void open(const std::string &name) override;
+    void close() noexcept override;
+    ssize_t write(const util::Buffer &bufferInput) override;
+    ssize_t read(util::Buffer &bufferOutput, const ssize_t nbBytes) override;
+
+private:
+    using Entries = std::map<std::string, int>;
+
+    /** Close the current entry file descriptor and remove it from the cache */
+    void evictCurrentEntry() noexcept;
+
+    Entries mEntries;
+    Entries::iterator mCurrentEntry{mEntries.end()};
+};
+}
+}
+}
@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2016, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include "cAVS/Linux/SimulatedFirmware.hpp"
+#include "cAVS/Linux/Device.hpp"
+#include "cAVS/Linux/ControlDevice.hpp"
+#include "cAVS/Linux/CompressDevice.hpp"
+#include "cAVS/Linux/CompressDeviceFactory.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+
+namespace debug_agent
+{
+namespace cavs
+{
+namespace linux
+{
+
+/** The following classes expose a SimulatedFirmware through the driver device interfaces.
+ * Firmware errors are reported as the exceptions of the corresponding devices.
+ */
+
+/** Debugfs commands, delayed by the simulated IPC latency */
+class SimulatedDevice final : public Device
+{
+public:
+    SimulatedDevice(std::shared_ptr<SimulatedFirmware> firmware) : mFirmware(firmware) {}
+
+    ssize_t commandWrite(const std::string &name, const util::Buffer &bufferInput) override;
+
+    void commandRead(const std::string &name, const util::Buffer &bufferInput,
+                     util::Buffer &bufferOutput) override;
+
+private:
+    std::shared_ptr<SimulatedFirmware> mFirmware;
+};
+
+/** ALSA controls, delayed by the simulated IPC latency */
+class SimulatedControlDevice final : public ControlDevice
+{
+public:
+    SimulatedControlDevice(std::shared_ptr<SimulatedFirmware> firmware)
+        : ControlDevice("simulated"), mFirmware(firmware)
+    {
+    }
+
+    void ctlRead(const std::string &name, util::Buffer &bufferOutput) override;
+    void ctlWrite(const std::string &name, const util::Buffer &bufferInput) override;
+    size_t getControlCountByTag(const std::string &name) const override;
+
+private:
+    std::shared_ptr<SimulatedFirmware> mFirmware;
+};
+
+/** Compress device paced by the simulated firmware:
+ * - a capture device receives the log fragments or probe packets produced at the configured
+ *   rate, the production being suspended while its buffer is full (overrun);
+ * - a playback device is drained at the configured injection rate.
+ *
+ * The stream advances lazily, when the device is accessed: no thread is required.
+ */
+class SimulatedCompressDevice final : public CompressDevice
+{
+public:
+    /** Stream carried by the device */
+    enum class Stream
+    {
+        Log,
+        ProbeExtraction,
+        ProbeInjection
+    };
+
+    /** @param[in] index the core id of a log stream, the probe index of an injection stream */
+    SimulatedCompressDevice(const compress::DeviceInfo &info,
+                            std::shared_ptr<SimulatedFirmware> firmware, Stream stream,
+                            unsigned int index);
+
+    void open(Mode mode, compress::Role role, compress::Config &config) override;
+    bool isRunning() const noexcept override;
+    bool isReady() const noexcept override;
+    void close() noexcept override;
+    bool wait(int timeoutMs) override;
+    void start() override;
+    void stop() override;
+    size_t write(const util::Buffer &inputBuffer) override;
+    size_t read(util::Buffer &outputBuffer) override;
+    std::size_t getAvailable() override;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    bool isCapture() const { return mStream != Stream::ProbeInjection; }
+
+    /** Advance the stream up to 'now'
+     * @return the time of the next stream event */
+    Clock::time_point update(Clock::time_point now);
+    Clock::time_point produce(Clock::time_point now);
+    Clock::time_point drain(Clock::time_point now);
+
+    /** @return true if the device can be read or written without blocking */
+    bool isAvailable() const;
+
+    std::shared_ptr<SimulatedFirmware> mFirmware;
+    const Stream mStream;
+    const unsigned int mIndex;
+
+    /** Production period of a capture device, zero if the production is disabled */
+    std::chrono::nanoseconds mPeriod{0};
+
+    mutable std::mutex mMutex;
+    std::condition_variable mCondition;
+    bool mReady = false;
+    bool mRunning = false;
+    std::size_t mFragmentSize = 0;
+
+    /** Capture: produced bytes not read yet, and the last produced chunk */
+    util::Buffer mPending;
+    util::Buffer mChunk;
+    Clock::time_point mNextProduction;
+
+    /** Playback: written bytes not consumed yet by the firmware */
+    std::size_t mFill = 0;
+    Clock::time_point mLastDrain;
+    std::chrono::microseconds mDrainJitter{0};
+};
+
+/** Creates the simulated compress devices, all on card 0:
+ * - devices [0, coreCount) are the loggers of each core;
+ * - device coreCount is the probe extractor;
+ * - the next injectionProbeCount devices are the probe injectors.
+ */
+class SimulatedCompressDeviceFactory final : public CompressDeviceFactory
+{
+public:
+    SimulatedCompressDeviceFactory(std::shared_ptr<SimulatedFirmware> firmware)
+        : mFirmware(firmware)
+    {
+    }
+
+    std::unique_ptr<CompressDevice> newCompressDevice(
+        const compress::DeviceInfo &info) const override;
+    const compress::LoggersInfo getLoggerDeviceInfoList() const override;
+    const compress::InjectionProbesInfo getInjectionProbeDeviceInfoList() const override;
+    const compress::ExtractionProbeInfo getExtractionProbeDeviceInfo() const override;
+
+private:
+    std::shared_ptr<SimulatedFirmware> mFirmware;
+};
+}
+}
+}
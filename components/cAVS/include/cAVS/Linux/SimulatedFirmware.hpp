@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2016, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include "cAVS/DspFw/ModuleType.hpp"
+#include "cAVS/DspFw/ModuleInstance.hpp"
+#include "cAVS/DspFw/Pipeline.hpp"
+#include "cAVS/DspFw/Scheduler.hpp"
+#include "cAVS/DspFw/Gateway.hpp"
+#include "cAVS/DspFw/Probe.hpp"
+#include "Util/Buffer.hpp"
+#include "Util/Exception.hpp"
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+#include <inttypes.h>
+
+namespace debug_agent
+{
+namespace cavs
+{
+namespace linux
+{
+
+/** Behavioural model of the DSP firmware, as seen through the driver interfaces.
+ *
+ * It answers the module parameter commands for a synthetic topology, holds the mixer controls
+ * and produces the content of the log and probe extraction streams. The simulated devices
+ * (see SimulatedDevices.hpp) expose it as a driver, pacing the streams at the configured rates:
+ * the debug agent can then be load tested end to end without any audio hardware.
+ *
+ * This class is thread safe.
+ */
+class SimulatedFirmware
+{
+public:
+    using Exception = util::Exception<SimulatedFirmware>;
+
+    /** Simulation parameters */
+    struct Config
+    {
+        /** The synthetic topology: each pipeline is a chain of module instances, from a host
+         * gateway to a link gateway, run by a task of one of the cores. */
+        uint32_t coreCount = 2;
+        uint32_t pipelineCount = 4;
+        uint32_t modulesPerPipeline = 3;
+
+        /** Log fragments produced per second by each core, 0 disables the log production */
+        uint32_t logRate = 50;
+        uint32_t logFragmentSize = 1024;
+
+        /** Probe packets produced per second, multiplexed over the connected extraction probes.
+         * 0 disables the extraction. */
+        uint32_t probeRate = 500;
+        uint32_t probePayloadSize = 256;
+
+        /** Bytes consumed per second by each injection probe */
+        uint32_t injectionRate = 192000;
+
+        uint32_t extractionProbeCount = 8;
+        uint32_t injectionProbeCount = 8;
+
+        /** Delay of each command and control access */
+        std::chrono::microseconds ipcLatency{0};
+
+        /** Random delay, up to this value, added to each command and control access and to the
+         * production time of each log fragment, probe packet and injected block */
+        std::chrono::microseconds jitter{0};
+
+        /** Seed of the jitter */
+        uint32_t seed = 0;
+
+        /** Parse a comma separated list of key=value pairs, unspecified keys keeping their
+         * default value, e.g. "cores=4,pipelines=16,logRate=200,latencyUs=100,jitterUs=50".
+         *
+         * Keys: cores, pipelines, modulesPerPipeline, logRate, logFragmentSize, probeRate,
+         * probePayloadSize, injectionRate, extractionProbes, injectionProbes, latencyUs,
+         * jitterUs, seed.
+         *
+         * @throw SimulatedFirmware::Exception if the description is invalid
+         */
+        static Config fromString(const std::string &description);
+
+        /** @throw SimulatedFirmware::Exception if a value is out of range */
+        void validate() const;
+    };
+
+    /** Counters of the simulated activity */
+    struct Statistics
+    {
+        uint64_t ipcCount = 0;
+        uint64_t logFragmentCount = 0;
+        uint64_t probePacketCount = 0;
+        uint64_t injectedByteCount = 0;
+    };
+
+    /** @throw SimulatedFirmware::Exception if the configuration is invalid */
+    SimulatedFirmware(const Config &config);
+
+    const Config &getConfig() const { return mConfig; }
+
+    /** Debugfs entries: module parameter commands and core power requests
+     * @{
+     * @throw SimulatedFirmware::Exception if the entry or the command is unknown
+     */
+    void commandWrite(const std::string &name, const util::Buffer &input);
+    void commandRead(const std::string &name, const util::Buffer &input, util::Buffer &output);
+    /** @} */
+
+    /** Mixer controls: log level and probe configurations
+     * @{
+     * @throw SimulatedFirmware::Exception if the control is unknown
+     */
+    void ctlRead(const std::string &name, util::Buffer &output) const;
+    void ctlWrite(const std::string &name, const util::Buffer &input);
+    /** @} */
+
+    std::size_t getControlCountByTag(const std::string &tag) const;
+
+    /** Sleep during the IPC latency plus a random jitter */
+    void delayIpc();
+
+    /** @return a random delay up to the configured jitter */
+    std::chrono::microseconds getJitter();
+
+    /** Produce the next log fragment of a core, replacing the content of 'fragment' */
+    void produceLogFragment(unsigned int coreId, util::Buffer &fragment);
+
+    /** Produce the next probe packet, from the next connected extraction probe, replacing the
+     * content of 'packet'.
+     * @return false if no extraction probe is connected */
+    bool produceProbePacket(util::Buffer &packet);
+
+    /** Account injected bytes consumed by the firmware */
+    void consumeInjectionData(std::size_t byteCount);
+
+    Statistics getStatistics() const;
+
+private:
+    /** module id, instance id, parameter id */
+    using ParameterKey = std::tuple<uint16_t, uint16_t, uint32_t>;
+
+    void buildTopology();
+    void buildConfigs();
+
+    /** @return the serialized value of a module parameter
+     * @throw SimulatedFirmware::Exception if the parameter is unknown */
+    util::Buffer getParameter(uint16_t moduleId, uint16_t instanceId, uint32_t parameterId) const;
+    void setParameter(uint16_t moduleId, uint16_t instanceId, uint32_t parameterId,
+                      const util::Buffer &value);
+    util::Buffer getBaseFwParameter(uint32_t parameterId) const;
+
+    void updateExtractedProbePoints();
+
+    /** @return the time elapsed since the firmware start, in microseconds */
+    uint64_t getWallClock() const;
+
+    const Config mConfig;
+    const std::chrono::steady_clock::time_point mStartTime;
+
+    /* Topology and configurations, built once */
+    util::Buffer mFwConfigTlvs;
+    util::Buffer mHwConfigTlvs;
+    std::vector<dsp_fw::ModuleEntry> mModuleEntries;
+    std::vector<dsp_fw::PplProps> mPipelines;
+    std::vector<dsp_fw::SchedulersInfo> mSchedulers;
+    std::vector<dsp_fw::GatewayProps> mGateways;
+    std::map<dsp_fw::CompoundModuleId, dsp_fw::ModuleInstanceProps> mModuleInstances;
+
+    mutable std::mutex mMutex;
+    std::map<ParameterKey, util::Buffer> mParameters;
+    uint32_t mPerfState = 0;
+    std::map<std::string, util::Buffer> mControls;
+    std::vector<dsp_fw::ProbePointId> mExtractedProbePoints;
+    std::size_t mNextExtractedProbe = 0;
+    std::vector<uint32_t> mLogSequences;
+    Statistics mStatistics;
+
+    std::mutex mRandomMutex;
+    std::mt19937 mRandom;
+};
+}
+}
+}
@@ -30,6 +30,7 @@
 #pragma once
 
 #include "Util/Buffer.hpp"
+#include "Util/BufferPool.hpp"
 #include <vector>
 #include <iostream>
 #include <stdexcept>
@@ -65,11 +66,19 @@ public:
      */
     LogBlockBase(unsigned int coreId, std::size_t length = 0) : mCoreId(coreId), mLogData(length)
     {
-        if (mCoreId > maxCoreId) {
+        checkCoreId(mCoreId);
+    }
 
-            throw Exception("Invalid Core ID: " + std::to_string(mCoreId) + " should be in [0.." +
-                            std::to_string(maxCoreId) + ']');
-        }
+    /**
+     * Change the log block producer core, used when a pooled log block is reused
+     *
+     * @param[in] coreId The ID of the log block producer core (in [0..15])
+     * @throw LogBlockBase::Exception
+     */
+    void setCoreId(unsigned int coreId)
+    {
+        checkCoreId(coreId);
+        mCoreId = coreId;
     }
 
     /**
@@ -110,6 +119,15 @@ public:
      */
 
 private:
+    static void checkCoreId(unsigned int coreId)
+    {
+        if (coreId > maxCoreId) {
+
+            throw Exception("Invalid Core ID: " + std::to_string(coreId) + " should be in [0.." +
+                            std::to_string(maxCoreId) + ']');
+        }
+    }
+
     /**
      * Each log block is produced by a core referenced by its ID.
      * mCoreId stores the ID of the core which has produced this log block.
@@ -137,6 +155,43 @@ private:
 static const size_t cavsLogBlockMaxSize = 0x0000FFFF;
 using LogBlock = LogBlockBase<cavsLogBlockMaxSize>;
 
+/** Pool of log blocks, sorted by log data capacity */
+class LogBlockPool final : public util::BufferPool<LogBlock>
+{
+public:
+    /**
+     * @param[in] maxCachedByteSize The maximum cumulated capacity of the log blocks kept by the
+     *                              depot.
+     */
+    LogBlockPool(std::size_t maxCachedByteSize)
+        : util::BufferPool<LogBlock>(maxCachedByteSize, &LogBlockPool::getCapacity,
+                                     &LogBlockPool::allocate)
+    {
+    }
+
+    /**
+     * @return a log block of the given core, whose log data have the requested size
+     * @throw LogBlock::Exception
+     */
+    std::unique_ptr<LogBlock> acquire(unsigned int coreId, std::size_t size)
+    {
+        auto block = util::BufferPool<LogBlock>::acquire(size);
+        block->setCoreId(coreId);
+        block->getLogData().resize(size);
+        return block;
+    }
+
+private:
+    static std::size_t getCapacity(const LogBlock &block) { return block.getLogData().capacity(); }
+
+    static std::unique_ptr<LogBlock> allocate(std::size_t capacity)
+    {
+        auto block = std::make_unique<LogBlock>(0);
+        block->getLogData().reserve(capacity);
+        return block;
+    }
+};
+
 template <const size_t maxSize>
 std::ostream &operator<<(std::ostream &os, const LogBlockBase<maxSize> &logBlock)
 {
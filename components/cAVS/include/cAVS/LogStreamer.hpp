@@ -90,6 +90,11 @@ private:
      */
     static const int minorVersion;
 
+    /**
+     * The maximum log data size read from the logger, and then flushed, at each iteration
+     */
+    static const std::size_t maxBatchByteSize;
+
     /* Make this class non copyable */
     LogStreamer(const LogStreamer &) = delete;
     LogStreamer &operator=(const LogStreamer &) = delete;
@@ -31,9 +31,11 @@
 
 #include "Util/EnumHelper.hpp"
 #include "cAVS/LogBlock.hpp"
+#include "Util/BlockingQueue.hpp"
 #include <stdexcept>
 #include <string>
 #include <memory>
+#include <vector>
 
 namespace debug_agent
 {
@@ -149,6 +151,35 @@ public:
      */
     virtual std::unique_ptr<LogBlock> readLogBlock() = 0;
 
+    /**
+     * Read several blocks of the FW log stream at once.
+     * @remarks The method waits until FW log data are available.
+     * @param[in] maxByteSize the maximum cumulated size of the returned blocks. At least one block
+     *                        is returned, whatever its size.
+     * @return the next blocks of log, or an empty collection if the log is stopped
+     */
+    virtual std::vector<std::unique_ptr<LogBlock>> readLogBlocks(std::size_t /*maxByteSize*/)
+    {
+        std::vector<std::unique_ptr<LogBlock>> blocks;
+        auto block = readLogBlock();
+        if (block != nullptr) {
+            blocks.push_back(std::move(block));
+        }
+        return blocks;
+    }
+
+    /**
+     * Give back consumed log blocks, so that their memory can be reused by the log producers.
+     * @param[in,out] blocks the consumed blocks, the collection is cleared
+     */
+    virtual void recycleLogBlocks(std::vector<std::unique_ptr<LogBlock>> &blocks)
+    {
+        blocks.clear();
+    }
+
+    /** @return the overflow statistics of the log block queue */
+    virtual util::QueueStatistics getQueueStatistics() const = 0;
+
     /**
     * Stop internal threads and unblock consumer threads
     */
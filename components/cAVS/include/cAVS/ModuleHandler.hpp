@@ -31,6 +31,7 @@
 #pragma once
 
 #include "cAVS/ModuleHandlerImpl.hpp"
+#include "cAVS/IpcScheduler.hpp"
 #include "cAVS/DspFw/ModuleType.hpp"
 #include "cAVS/DspFw/ModuleInstance.hpp"
 #include "cAVS/DspFw/FwConfig.hpp"
@@ -42,9 +43,12 @@
 #include "cAVS/DspFw/Scheduler.hpp"
 #include "DspFw/Common.hpp"
 #include "cAVS/DspFw/Infrastructure.hpp"
+#include "Util/BufferPool.hpp"
+#include "Util/SingleFlight.hpp"
 #include <stdexcept>
 #include <vector>
 #include <string>
+#include <tuple>
 
 namespace debug_agent
 {
@@ -62,6 +66,9 @@ static constexpr size_t tlvBufferSize = 2048;
  */
 static constexpr size_t maxParameterPayloadSize = 4 * 1024;
 
+/** Maximum cumulated size of the parameter reply buffers kept for reuse */
+static constexpr size_t replyPoolCachedByteSize = 256 * 1024;
+
 /** This abstract class exposes the FW module API */
 class ModuleHandler
 {
@@ -81,6 +88,9 @@ public:
      * - HwConfig::gatewayCount
      * - HwConfig::dspCoreCount
      *
+     * The firmware IPCs are ordered by an IpcScheduler: each query takes an IpcClass parameter,
+     * whose default value suits its most common use.
+     *
      * @param impl The OS-specific object that communicates with the hardware
      */
     ModuleHandler(std::unique_ptr<ModuleHandlerImpl> impl);
@@ -98,39 +108,61 @@ public:
     /** @return the hardware configuration */
     const dsp_fw::HwConfig &getHwConfig() const noexcept;
 
+    /** @return the allocation statistics of the parameter reply buffers */
+    util::BufferPoolStatistics getReplyPoolStatistics() const noexcept;
+
+    /** @return the count of the "config get" commands sent to the firmware, and of the
+     * concurrent identical ones served by them */
+    util::SingleFlightStatistics getConfigGetStatistics() const noexcept;
+
+    /** @return the scheduling statistics of the firmware IPCs of one class */
+    IpcClassStatistics getIpcStatistics(IpcClass ipcClass) const;
+
+    /** @return the number of core power commands saved by coalescing the votes of commands */
+    uint64_t getSavedCorePowerToggleCount() const;
+
     /** @return the pipeline identifier list */
-    std::vector<dsp_fw::PipeLineIdType> getPipelineIdList();
+    std::vector<dsp_fw::PipeLineIdType> getPipelineIdList(
+        IpcClass ipcClass = IpcClass::BulkIntrospection);
 
     /** @return the properties of one pipeline */
-    dsp_fw::PplProps getPipelineProps(dsp_fw::PipeLineIdType pipelineId);
+    dsp_fw::PplProps getPipelineProps(dsp_fw::PipeLineIdType pipelineId,
+                                      IpcClass ipcClass = IpcClass::BulkIntrospection);
 
     /** @return the schedulers of one core */
-    dsp_fw::SchedulersInfo getSchedulersInfo(dsp_fw::CoreId coreId);
+    dsp_fw::SchedulersInfo getSchedulersInfo(dsp_fw::CoreId coreId,
+                                             IpcClass ipcClass = IpcClass::BulkIntrospection);
 
     /** @return the gateways */
-    std::vector<dsp_fw::GatewayProps> getGatewaysInfo();
+    std::vector<dsp_fw::GatewayProps> getGatewaysInfo(
+        IpcClass ipcClass = IpcClass::BulkIntrospection);
 
     /** @return the state of the perf measurement service */
-    uint32_t getPerfState();
+    uint32_t getPerfState(IpcClass ipcClass = IpcClass::StreamingControl);
     /** Sets the state of the perf measurement service */
-    void setPerfState(uint32_t state);
+    void setPerfState(uint32_t state, IpcClass ipcClass = IpcClass::StreamingControl);
     /** @return the performance items */
-    std::vector<dsp_fw::PerfDataItem> getPerfItems();
+    std::vector<dsp_fw::PerfDataItem> getPerfItems(
+        IpcClass ipcClass = IpcClass::BackgroundPolling);
 
     /** @return the global memory state */
-    dsp_fw::GlobalMemoryState getGlobalMemoryState();
+    dsp_fw::GlobalMemoryState getGlobalMemoryState(
+        IpcClass ipcClass = IpcClass::BackgroundPolling);
 
     /** @return the properties of one module instance */
-    dsp_fw::ModuleInstanceProps getModuleInstanceProps(uint16_t moduleId, uint16_t instanceId);
+    dsp_fw::ModuleInstanceProps getModuleInstanceProps(
+        uint16_t moduleId, uint16_t instanceId, IpcClass ipcClass = IpcClass::BulkIntrospection);
 
     /** set module parameter */
     void setModuleParameter(uint16_t moduleId, uint16_t instanceId, dsp_fw::ParameterId parameterId,
-                            const util::Buffer &parameterPayload);
+                            const util::Buffer &parameterPayload,
+                            IpcClass ipcClass = IpcClass::InteractiveControl);
 
     /** @return module parameter */
     util::Buffer getModuleParameter(uint16_t moduleId, uint16_t instanceId,
                                     dsp_fw::ParameterId parameterId,
-                                    size_t parameterSize = maxParameterPayloadSize);
+                                    size_t parameterSize = maxParameterPayloadSize,
+                                    IpcClass ipcClass = IpcClass::InteractiveControl);
 
     /** The base firmware has several module like components in it.
      * To address them, the ParameterId is splited in a type and an instance part.
@@ -159,12 +191,25 @@ private:
      * @param[in] instanceId the module instance id
      * @param[in] parameterId the parameter id
      * @param[in] parameterSize the parameter's size
+     * @param[in] ipcClass the scheduling class of the command
      *
      * @returns the parameter payload.
      * @throw ModuleHandler::Exception
      */
     util::Buffer configGet(uint16_t moduleId, uint16_t instanceId, dsp_fw::ParameterId parameterId,
-                           size_t parameterSize);
+                           size_t parameterSize, IpcClass ipcClass);
+
+    /** Perform a "config get" command, writing the payload to a caller-provided buffer
+     *
+     * Concurrent identical commands are merged, whatever their class: only one of them is sent
+     * to the firmware, at the most urgent class of the merged commands, the others wait for its
+     * reply.
+     *
+     * @see ModuleHandlerImpl::configGet()
+     * @throw ModuleHandler::Exception
+     */
+    void configGet(uint16_t moduleId, uint16_t instanceId, dsp_fw::ParameterId parameterId,
+                   size_t parameterSize, util::Buffer &parameterPayload, IpcClass ipcClass);
 
     /** Perform a "config set" command
      *
@@ -172,11 +217,12 @@ private:
      * @param[in] instanceId the module instance id
      * @param[in] parameterId the parameter id
      * @param[in] parameterPayload the parameter payload to set as value
+     * @param[in] ipcClass the scheduling class of the command
      *
      * @throw ModuleHandler::Exception
      */
     void configSet(uint16_t moduleId, uint16_t instanceId, dsp_fw::ParameterId parameterId,
-                   const util::Buffer &parameterPayload);
+                   const util::Buffer &parameterPayload, IpcClass ipcClass);
 
     /** Get module parameter value as a template type
      * @tparam FirmwareParameterType The type of the retrieved parameter value
@@ -184,11 +230,12 @@ private:
     template <typename FirmwareParameterType>
     void getFwParameterValue(uint16_t moduleId, uint16_t instanceId,
                              dsp_fw::ParameterId moduleParamId, std::size_t fwParameterSize,
-                             FirmwareParameterType &result);
+                             FirmwareParameterType &result, IpcClass ipcClass);
 
     /** Get a tlv list from a module parameter value */
     template <typename TlvResponseHandlerInterface>
-    TlvResponseHandlerInterface readTlvParameters(dsp_fw::BaseFwParams parameterId);
+    TlvResponseHandlerInterface readTlvParameters(dsp_fw::BaseFwParams parameterId,
+                                                  IpcClass ipcClass);
 
     /** @return extended parameter id that contains the targeted module part id */
     static dsp_fw::ParameterId getExtendedParameterId(dsp_fw::BaseFwParams parameterTypeId,
@@ -206,6 +253,19 @@ private:
 
     std::unique_ptr<ModuleHandlerImpl> mImpl;
 
+    /** Provides the buffers of the decoded parameter replies, so that periodic queries do not
+     * allocate. Declared before the caches, which are filled by the constructor using it. */
+    util::ByteBufferPool mReplyPool{replyPoolCachedByteSize};
+
+    /** Orders the commands sent to mImpl. Declared before the caches, which are filled by the
+     * constructor using it. */
+    IpcScheduler mIpcScheduler;
+
+    /** (module id, instance id, parameter id, parameter size): requests of different classes
+     * are merged, the call being raised to the most urgent class of the merged requests */
+    using ConfigGetKey = std::tuple<uint16_t, uint16_t, uint32_t, size_t>;
+    util::SingleFlight<ConfigGetKey, util::Buffer, IpcScheduler::Urgency> mConfigGetFlights;
+
     // caches (they don't change during runtime and as such can be retrieved at startup time)
     dsp_fw::FwConfig mFwConfig;
     dsp_fw::HwConfig mHwConfig;
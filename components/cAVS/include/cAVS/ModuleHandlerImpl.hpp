@@ -50,6 +50,10 @@ public:
 
     virtual ~ModuleHandlerImpl() = default;
 
+    /** @return the number of core power commands saved by coalescing the votes of commands, if
+     * the implementation votes for the core power */
+    virtual uint64_t getSavedCorePowerToggleCount() const { return 0; }
+
 private:
     friend class ModuleHandler;
 
@@ -68,6 +72,28 @@ private:
     virtual util::Buffer configGet(uint16_t moduleId, uint16_t instanceId,
                                    dsp_fw::ParameterId parameterId, size_t parameterSize) = 0;
 
+    /** Perform a "config get" command, writing the parameter payload to a caller-provided buffer
+     *
+     * The buffer is resized to the payload size: its capacity is reused, so that queries
+     * performed with the same buffer do not allocate.
+     *
+     * The default implementation uses the buffer-returning configGet() method, implementations
+     * should override it to avoid the intermediate buffer.
+     *
+     * @param[in] moduleId the module type id
+     * @param[in] instanceId the module instance id
+     * @param[in] parameterId the parameter id
+     * @param[in] parameterSize the parameter's size
+     * @param[out] parameterPayload the parameter payload
+     *
+     * @throw ModuleHandler::Exception
+     */
+    virtual void configGet(uint16_t moduleId, uint16_t instanceId, dsp_fw::ParameterId parameterId,
+                           size_t parameterSize, util::Buffer &parameterPayload)
+    {
+        parameterPayload = configGet(moduleId, instanceId, parameterId, parameterSize);
+    }
+
     /** Perform a "config set" command
      *
      * This method should be implemented using driver specificities
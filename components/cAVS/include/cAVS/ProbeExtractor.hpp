@@ -32,17 +32,21 @@
 
 #include "cAVS/DspFw/Probe.hpp"
 #include "cAVS/Prober.hpp"
+#include "cAVS/ProbePacketParser.hpp"
 
 #include "Util/AssertAlways.hpp"
 #include "Util/PointerHelper.hpp"
-#include "Util/Stream.hpp"
+#include "Util/BlockInputStream.hpp"
 #include "Util/Exception.hpp"
 #include "Util/Buffer.hpp"
 #include "Util/BlockingQueue.hpp"
+#include "Util/BufferPool.hpp"
 
+#include <algorithm>
 #include <future>
 #include <memory>
 #include <map>
+#include <mutex>
 
 namespace debug_agent
 {
@@ -50,27 +54,68 @@ namespace cavs
 {
 
 /** Active object that performs probe packets extraction from an input stream, and then dispatches
- * them to the matching queue */
+ * them to the matching queue
+ *
+ * A corrupted packet does not abort the extraction: the extractor resynchronizes on the next valid
+ * packet, and counts resync events and discarded bytes per probe.
+ */
 class ProbeExtractor
 {
 public:
     using ProbePointMap = std::map<dsp_fw::ProbePointId, ProbeId>;
     using Exception = util::Exception<ProbeExtractor>;
-    using BlockingPacketQueue = util::BlockingQueue<util::Buffer>;
+    using BlockingPacketQueue = util::BlockingQueue<util::Buffer, util::PoolRecycler<util::Buffer>>;
     using BlockingExtractionQueues = std::vector<BlockingPacketQueue>;
 
+    using ResyncStatistics = Prober::ResyncStatistics;
+
+    /** Resynchronization counters, which can outlive the extractors that update them in order to
+     * cumulate the statistics of several sessions */
+    class ResyncCounters
+    {
+    public:
+        ResyncCounters() = default;
+        ResyncCounters(const ResyncCounters &) = delete;
+        ResyncCounters &operator=(const ResyncCounters &) = delete;
+
+        Prober::ExtractionResyncStatistics getStatistics() const
+        {
+            std::lock_guard<std::mutex> locker(mMutex);
+            return mStatistics;
+        }
+
+    private:
+        friend class ProbeExtractor;
+
+        mutable std::mutex mMutex;
+        Prober::ExtractionResyncStatistics mStatistics;
+    };
+
     /** The constructor starts the probe extractor thread
      *
      * @param[in] extractionQueues to push extracted and demultiplexed probe streams.
      * @param[in] probePointMap A <probe point id, probe index> map used to deduce probe index
      *                          from probe point id.
-     * @param[in] inputStream the extraction queues that will receive the packets
+     * @param[in] inputStream the stream that provides the multiplexed probe packets
+     * @param[in] packetPool the pool that provides the packet buffers. If not supplied, packet
+     *                       buffers are allocated.
+     * @param[in] resyncCounters the counters that accumulate the resynchronizations. If not
+     *                           supplied, the extractor uses its own counters.
      */
     ProbeExtractor(BlockingExtractionQueues &extractionQueues, const ProbePointMap &probePointMap,
-                   std::unique_ptr<util::InputStream> inputStream)
+                   std::unique_ptr<util::BlockInputStream> inputStream,
+                   util::ByteBufferPool *packetPool = nullptr,
+                   ResyncCounters *resyncCounters = nullptr)
         : mExtractionQueues(extractionQueues), mInputStream(std::move(inputStream)),
-          mProbePointMap(probePointMap)
+          mProbePointMap(probePointMap), mPacketPool(packetPool),
+          mResyncCounters(resyncCounters != nullptr ? *resyncCounters : mOwnResyncCounters)
     {
+        {
+            std::lock_guard<std::mutex> locker(mResyncCounters.mMutex);
+            auto &probes = mResyncCounters.mStatistics.probes;
+            probes.resize(std::max(probes.size(), mExtractionQueues.size()));
+        }
+
         // Clearing the extraction queues at session start, in this way data can still be retrieved
         // after session stop
         for (auto &queue : mExtractionQueues) {
@@ -86,51 +131,50 @@ public:
     /** Stop the extractor thread */
     void stop() { mInputStream->close(); }
 
+    /** @return the resynchronization statistics of a probe, i.e. of the corrupted packets whose
+     * probe point id matches this probe
+     * @throw ProbeExtractor::Exception if the probe id is out of range
+     */
+    ResyncStatistics getResyncStatistics(ProbeId probeId) const
+    {
+        if (probeId.getValue() >= mExtractionQueues.size()) {
+            throw Exception("Wrong probe id: " + std::to_string(probeId.getValue()));
+        }
+        std::lock_guard<std::mutex> locker(mResyncCounters.mMutex);
+        return mResyncCounters.mStatistics.probes[probeId.getValue()];
+    }
+
+    /** @return the resynchronization statistics of the corruptions that can not be attributed to
+     * a probe, for instance because of a wrong sync word */
+    ResyncStatistics getUnattributedResyncStatistics() const
+    {
+        std::lock_guard<std::mutex> locker(mResyncCounters.mMutex);
+        return mResyncCounters.mStatistics.unattributed;
+    }
+
 private:
     ProbeExtractor(const ProbeExtractor &) = delete;
     ProbeExtractor &operator=(const ProbeExtractor &) = delete;
 
     void extract()
     {
-        util::ByteStreamReader byteReader(*mInputStream);
+        ProbePacketParser parser(
+            [this](const dsp_fw::ProbePointId &probePointId, std::unique_ptr<util::Buffer> packet) {
+                dispatch(probePointId, std::move(packet));
+            },
+            [this](const dsp_fw::ProbePointId *probePointId, std::size_t discardedByteCount) {
+                onResync(probePointId, discardedByteCount);
+            },
+            ProbePacketParser::defaultMaxResyncByteCount,
+            ProbePacketParser::defaultMaxReplayByteCount, mPacketPool);
+
+        // The block buffer is swapped with the input stream one at each read, so its memory
+        // is reused from one block to another
+        util::Buffer block;
         try {
-            while (true) {
-
-                // reading one packet
-                dsp_fw::Packet packet;
-                byteReader.read(packet);
-
-                // finding the probe index that matches the probe point id
-                auto it = mProbePointMap.find(packet.probePointId);
-                if (it == mProbePointMap.end()) {
-                    throw Exception("Packet with unknown probe point id: " +
-                                    packet.probePointId.toString());
-                }
-
-                // Checking that the probe index is in a valid range
-                ProbeId probeId(it->second);
-                if (probeId.getValue() >= mExtractionQueues.size()) {
-                    throw Exception("Packet with wrong probe id: " +
-                                    std::to_string(probeId.getValue()));
-                }
-
-                // Writing the packet to a buffer
-                auto buffer = std::make_unique<util::Buffer>();
-                util::MemoryOutputStream outputStream(*buffer);
-                util::ByteStreamWriter writer(outputStream);
-
-                // Writing packet to the stream but with an uint32_t checksum to ensure
-                // compatibility with the fdk tool
-                // @todo remove this specificity when the fdk tools supports 64bits checksum
-                packet.toStream<uint32_t>(writer);
-
-                // Enqueueing the buffer into the right queue
-                if (!mExtractionQueues[probeId.getValue()].add(std::move(buffer))) {
-                    std::cerr << "Warning: extraction packet dropped." << std::endl;
-                }
+            while (mInputStream->readBlock(block)) {
+                parser.parse(block);
             }
-        } catch (util::ByteStreamReader::EOSException &) {
-            return;
         } catch (std::exception &e) {
             std::string message = "Aborting probe extraction due to: ";
             Exception ex(message + e.what());
@@ -139,12 +183,60 @@ private:
         }
     }
 
+    /** Enqueue a packet into the queue of its probe */
+    void dispatch(const dsp_fw::ProbePointId &probePointId, std::unique_ptr<util::Buffer> packet)
+    {
+        // finding the probe index that matches the probe point id
+        auto it = mProbePointMap.find(probePointId);
+        if (it == mProbePointMap.end()) {
+            throw Exception("Packet with unknown probe point id: " + probePointId.toString());
+        }
+
+        // Checking that the probe index is in a valid range
+        ProbeId probeId(it->second);
+        if (probeId.getValue() >= mExtractionQueues.size()) {
+            throw Exception("Packet with wrong probe id: " + std::to_string(probeId.getValue()));
+        }
+
+        // Enqueueing the buffer into the right queue
+        if (!mExtractionQueues[probeId.getValue()].add(std::move(packet))) {
+            std::cerr << "Warning: extraction packet dropped." << std::endl;
+        }
+    }
+
+    /** Account a resynchronization */
+    void onResync(const dsp_fw::ProbePointId *probePointId, std::size_t discardedByteCount)
+    {
+        std::lock_guard<std::mutex> locker(mResyncCounters.mMutex);
+        auto &counters = mResyncCounters.mStatistics;
+
+        ResyncStatistics *statistics = &counters.unattributed;
+        std::string origin = "unknown probe";
+        if (probePointId != nullptr) {
+            auto it = mProbePointMap.find(*probePointId);
+            if (it != mProbePointMap.end() && it->second.getValue() < mExtractionQueues.size()) {
+                statistics = &counters.probes[it->second.getValue()];
+                origin = "probe " + std::to_string(it->second.getValue());
+            }
+        }
+
+        ++statistics->resyncCount;
+        statistics->discardedByteCount += discardedByteCount;
+
+        std::cerr << "Warning: probe extraction resynchronized after a corrupted packet of "
+                  << origin << ", " << discardedByteCount << " bytes discarded." << std::endl;
+    }
+
     BlockingExtractionQueues &mExtractionQueues;
 
     /** Probe extraction is performed by an input stream that read from the probe device. */
-    std::unique_ptr<util::InputStream> mInputStream;
+    std::unique_ptr<util::BlockInputStream> mInputStream;
 
     ProbePointMap mProbePointMap;
+    util::ByteBufferPool *mPacketPool;
+
+    ResyncCounters mOwnResyncCounters;
+    ResyncCounters &mResyncCounters;
 
     std::future<void> mExtractionResult;
 };
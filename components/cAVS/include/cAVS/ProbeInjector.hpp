@@ -31,7 +31,7 @@
 #pragma once
 
 #include "Util/RingBufferOutputStream.hpp"
-#include "Util/RingBuffer.hpp"
+#include "Util/SpscRingBuffer.hpp"
 #include "Util/Buffer.hpp"
 #include "Util/AssertAlways.hpp"
 #include <future>
@@ -62,7 +62,7 @@ public:
      * @param[in] sampleByteSize The audio format sample byte size
      */
     ProbeInjector(std::unique_ptr<util::RingBufferOutputStream> rbOutputStream,
-                  util::RingBuffer &inputRingBuffer, std::size_t sampleByteSize)
+                  util::SpscRingBuffer &inputRingBuffer, std::size_t sampleByteSize)
         : mRbOutputStream(std::move(rbOutputStream)), mInputRingBuffer(inputRingBuffer),
           mSampleByteSize(sampleByteSize)
     {
@@ -83,6 +83,12 @@ public:
     {
         mRbOutputStream->close();
 
+        // The injection thread is the input ring buffer consumer: waiting for its end before
+        // clearing the ring buffer from this thread
+        if (mInjectionResult.valid()) {
+            mInjectionResult.wait();
+        }
+
         // Clearing the input ring buffer at probe session stop instead of probe session start
         // in order to allow to provision the input ring buffer before the session start
         mInputRingBuffer.clear();
@@ -116,33 +122,29 @@ private:
 
     void injectSamples(std::size_t sampleCount)
     {
-        // resizing the temporary buffer used for copy from input ring buffer to output one
+        // resizing the block that is handed to the output ring buffer
         mCopyBuffer.resize(sampleCount * mSampleByteSize);
         auto copyBufferIt = mCopyBuffer.begin();
-        // copying available samples from input ring buffer
-        std::size_t inputRingBufferAvailableSamples =
-            mInputRingBuffer.getUsedSize() / mSampleByteSize;
-        std::size_t samplesToCopy = std::min(inputRingBufferAvailableSamples, sampleCount);
-        std::size_t bytesToCopy = samplesToCopy * mSampleByteSize;
 
+        // copying available samples directly from the input ring buffer storage
+        auto input = mInputRingBuffer.acquireRead(mCopyBuffer.size());
+        std::size_t bytesToCopy = input.size() - input.size() % mSampleByteSize;
         if (bytesToCopy > 0) {
-            std::size_t read = mInputRingBuffer.readNonBlocking(&(*copyBufferIt), bytesToCopy);
-            // Always true because available data size has been queried
-            ASSERT_ALWAYS(read == bytesToCopy);
-            copyBufferIt += bytesToCopy;
+            copyBufferIt = input.copyTo(copyBufferIt, bytesToCopy);
+            mInputRingBuffer.commitRead(bytesToCopy);
         }
 
-        // completing the copy buffer with silence if needed
+        // completing the block with silence in place if needed
         if (copyBufferIt != mCopyBuffer.end()) {
             std::fill(copyBufferIt, mCopyBuffer.end(), 0);
         }
 
-        // writing the temporary buffer to the output ring buffer
-        mRbOutputStream->write(mCopyBuffer.data(), mCopyBuffer.size());
+        // writing the block to the output ring buffer
+        mRbOutputStream->writeBlock(mCopyBuffer);
     }
 
     std::unique_ptr<util::RingBufferOutputStream> mRbOutputStream;
-    util::RingBuffer &mInputRingBuffer;
+    util::SpscRingBuffer &mInputRingBuffer;
     std::size_t mSampleByteSize;
     std::future<void> mInjectionResult;
     util::Buffer mCopyBuffer;
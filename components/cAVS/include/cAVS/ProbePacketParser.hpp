@@ -0,0 +1,422 @@
+/*
+ * Copyright (c) 2016, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include "cAVS/DspFw/Probe.hpp"
+
+#include "Util/Buffer.hpp"
+#include "Util/BufferPool.hpp"
+#include "Util/Stream.hpp"
+#include "Util/Exception.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace debug_agent
+{
+namespace cavs
+{
+
+/** Incremental probe packet parser
+ *
+ * Probe packets are parsed directly from the blocks read from the extraction device: headers are
+ * decoded in place and payloads are bulk-copied into the output buffer. A packet may span several
+ * blocks, in this case the parser keeps its state between two parse() calls.
+ *
+ * Each parsed packet is re-serialized with an uint32_t checksum to ensure compatibility with the
+ * fdk tool, i.e. the output buffer content matches dsp_fw::Packet::toStream<uint32_t>().
+ * @todo remove this specificity when the fdk tools supports 64bits checksum
+ *
+ * If a resync handler is supplied, a corrupted packet (wrong sync word, payload size or checksum)
+ * does not stop the parsing: its first byte is discarded and the parser scans forward for the
+ * next sync word, including in the bytes of the rejected packet. The parsing resumes at the next
+ * packet whose checksum is valid. To bound the recovery cost, the parser gives up if more than
+ * maxResyncByteCount bytes are discarded before getting back in sync, and replays at most
+ * maxReplayByteCount bytes of payload and checksum per resynchronization: once this budget is
+ * spent, only the header bytes of the rejected candidates are scanned again, the following ones
+ * are discarded.
+ *
+ * If a packet pool is supplied, packet buffers are acquired from it, and rejected packets are
+ * released to it.
+ */
+class ProbePacketParser
+{
+public:
+    using Exception = util::Exception<ProbePacketParser>;
+
+    /** Called for each complete packet, with its probe point id and its serialized content */
+    using PacketHandler =
+        std::function<void(const dsp_fw::ProbePointId &, std::unique_ptr<util::Buffer>)>;
+
+    /** Called when the parser is back in sync after a corruption
+     *
+     * @param[in] probePointId the probe point id of the first rejected packet, or nullptr if its
+     *                         header was not identified (wrong sync word)
+     * @param[in] discardedByteCount the count of bytes discarded during the resynchronization
+     */
+    using ResyncHandler = std::function<void(const dsp_fw::ProbePointId *, std::size_t)>;
+
+    /** Payloads larger than this size are considered as corrupted */
+    static constexpr std::size_t maxPayloadSize = 1024 * 1024;
+
+    static constexpr std::size_t defaultMaxResyncByteCount = 4 * 1024 * 1024;
+
+    /** Enough to replay a candidate of the largest payload size, followed by a few shorter ones */
+    static constexpr std::size_t defaultMaxReplayByteCount = 2 * maxPayloadSize;
+
+    /**
+     * @param[in] packetHandler the handler that receives the parsed packets
+     * @param[in] resyncHandler the handler notified of resynchronizations. If not supplied, the
+     *                          parser throws on the first corrupted packet.
+     * @param[in] maxResyncByteCount the maximum count of bytes that can be discarded during one
+     *                               resynchronization
+     * @param[in] maxReplayByteCount the maximum count of payload and checksum bytes of the
+     *                               rejected candidates that are replayed during one
+     *                               resynchronization
+     * @param[in] packetPool the pool that provides the packet buffers. If not supplied, packet
+     *                       buffers are allocated.
+     */
+    ProbePacketParser(PacketHandler packetHandler, ResyncHandler resyncHandler = nullptr,
+                      std::size_t maxResyncByteCount = defaultMaxResyncByteCount,
+                      std::size_t maxReplayByteCount = defaultMaxReplayByteCount,
+                      util::ByteBufferPool *packetPool = nullptr)
+        : mPacketHandler(std::move(packetHandler)), mResyncHandler(std::move(resyncHandler)),
+          mMaxResyncByteCount(maxResyncByteCount), mMaxReplayByteCount(maxReplayByteCount),
+          mPacketPool(packetPool)
+    {
+    }
+    ProbePacketParser(const ProbePacketParser &) = delete;
+    ProbePacketParser &operator=(const ProbePacketParser &) = delete;
+
+    /** Parse a block of the extracted stream
+     * @throw ProbePacketParser::Exception if the stream is corrupted and cannot be resynchronized
+     */
+    void parse(const util::StreamByte *data, std::size_t size)
+    {
+        const util::StreamByte *current = data;
+        const util::StreamByte *end = data + size;
+
+        while (current != end) {
+            step(current, end);
+            replay();
+        }
+    }
+
+    void parse(const util::Buffer &block) { parse(block.data(), block.size()); }
+
+    /** @return true if no packet is partially parsed */
+    bool isIdle() const { return mState == State::Header && mStagedBytes == 0; }
+
+private:
+    enum class State
+    {
+        Header,
+        Payload,
+        Checksum,
+        Resync
+    };
+
+    /** sync word, probe point id, format, wall clock high and low, payload size */
+    static constexpr std::size_t headerSize = 6 * sizeof(uint32_t);
+    using ExtractedChecksumType = uint64_t;
+    using OutputChecksumType = uint32_t;
+
+    /** The payload size comes from the extracted stream and may be erroneous: limiting the
+     * up-front allocation, the buffer grows as the payload is really received. */
+    static constexpr std::size_t maxPayloadReservation = 64 * 1024;
+
+    template <typename T>
+    static T load(const util::StreamByte *field)
+    {
+        T value;
+        std::memcpy(&value, field, sizeof(T));
+        return value;
+    }
+
+    /** Get a pointer to 'required' contiguous bytes of the stream.
+     *
+     * If the field is fully available in the current block, it is accessed in place, otherwise
+     * it is gathered into the staging area across several blocks.
+     *
+     * @return a pointer to the field, or nullptr if the field is not yet complete
+     */
+    const util::StreamByte *gather(const util::StreamByte *&current, const util::StreamByte *end,
+                                   std::size_t required)
+    {
+        std::size_t available = end - current;
+        if (mStagedBytes == 0 && available >= required) {
+            auto field = current;
+            current += required;
+            return field;
+        }
+
+        std::size_t toCopy = std::min(required - mStagedBytes, available);
+        std::copy_n(current, toCopy, mStaging.begin() + mStagedBytes);
+        current += toCopy;
+        mStagedBytes += toCopy;
+
+        if (mStagedBytes < required) {
+            return nullptr;
+        }
+        mStagedBytes = 0;
+        return mStaging.data();
+    }
+
+    void step(const util::StreamByte *&current, const util::StreamByte *end)
+    {
+        switch (mState) {
+        case State::Header:
+            parseHeader(current, end);
+            break;
+        case State::Payload:
+            parsePayload(current, end);
+            break;
+        case State::Checksum:
+            parseChecksum(current, end);
+            break;
+        case State::Resync:
+            scanSyncWord(current, end);
+            break;
+        }
+    }
+
+    void parseHeader(const util::StreamByte *&current, const util::StreamByte *end)
+    {
+        auto header = gather(current, end, headerSize);
+        if (header == nullptr) {
+            return;
+        }
+
+        uint32_t syncWordValue = load<uint32_t>(header);
+        if (syncWordValue != dsp_fw::packet::syncWord) {
+            reject(header, headerSize, nullptr,
+                   "Invalid sync word in extracted probe packet header. Expected " +
+                       std::to_string(dsp_fw::packet::syncWord) + ", found " +
+                       std::to_string(syncWordValue));
+            return;
+        }
+
+        mProbePointId.full = load<uint32_t>(header + sizeof(uint32_t));
+        mRemainingPayload = load<uint32_t>(header + headerSize - sizeof(uint32_t));
+
+        if (mRemainingPayload > maxPayloadSize) {
+            reject(header, headerSize, &mProbePointId,
+                   "Invalid payload size in extracted probe packet header: " +
+                       std::to_string(mRemainingPayload));
+            return;
+        }
+
+        // Matching dsp_fw::Packet::sum(): the header fields are summed on 32 bits, then the
+        // payload size is added on 64 bits
+        uint32_t fieldSum = 0;
+        for (std::size_t offset = 0; offset < headerSize - sizeof(uint32_t);
+             offset += sizeof(uint32_t)) {
+            fieldSum += load<uint32_t>(header + offset);
+        }
+        mSum = static_cast<uint64_t>(fieldSum) + mRemainingPayload;
+
+        std::size_t payloadReservation =
+            mRemainingPayload < maxPayloadReservation ? mRemainingPayload : maxPayloadReservation;
+        std::size_t packetReservation =
+            headerSize + payloadReservation + sizeof(OutputChecksumType);
+        if (mPacketPool != nullptr) {
+            mPacket = mPacketPool->acquire(packetReservation);
+        } else {
+            mPacket = std::make_unique<util::Buffer>();
+            mPacket->reserve(packetReservation);
+        }
+        mPacket->insert(mPacket->end(), header, header + headerSize);
+
+        mState = mRemainingPayload > 0 ? State::Payload : State::Checksum;
+    }
+
+    void parsePayload(const util::StreamByte *&current, const util::StreamByte *end)
+    {
+        std::size_t toCopy = std::min<std::size_t>(mRemainingPayload, end - current);
+        mPacket->insert(mPacket->end(), current, current + toCopy);
+        current += toCopy;
+        mRemainingPayload -= toCopy;
+
+        if (mRemainingPayload == 0) {
+            mState = State::Checksum;
+        }
+    }
+
+    void parseChecksum(const util::StreamByte *&current, const util::StreamByte *end)
+    {
+        auto checksum = gather(current, end, sizeof(ExtractedChecksumType));
+        if (checksum == nullptr) {
+            return;
+        }
+
+        auto checksumValue = load<ExtractedChecksumType>(checksum);
+        if (checksumValue != mSum) {
+            // The whole packet candidate is rejected, including its checksum
+            auto candidate = std::move(mPacket);
+            candidate->insert(candidate->end(), checksum, checksum + sizeof(checksumValue));
+            reject(candidate->data(), candidate->size(), &mProbePointId,
+                   "Header checksum mismatch. Expected " + std::to_string(mSum) + ", found " +
+                       std::to_string(checksumValue) +
+                       ". While checking integrity of packet with probe point id {" +
+                       mProbePointId.toString() + "}");
+            if (mPacketPool != nullptr) {
+                mPacketPool->release(std::move(candidate));
+            }
+            return;
+        }
+
+        auto outputChecksum = static_cast<OutputChecksumType>(mSum);
+        auto outputChecksumBytes = reinterpret_cast<const util::StreamByte *>(&outputChecksum);
+        mPacket->insert(mPacket->end(), outputChecksumBytes,
+                        outputChecksumBytes + sizeof(outputChecksum));
+
+        mState = State::Header;
+        if (mResyncing) {
+            mResyncing = false;
+            mResyncHandler(mHasRejectedProbePointId ? &mRejectedProbePointId : nullptr,
+                           mDiscardedByteCount);
+        }
+        mPacketHandler(mProbePointId, std::move(mPacket));
+    }
+
+    /** Reject a packet candidate and start (or continue) the resynchronization
+     *
+     * The first byte of the candidate is discarded, the following ones are replayed because they
+     * may contain the next sync word, within the replay budget of the resynchronization.
+     *
+     * @throw ProbePacketParser::Exception if no resync handler is set
+     */
+    void reject(const util::StreamByte *candidate, std::size_t size,
+                const dsp_fw::ProbePointId *probePointId, const std::string &reason)
+    {
+        if (!mResyncHandler) {
+            throw Exception(reason);
+        }
+
+        if (!mResyncing) {
+            mResyncing = true;
+            mDiscardedByteCount = 0;
+            mReplayedByteCount = 0;
+            mHasRejectedProbePointId = probePointId != nullptr;
+            if (mHasRejectedProbePointId) {
+                mRejectedProbePointId = *probePointId;
+            }
+        }
+
+        /* The header bytes are always replayed: a rejected header costs at most headerSize
+         * steps per discarded byte. Replaying the payload bytes is bounded by the budget. */
+        std::size_t replayed = std::min(size - 1, headerSize - 1);
+        std::size_t budget = mMaxReplayByteCount - mReplayedByteCount;
+        std::size_t replayedPayload = std::min(size - 1 - replayed, budget);
+        mReplayedByteCount += replayedPayload;
+        replayed += replayedPayload;
+
+        discard(size - replayed);
+        mReplay.insert(mReplay.end(), candidate + 1, candidate + 1 + replayed);
+        mState = State::Resync;
+    }
+
+    /** Parse the bytes of rejected candidates
+     *
+     * A candidate found while replaying may also be rejected: in this case it is replayed first,
+     * followed by the remaining bytes of the current replay.
+     */
+    void replay()
+    {
+        while (!mReplay.empty()) {
+            util::Buffer replayed;
+            replayed.swap(mReplay);
+
+            const util::StreamByte *current = replayed.data();
+            const util::StreamByte *end = current + replayed.size();
+            while (current != end && mReplay.empty()) {
+                step(current, end);
+            }
+            mReplay.insert(mReplay.end(), current, end);
+        }
+    }
+
+    /** Skip bytes until the first byte of a sync word is found */
+    void scanSyncWord(const util::StreamByte *&current, const util::StreamByte *end)
+    {
+        auto syncWordFirstByte =
+            *reinterpret_cast<const util::StreamByte *>(&dsp_fw::packet::syncWord);
+        auto found = std::find(current, end, syncWordFirstByte);
+        discard(found - current);
+        current = found;
+        if (current != end) {
+            mState = State::Header;
+        }
+    }
+
+    void discard(std::size_t byteCount)
+    {
+        mDiscardedByteCount += byteCount;
+        if (mDiscardedByteCount > mMaxResyncByteCount) {
+            throw Exception("Unable to resynchronize the probe extraction stream: " +
+                            std::to_string(mDiscardedByteCount) + " bytes discarded");
+        }
+    }
+
+    PacketHandler mPacketHandler;
+    ResyncHandler mResyncHandler;
+    const std::size_t mMaxResyncByteCount;
+    const std::size_t mMaxReplayByteCount;
+    util::ByteBufferPool *const mPacketPool;
+
+    State mState = State::Header;
+
+    /** Staging area used for fields that span two blocks */
+    std::array<util::StreamByte, headerSize> mStaging;
+    std::size_t mStagedBytes = 0;
+
+    /** Current packet */
+    dsp_fw::ProbePointId mProbePointId;
+    std::size_t mRemainingPayload = 0;
+    uint64_t mSum = 0;
+    std::unique_ptr<util::Buffer> mPacket;
+
+    /** Resynchronization state */
+    bool mResyncing = false;
+    std::size_t mDiscardedByteCount = 0;
+    /** The count of payload and checksum bytes replayed during the resynchronization */
+    std::size_t mReplayedByteCount = 0;
+    bool mHasRejectedProbePointId = false;
+    dsp_fw::ProbePointId mRejectedProbePointId;
+    util::Buffer mReplay;
+};
+}
+}
@@ -72,6 +72,9 @@ public:
      */
     const Prober::InjectionSampleByteSizes getInjectionSampleByteSizes() const;
 
+    /** @return the resynchronization statistics of the extraction, cumulated over the sessions */
+    Prober::ExtractionResyncStatistics getExtractionResyncStatistics() const;
+
 private:
     Driver &mDriver;
     Prober::SessionProbes mProbeConfigs;
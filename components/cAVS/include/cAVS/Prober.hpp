@@ -31,6 +31,7 @@
 
 #include "DspFw/Probe.hpp"
 
+#include "Util/BlockingQueue.hpp"
 #include "Util/Exception.hpp"
 #include "Util/WrappedRaw.hpp"
 
@@ -90,6 +91,21 @@ public:
         return helper;
     }
 
+    /** Statistics of the resynchronizations of the extraction stream after corrupted packets */
+    struct ResyncStatistics
+    {
+        std::size_t resyncCount = 0;
+        std::size_t discardedByteCount = 0;
+    };
+
+    struct ExtractionResyncStatistics
+    {
+        /** One entry per extraction queue */
+        std::vector<ResyncStatistics> probes;
+        /** The corruptions that can not be attributed to a probe, e.g. wrong sync words */
+        ResyncStatistics unattributed;
+    };
+
     /** Configuration of one probe instance */
     struct ProbeConfig
     {
@@ -181,6 +197,32 @@ public:
      */
     virtual std::unique_ptr<util::Buffer> dequeueExtractionBlock(ProbeId probeIndex) = 0;
 
+    /**
+     * Return the next extraction blocks data at once
+     *
+     * This method blocks until data is available (or probe is stopped)
+     *
+     * Probe service state shall be in 'Active'.
+     *
+     * @param[in] probeIndex the index of the probe to query
+     * @param[in] maxByteSize the maximum cumulated size of the returned blocks. At least one block
+     *                        is returned, whatever its size.
+     * @return the next extraction blocks data, or an empty collection if the probe has been
+     *         stopped.
+     *
+     * @throw Prober::Exception
+     */
+    virtual std::vector<std::unique_ptr<util::Buffer>> dequeueExtractionBlocks(
+        ProbeId probeIndex, std::size_t /*maxByteSize*/)
+    {
+        std::vector<std::unique_ptr<util::Buffer>> blocks;
+        auto block = dequeueExtractionBlock(probeIndex);
+        if (block != nullptr) {
+            blocks.push_back(std::move(block));
+        }
+        return blocks;
+    }
+
     /**
      * Enqueue a block that will be injected to the probe.
      *
@@ -194,6 +236,21 @@ public:
      */
     virtual bool enqueueInjectionBlock(ProbeId probeIndex, const util::Buffer &buffer) = 0;
 
+    /**
+     * Give back consumed extraction blocks, so that their memory can be reused by the extractor.
+     * @param[in,out] blocks the consumed blocks, the collection is cleared
+     */
+    virtual void recycleExtractionBlocks(std::vector<std::unique_ptr<util::Buffer>> &blocks)
+    {
+        blocks.clear();
+    }
+
+    /** @return the overflow statistics of the extraction queues, one entry per queue */
+    virtual std::vector<util::QueueStatistics> getExtractionQueueStatistics() const = 0;
+
+    /** @return the resynchronization statistics of the extraction, cumulated over the sessions */
+    virtual ExtractionResyncStatistics getExtractionResyncStatistics() const = 0;
+
     Prober(const Prober &) = delete;
     Prober &operator=(const Prober &) = delete;
 };
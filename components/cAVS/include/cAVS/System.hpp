@@ -101,6 +101,18 @@ public:
         virtual void doReading(std::istream &is) = 0;
     };
 
+    /** IPC accounting of topology retrievals */
+    struct TopologyRefreshStatistics
+    {
+        /** The count of topology retrievals */
+        std::size_t refreshCount;
+        /** The count of IPCs sent to the firmware */
+        std::size_t ipcCount;
+        /** The count of module instance queries avoided by incremental refreshes, compared with
+         * full retrievals */
+        std::size_t savedIpcCount;
+    };
+
     /**
      * @throw System::Exception
      */
@@ -120,6 +132,12 @@ public:
      */
     Logger::Parameters getLogParameters();
 
+    /** @return the overflow statistics of the log block queue */
+    util::QueueStatistics getLogQueueStatistics() const;
+
+    /** @return the overflow statistics of the probe extraction queues, one entry per queue */
+    std::vector<util::QueueStatistics> getProbeExtractionQueueStatistics() const;
+
     /**
      * Try to acquire the log stream resource
      *
@@ -152,6 +170,26 @@ public:
     /** @return topology */
     void getTopology(Topology &topology);
 
+    /** Refresh a previously retrieved topology
+     *
+     * Gateways, pipelines and schedulers are read again, but the module instances are queried
+     * only if they belong to a new or changed pipeline or task: the props of the other ones are
+     * kept from the previous topology. An empty topology is fully retrieved.
+     *
+     * @param[in,out] topology the previous topology, replaced by the refreshed one. It is
+     *                         cleared on failure.
+     * @return the IPC accounting of this refresh
+     * @throw System::Exception
+     */
+    TopologyRefreshStatistics refreshTopology(Topology &topology);
+
+    /** @return the cumulated IPC accounting of all topology retrievals */
+    TopologyRefreshStatistics getTopologyRefreshStatistics() const;
+
+    /** @return the number of core power commands saved by coalescing the votes of the module
+     * commands */
+    uint64_t getSavedCorePowerToggleCount();
+
     ModuleHandler &getModuleHandler();
     ProbeService &getProbeService();
     PerfService &getPerfService();
@@ -220,6 +258,10 @@ private:
 
     static std::unique_ptr<Driver> createDriver(const DriverFactory &driverFactory);
 
+    /** Retrieve the topology, reusing the unchanged module instances of the previous one */
+    void retrieveTopology(Topology &previous, Topology &topology,
+                          TopologyRefreshStatistics &statistics);
+
     std::unique_ptr<Driver> mDriver;
 
     /** Mutex that guarantees log stream exclusive usage */
@@ -231,6 +273,9 @@ private:
     std::vector<std::mutex> mProbeInjectionMutexes;
 
     PerfService mPerfService;
+
+    mutable std::mutex mTopologyRefreshMutex;
+    TopologyRefreshStatistics mTopologyRefreshStatistics{0, 0, 0};
 };
 }
 }
@@ -30,6 +30,9 @@
 #pragma once
 
 #include <cAVS/DriverFactory.hpp>
+#include <chrono>
+#include <cstdint>
+#include <string>
 
 namespace debug_agent
 {
@@ -39,12 +42,40 @@ namespace cavs
 class SystemDriverFactory : public DriverFactory
 {
 public:
-    SystemDriverFactory(bool logControlOnly) : mLogControlOnly(logControlOnly){};
+    /** Default delay during which the core is kept awake after a module command, so that the
+     * commands of a burst (e.g. a topology refresh) share a single core power vote */
+    static const uint32_t defaultCorePowerIdleTimeoutMs = 100;
+
+    /** @param[in] logControlOnly disable the FW log data path, keeping the log control only
+     * @param[in] persistentDebugFs keep the debugfs entries open and access them through raw file
+     *                              descriptors instead of reopening them for each command
+     *                              (Linux only, ignored otherwise)
+     * @param[in] ipcTraceFileName if not empty, record all the driver accesses into this IPC
+     *                             trace file (Linux only, ignored otherwise)
+     * @param[in] simulatedFirmwareConfig if not empty, simulate the firmware with this
+     *                                    configuration instead of accessing the audio driver,
+     *                                    see linux::SimulatedFirmware::Config::fromString()
+     *                                    (Linux only, ignored otherwise)
+     * @param[in] corePowerIdleTimeoutMs the delay in milliseconds during which the core is kept
+     *                                   awake after a module command (Linux only, ignored
+     *                                   otherwise)
+     */
+    SystemDriverFactory(bool logControlOnly, bool persistentDebugFs = false,
+                        const std::string &ipcTraceFileName = "",
+                        const std::string &simulatedFirmwareConfig = "",
+                        uint32_t corePowerIdleTimeoutMs = defaultCorePowerIdleTimeoutMs)
+        : mLogControlOnly(logControlOnly), mPersistentDebugFs(persistentDebugFs),
+          mIpcTraceFileName(ipcTraceFileName), mSimulatedFirmwareConfig(simulatedFirmwareConfig),
+          mCorePowerIdleTimeout(corePowerIdleTimeoutMs){};
 
     virtual std::unique_ptr<Driver> newDriver() const override;
 
 private:
     bool mLogControlOnly = false;
+    bool mPersistentDebugFs = false;
+    std::string mIpcTraceFileName;
+    std::string mSimulatedFirmwareConfig;
+    std::chrono::milliseconds mCorePowerIdleTimeout;
 };
 }
 }
@@ -56,6 +56,8 @@ public:
     Topology() = default;
     Topology(const Topology &) = default;
     Topology &operator=(const Topology &) = default;
+    Topology(Topology &&) = default;
+    Topology &operator=(Topology &&) = default;
 
     /* Describe a link between two modules */
     struct Link
@@ -116,6 +118,9 @@ public:
 
     /**
      * Compute Links collection from pipes and modules collections
+     *
+     * Pins are matched through an index of their queue ids: the computation time is linear in
+     * the pin count.
      * @throw Topology::Exception
      */
     void computeLinks();
@@ -137,23 +142,34 @@ private:
     const dsp_fw::ModuleInstanceProps &getModuleInstance(
         const dsp_fw::CompoundModuleId &moduleInstanceId) const;
 
-    using InputId = uint32_t;
-    using Input = std::pair<dsp_fw::CompoundModuleId, InputId>;
-    using InputList = std::vector<Input>;
+    /** A module pin expecting a connection, with the queue id read once from its props */
+    struct Endpoint
+    {
+        Endpoint(const dsp_fw::CompoundModuleId &module, uint32_t pinId, uint32_t queueId)
+            : mModule(module), mPinId(pinId), mQueueId(queueId)
+        {
+        }
 
-    using OutputId = uint32_t;
-    using Output = std::pair<dsp_fw::CompoundModuleId, OutputId>;
-    using OutputList = std::vector<Output>;
+        dsp_fw::CompoundModuleId mModule;
+        uint32_t mPinId;
+        uint32_t mQueueId;
+    };
+    using InputList = std::vector<Endpoint>;
+    using OutputList = std::vector<Endpoint>;
 
     void computeIntraPipeLinks(InputList &unresolvedInputs, OutputList &unresolvedOutputs);
     void computeModulesPairLink(const dsp_fw::CompoundModuleId &sourceModuleId,
+                                const dsp_fw::ModuleInstanceProps &sourceModule,
                                 const dsp_fw::CompoundModuleId &destinationModuleId,
+                                const dsp_fw::ModuleInstanceProps &destinationModule,
                                 InputList &unresolvedInputs, OutputList &unresolvedOutputs);
 
     void computeInterPipeLinks(InputList &unresolvedInputs, OutputList &unresolvedOutputs);
     void checkUnresolved(InputList &unresolvedInputs, OutputList &unresolvedOutputs) const;
-    void addAllModuleOutputs(OutputList &list, const dsp_fw::CompoundModuleId &module) const;
-    void addAllModuleInputs(InputList &list, const dsp_fw::CompoundModuleId &module) const;
+    static void addAllModuleOutputs(OutputList &list, const dsp_fw::CompoundModuleId &module,
+                                    const dsp_fw::ModuleInstanceProps &moduleProps);
+    static void addAllModuleInputs(InputList &list, const dsp_fw::CompoundModuleId &module,
+                                   const dsp_fw::ModuleInstanceProps &moduleProps);
 };
 }
 }
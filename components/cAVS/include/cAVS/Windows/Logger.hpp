@@ -52,8 +52,9 @@ class Logger final : public cavs::Logger
 public:
     Logger(Device &device, WppClientFactory &wppClientFactory)
         : mDevice(device), mWppClientFactory(wppClientFactory),
-          mLogEntryQueue(queueMaxMemoryBytes, logBlockSize)
+          mLogBlockPool(queueMaxMemoryBytes), mLogEntryQueue(queueMaxMemoryBytes, logBlockSize)
     {
+        mLogEntryQueue.setRecycler(util::PoolRecycler<LogBlock>(mLogBlockPool));
     }
 
     ~Logger()
@@ -67,6 +68,9 @@ public:
     Parameters getParameters() override;
 
     std::unique_ptr<LogBlock> readLogBlock() override;
+    std::vector<std::unique_ptr<LogBlock>> readLogBlocks(std::size_t maxByteSize) override;
+    void recycleLogBlocks(std::vector<std::unique_ptr<LogBlock>> &blocks) override;
+    util::QueueStatistics getQueueStatistics() const override;
 
     void stop() noexcept override;
 
@@ -80,14 +84,15 @@ private:
         Set
     };
 
-    using BlockingQueue = util::BlockingQueue<LogBlock>;
+    using BlockingQueue = util::BlockingQueue<LogBlock, util::PoolRecycler<LogBlock>>;
 
     /** This class handles the log producer thread */
     class LogProducer final : public windows::WppLogEntryListener
     {
     public:
         /* The constructor starts the log producer thread */
-        LogProducer(BlockingQueue &queue, std::unique_ptr<WppClient> wppClient);
+        LogProducer(BlockingQueue &queue, LogBlockPool &pool,
+                    std::unique_ptr<WppClient> wppClient);
 
         /** The destructor stops (and joins) the log producer thread */
         ~LogProducer();
@@ -103,6 +108,7 @@ private:
         virtual void onLogEntry(uint32_t coreId, uint8_t *buffer, uint32_t bufferSize) override;
 
         BlockingQueue &mQueue;
+        LogBlockPool &mPool;
         std::unique_ptr<WppClient> mWppClient;
         std::thread mProducerThread;
     };
@@ -148,6 +154,8 @@ private:
 
     Device &mDevice;
     WppClientFactory &mWppClientFactory;
+    /** Log blocks are pooled, so that steady log production does not allocate memory */
+    LogBlockPool mLogBlockPool;
     BlockingQueue mLogEntryQueue;
     std::unique_ptr<LogProducer> mLogProducer;
     std::mutex mLogActivationContextMutex;
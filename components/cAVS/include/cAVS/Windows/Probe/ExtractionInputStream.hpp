@@ -31,6 +31,7 @@
 #pragma once
 
 #include "cAVS/Windows/EventHandle.hpp"
+#include "Util/BlockInputStream.hpp"
 #include "Util/RingBufferReader.hpp"
 #include "Util/Buffer.hpp"
 #include "Util/MemoryStream.hpp"
@@ -54,7 +55,7 @@ namespace probe
  * This input stream extracts data from the probe extraction ring buffer
  * It uses an event handle to know when the ring buffer is filled.
  */
-class ExtractionInputStream : public util::InputStream
+class ExtractionInputStream : public util::BlockInputStream
 {
 public:
     using Buffer = util::Buffer;
@@ -95,6 +96,26 @@ public:
         return byteCount;
     }
 
+    bool readBlock(util::Buffer &block) override
+    {
+        if (mCurentBlockStream.isEOS()) {
+            if (!fetchNextBlock()) {
+                // end of stream is reached
+                return false;
+            }
+            block.swap(mCurrentBlock);
+        } else {
+            // the current block has been partially read, returning its remaining bytes
+            block.assign(mCurrentBlock.begin() + mCurentBlockStream.getPointerOffset(),
+                         mCurrentBlock.end());
+        }
+
+        // the current block is now consumed
+        mCurrentBlock.clear();
+        mCurentBlockStream.reset();
+        return true;
+    }
+
 private:
     bool fetchNextBlock()
     {
@@ -81,8 +81,13 @@ public:
 
     void write(const util::StreamByte *src, std::size_t byteCount) override
     {
-        // writing the temporary buffer to the output ring buffer
-        mOutputRingBuffer.unsafeWrite({src, src + byteCount});
+        writeBlock({src, src + byteCount});
+    }
+
+    void writeBlock(const util::Buffer &block) override
+    {
+        // writing the block to the output ring buffer
+        mOutputRingBuffer.unsafeWrite(block);
     }
 
 private:
@@ -70,9 +70,17 @@ public:
                          const InjectionSampleByteSizes &injectionSampleByteSizes) override;
 
     std::unique_ptr<util::Buffer> dequeueExtractionBlock(ProbeId probeIndex) override;
+    std::vector<std::unique_ptr<util::Buffer>> dequeueExtractionBlocks(
+        ProbeId probeIndex, std::size_t maxByteSize) override;
 
     bool enqueueInjectionBlock(ProbeId probeIndex, const util::Buffer &buffer) override;
 
+    void recycleExtractionBlocks(std::vector<std::unique_ptr<util::Buffer>> &blocks) override;
+
+    std::vector<util::QueueStatistics> getExtractionQueueStatistics() const override;
+
+    ExtractionResyncStatistics getExtractionResyncStatistics() const override;
+
 private:
     ProberBackend mBackend;
     ProberStateMachine mStateMachine;
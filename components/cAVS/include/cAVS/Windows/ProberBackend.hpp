@@ -39,7 +39,7 @@
 #include "Util/ByteStreamWriter.hpp"
 #include "Util/BlockingQueue.hpp"
 #include "Util/Exception.hpp"
-#include "Util/RingBuffer.hpp"
+#include "Util/SpscRingBuffer.hpp"
 #include "cAVS/Windows/EventHandle.hpp"
 #include "cAVS/Windows/DriverTypes.hpp"
 
@@ -191,6 +191,10 @@ public:
      */
     std::unique_ptr<util::Buffer> dequeueExtractionBlock(ProbeId probeIndex);
 
+    /** @see cavs::Prober::dequeueExtractionBlocks */
+    std::vector<std::unique_ptr<util::Buffer>> dequeueExtractionBlocks(ProbeId probeIndex,
+                                                                       std::size_t maxByteSize);
+
     /**
      * Enqueue a block that will be injected to the probe.
      *
@@ -204,6 +208,15 @@ public:
      */
     bool enqueueInjectionBlock(ProbeId probeIndex, const util::Buffer &buffer);
 
+    /** @see cavs::Prober::recycleExtractionBlocks */
+    void recycleExtractionBlocks(std::vector<std::unique_ptr<util::Buffer>> &blocks);
+
+    /** @see cavs::Prober::getExtractionQueueStatistics */
+    std::vector<util::QueueStatistics> getExtractionQueueStatistics() const;
+
+    /** @see cavs::Prober::getExtractionResyncStatistics */
+    cavs::Prober::ExtractionResyncStatistics getExtractionResyncStatistics() const;
+
 private:
     ProberBackend(const ProberBackend &) = delete;
     ProberBackend &operator=(const ProberBackend &) = delete;
@@ -225,7 +238,7 @@ private:
     static constexpr auto mProbeFeature = driver::IOCTL_FEATURE::FEATURE_FW_PROBE;
     static constexpr std::size_t mQueueSize = 5 * 1024 * 1024;
 
-    using PacketQueue = util::BlockingQueue<util::Buffer>;
+    using PacketQueue = ProbeExtractor::BlockingPacketQueue;
 
     // 0 = get/setState
     using GetState =
@@ -271,10 +284,13 @@ private:
 
     /** map that provides the sample byte size of each injection probes. */
     cavs::Prober::InjectionSampleByteSizes mCachedInjectionSampleByteSizes;
+    /** Extracted packets are pooled, so that steady extraction does not allocate memory */
+    util::ByteBufferPool mPacketPool;
     ProbeExtractor::BlockingExtractionQueues mExtractionQueues;
     std::unique_ptr<ProbeExtractor> mExtractor;
+    ProbeExtractor::ResyncCounters mResyncCounters;
 
-    std::vector<util::RingBuffer> mInjectionQueues;
+    std::vector<util::SpscRingBuffer> mInjectionQueues;
     std::vector<ProbeInjector> mInjectors;
 
     mutable std::mutex mProbeConfigMutex;
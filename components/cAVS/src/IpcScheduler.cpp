@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2016, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cAVS/IpcScheduler.hpp"
+#include <algorithm>
+
+namespace debug_agent
+{
+namespace cavs
+{
+
+IpcScheduler::Slot IpcScheduler::acquire(IpcClass ipcClass)
+{
+    Urgency urgency(ipcClass);
+    return acquire(urgency);
+}
+
+IpcScheduler::Slot IpcScheduler::acquire(Urgency &urgency)
+{
+    std::unique_lock<std::mutex> locker(mMutex);
+    Request request(urgency.mClass);
+    if (!mBusy) {
+        mBusy = true;
+        grant(request, false);
+        return Slot(*this);
+    }
+
+    mWaiting.push_back(&request);
+    auto &statistics = getClassStatistics(request.ipcClass);
+    ++statistics.queueDepth;
+    statistics.maxQueueDepth = std::max(statistics.maxQueueDepth, statistics.queueDepth);
+
+    /* The releasing thread removes the request from the waiting list when granting it */
+    urgency.mRequest = &request;
+    mCondition.wait(locker, [&] { return request.granted; });
+    urgency.mRequest = nullptr;
+    return Slot(*this);
+}
+
+void IpcScheduler::raise(Urgency &urgency, IpcClass ipcClass)
+{
+    std::lock_guard<std::mutex> locker(mMutex);
+    if (!(ipcClass < urgency.mClass)) {
+        return;
+    }
+    urgency.mClass = ipcClass;
+
+    /* A waiting request moves to the queue of its new class */
+    Request *request = urgency.mRequest;
+    if (request != nullptr && !request->granted) {
+        --getClassStatistics(request->ipcClass).queueDepth;
+        auto &statistics = getClassStatistics(ipcClass);
+        ++statistics.queueDepth;
+        statistics.maxQueueDepth = std::max(statistics.maxQueueDepth, statistics.queueDepth);
+        request->ipcClass = ipcClass;
+    }
+}
+
+void IpcScheduler::release()
+{
+    std::lock_guard<std::mutex> locker(mMutex);
+    if (mWaiting.empty()) {
+        mBusy = false;
+        return;
+    }
+
+    /* The oldest starving request first, otherwise the oldest request of the most urgent class */
+    auto next = std::find_if(mWaiting.begin(), mWaiting.end(), [this](const Request *request) {
+        return request->overtakeCount >= mMaxOvertakeCount;
+    });
+    bool promoted = false;
+    if (next != mWaiting.end()) {
+        promoted = std::any_of(mWaiting.begin(), mWaiting.end(), [&](const Request *request) {
+            return request->ipcClass < (*next)->ipcClass;
+        });
+    } else {
+        next = std::min_element(mWaiting.begin(), mWaiting.end(),
+                                [](const Request *left, const Request *right) {
+                                    return left->ipcClass < right->ipcClass;
+                                });
+    }
+
+    /* The older requests are overtaken */
+    for (auto it = mWaiting.begin(); it != next; ++it) {
+        ++(*it)->overtakeCount;
+    }
+
+    Request &request = **next;
+    mWaiting.erase(next);
+    --getClassStatistics(request.ipcClass).queueDepth;
+    grant(request, promoted);
+    mCondition.notify_all();
+}
+
+void IpcScheduler::grant(Request &request, bool promoted)
+{
+    auto wait = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() -
+                                                                       request.requestTime);
+    auto &statistics = getClassStatistics(request.ipcClass);
+    ++statistics.requestCount;
+    if (promoted) {
+        ++statistics.promotedCount;
+    }
+    statistics.totalWait += wait;
+    statistics.maxWait = std::max(statistics.maxWait, wait);
+    request.granted = true;
+}
+
+IpcClassStatistics IpcScheduler::getStatistics(IpcClass ipcClass) const
+{
+    std::lock_guard<std::mutex> locker(mMutex);
+    return mStatistics[static_cast<std::size_t>(ipcClass)];
+}
+}
+}
@@ -32,6 +32,7 @@
 #include "Util/ByteStreamWriter.hpp"
 #include "Util/ByteStreamReader.hpp"
 #include <iostream>
+#include <cstdlib>
 
 using namespace debug_agent::util;
 using namespace std;
@@ -45,39 +46,68 @@ namespace cavs
 namespace linux
 {
 
-size_t AlsaControlDevice::getControlCountByTag(const std::string &tag) const
+AlsaControlDevice::Element::Element()
+    : id(nullptr, snd_ctl_elem_id_free), info(nullptr, snd_ctl_elem_info_free)
 {
-    size_t count = 0;
-    snd_hctl_t *handle;
-    snd_ctl_elem_id_t *id;
-    snd_ctl_elem_info_t *info;
-    snd_ctl_elem_id_alloca(&id);
-    snd_ctl_elem_info_alloca(&info);
-
-    int err = snd_hctl_open(&handle, mControl.c_str(), 0);
-    if (err < 0) {
-        throw Exception("Failed to open control " + mControl + ": " + snd_strerror(err));
+    snd_ctl_elem_id_t *newId;
+    snd_ctl_elem_info_t *newInfo;
+    if (snd_ctl_elem_id_malloc(&newId) < 0) {
+        throw std::bad_alloc();
     }
-    err = snd_hctl_load(handle);
-    if (err < 0) {
-        snd_hctl_close(handle);
-        throw Exception("Failed to load control " + mControl + ": " + snd_strerror(err));
+    id.reset(newId);
+    if (snd_ctl_elem_info_malloc(&newInfo) < 0) {
+        throw std::bad_alloc();
     }
-    snd_hctl_elem_t *elem = snd_hctl_first_elem(handle);
-    while (elem != nullptr) {
-        err = snd_hctl_elem_info(elem, info);
-        if (err < 0) {
-            snd_hctl_close(handle);
-            throw Exception("Failed to get ctl elem info: " + mControl + ": " + snd_strerror(err));
-        }
-        snd_hctl_elem_get_id(elem, id);
-        std::string name(snd_ctl_ascii_elem_id_get(id));
+    info.reset(newInfo);
+}
+
+size_t AlsaControlDevice::getControlCountByTag(const std::string &tag) const
+{
+    std::lock_guard<std::mutex> locker(mMutex);
+    processCardEvents();
+
+    const std::vector<std::string> &elementIds =
+        mCache.getElementIds([this](std::vector<std::string> &ids) {
+            snd_ctl_elem_list_t *list;
+            snd_ctl_elem_list_alloca(&list);
+
+            int err = snd_ctl_elem_list(mHandle, list);
+            if (err < 0) {
+                throw Exception("Failed to list elements of control " + mControl + ": " +
+                                snd_strerror(err));
+            }
+            unsigned int count = snd_ctl_elem_list_get_count(list);
+            err = snd_ctl_elem_list_alloc_space(list, count);
+            if (err < 0) {
+                throw Exception("Failed to list elements of control " + mControl + ": " +
+                                snd_strerror(err));
+            }
+            err = snd_ctl_elem_list(mHandle, list);
+            if (err < 0) {
+                snd_ctl_elem_list_free_space(list);
+                throw Exception("Failed to list elements of control " + mControl + ": " +
+                                snd_strerror(err));
+            }
+
+            snd_ctl_elem_id_t *id;
+            snd_ctl_elem_id_alloca(&id);
+            for (unsigned int index = 0; index < snd_ctl_elem_list_get_used(list); ++index) {
+                snd_ctl_elem_list_get_id(list, index, id);
+                char *asciiId = snd_ctl_ascii_elem_id_get(id);
+                if (asciiId != nullptr) {
+                    ids.emplace_back(asciiId);
+                    free(asciiId);
+                }
+            }
+            snd_ctl_elem_list_free_space(list);
+        });
+
+    size_t count = 0;
+    for (const auto &name : elementIds) {
         if (name.find(tag) != std::string::npos) {
             count += 1;
         }
-        elem = snd_hctl_elem_next(elem);
     }
-    snd_hctl_close(handle);
     return count;
 }
 
@@ -88,47 +118,77 @@ AlsaControlDevice::AlsaControlDevice(const std::string &name) : ControlDevice(na
         throw Exception("Invalid card " + getCardName() + " : " + snd_strerror(cardIndex));
     }
     mControl = {"hw:" + std::to_string(cardIndex)};
-}
 
-void AlsaControlDevice::getCtlHandle(const std::string &name, snd_ctl_t *&handle,
-                                     snd_ctl_elem_id_t &id, snd_ctl_elem_info_t &info,
-                                     snd_ctl_elem_value_t &control) const
-{
-    int error = snd_ctl_ascii_elem_id_parse(&id, name.c_str());
+    /* Card events are only read to invalidate the caches, reading them shall never block. */
+    int error = snd_ctl_open(&mHandle, mControl.c_str(), SND_CTL_NONBLOCK);
     if (error < 0) {
-        throw Exception("Failed to translate " + name + " as a control: " + snd_strerror(error));
+        throw Exception("Failed to open control " + mControl + ": " + snd_strerror(error));
     }
-
-    error = snd_ctl_open(&handle, mControl.c_str(), 0);
+    error = snd_ctl_subscribe_events(mHandle, 1);
     if (error < 0) {
-        throw Exception("Failed to open control " + mControl + ": " + snd_strerror(error));
+        snd_ctl_close(mHandle);
+        throw Exception("Failed to subscribe to events of control " + mControl + ": " +
+                        snd_strerror(error));
     }
+}
 
-    snd_ctl_elem_info_set_id(&info, &id);
-    error = snd_ctl_elem_info(handle, &info);
+AlsaControlDevice::~AlsaControlDevice()
+{
+    snd_ctl_close(mHandle);
+}
+
+void AlsaControlDevice::processCardEvents() const
+{
+    snd_ctl_event_t *event;
+    snd_ctl_event_alloca(&event);
+
+    mCache.processEvents([this, event](unsigned int &mask) {
+        int result = snd_ctl_read(mHandle, event);
+        mask = result > 0 && snd_ctl_event_get_type(event) == SND_CTL_EVENT_ELEM
+                   ? snd_ctl_event_elem_get_mask(event)
+                   : 0;
+        return result;
+    });
+}
+
+const AlsaControlDevice::Element &AlsaControlDevice::getElement(const std::string &name)
+{
+    processCardEvents();
+    return mCache.getElement(name, [this](const std::string &name) {
+        return resolveElement(name);
+    });
+}
+
+AlsaControlDevice::Element AlsaControlDevice::resolveElement(const std::string &name) const
+{
+    const std::string ctlName{getCtlName(name)};
+    Element element;
+    int error = snd_ctl_ascii_elem_id_parse(element.id.get(), ctlName.c_str());
     if (error < 0) {
-        snd_ctl_close(handle);
-        throw Exception("Cannot find " + name + " control mixer on " + mControl + ": " +
+        throw Exception("Failed to translate " + ctlName + " as a control: " +
                         snd_strerror(error));
     }
-    snd_ctl_elem_info_get_id(&info, &id);
 
-    snd_ctl_elem_value_set_id(&control, &id);
+    snd_ctl_elem_info_set_id(element.info.get(), element.id.get());
+    error = snd_ctl_elem_info(mHandle, element.info.get());
+    if (error < 0) {
+        throw Exception("Cannot find " + ctlName + " control mixer on " + mControl + ": " +
+                        snd_strerror(error));
+    }
+    /* Caching the complete identifier (numid...) resolved by the driver */
+    snd_ctl_elem_info_get_id(element.info.get(), element.id.get());
+    return element;
 }
 
 void AlsaControlDevice::ctlRead(const std::string &name, util::Buffer &bufferOutput)
 {
-    const std::string ctlName{getCtlName(name)};
-    snd_ctl_elem_id_t *id;
-    snd_ctl_elem_info_t *info;
-    snd_ctl_elem_id_alloca(&id);
-    snd_ctl_elem_info_alloca(&info);
-    snd_ctl_t *handle;
+    std::lock_guard<std::mutex> locker(mMutex);
+    const Element &element = getElement(name);
+    snd_ctl_elem_id_t *id = element.id.get();
+    snd_ctl_elem_info_t *info = element.info.get();
     snd_ctl_elem_value_t *control;
     snd_ctl_elem_value_alloca(&control);
-
-    getCtlHandle(ctlName, handle, *id, *info, *control);
-    assert(handle != NULL && info != NULL && id != NULL && control != NULL);
+    snd_ctl_elem_value_set_id(control, id);
 
     unsigned int count = snd_ctl_elem_info_get_count(info);
     snd_ctl_elem_type_t type = snd_ctl_elem_info_get_type(info);
@@ -139,9 +199,10 @@ void AlsaControlDevice::ctlRead(const std::string &name, util::Buffer &bufferOut
     if ((type == SND_CTL_ELEM_TYPE_BYTES) && snd_ctl_elem_info_is_tlv_readable(info)) {
 
         util::Buffer rawTlv(sizeof(TlvHeader) + count);
-        int ret = snd_ctl_elem_tlv_read(handle, id, reinterpret_cast<unsigned int *>(rawTlv.data()),
-                                        rawTlv.size());
-        snd_ctl_close(handle);
+        int ret = mCache.access(name, [&] {
+            return snd_ctl_elem_tlv_read(
+                mHandle, id, reinterpret_cast<unsigned int *>(rawTlv.data()), rawTlv.size());
+        });
         if (ret < 0) {
             throw Exception("Control " + getCardName() + " Unable to read element: " +
                             snd_strerror(ret));
@@ -152,16 +213,13 @@ void AlsaControlDevice::ctlRead(const std::string &name, util::Buffer &bufferOut
     }
 
     if (!snd_ctl_elem_info_is_readable(info)) {
-        snd_ctl_close(handle);
         throw Exception("Control " + getCardName() + " element is unreadable ");
     }
-    int error = snd_ctl_elem_read(handle, control);
+    int error = mCache.access(name, [&] { return snd_ctl_elem_read(mHandle, control); });
     if (error < 0) {
-        snd_ctl_close(handle);
         throw Exception("Cannot read the given element from control " + mControl + ":" +
                         std::string{snd_strerror(error)});
     }
-    snd_ctl_close(handle);
 
     for (unsigned int idx = 0; idx < count; idx++) {
         switch (type) {
@@ -201,19 +259,15 @@ void AlsaControlDevice::ctlRead(const std::string &name, util::Buffer &bufferOut
 
 void AlsaControlDevice::ctlWrite(const std::string &name, const util::Buffer &bufferInput)
 {
-    const std::string ctlName{getCtlName(name)};
-    snd_ctl_elem_id_t *id;
-    snd_ctl_elem_info_t *info;
-    snd_ctl_elem_id_alloca(&id);
-    snd_ctl_elem_info_alloca(&info);
-    snd_ctl_t *handle;
+    std::lock_guard<std::mutex> locker(mMutex);
+    const Element &element = getElement(name);
+    snd_ctl_elem_id_t *id = element.id.get();
+    snd_ctl_elem_info_t *info = element.info.get();
     snd_ctl_elem_value_t *control;
     snd_ctl_elem_value_alloca(&control);
+    snd_ctl_elem_value_set_id(control, id);
     int error;
 
-    getCtlHandle(ctlName, handle, *id, *info, *control);
-    assert(handle != NULL && info != NULL && id != NULL && control != NULL);
-
     unsigned int count = snd_ctl_elem_info_get_count(info);
     snd_ctl_elem_type_t type = snd_ctl_elem_info_get_type(info);
 
@@ -225,8 +279,10 @@ void AlsaControlDevice::ctlWrite(const std::string &name, const util::Buffer &bu
         messageWriter.writeRawBuffer(bufferInput);
         util::Buffer rawTlv = messageWriter.getBuffer();
 
-        error = snd_ctl_elem_tlv_write(handle, id, reinterpret_cast<unsigned int *>(rawTlv.data()));
-        snd_ctl_close(handle);
+        error = mCache.access(name, [&] {
+            return snd_ctl_elem_tlv_write(mHandle, id,
+                                          reinterpret_cast<unsigned int *>(rawTlv.data()));
+        });
         if (error < 0) {
             throw Exception("Control " + mControl + " element write error:" +
                             std::string{snd_strerror(error)});
@@ -235,7 +291,6 @@ void AlsaControlDevice::ctlWrite(const std::string &name, const util::Buffer &bu
     }
 
     if (!snd_ctl_elem_info_is_writable(info)) {
-        snd_ctl_close(handle);
         throw Exception("Control " + getCardName() + " element is unwritable ");
     }
 
@@ -273,17 +328,14 @@ void AlsaControlDevice::ctlWrite(const std::string &name, const util::Buffer &bu
             snd_ctl_elem_value_set_iec958(control, &iec958);
             break;
         default:
-            snd_ctl_close(handle);
             throw Exception("Control " + getCardName() + " element has unknown type");
         }
     }
-    error = snd_ctl_elem_write(handle, control);
+    error = mCache.access(name, [&] { return snd_ctl_elem_write(mHandle, control); });
     if (error < 0) {
-        snd_ctl_close(handle);
         throw Exception("Control " + mControl + " element write error:" +
                         std::string{snd_strerror(error)});
     }
-    snd_ctl_close(handle);
 }
 }
 }
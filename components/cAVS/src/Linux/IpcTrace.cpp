@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2016, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cAVS/Linux/IpcTrace.hpp"
+#include "Util/FileHelper.hpp"
+#include <algorithm>
+#include <iostream>
+
+namespace debug_agent
+{
+namespace cavs
+{
+namespace linux
+{
+
+/** "IPCT" in little endian */
+static const uint32_t traceMagic = 0x54435049;
+static const uint32_t traceVersion = 1;
+
+/** Upper bounds checked while reading, so that a corrupted trace cannot make the allocations
+ * fail */
+static const uint32_t maxTargetSize = 4 * 1024;
+static const uint32_t maxBufferSize = 64 * 1024 * 1024;
+
+static void writeString(util::ByteStreamWriter &writer, const std::string &value)
+{
+    writer.write(static_cast<uint32_t>(value.size()));
+    writer.writeMemoryLayout(value.data(), value.size());
+}
+
+static void readString(util::ByteStreamReader &reader, std::string &value)
+{
+    uint32_t size = 0;
+    reader.read(size);
+    if (size > maxTargetSize) {
+        throw util::ByteStreamReader::Exception("Invalid string size: " + std::to_string(size));
+    }
+    value.assign(size, '\0');
+    reader.readMemoryLayout(&value[0], size);
+}
+
+static void writeBuffer(util::ByteStreamWriter &writer, const util::Buffer &buffer)
+{
+    auto lastNonZero = std::find_if(buffer.rbegin(), buffer.rend(),
+                                    [](uint8_t byte) { return byte != 0; });
+    auto storedSize = static_cast<uint32_t>(buffer.rend() - lastNonZero);
+
+    writer.write(static_cast<uint32_t>(buffer.size()));
+    writer.write(storedSize);
+    writer.writeMemoryLayout(buffer.data(), storedSize);
+}
+
+static void readBuffer(util::ByteStreamReader &reader, util::Buffer &buffer)
+{
+    uint32_t size = 0;
+    uint32_t storedSize = 0;
+    reader.read(size);
+    reader.read(storedSize);
+    if (size > maxBufferSize || storedSize > size) {
+        throw util::ByteStreamReader::Exception("Invalid buffer size: " + std::to_string(size) +
+                                                " stored: " + std::to_string(storedSize));
+    }
+    buffer.assign(size, 0);
+    reader.readMemoryLayout(buffer.data(), storedSize);
+}
+
+void IpcTraceRecord::fromStream(util::ByteStreamReader &reader)
+{
+    reader.read(operation);
+    reader.read(status);
+    reader.read(timestamp);
+    readString(reader, target);
+    readBuffer(reader, input);
+    readBuffer(reader, output);
+    readBuffer(reader, reply);
+    reader.read(argument);
+    reader.read(result);
+    devices.clear();
+    reader.readVector<uint32_t>(devices);
+}
+
+void IpcTraceRecord::toStream(util::ByteStreamWriter &writer) const
+{
+    writer.write(operation);
+    writer.write(status);
+    writer.write(timestamp);
+    writeString(writer, target);
+    writeBuffer(writer, input);
+    writeBuffer(writer, output);
+    writeBuffer(writer, reply);
+    writer.write(argument);
+    writer.write(result);
+    writer.writeVector<uint32_t>(devices);
+}
+
+IpcTraceWriter::IpcTraceWriter(const std::string &fileName)
+    : mStart(std::chrono::steady_clock::now()), mFile(fileName, std::ios::binary)
+{
+    if (!mFile) { /* Using stream bool operator */
+        throw Exception("Unable to create trace file: " + fileName);
+    }
+
+    util::BufferByteStreamWriter writer(mScratch);
+    writer.write(traceMagic);
+    writer.write(traceVersion);
+    mFile.write(reinterpret_cast<const char *>(mScratch.data()), mScratch.size());
+}
+
+uint64_t IpcTraceWriter::getTimestamp() const
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now() - mStart)
+        .count();
+}
+
+void IpcTraceWriter::write(const IpcTraceRecord &record)
+{
+    std::lock_guard<std::mutex> locker(mMutex);
+    if (mFailed) {
+        return;
+    }
+
+    /* Serializing in the scratch buffer, which keeps its capacity across records */
+    util::BufferByteStreamWriter writer(mScratch);
+    writer.write(record);
+    mFile.write(reinterpret_cast<const char *>(mScratch.data()), mScratch.size());
+
+    if (mFile.bad()) {
+        std::cout << "Error while writing the IPC trace, recording stopped" << std::endl;
+        mFailed = true;
+    }
+}
+
+IpcTraceReader::IpcTraceReader(const std::string &fileName)
+{
+    util::Buffer content;
+    try {
+        content = util::file_helper::readAsBytes(fileName);
+    } catch (util::file_helper::Exception &e) {
+        throw Exception("Cannot read trace: " + std::string(e.what()));
+    }
+
+    util::MemoryByteStreamReader reader(content);
+    try {
+        uint32_t magic = 0;
+        uint32_t version = 0;
+        reader.read(magic);
+        reader.read(version);
+        if (magic != traceMagic) {
+            throw Exception("Not an IPC trace: " + fileName);
+        }
+        if (version != traceVersion) {
+            throw Exception("Unsupported IPC trace version: " + std::to_string(version));
+        }
+
+        while (!reader.isEOS()) {
+            IpcTraceRecord record;
+            try {
+                reader.read(record);
+            } catch (util::ByteStreamReader::EOSException &) {
+                /* The recording has been interrupted while writing the last record */
+                std::cout << "Warning: truncated IPC trace " << fileName << std::endl;
+                break;
+            }
+            mRecords.push_back(std::move(record));
+        }
+    } catch (util::ByteStreamReader::Exception &e) {
+        throw Exception("Invalid IPC trace " + fileName + ": " + std::string(e.what()));
+    }
+}
+}
+}
+}
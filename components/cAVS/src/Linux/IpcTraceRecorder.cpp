@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) 2016, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cAVS/Linux/IpcTraceRecorder.hpp"
+
+namespace debug_agent
+{
+namespace cavs
+{
+namespace linux
+{
+
+/** Perform a driver access and record it, including when it throws.
+ *
+ * @param[in] access the driver access
+ * @param[in] complete fills the record with the access outputs, called whatever the outcome
+ */
+template <typename Access, typename Complete>
+static void recordAccess(IpcTraceWriter &trace, IpcTraceRecord &record, Access &&access,
+                         Complete &&complete)
+{
+    record.timestamp = trace.getTimestamp();
+    try {
+        access();
+    } catch (CompressDevice::IoException &) {
+        record.status = IpcTraceStatus::Interrupted;
+        complete();
+        trace.write(record);
+        throw;
+    } catch (...) {
+        record.status = IpcTraceStatus::Failed;
+        complete();
+        trace.write(record);
+        throw;
+    }
+    complete();
+    trace.write(record);
+}
+
+template <typename Access>
+static void recordAccess(IpcTraceWriter &trace, IpcTraceRecord &record, Access &&access)
+{
+    recordAccess(trace, record, std::forward<Access>(access), [] {});
+}
+
+template <typename DeviceInfoType>
+static IpcTraceDeviceInfo toTraceDeviceInfo(const DeviceInfoType &info, std::size_t index = 0)
+{
+    return {info.cardId(), info.deviceId(), static_cast<uint32_t>(index)};
+}
+
+ssize_t RecordingDevice::commandWrite(const std::string &name, const util::Buffer &bufferInput)
+{
+    IpcTraceRecord record(IpcTraceOperation::CommandWrite, name);
+    record.input = bufferInput;
+    ssize_t written = 0;
+    recordAccess(*mTrace, record, [&] { written = mDevice->commandWrite(name, bufferInput); },
+                 [&] { record.result = written; });
+    return written;
+}
+
+void RecordingDevice::commandRead(const std::string &name, const util::Buffer &bufferInput,
+                                  util::Buffer &bufferOutput)
+{
+    IpcTraceRecord record(IpcTraceOperation::CommandRead, name);
+    record.input = bufferInput;
+    record.output = bufferOutput;
+    recordAccess(*mTrace, record, [&] { mDevice->commandRead(name, bufferInput, bufferOutput); },
+                 [&] { record.reply = bufferOutput; });
+}
+
+void RecordingControlDevice::ctlRead(const std::string &name, util::Buffer &bufferOutput)
+{
+    IpcTraceRecord record(IpcTraceOperation::ControlRead, name);
+    record.output = bufferOutput;
+    recordAccess(*mTrace, record, [&] { mDevice->ctlRead(name, bufferOutput); },
+                 [&] { record.reply = bufferOutput; });
+}
+
+void RecordingControlDevice::ctlWrite(const std::string &name, const util::Buffer &bufferInput)
+{
+    IpcTraceRecord record(IpcTraceOperation::ControlWrite, name);
+    record.input = bufferInput;
+    recordAccess(*mTrace, record, [&] { mDevice->ctlWrite(name, bufferInput); });
+}
+
+size_t RecordingControlDevice::getControlCountByTag(const std::string &name) const
+{
+    IpcTraceRecord record(IpcTraceOperation::ControlCount, name);
+    size_t count = 0;
+    recordAccess(*mTrace, record, [&] { count = mDevice->getControlCountByTag(name); },
+                 [&] { record.result = count; });
+    return count;
+}
+
+void RecordingCompressDevice::open(Mode mode, compress::Role role, compress::Config &config)
+{
+    IpcTraceRecord record(IpcTraceOperation::CompressOpen, getName());
+    recordAccess(*mTrace, record, [&] { mDevice->open(mode, role, config); });
+}
+
+bool RecordingCompressDevice::wait(int timeoutMs)
+{
+    IpcTraceRecord record(IpcTraceOperation::CompressWait, getName());
+    record.argument = timeoutMs;
+    bool ready = false;
+    recordAccess(*mTrace, record, [&] { ready = mDevice->wait(timeoutMs); },
+                 [&] { record.result = ready; });
+    return ready;
+}
+
+void RecordingCompressDevice::start()
+{
+    IpcTraceRecord record(IpcTraceOperation::CompressStart, getName());
+    recordAccess(*mTrace, record, [&] { mDevice->start(); });
+}
+
+void RecordingCompressDevice::stop()
+{
+    IpcTraceRecord record(IpcTraceOperation::CompressStop, getName());
+    recordAccess(*mTrace, record, [&] { mDevice->stop(); });
+}
+
+size_t RecordingCompressDevice::write(const util::Buffer &inputBuffer)
+{
+    IpcTraceRecord record(IpcTraceOperation::CompressWrite, getName());
+    record.input = inputBuffer;
+    size_t written = 0;
+    recordAccess(*mTrace, record, [&] { written = mDevice->write(inputBuffer); },
+                 [&] { record.result = written; });
+    return written;
+}
+
+size_t RecordingCompressDevice::read(util::Buffer &outputBuffer)
+{
+    IpcTraceRecord record(IpcTraceOperation::CompressRead, getName());
+    size_t read = 0;
+    recordAccess(*mTrace, record, [&] { read = mDevice->read(outputBuffer); }, [&] {
+        record.reply = outputBuffer;
+        record.result = read;
+    });
+    return read;
+}
+
+std::size_t RecordingCompressDevice::getAvailable()
+{
+    IpcTraceRecord record(IpcTraceOperation::CompressAvailable, getName());
+    std::size_t available = 0;
+    recordAccess(*mTrace, record, [&] { available = mDevice->getAvailable(); },
+                 [&] { record.result = available; });
+    return available;
+}
+
+std::size_t RecordingCompressDevice::getBufferSize() const
+{
+    IpcTraceRecord record(IpcTraceOperation::CompressBufferSize, getName());
+    std::size_t size = 0;
+    recordAccess(*mTrace, record, [&] { size = mDevice->getBufferSize(); },
+                 [&] { record.result = size; });
+    return size;
+}
+
+std::unique_ptr<CompressDevice> RecordingCompressDeviceFactory::newCompressDevice(
+    const compress::DeviceInfo &info) const
+{
+    IpcTraceRecord record(IpcTraceOperation::CompressCreate, info.name());
+    record.devices.push_back(toTraceDeviceInfo(info));
+    std::unique_ptr<CompressDevice> device;
+    recordAccess(*mTrace, record, [&] { device = mFactory->newCompressDevice(info); });
+    return std::make_unique<RecordingCompressDevice>(std::move(device), mTrace);
+}
+
+const compress::LoggersInfo RecordingCompressDeviceFactory::getLoggerDeviceInfoList() const
+{
+    IpcTraceRecord record(IpcTraceOperation::LoggerDevices, "");
+    compress::LoggersInfo loggersInfo;
+    auto complete = [&] {
+        for (const auto &info : loggersInfo) {
+            record.devices.push_back(toTraceDeviceInfo(info, info.coreId()));
+        }
+    };
+    recordAccess(*mTrace, record, [&] { loggersInfo = mFactory->getLoggerDeviceInfoList(); },
+                 complete);
+    return loggersInfo;
+}
+
+const compress::InjectionProbesInfo
+RecordingCompressDeviceFactory::getInjectionProbeDeviceInfoList() const
+{
+    IpcTraceRecord record(IpcTraceOperation::InjectionProbeDevices, "");
+    compress::InjectionProbesInfo probesInfo;
+    auto complete = [&] {
+        for (const auto &info : probesInfo) {
+            record.devices.push_back(toTraceDeviceInfo(info, info.probeIndex()));
+        }
+    };
+    recordAccess(*mTrace, record,
+                 [&] { probesInfo = mFactory->getInjectionProbeDeviceInfoList(); }, complete);
+    return probesInfo;
+}
+
+const compress::ExtractionProbeInfo RecordingCompressDeviceFactory::getExtractionProbeDeviceInfo()
+    const
+{
+    IpcTraceRecord record(IpcTraceOperation::ExtractionProbeDevice, "");
+    /* ExtractionProbeInfo is not default constructible */
+    std::unique_ptr<compress::ExtractionProbeInfo> probeInfo;
+    auto access = [&] {
+        probeInfo = std::make_unique<compress::ExtractionProbeInfo>(
+            mFactory->getExtractionProbeDeviceInfo());
+    };
+    auto complete = [&] {
+        if (probeInfo != nullptr) {
+            record.devices.push_back(toTraceDeviceInfo(*probeInfo));
+        }
+    };
+    recordAccess(*mTrace, record, access, complete);
+    return *probeInfo;
+}
+}
+}
+}
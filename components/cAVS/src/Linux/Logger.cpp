@@ -37,6 +37,7 @@
 #include <cstring>
 #include <algorithm>
 #include <map>
+#include <limits>
 
 namespace debug_agent
 {
@@ -151,6 +152,21 @@ std::unique_ptr<LogBlock> Logger::readLogBlock()
     return mLogEntryQueue.remove();
 }
 
+std::vector<std::unique_ptr<LogBlock>> Logger::readLogBlocks(std::size_t maxByteSize)
+{
+    return mLogEntryQueue.removeUpTo(maxByteSize, std::numeric_limits<std::size_t>::max());
+}
+
+void Logger::recycleLogBlocks(std::vector<std::unique_ptr<LogBlock>> &blocks)
+{
+    mLogBlockPool.release(blocks);
+}
+
+util::QueueStatistics Logger::getQueueStatistics() const
+{
+    return mLogEntryQueue.getStatistics();
+}
+
 void Logger::constructProducers()
 {
     compress::LoggersInfo loggersInfo;
@@ -162,7 +178,8 @@ void Logger::constructProducers()
     for (const auto &loggerInfo : loggersInfo) {
         /* @todo: if one is failing, shall we continue in degradated mode? */
         mLogProducers.push_back(
-            std::make_unique<LogProducer>(mLogEntryQueue, loggerInfo.coreId(), mDevice,
+            std::make_unique<LogProducer>(mLogEntryQueue, mLogBlockPool, loggerInfo.coreId(),
+                                          mDevice,
                                           mCompressDeviceFactory.newCompressDevice(loggerInfo)));
     }
     if (mLogProducers.empty()) {
@@ -220,10 +237,11 @@ Logger::Level Logger::fromLinux(const mixer_ctl::LogPriority &level)
 /* The constructor starts the log producer thread.
  * @todo: once driver supports waking up one core separately, send the request to the right core.
  */
-Logger::LogProducer::LogProducer(BlockingLogQueue &queue, unsigned int coreId, Device &device,
+Logger::LogProducer::LogProducer(BlockingLogQueue &queue, LogBlockPool &pool,
+                                 unsigned int coreId, Device &device,
                                  std::unique_ptr<CompressDevice> logDevice)
-    : mQueue(queue), mCoreId(coreId), mLogDevice(std::move(logDevice)), mDevice(device),
-      mCorePower(device)
+    : mQueue(queue), mPool(pool), mCoreId(coreId), mLogDevice(std::move(logDevice)),
+      mDevice(device), mCorePower(device)
 {
     /* No parameter to start / stop logging on linux. So, just consider that if a log device
      * could be opened and started and consequently a log producer instantiated it is enough
@@ -316,13 +334,15 @@ void Logger::LogProducer::produceEntries()
         mProductionThreadBlocked = false;
         mCondVar.notify_one();
         /* Wait guarantees that there is something to read. */
-        LogBlockPtr logBlock(std::make_unique<LogBlock>(mCoreId, fragmentSize));
+        LogBlockPtr logBlock(mPool.acquire(mCoreId, fragmentSize));
         try {
             mLogDevice->read(logBlock->getLogData());
         } catch (const CompressDevice::Exception &e) {
             std::cout << "Error reading log from Log Device: " + std::string(e.what()) << std::endl;
         }
-        if (logBlock->getLogData().size() != 0 && !mQueue.add(std::move(logBlock))) {
+        if (logBlock->getLogData().size() == 0) {
+            mPool.release(std::move(logBlock));
+        } else if (!mQueue.add(std::move(logBlock))) {
             std::cout << "Warning: dropping log entry: the queue is full or closed" << std::endl;
         }
     }
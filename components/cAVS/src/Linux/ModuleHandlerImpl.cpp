@@ -29,9 +29,10 @@
  */
 #include "cAVS/Linux/ModuleHandlerImpl.hpp"
 #include "cAVS/Linux/DriverTypes.hpp"
-#include "cAVS/Linux/CorePower.hpp"
+#include "cAVS/Linux/CorePowerVoter.hpp"
 #include "cAVS/DspFw/Common.hpp"
 #include "Util/ByteStreamReader.hpp"
+#include "Util/ByteStreamWriter.hpp"
 #include "Util/Buffer.hpp"
 #include <vector>
 #include <iostream>
@@ -46,52 +47,79 @@ namespace linux
 util::Buffer ModuleHandlerImpl::configGet(uint16_t moduleId, uint16_t instanceId,
                                           dsp_fw::ParameterId parameterId, size_t parameterSize)
 {
-    AutoPreventFromSleeping<Exception> autoPower(mCorePower);
+    util::Buffer parameterPayload;
+    configGet(moduleId, instanceId, parameterId, parameterSize, parameterPayload);
+    return parameterPayload;
+}
+
+void ModuleHandlerImpl::configGet(uint16_t moduleId, uint16_t instanceId,
+                                  dsp_fw::ParameterId parameterId, size_t parameterSize,
+                                  util::Buffer &parameterPayload)
+{
+    CorePowerVoter<Exception>::Vote corePowerVote(mCorePowerVoter);
     /* Creating the header and body payload using the LargeConfigAccess type */
     driver::LargeConfigAccess configAccess(driver::LargeConfigAccess::CmdType::Get, moduleId,
                                            instanceId, parameterId.getValue(), parameterSize);
 
+    /* The device serializes the commands anyway, so sharing the command buffers costs no
+     * parallelism. */
+    std::lock_guard<std::mutex> guard(mCommandMutex);
+
     /* Creating debugfs command buffers. */
-    util::MemoryByteStreamWriter messageWriter;
+    util::BufferByteStreamWriter messageWriter(mMessageBuffer, configAccess.getSerializedSize());
     messageWriter.write(configAccess);
 
-    util::Buffer receivedMessage;
-    receivedMessage.resize(maxParameterPayloadSize);
+    /* The reply buffer capacity is kept from one command to the other, but its content is reset
+     * so that a short reply cannot be completed by the bytes of a former one. */
+    mReplyBuffer.assign(maxParameterPayloadSize, 0);
 
     try {
-        mDevice.commandRead(driver::setGetCtrl, messageWriter.getBuffer(), receivedMessage);
+        mDevice.commandRead(driver::setGetCtrl, mMessageBuffer, mReplyBuffer);
     } catch (const Device::Exception &e) {
         throw Exception("Get module parameter failed to read command debugfs in file: " +
                         std::string(driver::setGetCtrl) + ", Device returns an exception: " +
                         std::string(e.what()));
     }
 
-    /* Reading the answer using the header of the corresponding replied debugfs command. */
-    util::MemoryByteStreamReader messageReader(receivedMessage);
-    messageReader.read(configAccess);
-    const auto &payloadBegin = messageReader.getBuffer().begin() + messageReader.getPointerOffset();
-    return {payloadBegin, payloadBegin + configAccess.getReplyPayloadSize()};
+    /* Reading the answer using the header of the corresponding replied debugfs command, then
+     * copying the payload straight from the reply buffer. */
+    try {
+        util::BufferViewByteStreamReader messageReader(mReplyBuffer);
+        messageReader.read(configAccess);
+        /* The reply may be shorter than the requested payload size */
+        std::size_t payloadSize = std::min(configAccess.getReplyPayloadSize(),
+                                           mReplyBuffer.size() - messageReader.getPointerOffset());
+        util::BufferView payload = messageReader.readView(payloadSize);
+        parameterPayload.assign(payload.begin(), payload.end());
+    } catch (const util::ByteStreamReader::Exception &e) {
+        throw Exception("Get module parameter failed to decode the reply: " +
+                        std::string(e.what()));
+    }
 }
 
 void ModuleHandlerImpl::configSet(uint16_t moduleId, uint16_t instanceId,
                                   dsp_fw::ParameterId parameterId,
                                   const util::Buffer &parameterPayload)
 {
-    AutoPreventFromSleeping<Exception> autoPower(mCorePower);
+    CorePowerVoter<Exception>::Vote corePowerVote(mCorePowerVoter);
+    std::lock_guard<std::mutex> guard(mCommandMutex);
+
     /* Creating the header and body payload using the Large or Module ConfigAccess type */
-    util::MemoryByteStreamWriter messageWriter;
     if (parameterId.getValue() == dsp_fw::BaseModuleParams::MOD_INST_ENABLE) {
         driver::ModuleConfigAccess configAccess(driver::ModuleConfigAccess::CmdType::Set, moduleId,
                                                 instanceId, parameterId.getValue());
+        util::BufferByteStreamWriter messageWriter(mMessageBuffer);
         messageWriter.write(configAccess);
     } else {
         driver::LargeConfigAccess configAccess(driver::LargeConfigAccess::CmdType::Set, moduleId,
                                                instanceId, parameterId.getValue(),
                                                parameterPayload.size(), parameterPayload);
+        util::BufferByteStreamWriter messageWriter(mMessageBuffer,
+                                                   configAccess.getSerializedSize());
         messageWriter.write(configAccess);
     }
     try {
-        mDevice.commandWrite(driver::setGetCtrl, messageWriter.getBuffer());
+        mDevice.commandWrite(driver::setGetCtrl, mMessageBuffer);
     } catch (const Device::Exception &e) {
         throw Exception("Get module parameter failed to write command debugfs in file: " +
                         std::string(driver::setGetCtrl) + ", Device returns an exception: " +
@@ -42,6 +42,7 @@
 #include <cstring>
 #include <map>
 #include <algorithm>
+#include <limits>
 #include <stdexcept>
 
 namespace debug_agent
@@ -62,7 +63,7 @@ static const std::map<Prober::ProbePurpose, mixer_ctl::ProbePurpose> purposeConv
 
 Prober::Prober(ControlDevice &controlDevice, CompressDeviceFactory &compressDeviceFactory)
     : mControlDevice(controlDevice), mCompressDeviceFactory(compressDeviceFactory),
-      mIsActiveState(false)
+      mPacketPool(mQueueSize), mIsActiveState(false)
 {
     try {
         mMaxExtractionProbes = mControlDevice.getControlCountByTag(mixer_ctl::mExtractorControlTag);
@@ -79,6 +80,7 @@ Prober::Prober(ControlDevice &controlDevice, CompressDeviceFactory &compressDevi
     for (std::size_t extractIndex = 0; extractIndex < mMaxExtractionProbes; ++extractIndex) {
         mExtractionQueues.emplace_back(mQueueSize,
                                        [](const util::Buffer &buffer) { return buffer.size(); });
+        mExtractionQueues.back().setRecycler(util::PoolRecycler<util::Buffer>(mPacketPool));
     }
 }
 
@@ -148,17 +150,20 @@ void Prober::setProbesConfig(const SessionProbes &probes,
         throw Exception("Exceed max injection probes supported: " + injectionProbes.size());
     }
 
+    /* The control buffer is reused for each probe */
+    util::Buffer controlBuffer;
+
     /** Setting extraction probe mixers. */
     if (not extractionProbes.empty()) {
         ProbeId::RawType probeControlId{0};
         for (const auto probeId : extractionProbes) {
             const auto &extractionProbe = mCachedProbeConfig[probeId.getValue()];
             mixer_ctl::ProbeControl probeControl(toLinux(extractionProbe));
-            util::MemoryByteStreamWriter controlWriter;
+            util::BufferByteStreamWriter controlWriter(controlBuffer);
             controlWriter.write(probeControl);
             try {
                 mControlDevice.ctlWrite(mixer_ctl::getProbeExtractControl(probeControlId),
-                                        controlWriter.getBuffer());
+                                        controlBuffer);
                 mExtractionProbeMap[probeId] = ProbeId{probeControlId};
                 probeControlId++;
             } catch (const ControlDevice::Exception &e) {
@@ -175,11 +180,11 @@ void Prober::setProbesConfig(const SessionProbes &probes,
         for (auto probeId : injectionProbes) {
             const auto &probe = mCachedProbeConfig[probeId.getValue()];
             mixer_ctl::ProbeControl probeControl(toLinux(probe));
-            util::MemoryByteStreamWriter controlWriter;
+            util::BufferByteStreamWriter controlWriter(controlBuffer);
             controlWriter.write(probeControl);
             try {
                 mControlDevice.ctlWrite(mixer_ctl::getProbeInjectControl(probeControlId),
-                                        controlWriter.getBuffer());
+                                        controlBuffer);
                 mInjectionProbeMap[probeId] = ProbeId{probeControlId};
                 probeControlId++;
             } catch (const ControlDevice::Exception &e) {
@@ -235,6 +240,15 @@ std::unique_ptr<util::Buffer> Prober::dequeueExtractionBlock(ProbeId probeIndex)
     return mExtractionQueues[probeControlId.getValue()].remove();
 }
 
+std::vector<std::unique_ptr<util::Buffer>> Prober::dequeueExtractionBlocks(
+    ProbeId probeIndex, std::size_t maxByteSize)
+{
+    ProbeId probeControlId{getExtractProbeControlId(probeIndex)};
+
+    return mExtractionQueues[probeControlId.getValue()].removeUpTo(
+        maxByteSize, std::numeric_limits<std::size_t>::max());
+}
+
 bool Prober::enqueueInjectionBlock(ProbeId probeIndex, const util::Buffer &buffer)
 {
     ProbeId probeControlId{getInjectProbeControlId(probeIndex)};
@@ -243,6 +257,27 @@ bool Prober::enqueueInjectionBlock(ProbeId probeIndex, const util::Buffer &buffe
     return mInjectionQueues[probeControlId.getValue()].writeBlocking(buffer.data(), buffer.size());
 }
 
+void Prober::recycleExtractionBlocks(std::vector<std::unique_ptr<util::Buffer>> &blocks)
+{
+    mPacketPool.release(blocks);
+}
+
+std::vector<util::QueueStatistics> Prober::getExtractionQueueStatistics() const
+{
+    std::vector<util::QueueStatistics> statistics;
+    for (auto &queue : mExtractionQueues) {
+        statistics.push_back(queue.getStatistics());
+    }
+    return statistics;
+}
+
+Prober::ExtractionResyncStatistics Prober::getExtractionResyncStatistics() const
+{
+    auto statistics = mResyncCounters.getStatistics();
+    statistics.probes.resize(mExtractionQueues.size());
+    return statistics;
+}
+
 void Prober::startStreaming()
 {
     auto result = getActiveSession(mCachedProbeConfig);
@@ -281,8 +316,10 @@ void Prober::startStreaming()
             throw Exception("Could not start extraction input stream: " + std::string(e.what()));
         }
         try {
-            mProbeExtractor = std::make_unique<ProbeExtractor>(mExtractionQueues, probePointMap,
-                                                               std::move(inputStream));
+            mProbeExtractor =
+                std::make_unique<ProbeExtractor>(mExtractionQueues, probePointMap,
+                                                 std::move(inputStream), &mPacketPool,
+                                                 &mResyncCounters);
         } catch (const ProbeExtractor::Exception &e) {
             throw Exception("Could not start extraction input stream: " + std::string(e.what()));
         }
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2016, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cAVS/Linux/RawDebugFsEntryHandler.hpp"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace debug_agent::util;
+using namespace std;
+
+namespace debug_agent
+{
+namespace cavs
+{
+namespace linux
+{
+
+RawDebugFsEntryHandler::~RawDebugFsEntryHandler()
+{
+    for (auto &entry : mEntries) {
+        ::close(entry.second);
+    }
+}
+
+void RawDebugFsEntryHandler::open(const std::string &name)
+{
+    if (mCurrentEntry != mEntries.end()) {
+        throw Exception("Parallel operation not permitted on same debugfs entry: " + name);
+    }
+    auto it = mEntries.find(name);
+    if (it == mEntries.end()) {
+        int fd = ::open(name.c_str(), O_RDWR | O_CLOEXEC);
+        if (fd < 0) {
+            throw Exception("error while opening debugfs " + name + " file.");
+        }
+        it = mEntries.emplace(name, fd).first;
+    }
+    mCurrentEntry = it;
+}
+
+void RawDebugFsEntryHandler::close() noexcept
+{
+    mCurrentEntry = mEntries.end();
+}
+
+void RawDebugFsEntryHandler::evictCurrentEntry() noexcept
+{
+    ::close(mCurrentEntry->second);
+    mEntries.erase(mCurrentEntry);
+    mCurrentEntry = mEntries.end();
+}
+
+ssize_t RawDebugFsEntryHandler::write(const Buffer &bufferInput)
+{
+    if (mCurrentEntry == mEntries.end()) {
+        throw Exception("Illegal write operation on closed file");
+    }
+    /* A debugfs entry consumes a command in a single write, a partial write is an error. */
+    ssize_t written;
+    do {
+        written = ::pwrite(mCurrentEntry->second, bufferInput.data(), bufferInput.size(), 0);
+    } while (written < 0 && errno == EINTR);
+
+    if (written != static_cast<ssize_t>(bufferInput.size())) {
+        std::string error(written < 0 ? strerror(errno) : "partial write");
+        evictCurrentEntry();
+        throw Exception("error during write operation: " + error);
+    }
+    return written;
+}
+
+ssize_t RawDebugFsEntryHandler::read(Buffer &bufferOutput, const ssize_t nbBytes)
+{
+    if (mCurrentEntry == mEntries.end()) {
+        throw Exception("Illegal read operation on closed file");
+    }
+    ssize_t nbRead;
+    do {
+        nbRead = ::pread(mCurrentEntry->second, bufferOutput.data(), nbBytes, 0);
+    } while (nbRead < 0 && errno == EINTR);
+
+    /* Reading less than expected is not an error, as blind request with max size are ok. */
+    if (nbRead <= 0) {
+        std::string error(nbRead < 0 ? strerror(errno) : "end of file");
+        evictCurrentEntry();
+        throw Exception("error during read operation: " + error);
+    }
+    return nbRead;
+}
+}
+}
+}
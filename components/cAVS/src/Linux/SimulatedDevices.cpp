@@ -0,0 +1,343 @@
+/*
+ * Copyright (c) 2016, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cAVS/Linux/SimulatedDevices.hpp"
+#include <algorithm>
+
+namespace debug_agent
+{
+namespace cavs
+{
+namespace linux
+{
+
+/** Card of all simulated compress devices */
+static const unsigned int cardId = 0;
+
+ssize_t SimulatedDevice::commandWrite(const std::string &name, const util::Buffer &bufferInput)
+{
+    mFirmware->delayIpc();
+    try {
+        mFirmware->commandWrite(name, bufferInput);
+    } catch (SimulatedFirmware::Exception &e) {
+        throw Exception("Simulated firmware error: " + std::string(e.what()));
+    }
+    return bufferInput.size();
+}
+
+void SimulatedDevice::commandRead(const std::string &name, const util::Buffer &bufferInput,
+                                  util::Buffer &bufferOutput)
+{
+    mFirmware->delayIpc();
+    try {
+        mFirmware->commandRead(name, bufferInput, bufferOutput);
+    } catch (SimulatedFirmware::Exception &e) {
+        throw Exception("Simulated firmware error: " + std::string(e.what()));
+    }
+}
+
+void SimulatedControlDevice::ctlRead(const std::string &name, util::Buffer &bufferOutput)
+{
+    mFirmware->delayIpc();
+    try {
+        mFirmware->ctlRead(name, bufferOutput);
+    } catch (SimulatedFirmware::Exception &e) {
+        throw Exception("Simulated firmware error: " + std::string(e.what()));
+    }
+}
+
+void SimulatedControlDevice::ctlWrite(const std::string &name, const util::Buffer &bufferInput)
+{
+    mFirmware->delayIpc();
+    try {
+        mFirmware->ctlWrite(name, bufferInput);
+    } catch (SimulatedFirmware::Exception &e) {
+        throw Exception("Simulated firmware error: " + std::string(e.what()));
+    }
+}
+
+size_t SimulatedControlDevice::getControlCountByTag(const std::string &name) const
+{
+    return mFirmware->getControlCountByTag(name);
+}
+
+SimulatedCompressDevice::SimulatedCompressDevice(const compress::DeviceInfo &info,
+                                                 std::shared_ptr<SimulatedFirmware> firmware,
+                                                 Stream stream, unsigned int index)
+    : CompressDevice(info), mFirmware(firmware), mStream(stream), mIndex(index)
+{
+    const SimulatedFirmware::Config &config = mFirmware->getConfig();
+    uint32_t rate = mStream == Stream::Log ? config.logRate : config.probeRate;
+    if (isCapture() && rate > 0) {
+        mPeriod = std::chrono::nanoseconds(std::chrono::seconds(1)) / rate;
+    }
+}
+
+void SimulatedCompressDevice::open(Mode, compress::Role role, compress::Config &config)
+{
+    std::lock_guard<std::mutex> guard(mMutex);
+    if ((role == compress::Role::Capture) != isCapture()) {
+        throw Exception("Invalid role for simulated device " + getName());
+    }
+    if (config.mConfig.fragment_size == 0 || config.mConfig.fragments == 0) {
+        throw Exception("Invalid buffer configuration for simulated device " + getName());
+    }
+    setConfig(config);
+    mFragmentSize = config.mConfig.fragment_size;
+    mPending.clear();
+    mPending.reserve(getBufferSize());
+    mFill = 0;
+    mReady = true;
+}
+
+bool SimulatedCompressDevice::isRunning() const noexcept
+{
+    std::lock_guard<std::mutex> guard(mMutex);
+    return mRunning;
+}
+
+bool SimulatedCompressDevice::isReady() const noexcept
+{
+    std::lock_guard<std::mutex> guard(mMutex);
+    return mReady;
+}
+
+void SimulatedCompressDevice::close() noexcept
+{
+    std::lock_guard<std::mutex> guard(mMutex);
+    mReady = false;
+    mRunning = false;
+    mPending.clear();
+    mFill = 0;
+    mCondition.notify_all();
+}
+
+void SimulatedCompressDevice::start()
+{
+    std::lock_guard<std::mutex> guard(mMutex);
+    if (!mReady) {
+        throw Exception("Simulated device " + getName() + " is not open");
+    }
+    Clock::time_point now = Clock::now();
+    mNextProduction = mPeriod.count() > 0 ? now + mPeriod + mFirmware->getJitter()
+                                          : Clock::time_point::max();
+    mLastDrain = now;
+    mRunning = true;
+    mCondition.notify_all();
+}
+
+void SimulatedCompressDevice::stop()
+{
+    std::lock_guard<std::mutex> guard(mMutex);
+    mRunning = false;
+    mCondition.notify_all();
+}
+
+bool SimulatedCompressDevice::wait(int timeoutMs)
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+    Clock::time_point deadline = timeoutMs == mInfiniteTimeout
+                                     ? Clock::time_point::max()
+                                     : Clock::now() + std::chrono::milliseconds(timeoutMs);
+    for (;;) {
+        if (!mRunning) {
+            /* Stopped while waiting, as a real device */
+            throw IoException();
+        }
+        Clock::time_point now = Clock::now();
+        Clock::time_point nextEvent = update(now);
+        if (isAvailable()) {
+            return true;
+        }
+        if (now >= deadline) {
+            return false;
+        }
+        Clock::time_point wakeUp = std::min(deadline, nextEvent);
+        if (wakeUp == Clock::time_point::max()) {
+            mCondition.wait(lock);
+        } else {
+            mCondition.wait_until(lock, wakeUp);
+        }
+    }
+}
+
+size_t SimulatedCompressDevice::write(const util::Buffer &inputBuffer)
+{
+    std::lock_guard<std::mutex> guard(mMutex);
+    if (!mReady || isCapture()) {
+        throw Exception("Simulated device " + getName() + " is not open for playback");
+    }
+    if (mRunning) {
+        drain(Clock::now());
+    }
+    std::size_t written = std::min(inputBuffer.size(), getBufferSize() - mFill);
+    mFill += written;
+    mDrainJitter = mFirmware->getJitter();
+    return written;
+}
+
+size_t SimulatedCompressDevice::read(util::Buffer &outputBuffer)
+{
+    std::lock_guard<std::mutex> guard(mMutex);
+    if (!mReady || !isCapture()) {
+        throw Exception("Simulated device " + getName() + " is not open for capture");
+    }
+    if (mRunning) {
+        update(Clock::now());
+    }
+    std::size_t count = std::min(outputBuffer.size(), mPending.size());
+    std::copy_n(mPending.begin(), count, outputBuffer.begin());
+    mPending.erase(mPending.begin(), mPending.begin() + count);
+    outputBuffer.resize(count);
+    return count;
+}
+
+std::size_t SimulatedCompressDevice::getAvailable()
+{
+    std::lock_guard<std::mutex> guard(mMutex);
+    if (mRunning) {
+        update(Clock::now());
+    }
+    return isCapture() ? mPending.size() : getBufferSize() - mFill;
+}
+
+SimulatedCompressDevice::Clock::time_point SimulatedCompressDevice::update(Clock::time_point now)
+{
+    return isCapture() ? produce(now) : drain(now);
+}
+
+SimulatedCompressDevice::Clock::time_point SimulatedCompressDevice::produce(Clock::time_point now)
+{
+    while (mNextProduction <= now) {
+        if (mPending.size() >= getBufferSize()) {
+            /* Overrun: the firmware drops its production until the buffer is read */
+            mNextProduction = now + mPeriod;
+            break;
+        }
+        if (mStream == Stream::Log) {
+            mFirmware->produceLogFragment(mIndex, mChunk);
+        } else if (!mFirmware->produceProbePacket(mChunk)) {
+            /* No probe connected yet */
+            mNextProduction = now + mPeriod;
+            break;
+        }
+        mPending.insert(mPending.end(), mChunk.begin(), mChunk.end());
+        mNextProduction += mPeriod + mFirmware->getJitter();
+    }
+    return mNextProduction;
+}
+
+SimulatedCompressDevice::Clock::time_point SimulatedCompressDevice::drain(Clock::time_point now)
+{
+    const double rate = mFirmware->getConfig().injectionRate;
+
+    if (mFill > 0) {
+        std::chrono::duration<double> elapsed = now - mLastDrain;
+        std::size_t drained = std::min(mFill, static_cast<std::size_t>(elapsed.count() * rate));
+        if (drained > 0) {
+            mFill -= drained;
+            mFirmware->consumeInjectionData(drained);
+            mLastDrain += std::chrono::duration_cast<Clock::duration>(
+                std::chrono::duration<double>(drained / rate));
+        }
+    }
+    if (mFill == 0) {
+        mLastDrain = now;
+    }
+
+    /* Time when a fragment can be written */
+    std::size_t free = getBufferSize() - mFill;
+    if (free >= mFragmentSize) {
+        return now;
+    }
+    return mLastDrain + mDrainJitter +
+           std::chrono::duration_cast<Clock::duration>(
+               std::chrono::duration<double>((mFragmentSize - free) / rate));
+}
+
+bool SimulatedCompressDevice::isAvailable() const
+{
+    return isCapture() ? !mPending.empty() : getBufferSize() - mFill >= mFragmentSize;
+}
+
+std::unique_ptr<CompressDevice> SimulatedCompressDeviceFactory::newCompressDevice(
+    const compress::DeviceInfo &info) const
+{
+    using Stream = SimulatedCompressDevice::Stream;
+    const SimulatedFirmware::Config &config = mFirmware->getConfig();
+    unsigned int deviceId = info.deviceId();
+
+    if (info.cardId() == cardId) {
+        if (deviceId < config.coreCount) {
+            return std::make_unique<SimulatedCompressDevice>(info, mFirmware, Stream::Log,
+                                                             deviceId);
+        }
+        deviceId -= config.coreCount;
+        if (deviceId == 0) {
+            return std::make_unique<SimulatedCompressDevice>(info, mFirmware,
+                                                             Stream::ProbeExtraction, 0);
+        }
+        deviceId -= 1;
+        if (deviceId < config.injectionProbeCount) {
+            return std::make_unique<SimulatedCompressDevice>(info, mFirmware,
+                                                             Stream::ProbeInjection, deviceId);
+        }
+    }
+    throw Exception("No simulated compress device " + info.name());
+}
+
+const compress::LoggersInfo SimulatedCompressDeviceFactory::getLoggerDeviceInfoList() const
+{
+    compress::LoggersInfo loggers;
+    for (unsigned int coreId = 0; coreId < mFirmware->getConfig().coreCount; ++coreId) {
+        loggers.emplace_back(cardId, coreId, coreId);
+    }
+    return loggers;
+}
+
+const compress::InjectionProbesInfo SimulatedCompressDeviceFactory::
+    getInjectionProbeDeviceInfoList() const
+{
+    const SimulatedFirmware::Config &config = mFirmware->getConfig();
+    compress::InjectionProbesInfo injectors;
+    for (unsigned int index = 0; index < config.injectionProbeCount; ++index) {
+        injectors.emplace_back(cardId, config.coreCount + 1 + index, index);
+    }
+    return injectors;
+}
+
+const compress::ExtractionProbeInfo SimulatedCompressDeviceFactory::getExtractionProbeDeviceInfo()
+    const
+{
+    return {cardId, mFirmware->getConfig().coreCount};
+}
+}
+}
+}
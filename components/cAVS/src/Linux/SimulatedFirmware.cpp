@@ -0,0 +1,658 @@
+/*
+ * Copyright (c) 2016, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cAVS/Linux/SimulatedFirmware.hpp"
+#include "cAVS/Linux/DriverTypes.hpp"
+#include "cAVS/Linux/ControlDeviceTypes.hpp"
+#include "cAVS/DspFw/ConfigTypes.hpp"
+#include "cAVS/DspFw/GlobalPerfData.hpp"
+#include "Util/ByteStreamReader.hpp"
+#include "Util/ByteStreamWriter.hpp"
+#include "Util/StringHelper.hpp"
+#include "Util/convert.hpp"
+#include <algorithm>
+#include <limits>
+#include <thread>
+
+namespace debug_agent
+{
+namespace cavs
+{
+namespace linux
+{
+
+/** Limits of the synthetic topology, so that each firmware reply fits in the parameter
+ * payload */
+static const uint32_t maxCoreCount = 8;
+static const uint32_t maxModulesPerPipeline = 16;
+static const uint32_t maxModuleInstanceCount = 240;
+static const uint32_t maxProbeCount = 64;
+static const uint32_t maxRate = 1000 * 1000;
+static const uint32_t maxChunkSize = 64 * 1024;
+
+/** Log fragment header: wall clock, core id and sequence number */
+static const uint32_t logFragmentHeaderSize = sizeof(uint64_t) + 2 * sizeof(uint32_t);
+
+/** Command types of the module configuration messages, see DriverTypes.hpp */
+static const uint32_t moduleConfigSet =
+    static_cast<uint32_t>(driver::ModuleConfigAccess::CmdType::Set);
+static const uint32_t largeConfigGet =
+    static_cast<uint32_t>(driver::LargeConfigAccess::CmdType::Get);
+static const uint32_t largeConfigSet =
+    static_cast<uint32_t>(driver::LargeConfigAccess::CmdType::Set);
+
+/** Name of the module type run at each position of a pipeline, the first and the last ones being
+ * the gateway copiers */
+static const std::vector<std::string> processingModuleNames = {
+    "MIXIN", "MIXOUT", "SRC", "UPDWMIX", "GAIN", "PEAKVOL", "AEC",
+    "NS",    "EQIIR",  "EQFIR", "DRC",   "WOV",  "KPB",     "MUX"};
+
+/** Message header of a module configuration command, see driver::MessageHeader */
+struct CommandHeader
+{
+    uint32_t moduleId;
+    uint32_t instanceId;
+    uint32_t type;
+    uint32_t dataSize;
+    uint32_t largeParamId;
+
+    void fromStream(util::ByteStreamReader &reader)
+    {
+        uint32_t size, primaryWord, extendedWord;
+        reader.read(size);
+        reader.read(primaryWord);
+        reader.read(extendedWord);
+
+        moduleId = primaryWord & 0xFFFF;
+        instanceId = (primaryWord >> 16) & 0xFF;
+        type = (primaryWord >> 24) & 0x1F;
+        dataSize = extendedWord & 0xFFFFF;
+        largeParamId = (extendedWord >> 20) & 0xFF;
+    }
+};
+
+template <typename T>
+static void writeTlv(util::ByteStreamWriter &writer, uint32_t tag, const T &value)
+{
+    util::MemoryByteStreamWriter valueWriter;
+    valueWriter.write(value);
+    writer.write(tag);
+    writer.write(static_cast<uint32_t>(valueWriter.getBuffer().size()));
+    writer.writeRawBuffer(valueWriter.getBuffer());
+}
+
+template <typename T>
+static util::Buffer serialize(const T &value)
+{
+    util::MemoryByteStreamWriter writer;
+    writer.write(value);
+    return writer.getBuffer();
+}
+
+SimulatedFirmware::Config SimulatedFirmware::Config::fromString(const std::string &description)
+{
+    static const std::map<std::string, uint32_t Config::*> integerKeys = {
+        {"cores", &Config::coreCount},
+        {"pipelines", &Config::pipelineCount},
+        {"modulesPerPipeline", &Config::modulesPerPipeline},
+        {"logRate", &Config::logRate},
+        {"logFragmentSize", &Config::logFragmentSize},
+        {"probeRate", &Config::probeRate},
+        {"probePayloadSize", &Config::probePayloadSize},
+        {"injectionRate", &Config::injectionRate},
+        {"extractionProbes", &Config::extractionProbeCount},
+        {"injectionProbes", &Config::injectionProbeCount},
+        {"seed", &Config::seed}};
+    static const std::map<std::string, std::chrono::microseconds Config::*> delayKeys = {
+        {"latencyUs", &Config::ipcLatency}, {"jitterUs", &Config::jitter}};
+
+    Config config;
+    std::size_t begin = 0;
+    while (begin < description.size()) {
+        std::size_t end = std::min(description.find(',', begin), description.size());
+        std::string pair = description.substr(begin, end - begin);
+        begin = end + 1;
+
+        std::size_t separator = pair.find('=');
+        if (separator == std::string::npos) {
+            throw Exception("Invalid simulation parameter '" + pair + "': expecting key=value");
+        }
+        std::string key = pair.substr(0, separator);
+        std::string valueString = pair.substr(separator + 1);
+        uint32_t value;
+        if (!::convertTo(valueString, value)) {
+            throw Exception("Invalid value of simulation parameter '" + key + "': " +
+                            valueString);
+        }
+
+        auto integerKey = integerKeys.find(key);
+        auto delayKey = delayKeys.find(key);
+        if (integerKey != integerKeys.end()) {
+            config.*(integerKey->second) = value;
+        } else if (delayKey != delayKeys.end()) {
+            config.*(delayKey->second) = std::chrono::microseconds(value);
+        } else {
+            throw Exception("Unknown simulation parameter: " + key);
+        }
+    }
+    config.validate();
+    return config;
+}
+
+void SimulatedFirmware::Config::validate() const
+{
+    auto checkRange = [](const std::string &name, uint32_t value, uint32_t min, uint32_t max) {
+        if (value < min || value > max) {
+            throw Exception("Simulation parameter " + name + " out of range: " +
+                            std::to_string(value) + " not in [" + std::to_string(min) + ", " +
+                            std::to_string(max) + "]");
+        }
+    };
+    checkRange("cores", coreCount, 1, maxCoreCount);
+    checkRange("modulesPerPipeline", modulesPerPipeline, 1, maxModulesPerPipeline);
+    checkRange("pipelines", pipelineCount, 1, maxModuleInstanceCount / modulesPerPipeline);
+    checkRange("logRate", logRate, 0, maxRate);
+    checkRange("logFragmentSize", logFragmentSize, logFragmentHeaderSize, maxChunkSize);
+    checkRange("probeRate", probeRate, 0, maxRate);
+    checkRange("probePayloadSize", probePayloadSize, 1, maxChunkSize);
+    checkRange("injectionRate", injectionRate, 1, std::numeric_limits<uint32_t>::max());
+    checkRange("extractionProbes", extractionProbeCount, 1, maxProbeCount);
+    checkRange("injectionProbes", injectionProbeCount, 1, maxProbeCount);
+}
+
+SimulatedFirmware::SimulatedFirmware(const Config &config)
+    : mConfig(config), mStartTime(std::chrono::steady_clock::now()),
+      mLogSequences(config.coreCount, 0), mRandom(config.seed)
+{
+    mConfig.validate();
+    buildTopology();
+    buildConfigs();
+
+    mControls[mixer_ctl::logLevelMixer] = serialize(mixer_ctl::LogPriority::Critical);
+
+    dsp_fw::ProbePointId unsetPoint;
+    unsetPoint.full = 0;
+    for (uint32_t index = 0; index < mConfig.extractionProbeCount; ++index) {
+        mControls[mixer_ctl::getProbeExtractControl(index)] = serialize(mixer_ctl::ProbeControl(
+            mixer_ctl::ProbeState::Disconnect, mixer_ctl::ProbePurpose::Extract, unsetPoint));
+    }
+    for (uint32_t index = 0; index < mConfig.injectionProbeCount; ++index) {
+        mControls[mixer_ctl::getProbeInjectControl(index)] = serialize(mixer_ctl::ProbeControl(
+            mixer_ctl::ProbeState::Disconnect, mixer_ctl::ProbePurpose::Inject, unsetPoint));
+    }
+}
+
+void SimulatedFirmware::buildTopology()
+{
+    /* Module types: the base firmware then one type per pipeline position */
+    dsp_fw::ModuleEntry baseFirmware{};
+    util::StringHelper::setStringToFixedSizeArray(baseFirmware.name, sizeof(baseFirmware.name),
+                                                  "BASEFW");
+    mModuleEntries.push_back(baseFirmware);
+
+    for (uint32_t position = 0; position < mConfig.modulesPerPipeline; ++position) {
+        std::string name;
+        if (mConfig.modulesPerPipeline == 1) {
+            name = "COPIER";
+        } else if (position == 0) {
+            name = "HCOPIER";
+        } else if (position == mConfig.modulesPerPipeline - 1) {
+            name = "LCOPIER";
+        } else {
+            name = processingModuleNames[position - 1];
+        }
+        dsp_fw::ModuleEntry entry{};
+        entry.module_id = static_cast<uint16_t>(position + 1);
+        util::StringHelper::setStringToFixedSizeArray(entry.name, sizeof(entry.name), name);
+        entry.uuid[0] = entry.module_id;
+        entry.affinity_mask = (1u << mConfig.coreCount) - 1;
+        entry.instance_max_count = static_cast<uint16_t>(mConfig.pipelineCount);
+        mModuleEntries.push_back(entry);
+    }
+
+    /* Pipelines: pipeline p is made of the instance p of each module type, linked through
+     * queues, and is run by a task of the core p % coreCount */
+    mSchedulers.resize(mConfig.coreCount);
+    for (uint32_t coreId = 0; coreId < mConfig.coreCount; ++coreId) {
+        dsp_fw::SchedulerProps scheduler{};
+        scheduler.core_id = coreId;
+        mSchedulers[coreId].scheduler_info.push_back(scheduler);
+    }
+
+    for (uint32_t pipelineId = 0; pipelineId < mConfig.pipelineCount; ++pipelineId) {
+        dsp_fw::ConnectorNodeId hostGateway(dsp_fw::ConnectorNodeId::kHdaHostOutputClass,
+                                            static_cast<uint8_t>(pipelineId));
+        dsp_fw::ConnectorNodeId linkGateway(dsp_fw::ConnectorNodeId::kHdaLinkOutputClass,
+                                            static_cast<uint8_t>(pipelineId));
+        mGateways.push_back({hostGateway.GetBareNodeId(), dsp_fw::GatewayAttributes{0}});
+        mGateways.push_back({linkGateway.GetBareNodeId(), dsp_fw::GatewayAttributes{0}});
+
+        dsp_fw::PplProps pipeline;
+        pipeline.id = dsp_fw::PipeLineIdType{pipelineId};
+        pipeline.priority = pipelineId % 4;
+        pipeline.state = 0;
+        pipeline.total_memory_bytes = 4096 * mConfig.modulesPerPipeline;
+        pipeline.used_memory_bytes = 2048 * mConfig.modulesPerPipeline;
+        pipeline.context_pages = 1;
+        pipeline.ll_tasks.push_back(pipelineId);
+
+        for (uint32_t position = 0; position < mConfig.modulesPerPipeline; ++position) {
+            dsp_fw::ModuleInstanceProps instance{};
+            instance.id = {static_cast<uint16_t>(position + 1), static_cast<uint16_t>(pipelineId)};
+            instance.stack_bytes = 1024;
+            instance.ibs_bytes = 384;
+            instance.obs_bytes = 384;
+            instance.cpc = 1000 * (position + 1);
+            instance.cpc_peak = 1200 * (position + 1);
+
+            /* The queue between the positions k and k + 1 of the pipeline p */
+            dsp_fw::PinProps inputPin{};
+            inputPin.phys_queue_id = dsp_fw::PinProps::invalidQueueId;
+            dsp_fw::PinProps outputPin{};
+            outputPin.phys_queue_id = dsp_fw::PinProps::invalidQueueId;
+            if (position == 0) {
+                instance.input_gateway = hostGateway;
+            } else {
+                inputPin.phys_queue_id = pipelineId * maxModulesPerPipeline + position - 1;
+            }
+            if (position == mConfig.modulesPerPipeline - 1) {
+                instance.output_gateway = linkGateway;
+            } else {
+                outputPin.phys_queue_id = pipelineId * maxModulesPerPipeline + position;
+            }
+            instance.input_pins.pin_info.push_back(inputPin);
+            instance.output_pins.pin_info.push_back(outputPin);
+
+            pipeline.module_instances.push_back(instance.id);
+            mModuleInstances[instance.id] = instance;
+        }
+
+        dsp_fw::TaskProps task;
+        task.task_id = pipelineId;
+        task.module_instance_id = pipeline.module_instances;
+        mSchedulers[pipelineId % mConfig.coreCount].scheduler_info[0].task_info.push_back(task);
+
+        mPipelines.push_back(pipeline);
+    }
+}
+
+void SimulatedFirmware::buildConfigs()
+{
+    dsp_fw::FwVersion version{};
+    version.major = 1;
+
+    util::BufferByteStreamWriter fwConfigWriter(mFwConfigTlvs);
+    writeTlv(fwConfigWriter, dsp_fw::FwConfigParams::FW_VERSION_FW_CFG, version);
+    writeTlv(fwConfigWriter, dsp_fw::FwConfigParams::MAX_PPL_CNT_FW_CFG, mConfig.pipelineCount);
+    writeTlv(fwConfigWriter, dsp_fw::FwConfigParams::MODULES_COUNT_FW_CFG,
+             static_cast<uint32_t>(mModuleEntries.size()));
+    writeTlv(fwConfigWriter, dsp_fw::FwConfigParams::MAX_MOD_INST_COUNT_FW_CFG,
+             static_cast<uint32_t>(mModuleInstances.size()));
+
+    util::BufferByteStreamWriter hwConfigWriter(mHwConfigTlvs);
+    writeTlv(hwConfigWriter, dsp_fw::HwConfigParams::DSP_CORES_HW_CFG, mConfig.coreCount);
+    writeTlv(hwConfigWriter, dsp_fw::HwConfigParams::GATEWAY_COUNT_HW_CFG,
+             static_cast<uint32_t>(mGateways.size()));
+}
+
+void SimulatedFirmware::commandWrite(const std::string &name, const util::Buffer &input)
+{
+    std::lock_guard<std::mutex> guard(mMutex);
+    ++mStatistics.ipcCount;
+
+    if (name == driver::corePowerCtrl) {
+        std::string command(input.begin(), input.end());
+        for (auto &prefix : {driver::wakeUpCoreCmd, driver::sleepCoreCmd}) {
+            uint32_t coreId;
+            if (command.compare(0, prefix.size() + 1, prefix + " ") == 0 &&
+                ::convertTo(command.substr(prefix.size() + 1), coreId) &&
+                coreId < mConfig.coreCount) {
+                return;
+            }
+        }
+        throw Exception("Invalid core power command: " + command);
+    }
+    if (name != driver::setGetCtrl) {
+        throw Exception("Unknown debugfs entry: " + name);
+    }
+
+    try {
+        util::MemoryByteStreamReader reader(input);
+        CommandHeader header;
+        reader.read(header);
+
+        if (header.type == moduleConfigSet) {
+            /* Module enabling: nothing to simulate */
+            return;
+        }
+        if (header.type != largeConfigSet) {
+            throw Exception("Unsupported command type: " + std::to_string(header.type));
+        }
+        uint32_t parameterId = header.largeParamId;
+        if (header.largeParamId == driver::VENDOR_CONFIG_PARAM) {
+            driver::TunneledHeader tunneledHeader;
+            reader.read(tunneledHeader);
+            parameterId = tunneledHeader.mParamId;
+        }
+        util::Buffer value(input.begin() + reader.getPointerOffset(), input.end());
+        setParameter(static_cast<uint16_t>(header.moduleId),
+                     static_cast<uint16_t>(header.instanceId), parameterId, value);
+    } catch (util::ByteStreamReader::Exception &e) {
+        throw Exception("Invalid set parameter command: " + std::string(e.what()));
+    }
+}
+
+void SimulatedFirmware::commandRead(const std::string &name, const util::Buffer &input,
+                                    util::Buffer &output)
+{
+    std::lock_guard<std::mutex> guard(mMutex);
+    ++mStatistics.ipcCount;
+
+    if (name != driver::setGetCtrl) {
+        throw Exception("Unknown debugfs entry: " + name);
+    }
+
+    try {
+        util::MemoryByteStreamReader reader(input);
+        CommandHeader header;
+        reader.read(header);
+        if (header.type != largeConfigGet) {
+            throw Exception("Unsupported command type: " + std::to_string(header.type));
+        }
+
+        bool tunneled = header.largeParamId == driver::VENDOR_CONFIG_PARAM;
+        driver::TunneledHeader tunneledHeader{header.largeParamId, header.dataSize};
+        if (tunneled) {
+            reader.read(tunneledHeader);
+        }
+
+        util::Buffer value = getParameter(static_cast<uint16_t>(header.moduleId),
+                                          static_cast<uint16_t>(header.instanceId),
+                                          tunneledHeader.mParamId);
+        /* The reply is truncated to the size requested by the host */
+        if (value.size() > tunneledHeader.mParamSize) {
+            value.resize(tunneledHeader.mParamSize);
+        }
+
+        util::BufferByteStreamWriter writer(output, sizeof(tunneledHeader) + value.size());
+        if (tunneled) {
+            writer.write(driver::TunneledHeader{tunneledHeader.mParamId,
+                                                static_cast<uint32_t>(value.size())});
+        }
+        writer.writeRawBuffer(value);
+    } catch (util::ByteStreamReader::Exception &e) {
+        throw Exception("Invalid get parameter command: " + std::string(e.what()));
+    }
+}
+
+util::Buffer SimulatedFirmware::getParameter(uint16_t moduleId, uint16_t instanceId,
+                                             uint32_t parameterId) const
+{
+    if (moduleId == dsp_fw::baseFirmwareModuleId && instanceId == dsp_fw::baseFirmwareInstanceId) {
+        if (parameterId != dsp_fw::BaseFwParams::PERF_MEASUREMENTS_STATE) {
+            auto parameter = mParameters.find(ParameterKey{moduleId, instanceId, parameterId});
+            if (parameter != mParameters.end()) {
+                return parameter->second;
+            }
+        }
+        return getBaseFwParameter(parameterId);
+    }
+
+    if (parameterId == dsp_fw::BaseModuleParams::MOD_INST_PROPS) {
+        auto instance = mModuleInstances.find(dsp_fw::CompoundModuleId{moduleId, instanceId});
+        if (instance == mModuleInstances.end()) {
+            throw Exception("Unknown module instance: (" + std::to_string(moduleId) + "," +
+                            std::to_string(instanceId) + ")");
+        }
+        return serialize(instance->second);
+    }
+
+    auto parameter = mParameters.find(ParameterKey{moduleId, instanceId, parameterId});
+    if (parameter == mParameters.end()) {
+        throw Exception("Parameter " + std::to_string(parameterId) + " of module instance (" +
+                        std::to_string(moduleId) + "," + std::to_string(instanceId) +
+                        ") has not been set");
+    }
+    return parameter->second;
+}
+
+util::Buffer SimulatedFirmware::getBaseFwParameter(uint32_t parameterId) const
+{
+    /* Extended parameter ids carry a pipeline or a core id, see
+     * ModuleHandler::getExtendedParameterId() */
+    uint32_t extendedId = parameterId >> 8;
+
+    switch (static_cast<dsp_fw::BaseFwParams>(parameterId & 0xFF)) {
+    case dsp_fw::BaseFwParams::FW_CONFIG:
+        return mFwConfigTlvs;
+    case dsp_fw::BaseFwParams::HW_CONFIG_GET:
+        return mHwConfigTlvs;
+    case dsp_fw::BaseFwParams::MODULES_INFO_GET: {
+        dsp_fw::ModulesInfo modules;
+        modules.module_info = mModuleEntries;
+        return serialize(modules);
+    }
+    case dsp_fw::BaseFwParams::PIPELINE_LIST_INFO_GET: {
+        dsp_fw::PipelinesListInfo pipelines;
+        for (auto &pipeline : mPipelines) {
+            pipelines.ppl_id.push_back(pipeline.id);
+        }
+        return serialize(pipelines);
+    }
+    case dsp_fw::BaseFwParams::PIPELINE_PROPS_GET:
+        if (extendedId >= mPipelines.size()) {
+            throw Exception("Unknown pipeline: " + std::to_string(extendedId));
+        }
+        return serialize(mPipelines[extendedId]);
+    case dsp_fw::BaseFwParams::SCHEDULERS_INFO_GET:
+        if (extendedId >= mSchedulers.size()) {
+            throw Exception("Unknown core: " + std::to_string(extendedId));
+        }
+        return serialize(mSchedulers[extendedId]);
+    case dsp_fw::BaseFwParams::GATEWAYS_INFO_GET: {
+        dsp_fw::GatewaysInfo gateways;
+        gateways.gateways = mGateways;
+        return serialize(gateways);
+    }
+    case dsp_fw::BaseFwParams::MEMORY_STATE_INFO_GET:
+        /* Empty TLV list */
+        return {};
+    case dsp_fw::BaseFwParams::PERF_MEASUREMENTS_STATE:
+        return serialize(mPerfState);
+    case dsp_fw::BaseFwParams::GLOBAL_PERF_DATA: {
+        /* The load of each module instance varies around its nominal cycle count */
+        uint64_t phase = getWallClock() / 1000;
+        dsp_fw::GlobalPerfData perfData;
+        for (auto &instance : mModuleInstances) {
+            uint32_t average = instance.second.cpc + static_cast<uint32_t>(phase % 100);
+            perfData.items.emplace_back(instance.first.moduleId, instance.first.instanceId,
+                                        false, false, instance.second.cpc_peak, average);
+        }
+        for (uint32_t coreId = 0; coreId < mConfig.coreCount; ++coreId) {
+            perfData.items.emplace_back(0, coreId, false, false, 100000, 50000);
+        }
+        return serialize(perfData);
+    }
+    default:
+        throw Exception("Unsupported base firmware parameter: " + std::to_string(parameterId));
+    }
+}
+
+void SimulatedFirmware::setParameter(uint16_t moduleId, uint16_t instanceId,
+                                     uint32_t parameterId, const util::Buffer &value)
+{
+    if (moduleId == dsp_fw::baseFirmwareModuleId &&
+        instanceId == dsp_fw::baseFirmwareInstanceId &&
+        parameterId == dsp_fw::BaseFwParams::PERF_MEASUREMENTS_STATE) {
+        util::MemoryByteStreamReader reader(value);
+        reader.read(mPerfState);
+        return;
+    }
+    mParameters[ParameterKey{moduleId, instanceId, parameterId}] = value;
+}
+
+void SimulatedFirmware::ctlRead(const std::string &name, util::Buffer &output) const
+{
+    std::lock_guard<std::mutex> guard(mMutex);
+
+    auto control = mControls.find(name);
+    if (control == mControls.end()) {
+        throw Exception("Unknown control: " + name);
+    }
+    output = control->second;
+}
+
+void SimulatedFirmware::ctlWrite(const std::string &name, const util::Buffer &input)
+{
+    std::lock_guard<std::mutex> guard(mMutex);
+    ++mStatistics.ipcCount;
+
+    auto control = mControls.find(name);
+    if (control == mControls.end()) {
+        throw Exception("Unknown control: " + name);
+    }
+    control->second = input;
+
+    if (name.compare(0, mixer_ctl::mExtractorControlTag.size(),
+                     mixer_ctl::mExtractorControlTag) == 0) {
+        updateExtractedProbePoints();
+    }
+}
+
+std::size_t SimulatedFirmware::getControlCountByTag(const std::string &tag) const
+{
+    std::lock_guard<std::mutex> guard(mMutex);
+
+    return std::count_if(mControls.begin(), mControls.end(), [&tag](const auto &control) {
+        return control.first.find(tag) != std::string::npos;
+    });
+}
+
+void SimulatedFirmware::updateExtractedProbePoints()
+{
+    mExtractedProbePoints.clear();
+    mNextExtractedProbe = 0;
+    for (uint32_t index = 0; index < mConfig.extractionProbeCount; ++index) {
+        const util::Buffer &value = mControls[mixer_ctl::getProbeExtractControl(index)];
+        mixer_ctl::ProbeControl control;
+        try {
+            util::MemoryByteStreamReader reader(value);
+            reader.read(control);
+        } catch (util::ByteStreamReader::Exception &) {
+            /* Not a valid probe configuration: the probe is not connected */
+            continue;
+        }
+        if (control.getState() == mixer_ctl::ProbeState::Connect &&
+            control.getPurpose() != mixer_ctl::ProbePurpose::Inject) {
+            mExtractedProbePoints.push_back(control.getPointId());
+        }
+    }
+}
+
+void SimulatedFirmware::delayIpc()
+{
+    auto delay = mConfig.ipcLatency + getJitter();
+    if (delay.count() > 0) {
+        std::this_thread::sleep_for(delay);
+    }
+}
+
+std::chrono::microseconds SimulatedFirmware::getJitter()
+{
+    if (mConfig.jitter.count() == 0) {
+        return std::chrono::microseconds(0);
+    }
+    std::lock_guard<std::mutex> guard(mRandomMutex);
+    std::uniform_int_distribution<std::chrono::microseconds::rep> distribution(
+        0, mConfig.jitter.count());
+    return std::chrono::microseconds(distribution(mRandom));
+}
+
+void SimulatedFirmware::produceLogFragment(unsigned int coreId, util::Buffer &fragment)
+{
+    std::lock_guard<std::mutex> guard(mMutex);
+    if (coreId >= mConfig.coreCount) {
+        throw Exception("Unknown core: " + std::to_string(coreId));
+    }
+    uint32_t sequence = mLogSequences[coreId]++;
+    ++mStatistics.logFragmentCount;
+
+    util::BufferByteStreamWriter writer(fragment, mConfig.logFragmentSize);
+    writer.write(getWallClock());
+    writer.write(static_cast<uint32_t>(coreId));
+    writer.write(sequence);
+    fragment.resize(mConfig.logFragmentSize, static_cast<uint8_t>(sequence));
+}
+
+bool SimulatedFirmware::produceProbePacket(util::Buffer &packet)
+{
+    std::lock_guard<std::mutex> guard(mMutex);
+    if (mExtractedProbePoints.empty()) {
+        return false;
+    }
+
+    dsp_fw::Packet probePacket;
+    probePacket.probePointId = mExtractedProbePoints[mNextExtractedProbe];
+    mNextExtractedProbe = (mNextExtractedProbe + 1) % mExtractedProbePoints.size();
+
+    uint64_t wallClock = getWallClock();
+    probePacket.format = 0;
+    probePacket.dspWallClockTsHw = static_cast<uint32_t>(wallClock >> 32);
+    probePacket.dspWallClockTsLw = static_cast<uint32_t>(wallClock);
+    probePacket.data.assign(mConfig.probePayloadSize,
+                            static_cast<uint8_t>(mStatistics.probePacketCount));
+    ++mStatistics.probePacketCount;
+
+    util::BufferByteStreamWriter writer(packet, mConfig.probePayloadSize + 64);
+    probePacket.toStream(writer);
+    return true;
+}
+
+void SimulatedFirmware::consumeInjectionData(std::size_t byteCount)
+{
+    std::lock_guard<std::mutex> guard(mMutex);
+    mStatistics.injectedByteCount += byteCount;
+}
+
+SimulatedFirmware::Statistics SimulatedFirmware::getStatistics() const
+{
+    std::lock_guard<std::mutex> guard(mMutex);
+    return mStatistics;
+}
+
+uint64_t SimulatedFirmware::getWallClock() const
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now() - mStartTime)
+        .count();
+}
+}
+}
+}
@@ -31,46 +31,103 @@
 #include <cAVS/Linux/Driver.hpp>
 #include <cAVS/Linux/SystemDevice.hpp>
 #include <cAVS/Linux/DebugFsEntryHandler.hpp>
+#include <cAVS/Linux/RawDebugFsEntryHandler.hpp>
 #include <cAVS/Linux/ControlDeviceFactory.hpp>
 #include "cAVS/Linux/TinyCompressDeviceFactory.hpp"
+#include "cAVS/Linux/IpcTraceRecorder.hpp"
+#include "cAVS/Linux/SimulatedDevices.hpp"
+#include <chrono>
 
 namespace debug_agent
 {
 namespace cavs
 {
-static const std::string controlDevice{"control"};
+static const std::string controlDeviceType{"control"};
 
-std::unique_ptr<Driver> SystemDriverFactory::newDriver() const
+/** Create the devices accessing the audio driver */
+static void newSystemDevices(bool persistentDebugFs, std::unique_ptr<linux::Device> &device,
+                             std::unique_ptr<linux::ControlDevice> &controlDevice,
+                             std::unique_ptr<linux::CompressDeviceFactory> &compressDeviceFactory)
 {
     /* Creating the CompressDeviceFactory */
-    std::unique_ptr<linux::CompressDeviceFactory> compressDeviceFactory(
-        std::make_unique<linux::TinyCompressDeviceFactory>());
+    compressDeviceFactory = std::make_unique<linux::TinyCompressDeviceFactory>();
 
     assert(compressDeviceFactory != nullptr);
 
     /* Finding ALSA Device Card for control using compress Factory */
-    const std::string controlCard{linux::AudioProcfsHelper::getDeviceType(controlDevice)};
+    const std::string controlCard{linux::AudioProcfsHelper::getDeviceType(controlDeviceType)};
     assert(!controlCard.empty());
 
     /* Creating the Control Device for the control Card */
-    std::unique_ptr<linux::ControlDevice> controlDevice;
     try {
         linux::ControlDeviceFactory controlDeviceFactory;
         controlDevice = controlDeviceFactory.newControlDevice(controlCard);
     } catch (linux::ControlDevice::Exception &e) {
-        throw Exception("Cannot create control device: " + std::string(e.what()));
+        throw DriverFactory::Exception("Cannot create control device: " + std::string(e.what()));
     }
     assert(controlDevice != nullptr);
 
-    std::unique_ptr<linux::Device> device;
+    std::unique_ptr<linux::FileEntryHandler> fileEntryHandler;
+    if (persistentDebugFs) {
+        fileEntryHandler = std::make_unique<linux::RawDebugFsEntryHandler>();
+    } else {
+        fileEntryHandler = std::make_unique<linux::DebugFsEntryHandler>();
+    }
+
     try {
-        device =
-            std::make_unique<linux::SystemDevice>(std::make_unique<linux::DebugFsEntryHandler>());
+        device = std::make_unique<linux::SystemDevice>(std::move(fileEntryHandler));
     } catch (linux::Device::Exception &e) {
-        throw Exception("Cannot create device: " + std::string(e.what()));
+        throw DriverFactory::Exception("Cannot create device: " + std::string(e.what()));
+    }
+}
+
+/** Create the devices exposing a simulated firmware, see SimulatedFirmware::Config::fromString()
+ * for the configuration syntax */
+static void newSimulatedDevices(
+    const std::string &config, std::unique_ptr<linux::Device> &device,
+    std::unique_ptr<linux::ControlDevice> &controlDevice,
+    std::unique_ptr<linux::CompressDeviceFactory> &compressDeviceFactory)
+{
+    std::shared_ptr<linux::SimulatedFirmware> firmware;
+    try {
+        firmware = std::make_shared<linux::SimulatedFirmware>(
+            linux::SimulatedFirmware::Config::fromString(config));
+    } catch (linux::SimulatedFirmware::Exception &e) {
+        throw DriverFactory::Exception("Cannot simulate firmware: " + std::string(e.what()));
     }
+    device = std::make_unique<linux::SimulatedDevice>(firmware);
+    controlDevice = std::make_unique<linux::SimulatedControlDevice>(firmware);
+    compressDeviceFactory = std::make_unique<linux::SimulatedCompressDeviceFactory>(firmware);
+}
+
+std::unique_ptr<Driver> SystemDriverFactory::newDriver() const
+{
+    std::unique_ptr<linux::Device> device;
+    std::unique_ptr<linux::ControlDevice> controlDevice;
+    std::unique_ptr<linux::CompressDeviceFactory> compressDeviceFactory;
+    if (mSimulatedFirmwareConfig.empty()) {
+        newSystemDevices(mPersistentDebugFs, device, controlDevice, compressDeviceFactory);
+    } else {
+        newSimulatedDevices(mSimulatedFirmwareConfig, device, controlDevice,
+                            compressDeviceFactory);
+    }
+
+    if (!mIpcTraceFileName.empty()) {
+        std::shared_ptr<linux::IpcTraceWriter> trace;
+        try {
+            trace = std::make_shared<linux::IpcTraceWriter>(mIpcTraceFileName);
+        } catch (linux::IpcTraceWriter::Exception &e) {
+            throw Exception("Cannot record IPC trace: " + std::string(e.what()));
+        }
+        device = std::make_unique<linux::RecordingDevice>(std::move(device), trace);
+        controlDevice =
+            std::make_unique<linux::RecordingControlDevice>(std::move(controlDevice), trace);
+        compressDeviceFactory = std::make_unique<linux::RecordingCompressDeviceFactory>(
+            std::move(compressDeviceFactory), trace);
+    }
+
     return std::make_unique<linux::Driver>(std::move(device), std::move(controlDevice),
-                                           std::move(compressDeviceFactory));
+                                           std::move(compressDeviceFactory), mCorePowerIdleTimeout);
 }
 }
 }
@@ -88,6 +88,7 @@ const std::string LogStreamer::systemType = "cavs";
 const std::string LogStreamer::formatType = "fwlogs";
 const int LogStreamer::majorVersion = 1;
 const int LogStreamer::minorVersion = 0;
+const std::size_t LogStreamer::maxBatchByteSize = 64 * 1024;
 
 LogStreamer::LogStreamer(Logger &logger, const std::vector<dsp_fw::ModuleEntry> &moduleEntries)
     : base(systemType, formatType, majorVersion, minorVersion), mLogger(logger),
@@ -114,14 +115,17 @@ void LogStreamer::streamFormatHeader(std::ostream &os)
 
 bool LogStreamer::streamNextFormatData(std::ostream &os)
 {
-    /* Blocking read to get a log block */
+    /* Blocking read to get the available log blocks, which are then flushed at once */
     try {
-        std::unique_ptr<LogBlock> block(std::move(mLogger.readLogBlock()));
-        if (block == nullptr) {
+        auto blocks = mLogger.readLogBlocks(maxBatchByteSize);
+        if (blocks.empty()) {
             /* Logger is closed, no more entries */
             return false;
         }
-        os << *block;
+        for (auto &block : blocks) {
+            os << *block;
+        }
+        mLogger.recycleLogBlocks(blocks);
     } catch (Logger::Exception &e) {
 
         throw Streamer::Exception(std::string("Fail to read log: ") + e.what());
@@ -39,8 +39,10 @@ namespace cavs
 
 ModuleHandler::ModuleHandler(std::unique_ptr<ModuleHandlerImpl> impl)
     : mImpl(std::move(impl)),
-      mFwConfig(readTlvParameters<dsp_fw::FwConfig>(dsp_fw::BaseFwParams::FW_CONFIG)),
-      mHwConfig(readTlvParameters<dsp_fw::HwConfig>(dsp_fw::BaseFwParams::HW_CONFIG_GET))
+      mFwConfig(readTlvParameters<dsp_fw::FwConfig>(dsp_fw::BaseFwParams::FW_CONFIG,
+                                                    IpcClass::BulkIntrospection)),
+      mHwConfig(readTlvParameters<dsp_fw::HwConfig>(dsp_fw::BaseFwParams::HW_CONFIG_GET,
+                                                    IpcClass::BulkIntrospection))
 {
     std::string error;
     if (not mFwConfig.isFwVersionValid) {
@@ -69,33 +71,61 @@ ModuleHandler::ModuleHandler(std::unique_ptr<ModuleHandlerImpl> impl)
 }
 
 util::Buffer ModuleHandler::configGet(uint16_t moduleId, uint16_t instanceId,
-                                      dsp_fw::ParameterId parameterId, size_t parameterSize)
+                                      dsp_fw::ParameterId parameterId, size_t parameterSize,
+                                      IpcClass ipcClass)
 {
-    try {
-        return mImpl->configGet(moduleId, instanceId, parameterId, parameterSize);
-    } catch (ModuleHandlerImpl::Exception &e) {
-        throw Exception(e.what());
-    }
+    util::Buffer parameterPayload;
+    configGet(moduleId, instanceId, parameterId, parameterSize, parameterPayload, ipcClass);
+    return parameterPayload;
+}
+
+void ModuleHandler::configGet(uint16_t moduleId, uint16_t instanceId,
+                              dsp_fw::ParameterId parameterId, size_t parameterSize,
+                              util::Buffer &parameterPayload, IpcClass ipcClass)
+{
+    ConfigGetKey key{moduleId, instanceId, parameterId.getValue(), parameterSize};
+    mConfigGetFlights.run(
+        key, parameterPayload,
+        [&](util::Buffer &payload, IpcScheduler::Urgency &urgency) {
+            /* The requests merged in the meantime may have raised the urgency of the call */
+            mIpcScheduler.raise(urgency, ipcClass);
+            auto slot = mIpcScheduler.acquire(urgency);
+            try {
+                mImpl->configGet(moduleId, instanceId, parameterId, parameterSize, payload);
+            } catch (ModuleHandlerImpl::Exception &e) {
+                throw Exception(e.what());
+            }
+        },
+        [&](IpcScheduler::Urgency &urgency) { mIpcScheduler.raise(urgency, ipcClass); });
 }
 
 void ModuleHandler::configSet(uint16_t moduleId, uint16_t instanceId,
-                              dsp_fw::ParameterId parameterId, const util::Buffer &parameterPayload)
+                              dsp_fw::ParameterId parameterId, const util::Buffer &parameterPayload,
+                              IpcClass ipcClass)
 {
     try {
+        auto slot = mIpcScheduler.acquire(ipcClass);
         mImpl->configSet(moduleId, instanceId, parameterId, parameterPayload);
     } catch (ModuleHandlerImpl::Exception &e) {
+        mConfigGetFlights.forget();
         throw Exception(e.what());
     }
+    /* The "config get" commands in flight may have been answered before the set: the next ones
+     * shall not be merged with them */
+    mConfigGetFlights.forget();
 }
 
 template <typename FirmwareParameterType>
 void ModuleHandler::getFwParameterValue(uint16_t moduleId, uint16_t instanceId,
                                         dsp_fw::ParameterId moduleParamId,
-                                        std::size_t fwParameterSize, FirmwareParameterType &result)
+                                        std::size_t fwParameterSize, FirmwareParameterType &result,
+                                        IpcClass ipcClass)
 {
-    util::Buffer buffer = configGet(moduleId, instanceId, moduleParamId, fwParameterSize);
+    /* The buffer goes back to the pool on failure too */
+    auto buffer = mReplyPool.acquirePooled(fwParameterSize);
+    configGet(moduleId, instanceId, moduleParamId, fwParameterSize, *buffer, ipcClass);
 
-    util::MemoryByteStreamReader reader(buffer);
+    util::MemoryByteStreamReader reader(*buffer);
     try {
         /* Reading parameter */
         reader.read(result);
@@ -114,17 +144,19 @@ void ModuleHandler::getFwParameterValue(uint16_t moduleId, uint16_t instanceId,
 }
 
 template <typename TlvResponseHandlerInterface>
-TlvResponseHandlerInterface ModuleHandler::readTlvParameters(dsp_fw::BaseFwParams parameterId)
+TlvResponseHandlerInterface ModuleHandler::readTlvParameters(dsp_fw::BaseFwParams parameterId,
+                                                             IpcClass ipcClass)
 {
     TlvResponseHandlerInterface responseHandler;
 
     /** According to the SwAS, setting initial buffer size to tlvBufferSize.
      * Using 0xFF for test purpose (mark unused memory) */
-    util::Buffer buffer = configGet(dsp_fw::baseFirmwareModuleId, dsp_fw::baseFirmwareInstanceId,
-                                    dsp_fw::toParameterId(parameterId), tlvBufferSize);
+    auto buffer = mReplyPool.acquirePooled(tlvBufferSize);
+    configGet(dsp_fw::baseFirmwareModuleId, dsp_fw::baseFirmwareInstanceId,
+              dsp_fw::toParameterId(parameterId), tlvBufferSize, *buffer, ipcClass);
 
     /* Now parse the TLV answer */
-    tlv::TlvUnpack unpack(responseHandler, buffer);
+    tlv::TlvUnpack unpack(responseHandler, *buffer);
 
     bool end = false;
     do {
@@ -173,7 +205,7 @@ void ModuleHandler::cacheModuleEntries()
     dsp_fw::ModulesInfo modulesInfo;
     getFwParameterValue(dsp_fw::baseFirmwareModuleId, dsp_fw::baseFirmwareInstanceId,
                         dsp_fw::toParameterId(dsp_fw::BaseFwParams::MODULES_INFO_GET),
-                        moduleInfoSize, modulesInfo);
+                        moduleInfoSize, modulesInfo, IpcClass::BulkIntrospection);
 
     /** @todo use logging */
     std::cout << "Number of modules found in FW: " << modulesInfo.module_info.size() << std::endl;
@@ -197,7 +229,27 @@ const dsp_fw::HwConfig &ModuleHandler::getHwConfig() const noexcept
     return mHwConfig;
 }
 
-std::vector<dsp_fw::PipeLineIdType> ModuleHandler::getPipelineIdList()
+util::BufferPoolStatistics ModuleHandler::getReplyPoolStatistics() const noexcept
+{
+    return mReplyPool.getStatistics();
+}
+
+util::SingleFlightStatistics ModuleHandler::getConfigGetStatistics() const noexcept
+{
+    return mConfigGetFlights.getStatistics();
+}
+
+IpcClassStatistics ModuleHandler::getIpcStatistics(IpcClass ipcClass) const
+{
+    return mIpcScheduler.getStatistics(ipcClass);
+}
+
+uint64_t ModuleHandler::getSavedCorePowerToggleCount() const
+{
+    return mImpl->getSavedCorePowerToggleCount();
+}
+
+std::vector<dsp_fw::PipeLineIdType> ModuleHandler::getPipelineIdList(IpcClass ipcClass)
 {
     auto maxPplCount = mFwConfig.maxPplCount;
     /* Calculating the memory space required */
@@ -207,7 +259,7 @@ std::vector<dsp_fw::PipeLineIdType> ModuleHandler::getPipelineIdList()
     dsp_fw::PipelinesListInfo pipelineListInfo;
     getFwParameterValue(dsp_fw::baseFirmwareModuleId, dsp_fw::baseFirmwareInstanceId,
                         dsp_fw::toParameterId(dsp_fw::BaseFwParams::PIPELINE_LIST_INFO_GET),
-                        parameterSize, pipelineListInfo);
+                        parameterSize, pipelineListInfo, ipcClass);
 
     /* Checking returned pipeline count */
     if (pipelineListInfo.ppl_id.size() > maxPplCount) {
@@ -219,7 +271,8 @@ std::vector<dsp_fw::PipeLineIdType> ModuleHandler::getPipelineIdList()
     return pipelineListInfo.ppl_id;
 }
 
-dsp_fw::PplProps ModuleHandler::getPipelineProps(dsp_fw::PipeLineIdType pipelineId)
+dsp_fw::PplProps ModuleHandler::getPipelineProps(dsp_fw::PipeLineIdType pipelineId,
+                                                 IpcClass ipcClass)
 {
     /* Using extended parameter id to supply the pipeline id*/
     auto paramId = getExtendedParameterId(dsp_fw::BaseFwParams::PIPELINE_PROPS_GET, pipelineId);
@@ -227,12 +280,13 @@ dsp_fw::PplProps ModuleHandler::getPipelineProps(dsp_fw::PipeLineIdType pipeline
     dsp_fw::PplProps props;
     /* Query FW through driver */
     getFwParameterValue(dsp_fw::baseFirmwareModuleId, dsp_fw::baseFirmwareInstanceId, paramId,
-                        maxParameterPayloadSize, props);
+                        maxParameterPayloadSize, props, ipcClass);
 
     return props;
 }
 
-dsp_fw::SchedulersInfo ModuleHandler::getSchedulersInfo(dsp_fw::CoreId coreId)
+dsp_fw::SchedulersInfo ModuleHandler::getSchedulersInfo(dsp_fw::CoreId coreId,
+                                                        IpcClass ipcClass)
 {
     /* Using extended parameter id to supply the core id*/
     auto paramId = getExtendedParameterId(dsp_fw::BaseFwParams::SCHEDULERS_INFO_GET, coreId);
@@ -240,12 +294,12 @@ dsp_fw::SchedulersInfo ModuleHandler::getSchedulersInfo(dsp_fw::CoreId coreId)
     dsp_fw::SchedulersInfo schedulers;
     /* Query FW through driver */
     getFwParameterValue(dsp_fw::baseFirmwareModuleId, dsp_fw::baseFirmwareInstanceId, paramId,
-                        maxParameterPayloadSize, schedulers);
+                        maxParameterPayloadSize, schedulers, ipcClass);
 
     return schedulers;
 }
 
-std::vector<dsp_fw::GatewayProps> ModuleHandler::getGatewaysInfo()
+std::vector<dsp_fw::GatewayProps> ModuleHandler::getGatewaysInfo(IpcClass ipcClass)
 {
     auto gatewayCount = mHwConfig.gatewayCount;
     /* Calculating the memory space required */
@@ -255,7 +309,7 @@ std::vector<dsp_fw::GatewayProps> ModuleHandler::getGatewaysInfo()
     dsp_fw::GatewaysInfo gatewaysInfo;
     getFwParameterValue(dsp_fw::baseFirmwareModuleId, dsp_fw::baseFirmwareInstanceId,
                         dsp_fw::toParameterId(dsp_fw::BaseFwParams::GATEWAYS_INFO_GET),
-                        parameterSize, gatewaysInfo);
+                        parameterSize, gatewaysInfo, ipcClass);
 
     /* Checking returned gateway count */
     if (gatewaysInfo.gateways.size() > gatewayCount) {
@@ -267,25 +321,25 @@ std::vector<dsp_fw::GatewayProps> ModuleHandler::getGatewaysInfo()
     return gatewaysInfo.gateways;
 }
 
-void ModuleHandler::setPerfState(uint32_t state)
+void ModuleHandler::setPerfState(uint32_t state, IpcClass ipcClass)
 {
     util::MemoryByteStreamWriter writer;
     writer.write(state);
     configSet(dsp_fw::baseFirmwareModuleId, dsp_fw::baseFirmwareInstanceId,
               dsp_fw::ParameterId{dsp_fw::BaseFwParams::PERF_MEASUREMENTS_STATE},
-              writer.getBuffer());
+              writer.getBuffer(), ipcClass);
 }
 
-uint32_t ModuleHandler::getPerfState()
+uint32_t ModuleHandler::getPerfState(IpcClass ipcClass)
 {
     uint32_t fromDriver;
     getFwParameterValue(dsp_fw::baseFirmwareModuleId, dsp_fw::baseFirmwareInstanceId,
                         dsp_fw::toParameterId(dsp_fw::BaseFwParams::PERF_MEASUREMENTS_STATE),
-                        sizeof(fromDriver), fromDriver);
+                        sizeof(fromDriver), fromDriver, ipcClass);
     return fromDriver;
 }
 
-std::vector<dsp_fw::PerfDataItem> ModuleHandler::getPerfItems()
+std::vector<dsp_fw::PerfDataItem> ModuleHandler::getPerfItems(IpcClass ipcClass)
 {
     auto itemCount = mFwConfig.maxModInstCount + mHwConfig.dspCoreCount;
     /* Calculating the memory space required */
@@ -295,7 +349,7 @@ std::vector<dsp_fw::PerfDataItem> ModuleHandler::getPerfItems()
     dsp_fw::GlobalPerfData perfData;
     getFwParameterValue(dsp_fw::baseFirmwareModuleId, dsp_fw::baseFirmwareInstanceId,
                         dsp_fw::toParameterId(dsp_fw::BaseFwParams::GLOBAL_PERF_DATA),
-                        parameterSize, perfData);
+                        parameterSize, perfData, ipcClass);
 
     /* Checking returned perf item count */
     if (perfData.items.size() > itemCount) {
@@ -307,26 +361,28 @@ std::vector<dsp_fw::PerfDataItem> ModuleHandler::getPerfItems()
     return perfData.items;
 }
 
-dsp_fw::GlobalMemoryState ModuleHandler::getGlobalMemoryState()
+dsp_fw::GlobalMemoryState ModuleHandler::getGlobalMemoryState(IpcClass ipcClass)
 {
     return readTlvParameters<dsp_fw::GlobalMemoryState>(
-        dsp_fw::BaseFwParams::MEMORY_STATE_INFO_GET);
+        dsp_fw::BaseFwParams::MEMORY_STATE_INFO_GET, ipcClass);
 }
 
 dsp_fw::ModuleInstanceProps ModuleHandler::getModuleInstanceProps(uint16_t moduleId,
-                                                                  uint16_t instanceId)
+                                                                  uint16_t instanceId,
+                                                                  IpcClass ipcClass)
 {
     dsp_fw::ModuleInstanceProps props;
     getFwParameterValue(moduleId, instanceId,
                         dsp_fw::toParameterId(dsp_fw::BaseModuleParams::MOD_INST_PROPS),
-                        maxParameterPayloadSize, props);
+                        maxParameterPayloadSize, props, ipcClass);
 
     return props;
 }
 
 void ModuleHandler::setModuleParameter(uint16_t moduleId, uint16_t instanceId,
                                        dsp_fw::ParameterId parameterId,
-                                       const util::Buffer &parameterPayload)
+                                       const util::Buffer &parameterPayload,
+                                       IpcClass ipcClass)
 {
     if (parameterPayload.size() > maxParameterPayloadSize) {
         throw Exception("Cannot set module parameter: payload to big : " +
@@ -334,15 +390,15 @@ void ModuleHandler::setModuleParameter(uint16_t moduleId, uint16_t instanceId,
                         std::to_string(maxParameterPayloadSize));
     }
 
-    configSet(moduleId, instanceId, parameterId, parameterPayload);
+    configSet(moduleId, instanceId, parameterId, parameterPayload, ipcClass);
 }
 
 util::Buffer ModuleHandler::getModuleParameter(uint16_t moduleId, uint16_t instanceId,
                                                dsp_fw::ParameterId parameterId,
-                                               size_t parameterSize)
+                                               size_t parameterSize, IpcClass ipcClass)
 {
     /* Query FW through driver */
-    return configGet(moduleId, instanceId, parameterId, parameterSize);
+    return configGet(moduleId, instanceId, parameterId, parameterSize, ipcClass);
 }
 }
 }
@@ -99,7 +99,8 @@ PerfService::CompoundPerfData PerfService::getData()
                 if (not rawItem.details.bits.isRemoved) {
                     try {
                         dsp_fw::ModuleInstanceProps props = mModuleHandler.getModuleInstanceProps(
-                            rawItem.resourceId.moduleId, rawItem.resourceId.instanceId);
+                            rawItem.resourceId.moduleId, rawItem.resourceId.instanceId,
+                            IpcClass::BackgroundPolling);
                         budget = computeBudget(props);
                     } catch (ModuleHandler::Exception &e) {
                         // continue on error (leave the budget uncomputed)
@@ -101,7 +101,8 @@ const Prober::InjectionSampleByteSizes ProbeService::getInjectionSampleByteSizes
                 try {
                     props = mDriver.getModuleHandler().getModuleInstanceProps(
                         probeConfig.probePoint.fields.getModuleId(),
-                        probeConfig.probePoint.fields.getInstanceId());
+                        probeConfig.probePoint.fields.getInstanceId(),
+                        IpcClass::StreamingControl);
                 } catch (ModuleHandler::Exception &e) {
                     throw Exception("Can not retreive injection format of probe id " +
                                     std::to_string(probeIndex) + ": " + std::string(e.what()));
@@ -147,5 +148,10 @@ const Prober::InjectionSampleByteSizes ProbeService::getInjectionSampleByteSizes
     }
     return sizeMap;
 }
+
+Prober::ExtractionResyncStatistics ProbeService::getExtractionResyncStatistics() const
+{
+    return mDriver.getProber().getExtractionResyncStatistics();
+}
 } // cavs
 } // debug_agent
@@ -62,14 +62,21 @@ void System::ProbeExtractionStreamResource::doWriting(std::ostream &os)
     system::IfdkStreamHeader header(systemType, formatType, majorVersion, minorVersion);
     os << header;
 
+    // maximum probe data size dequeued, and then flushed, at each iteration
+    static const std::size_t maxBatchByteSize = 64 * 1024;
+
     try {
         while (true) {
-            std::unique_ptr<util::Buffer> block = mProber.dequeueExtractionBlock(mProbeIndex);
-            if (block == nullptr) {
+            auto blocks = mProber.dequeueExtractionBlocks(mProbeIndex, maxBatchByteSize);
+            if (blocks.empty()) {
                 // Extraction is finished
                 return;
             }
-            os.write(reinterpret_cast<const char *>(block->data()), block->size());
+            for (auto &block : blocks) {
+                os.write(reinterpret_cast<const char *>(block->data()), block->size());
+            }
+            mProber.recycleExtractionBlocks(blocks);
+            os.flush();
             if (os.fail()) {
                 throw Exception("Unable to write probe data to output stream");
             }
@@ -163,6 +170,16 @@ Logger::Parameters System::getLogParameters()
     }
 }
 
+util::QueueStatistics System::getLogQueueStatistics() const
+{
+    return mDriver->getLogger().getQueueStatistics();
+}
+
+std::vector<util::QueueStatistics> System::getProbeExtractionQueueStatistics() const
+{
+    return mDriver->getProber().getExtractionQueueStatistics();
+}
+
 template <typename T>
 std::unique_ptr<T> System::tryToAcquireResource(std::unique_ptr<T> resource)
 {
@@ -200,14 +217,54 @@ std::unique_ptr<System::InputStreamResource> System::tryToAcquireProbeInjectionS
 void System::getTopology(Topology &topology)
 {
     topology.clear();
+    refreshTopology(topology);
+}
+
+System::TopologyRefreshStatistics System::refreshTopology(Topology &topology)
+{
+    Topology previous(std::move(topology));
+    topology.clear();
+
+    TopologyRefreshStatistics statistics{1, 0, 0};
+    try {
+        retrieveTopology(previous, topology, statistics);
+    } catch (...) {
+        /* A partially retrieved topology cannot be the base of the next refresh */
+        topology.clear();
+        throw;
+    }
+
+    std::lock_guard<std::mutex> locker(mTopologyRefreshMutex);
+    ++mTopologyRefreshStatistics.refreshCount;
+    mTopologyRefreshStatistics.ipcCount += statistics.ipcCount;
+    mTopologyRefreshStatistics.savedIpcCount += statistics.savedIpcCount;
+    return statistics;
+}
+
+System::TopologyRefreshStatistics System::getTopologyRefreshStatistics() const
+{
+    std::lock_guard<std::mutex> locker(mTopologyRefreshMutex);
+    return mTopologyRefreshStatistics;
+}
+
+uint64_t System::getSavedCorePowerToggleCount()
+{
+    return getModuleHandler().getSavedCorePowerToggleCount();
+}
 
+void System::retrieveTopology(Topology &previous, Topology &topology,
+                              TopologyRefreshStatistics &statistics)
+{
     ModuleHandler &handler = getModuleHandler();
     std::set<dsp_fw::CompoundModuleId> moduleInstanceIds;
+    /* Module instances belonging to a new or changed pipeline or task */
+    std::set<dsp_fw::CompoundModuleId> changedModuleInstanceIds;
 
     auto &hwConfig = handler.getHwConfig();
 
     try {
         topology.gateways = handler.getGatewaysInfo();
+        ++statistics.ipcCount;
     } catch (ModuleHandler::Exception &e) {
         throw Exception("Can not retrieve gateways: " + std::string(e.what()));
     }
@@ -215,20 +272,33 @@ void System::getTopology(Topology &topology)
     std::vector<dsp_fw::PipeLineIdType> pipelineIds;
     try {
         pipelineIds = handler.getPipelineIdList();
+        ++statistics.ipcCount;
     } catch (ModuleHandler::Exception &e) {
         throw Exception("Can not retrieve pipeline ids: " + std::string(e.what()));
     }
 
+    std::map<dsp_fw::PipeLineIdType, const dsp_fw::PplProps *> previousPipelines;
+    for (auto &props : previous.pipelines) {
+        previousPipelines[props.id] = &props;
+    }
+
     /* Retrieving pipeline props*/
     for (auto pplId : pipelineIds) {
         try {
             dsp_fw::PplProps props = handler.getPipelineProps(pplId);
-            topology.pipelines.push_back(props);
+            ++statistics.ipcCount;
 
             /* Collecting module instance ids*/
+            auto previousProps = previousPipelines.find(props.id);
+            bool isChanged =
+                previousProps == previousPipelines.end() || !(*previousProps->second == props);
             for (auto instanceId : props.module_instances) {
                 moduleInstanceIds.insert(instanceId);
+                if (isChanged) {
+                    changedModuleInstanceIds.insert(instanceId);
+                }
             }
+            topology.pipelines.push_back(props);
         } catch (ModuleHandler::Exception &e) {
             throw Exception("Can not retrieve pipeline props of id " +
                             std::to_string(pplId.getValue()) + " : " + std::string(e.what()));
@@ -241,30 +311,57 @@ void System::getTopology(Topology &topology)
                   return pipeA.priority < pipeB.priority;
               });
 
+    /* Tasks are identified by their core and task ids */
+    using TaskKey = std::pair<uint32_t, uint32_t>;
+    std::map<TaskKey, const dsp_fw::TaskProps *> previousTasks;
+    for (auto &info : previous.schedulers) {
+        for (auto &scheduler : info.scheduler_info) {
+            for (auto &task : scheduler.task_info) {
+                previousTasks[TaskKey(scheduler.core_id, task.task_id)] = &task;
+            }
+        }
+    }
+
     for (uint32_t coreId = 0; coreId < hwConfig.dspCoreCount; coreId++) {
         try {
             dsp_fw::SchedulersInfo info = handler.getSchedulersInfo(dsp_fw::CoreId{coreId});
-            topology.schedulers.push_back(info);
+            ++statistics.ipcCount;
 
             /* Collecting module instance ids*/
             for (auto &scheduler : info.scheduler_info) {
                 for (auto &task : scheduler.task_info) {
+                    auto previousTask =
+                        previousTasks.find(TaskKey(scheduler.core_id, task.task_id));
+                    bool isChanged =
+                        previousTask == previousTasks.end() || !(*previousTask->second == task);
                     for (auto &instanceId : task.module_instance_id) {
                         moduleInstanceIds.insert(instanceId);
+                        if (isChanged) {
+                            changedModuleInstanceIds.insert(instanceId);
+                        }
                     }
                 }
             }
+            topology.schedulers.push_back(info);
         } catch (ModuleHandler::Exception &e) {
             throw Exception("Can not retrieve scheduler props of core id: " +
                             std::to_string(coreId) + " : " + std::string(e.what()));
         }
     }
 
-    /* Retrieving module instances*/
+    /* Retrieving module instances, those of unchanged pipelines and tasks are kept */
     for (auto &compoundId : moduleInstanceIds) {
+        auto previousInstance = previous.moduleInstances.find(compoundId);
+        if (previousInstance != previous.moduleInstances.end() &&
+            changedModuleInstanceIds.find(compoundId) == changedModuleInstanceIds.end()) {
+            topology.moduleInstances[compoundId] = std::move(previousInstance->second);
+            ++statistics.savedIpcCount;
+            continue;
+        }
         try {
             topology.moduleInstances[compoundId] =
                 handler.getModuleInstanceProps(compoundId.moduleId, compoundId.instanceId);
+            ++statistics.ipcCount;
         } catch (ModuleHandler::Exception &e) {
             throw Exception("Can not retrieve module instance with id: (" +
                             std::to_string(compoundId.moduleId) + "," +
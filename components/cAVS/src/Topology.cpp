@@ -30,6 +30,8 @@
 #include "cAVS/Topology.hpp"
 #include <string>
 #include <iostream>
+#include <limits>
+#include <unordered_map>
 
 namespace debug_agent
 {
@@ -49,11 +51,10 @@ const dsp_fw::ModuleInstanceProps &Topology::getModuleInstance(
     return it->second;
 }
 
-void Topology::addAllModuleOutputs(OutputList &list, const dsp_fw::CompoundModuleId &module) const
+void Topology::addAllModuleOutputs(OutputList &list, const dsp_fw::CompoundModuleId &module,
+                                   const dsp_fw::ModuleInstanceProps &moduleProps)
 {
-    const dsp_fw::ModuleInstanceProps &moduleProps = getModuleInstance(module);
-
-    OutputId outputId;
+    uint32_t outputId;
     if (moduleProps.output_gateway.val.dw == dsp_fw::ConnectorNodeId::kInvalidNodeId) {
 
         outputId = 0;
@@ -65,19 +66,18 @@ void Topology::addAllModuleOutputs(OutputList &list, const dsp_fw::CompoundModul
 
     for (; outputId < moduleProps.output_pins.pin_info.size(); ++outputId) {
 
-        if (moduleProps.output_pins.pin_info[outputId].phys_queue_id !=
-            dsp_fw::PinProps::invalidQueueId) {
+        uint32_t queueId = moduleProps.output_pins.pin_info[outputId].phys_queue_id;
+        if (queueId != dsp_fw::PinProps::invalidQueueId) {
 
-            list.push_back(Output(module, outputId));
+            list.push_back(Endpoint(module, outputId, queueId));
         }
     }
 }
 
-void Topology::addAllModuleInputs(InputList &list, const dsp_fw::CompoundModuleId &module) const
+void Topology::addAllModuleInputs(InputList &list, const dsp_fw::CompoundModuleId &module,
+                                  const dsp_fw::ModuleInstanceProps &moduleProps)
 {
-    const dsp_fw::ModuleInstanceProps &moduleProps = getModuleInstance(module);
-
-    InputId inputId;
+    uint32_t inputId;
     if (moduleProps.input_gateway.val.dw == dsp_fw::ConnectorNodeId::kInvalidNodeId) {
 
         inputId = 0;
@@ -89,10 +89,10 @@ void Topology::addAllModuleInputs(InputList &list, const dsp_fw::CompoundModuleI
 
     for (; inputId < moduleProps.input_pins.pin_info.size(); ++inputId) {
 
-        if (moduleProps.input_pins.pin_info[inputId].phys_queue_id !=
-            dsp_fw::PinProps::invalidQueueId) {
+        uint32_t queueId = moduleProps.input_pins.pin_info[inputId].phys_queue_id;
+        if (queueId != dsp_fw::PinProps::invalidQueueId) {
 
-            list.push_back(Input(module, inputId));
+            list.push_back(Endpoint(module, inputId, queueId));
         }
     }
 }
@@ -117,6 +117,9 @@ void Topology::computeLinks()
 
 void Topology::computeIntraPipeLinks(InputList &unresolvedInputs, OutputList &unresolvedOutputs)
 {
+    /* Props of the current pipe module instances, looked up once per module instance */
+    std::vector<const dsp_fw::ModuleInstanceProps *> pipeModules;
+
     for (auto const &pipe : pipelines) {
 
         if (pipe.module_instances.size() == 0) {
@@ -124,13 +127,19 @@ void Topology::computeIntraPipeLinks(InputList &unresolvedInputs, OutputList &un
             // No module instance in this pipe: continue with next one
             continue;
         }
+
+        pipeModules.clear();
+        for (auto const &moduleId : pipe.module_instances) {
+            pipeModules.push_back(&getModuleInstance(moduleId));
+        }
+
         /* In a pipe, module instances collection is ordered like the module are ordered:
          * Gather first module instance inputs into unresolved inputs connections list
          */
-        addAllModuleInputs(unresolvedInputs, pipe.module_instances.front());
+        addAllModuleInputs(unresolvedInputs, pipe.module_instances.front(), *pipeModules.front());
 
         /* Gather last module instance outputs into unresolved outputs connections list */
-        addAllModuleOutputs(unresolvedOutputs, pipe.module_instances.back());
+        addAllModuleOutputs(unresolvedOutputs, pipe.module_instances.back(), *pipeModules.back());
 
         if (pipe.module_instances.size() < 2) {
 
@@ -142,47 +151,43 @@ void Topology::computeIntraPipeLinks(InputList &unresolvedInputs, OutputList &un
         for (size_t pipeModuleIndex = 0; pipeModuleIndex < pipe.module_instances.size() - 1;
              ++pipeModuleIndex) {
 
-            const dsp_fw::CompoundModuleId &sourceModuleId = pipe.module_instances[pipeModuleIndex];
-            const dsp_fw::CompoundModuleId &destinationModuleId =
-                pipe.module_instances[pipeModuleIndex + 1];
-
-            computeModulesPairLink(sourceModuleId, destinationModuleId, unresolvedInputs,
-                                   unresolvedOutputs);
+            computeModulesPairLink(
+                pipe.module_instances[pipeModuleIndex], *pipeModules[pipeModuleIndex],
+                pipe.module_instances[pipeModuleIndex + 1], *pipeModules[pipeModuleIndex + 1],
+                unresolvedInputs, unresolvedOutputs);
         }
     }
 }
 
 void Topology::computeModulesPairLink(const dsp_fw::CompoundModuleId &sourceModuleId,
+                                      const dsp_fw::ModuleInstanceProps &sourceModule,
                                       const dsp_fw::CompoundModuleId &destinationModuleId,
+                                      const dsp_fw::ModuleInstanceProps &destinationModule,
                                       InputList &unresolvedInputs, OutputList &unresolvedOutputs)
 {
-    /* List all destination module outputs */
+    /* List all source module outputs */
     OutputList sourceOutputs;
-    addAllModuleOutputs(sourceOutputs, sourceModuleId);
+    addAllModuleOutputs(sourceOutputs, sourceModuleId, sourceModule);
 
     /* List all destination module inputs */
     InputList destinationInputs;
-    addAllModuleInputs(destinationInputs, destinationModuleId);
+    addAllModuleInputs(destinationInputs, destinationModuleId, destinationModule);
 
     /* For each output of source module... */
-    for (Output const &output : sourceOutputs) {
+    for (Endpoint const &output : sourceOutputs) {
 
-        const dsp_fw::ModuleInstanceProps &sourceModule = getModuleInstance(sourceModuleId);
-        const dsp_fw::PinProps &outputPin = sourceModule.output_pins.pin_info[output.second];
         bool connectionFound = false;
 
-        /* ...look for an input connected to the same queue */
-        for (auto inputIt = destinationInputs.begin(); inputIt != destinationInputs.end();) {
-
-            const dsp_fw::ModuleInstanceProps &destinationModule =
-                getModuleInstance(destinationModuleId);
-            const dsp_fw::PinProps &inputPin =
-                destinationModule.input_pins.pin_info[inputIt->second];
+        /* ...look for an input connected to the same queue. A module has only a few pins: a
+         * linear scan is cheaper than an index here */
+        for (auto inputIt = destinationInputs.begin(); inputIt != destinationInputs.end();
+             ++inputIt) {
 
-            if (outputPin.phys_queue_id == inputPin.phys_queue_id) {
+            if (output.mQueueId == inputIt->mQueueId) {
 
                 /* Output and input are connected to the same queue: we've just found a link */
-                links.push_back(Link(output.first, output.second, inputIt->first, inputIt->second));
+                links.push_back(
+                    Link(output.mModule, output.mPinId, inputIt->mModule, inputIt->mPinId));
 
                 // Remind the output has a connection with an input
                 connectionFound = true;
@@ -190,10 +195,6 @@ void Topology::computeModulesPairLink(const dsp_fw::CompoundModuleId &sourceModu
                 /* This input is used: remove it from the list */
                 destinationInputs.erase(inputIt);
                 break;
-            } else {
-
-                /* Try next input */
-                ++inputIt;
             }
         }
 
@@ -211,69 +212,77 @@ void Topology::computeModulesPairLink(const dsp_fw::CompoundModuleId &sourceModu
 
 void Topology::computeInterPipeLinks(InputList &unresolvedInputs, OutputList &unresolvedOutputs)
 {
-    bool connectionFound;
-    for (auto outputIt = unresolvedOutputs.begin(); outputIt != unresolvedOutputs.end();) {
-
-        connectionFound = false;
+    static const std::size_t noInput = std::numeric_limits<std::size_t>::max();
 
-        const dsp_fw::ModuleInstanceProps &sourceModule = getModuleInstance(outputIt->first);
-        const dsp_fw::PinProps &outputPinProps =
-            sourceModule.output_pins.pin_info[outputIt->second];
+    /* Index the unresolved inputs by queue id: each queue id leads to its first unresolved
+     * input, which leads to the next one of the same queue through nextInputs. The chains keep
+     * the unresolved inputs order, so each output is linked to the first remaining input of its
+     * queue, as a linear scan of the list would do. */
+    std::unordered_map<uint32_t, std::size_t> firstInputs;
+    firstInputs.reserve(unresolvedInputs.size());
+    std::vector<std::size_t> nextInputs(unresolvedInputs.size(), noInput);
 
-        for (auto inputIt = unresolvedInputs.begin(); inputIt != unresolvedInputs.end();) {
+    for (std::size_t inputIndex = unresolvedInputs.size(); inputIndex > 0; --inputIndex) {
 
-            const dsp_fw::ModuleInstanceProps &destinationModule =
-                getModuleInstance(inputIt->first);
-            const dsp_fw::PinProps &inputPinProps =
-                destinationModule.input_pins.pin_info[inputIt->second];
+        auto result = firstInputs.emplace(unresolvedInputs[inputIndex - 1].mQueueId, noInput);
+        nextInputs[inputIndex - 1] = result.first->second;
+        result.first->second = inputIndex - 1;
+    }
 
-            if (outputPinProps.phys_queue_id == inputPinProps.phys_queue_id) {
+    std::vector<bool> connectedInputs(unresolvedInputs.size(), false);
+    OutputList remainingOutputs;
 
-                connectionFound = true;
-                links.push_back(
-                    Link(outputIt->first, outputIt->second, inputIt->first, inputIt->second));
+    for (Endpoint const &output : unresolvedOutputs) {
 
-                unresolvedInputs.erase(inputIt);
-                break;
-            } else {
+        auto firstInputIt = firstInputs.find(output.mQueueId);
+        if (firstInputIt == firstInputs.end() || firstInputIt->second == noInput) {
 
-                ++inputIt;
-            }
+            remainingOutputs.push_back(output);
+            continue;
         }
 
-        if (connectionFound) {
+        std::size_t inputIndex = firstInputIt->second;
+        const Endpoint &input = unresolvedInputs[inputIndex];
+        links.push_back(Link(output.mModule, output.mPinId, input.mModule, input.mPinId));
 
-            outputIt = unresolvedOutputs.erase(outputIt);
-        } else {
+        /* This input is used: the next input of the same queue becomes the first one */
+        connectedInputs[inputIndex] = true;
+        firstInputIt->second = nextInputs[inputIndex];
+    }
+
+    /* Keep the inputs which are still unresolved, in their original order */
+    std::size_t remainingInputCount = 0;
+    for (std::size_t inputIndex = 0; inputIndex < unresolvedInputs.size(); ++inputIndex) {
 
-            ++outputIt;
+        if (!connectedInputs[inputIndex]) {
+            unresolvedInputs[remainingInputCount++] = unresolvedInputs[inputIndex];
         }
     }
+    unresolvedInputs.erase(unresolvedInputs.begin() + remainingInputCount,
+                           unresolvedInputs.end());
+
+    unresolvedOutputs.swap(remainingOutputs);
 }
 
 void Topology::checkUnresolved(InputList &unresolvedInputs, OutputList &unresolvedOutputs) const
 {
     for (auto const &output : unresolvedOutputs) {
 
-        const dsp_fw::ModuleInstanceProps &moduleProps = getModuleInstance(output.first);
-
         /** @fixme use cAVS plugin log instead */
         std::cout << "[cAVS] Error: "
-                  << "Unconnected output pin #" << output.second << " of module instance ID #"
-                  << output.first.instanceId << " (Module ID #" << output.first.moduleId
-                  << "): expecting connection through queue ID #"
-                  << moduleProps.output_pins.pin_info[output.second].phys_queue_id << std::endl;
+                  << "Unconnected output pin #" << output.mPinId << " of module instance ID #"
+                  << output.mModule.instanceId << " (Module ID #" << output.mModule.moduleId
+                  << "): expecting connection through queue ID #" << output.mQueueId
+                  << std::endl;
     }
     for (auto const &input : unresolvedInputs) {
 
-        const dsp_fw::ModuleInstanceProps &moduleProps = getModuleInstance(input.first);
-
         /** @fixme use cAVS plugin log instead */
         std::cout << "[cAVS] Error: "
-                  << "Unconnected input pin #" << input.second << " of module instance ID #"
-                  << input.first.instanceId << " (Module ID #" << input.first.moduleId
-                  << "): expecting connection through queue ID #"
-                  << moduleProps.input_pins.pin_info[input.second].phys_queue_id << std::endl;
+                  << "Unconnected input pin #" << input.mPinId << " of module instance ID #"
+                  << input.mModule.instanceId << " (Module ID #" << input.mModule.moduleId
+                  << "): expecting connection through queue ID #" << input.mQueueId
+                  << std::endl;
     }
 }
 }
@@ -36,6 +36,7 @@
 #include <string>
 #include <cstring>
 #include <algorithm>
+#include <limits>
 #include <cassert>
 #include <iostream>
 
@@ -46,8 +47,9 @@ namespace cavs
 namespace windows
 {
 
-Logger::LogProducer::LogProducer(BlockingQueue &queue, std::unique_ptr<WppClient> wppClient)
-    : mQueue(queue), mWppClient(std::move(wppClient)),
+Logger::LogProducer::LogProducer(BlockingQueue &queue, LogBlockPool &pool,
+                                 std::unique_ptr<WppClient> wppClient)
+    : mQueue(queue), mPool(pool), mWppClient(std::move(wppClient)),
 
       /* Note: mProducerThread should be the last initialized member because it starts a thread
        * that uses the previous members.
@@ -79,7 +81,7 @@ void Logger::LogProducer::produceEntries()
 
 void Logger::LogProducer::onLogEntry(uint32_t coreId, uint8_t *buffer, uint32_t bufferSize)
 {
-    std::unique_ptr<LogBlock> logBlock = std::make_unique<LogBlock>(coreId, bufferSize);
+    std::unique_ptr<LogBlock> logBlock = mPool.acquire(coreId, bufferSize);
     std::copy(buffer, buffer + bufferSize, logBlock->getLogData().begin());
 
     if (!mQueue.add(std::move(logBlock))) {
@@ -213,8 +215,8 @@ void Logger::startLogLocked(const Parameters &parameters)
     assert(mLogProducer == nullptr);
 
     /* Starting the producer thread before enabling logs into the fw */
-    mLogProducer = std::move(
-        std::make_unique<LogProducer>(mLogEntryQueue, mWppClientFactory.createInstance()));
+    mLogProducer = std::move(std::make_unique<LogProducer>(mLogEntryQueue, mLogBlockPool,
+                                                           mWppClientFactory.createInstance()));
 
     try {
         setLogParameterIoctl(parameters);
@@ -331,6 +333,21 @@ std::unique_ptr<LogBlock> Logger::readLogBlock()
     return mLogEntryQueue.remove();
 }
 
+std::vector<std::unique_ptr<LogBlock>> Logger::readLogBlocks(std::size_t maxByteSize)
+{
+    return mLogEntryQueue.removeUpTo(maxByteSize, std::numeric_limits<std::size_t>::max());
+}
+
+void Logger::recycleLogBlocks(std::vector<std::unique_ptr<LogBlock>> &blocks)
+{
+    mLogBlockPool.release(blocks);
+}
+
+util::QueueStatistics Logger::getQueueStatistics() const
+{
+    return mLogEntryQueue.getStatistics();
+}
+
 void Logger::stop() noexcept
 {
     /* Stopping log session if one is running */
@@ -53,7 +53,8 @@ util::Buffer ModuleHandlerImpl::bigCmdModuleAccessIoctl(bool isGet, uint16_t mod
     driver::IoctlFwModuleParam moduleParam(moduleId, instanceId, moduleParamId,
                                            static_cast<uint32_t>(suppliedOutputBuffer.size()));
 
-    util::MemoryByteStreamWriter bodyPayloadWriter;
+    util::MemoryByteStreamWriter bodyPayloadWriter(sizeof(moduleParam) +
+                                                   suppliedOutputBuffer.size());
     bodyPayloadWriter.write(moduleParam);
     bodyPayloadWriter.writeRawBuffer(suppliedOutputBuffer);
 
@@ -70,6 +70,16 @@ std::unique_ptr<util::Buffer> Prober::dequeueExtractionBlock(ProbeId probeIndex)
     }
 }
 
+std::vector<std::unique_ptr<util::Buffer>> Prober::dequeueExtractionBlocks(
+    ProbeId probeIndex, std::size_t maxByteSize)
+{
+    try {
+        return mBackend.dequeueExtractionBlocks(probeIndex, maxByteSize);
+    } catch (ProberBackend::Exception &e) {
+        throw Exception(std::string(e.what()));
+    }
+}
+
 bool Prober::enqueueInjectionBlock(ProbeId probeIndex, const util::Buffer &buffer)
 {
     try {
@@ -79,6 +89,21 @@ bool Prober::enqueueInjectionBlock(ProbeId probeIndex, const util::Buffer &buffe
     }
 }
 
+void Prober::recycleExtractionBlocks(std::vector<std::unique_ptr<util::Buffer>> &blocks)
+{
+    mBackend.recycleExtractionBlocks(blocks);
+}
+
+std::vector<util::QueueStatistics> Prober::getExtractionQueueStatistics() const
+{
+    return mBackend.getExtractionQueueStatistics();
+}
+
+Prober::ExtractionResyncStatistics Prober::getExtractionResyncStatistics() const
+{
+    return mBackend.getExtractionResyncStatistics();
+}
+
 std::size_t Prober::getMaxProbeCount() const
 {
     return mBackend.getMaxProbeCount();
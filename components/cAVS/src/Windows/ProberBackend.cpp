@@ -32,6 +32,7 @@
 #include "cAVS/Windows/IoctlHelpers.hpp"
 #include "cAVS/Windows/Probe/ExtractionInputStream.hpp"
 #include "cAVS/Windows/Probe/InjectionOutputStream.hpp"
+#include <limits>
 
 namespace debug_agent
 {
@@ -157,11 +158,13 @@ void ProberBackend::setStateTransition(State newState, State oldState)
 }
 
 ProberBackend::ProberBackend(Device &device, const EventHandles &eventHandles)
-    : mDevice(device), mEventHandles(eventHandles), mCachedProbeConfiguration(getMaxProbeCount())
+    : mDevice(device), mEventHandles(eventHandles), mCachedProbeConfiguration(getMaxProbeCount()),
+      mPacketPool(mQueueSize)
 {
     for (std::size_t probeIndex = 0; probeIndex < getMaxProbeCount(); ++probeIndex) {
         mExtractionQueues.emplace_back(mQueueSize,
                                        [](const util::Buffer &buffer) { return buffer.size(); });
+        mExtractionQueues.back().setRecycler(util::PoolRecycler<util::Buffer>(mPacketPool));
         mInjectionQueues.emplace_back(mQueueSize);
     }
 }
@@ -222,6 +225,14 @@ std::unique_ptr<util::Buffer> ProberBackend::dequeueExtractionBlock(ProbeId prob
     return mExtractionQueues[probeIndex.getValue()].remove();
 }
 
+std::vector<std::unique_ptr<util::Buffer>> ProberBackend::dequeueExtractionBlocks(
+    ProbeId probeIndex, std::size_t maxByteSize)
+{
+    checkProbeId(probeIndex);
+    return mExtractionQueues[probeIndex.getValue()].removeUpTo(
+        maxByteSize, std::numeric_limits<std::size_t>::max());
+}
+
 bool ProberBackend::enqueueInjectionBlock(ProbeId probeIndex, const util::Buffer &buffer)
 {
     checkProbeId(probeIndex);
@@ -230,6 +241,27 @@ bool ProberBackend::enqueueInjectionBlock(ProbeId probeIndex, const util::Buffer
     return mInjectionQueues[probeIndex.getValue()].writeBlocking(buffer.data(), buffer.size());
 }
 
+void ProberBackend::recycleExtractionBlocks(std::vector<std::unique_ptr<util::Buffer>> &blocks)
+{
+    mPacketPool.release(blocks);
+}
+
+std::vector<util::QueueStatistics> ProberBackend::getExtractionQueueStatistics() const
+{
+    std::vector<util::QueueStatistics> statistics;
+    for (auto &queue : mExtractionQueues) {
+        statistics.push_back(queue.getStatistics());
+    }
+    return statistics;
+}
+
+cavs::Prober::ExtractionResyncStatistics ProberBackend::getExtractionResyncStatistics() const
+{
+    auto statistics = mResyncCounters.getStatistics();
+    statistics.probes.resize(mExtractionQueues.size());
+    return statistics;
+}
+
 driver::RingBuffersDescription ProberBackend::getRingBuffers()
 {
     using RingBuffer = driver::RingBufferDescription;
@@ -298,7 +330,8 @@ void ProberBackend::startStreaming()
                                        ringBuffers.extractionRBDescription.size,
                                        [this] { return getExtractionRingBufferLinearPosition(); }));
             mExtractor = std::make_unique<ProbeExtractor>(mExtractionQueues, probePointMap,
-                                                          std::move(inputStream));
+                                                          std::move(inputStream), &mPacketPool,
+                                                          &mResyncCounters);
         }
 
         // opening queues of the active probes and creating injectors
@@ -34,7 +34,10 @@
 #include "cAVS/DspFw/Pipeline.hpp"
 #include "cAVS/DspFw/Gateway.hpp"
 #include "cAVS/DspFw/Scheduler.hpp"
+#include "cAVS/DspFw/GlobalPerfData.hpp"
 #include <catch.hpp>
+#include <chrono>
+#include <iostream>
 
 using namespace debug_agent::util;
 using namespace debug_agent::cavs::dsp_fw;
@@ -152,6 +155,12 @@ TEST_CASE("FirmwareTypes : SchedulersInfo")
 
 /** MODULE INSTANCES */
 
+TEST_CASE("FirmwareTypes : ConnectorNodeId")
+{
+    testType(ConnectorNodeId(0x12345678), {0x78, 0x56, 0x34, 0x12});
+    testType(ConnectorNodeId(ConnectorNodeId::kI2sLinkInputClass, 3), {3, 13, 0, 0});
+}
+
 TEST_CASE("FirmwareTypes : PinProps")
 {
     testType(PinProps{StreamType::ePcm, audioFormat, 2},
@@ -210,6 +219,14 @@ TEST_CASE("FirmwareTypes : ModuleInstanceProps")
 
 /** GATEWAY */
 
+TEST_CASE("FirmwareTypes : GatewayAttributes")
+{
+    GatewayAttributes attributes;
+    attributes.dw = 0;
+    attributes.bits.lp_buffer_alloc = 1;
+    testType(attributes, {1, 0, 0, 0});
+}
+
 TEST_CASE("FirmwareTypes : GatewayProps")
 {
     testType(GatewayProps{1, 2}, {1, 0, 0, 0, 2, 0, 0, 0});
@@ -303,3 +320,140 @@ TEST_CASE("FirmwareTypes : DmaBufferConfig")
 {
     testType(DmaBufferConfig{1, 2}, {1, 0, 0, 0, 2, 0, 0, 0});
 }
+
+/** PERFORMANCE */
+
+TEST_CASE("FirmwareTypes : GlobalPerfData")
+{
+    testType(GlobalPerfData{{{1, 2, true, false, 3, 4}, {5, 6, false, true, 7, 8}}},
+             {
+                 2, 0, 0, 0,
+
+                 2, 0, 1, 0, 1, 0, 0, 0, 3, 0, 0, 0, 4, 0, 0, 0,
+
+                 6, 0, 5, 0, 0, 0, 0, 0x80, 7, 0, 0, 0, 8, 0, 0, 0,
+             });
+}
+
+/** DECODING BENCHMARK */
+
+/* Reads the members of a member list one at a time, as the former hand-written serializers did */
+template <typename List>
+struct MemberByMemberReader;
+
+template <typename... Members>
+struct MemberByMemberReader<MemberList<Members...>>
+{
+    template <typename T>
+    static void read(T &value, ByteStreamReader &reader)
+    {
+        int expand[] = {0, (Members::read(value, reader), 0)...};
+        (void)expand;
+    }
+};
+
+template <typename T, typename Read>
+double measureDecoding(const T &value, std::size_t iterations, Read read)
+{
+    MemoryByteStreamWriter writer;
+    writer.write(value);
+    const Buffer &buffer = writer.getBuffer();
+
+    /* Vectors are appended to, so each iteration decodes a new value, as replies are */
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; ++i) {
+        MemoryByteStreamReader reader(buffer);
+        T readValue;
+        read(readValue, reader);
+    }
+    std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+
+    MemoryByteStreamReader reader(buffer);
+    T readValue;
+    read(readValue, reader);
+    CHECK(readValue == value);
+    return duration.count() * 1e9 / iterations;
+}
+
+template <typename T>
+void benchmarkDecoding(const std::string &name, const T &value)
+{
+    static const std::size_t iterations = 200000;
+
+    double memberDuration = measureDecoding(value, iterations, [](T &v, ByteStreamReader &r) {
+        MemberByMemberReader<typename T::Members>::read(v, r);
+    });
+    double listDuration =
+        measureDecoding(value, iterations, [](T &v, ByteStreamReader &r) { r.read(v); });
+
+    std::cout << name << ": member by member " << memberDuration << " ns, member list "
+              << listDuration << " ns\n";
+}
+
+TEST_CASE("FirmwareTypes : decoding benchmark", "[.][benchmark]")
+{
+    SECTION ("ModuleInstanceProps") {
+        const PinListInfo pins = {{{StreamType::ePcm, audioFormat, 3},
+                                   {StreamType::ePcm, audioFormat, 4}}};
+        benchmarkDecoding("ModuleInstanceProps",
+                          ModuleInstanceProps{{1, 9}, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, pins, pins,
+                                              ConnectorNodeId(12), ConnectorNodeId(13)});
+    }
+
+    SECTION ("PplProps") {
+        using ID = PipeLineIdType;
+        PplProps props{ID{1}, 2, 3, 4, 5, 6, {}, {}, {}};
+        for (uint16_t i = 0; i < 8; ++i) {
+            props.module_instances.push_back({i, static_cast<uint16_t>(i + 1)});
+            props.ll_tasks.push_back(i);
+        }
+        benchmarkDecoding("PplProps", props);
+    }
+
+    SECTION ("SchedulersInfo") {
+        SchedulersInfo infos;
+        for (uint32_t core = 0; core < 2; ++core) {
+            SchedulerProps scheduler{core, 2, {}};
+            for (uint32_t task = 0; task < 4; ++task) {
+                scheduler.task_info.push_back(TaskProps{task, {{1, 2}, {3, 4}}});
+            }
+            infos.scheduler_info.push_back(scheduler);
+        }
+        benchmarkDecoding("SchedulersInfo", infos);
+    }
+
+    SECTION ("GlobalPerfData") {
+        GlobalPerfData perfData;
+        for (uint16_t i = 0; i < 32; ++i) {
+            perfData.items.push_back({i, 1, true, false, 3, 4});
+        }
+        benchmarkDecoding("GlobalPerfData", perfData);
+    }
+
+    SECTION ("GatewaysInfo") {
+        GatewaysInfo gateways;
+        for (uint32_t i = 0; i < 16; ++i) {
+            gateways.gateways.push_back({i, {1}});
+        }
+        benchmarkDecoding("GatewaysInfo", gateways);
+    }
+
+    SECTION ("ModulesInfo") {
+        const ModuleEntry module{1,
+                                 0,
+                                 {0, 1, 2, 3, 4, 5, 6, 7},
+                                 {1, 2, 3, 4},
+                                 {5},
+                                 {HASH_MEMORY},
+                                 1,
+                                 2,
+                                 3,
+                                 4,
+                                 5,
+                                 6,
+                                 {{{1}, 2, 3}, {{4}, 5, 6}, {{7}, 8, 9}}};
+        ModulesInfo modulesInfo;
+        modulesInfo.module_info.assign(8, module);
+        benchmarkDecoding("ModulesInfo", modulesInfo);
+    }
+}
@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2016, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cAVS/IpcScheduler.hpp"
+#include <catch.hpp>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace debug_agent::cavs;
+
+/** Requests IPCs from several threads and records the grant order */
+class GrantRecorder
+{
+public:
+    GrantRecorder(IpcScheduler &scheduler) : mScheduler(scheduler) {}
+
+    /** Request an IPC and wait until it is queued */
+    void request(IpcClass ipcClass)
+    {
+        std::size_t queueDepth = mScheduler.getStatistics(ipcClass).queueDepth;
+        mClients.push_back(std::async(std::launch::async, [this, ipcClass] {
+            auto slot = mScheduler.acquire(ipcClass);
+            std::lock_guard<std::mutex> locker(mMutex);
+            mGrants.push_back(ipcClass);
+        }));
+        while (mScheduler.getStatistics(ipcClass).queueDepth == queueDepth) {
+            std::this_thread::yield();
+        }
+    }
+
+    /** @return the grant order, once all IPCs have been granted */
+    std::vector<IpcClass> getGrants()
+    {
+        for (auto &client : mClients) {
+            client.get();
+        }
+        return mGrants;
+    }
+
+private:
+    IpcScheduler &mScheduler;
+    std::vector<std::future<void>> mClients;
+    std::mutex mMutex;
+    std::vector<IpcClass> mGrants;
+};
+
+TEST_CASE("IPC scheduler: IPCs are granted by priority class")
+{
+    IpcScheduler scheduler;
+    GrantRecorder recorder(scheduler);
+    {
+        /* The firmware is busy: the requests are queued */
+        auto slot = scheduler.acquire(IpcClass::BulkIntrospection);
+        recorder.request(IpcClass::BackgroundPolling);
+        recorder.request(IpcClass::BulkIntrospection);
+        recorder.request(IpcClass::InteractiveControl);
+        recorder.request(IpcClass::StreamingControl);
+        recorder.request(IpcClass::InteractiveControl);
+    }
+
+    CHECK(recorder.getGrants() ==
+          std::vector<IpcClass>({IpcClass::InteractiveControl, IpcClass::InteractiveControl,
+                                 IpcClass::StreamingControl, IpcClass::BulkIntrospection,
+                                 IpcClass::BackgroundPolling}));
+
+    IpcClassStatistics interactive = scheduler.getStatistics(IpcClass::InteractiveControl);
+    CHECK(interactive.requestCount == 2);
+    CHECK(interactive.queueDepth == 0);
+    CHECK(interactive.maxQueueDepth == 2);
+    CHECK(interactive.promotedCount == 0);
+    CHECK(interactive.maxWait <= interactive.totalWait);
+
+    IpcClassStatistics bulk = scheduler.getStatistics(IpcClass::BulkIntrospection);
+    CHECK(bulk.requestCount == 2);
+    CHECK(bulk.maxQueueDepth == 1);
+
+    /* The firmware is idle: an IPC is granted at once */
+    scheduler.acquire(IpcClass::BackgroundPolling);
+    CHECK(scheduler.getStatistics(IpcClass::BackgroundPolling).requestCount == 2);
+}
+
+TEST_CASE("IPC scheduler: starving IPCs are promoted")
+{
+    IpcScheduler scheduler(2);
+    GrantRecorder recorder(scheduler);
+    {
+        auto slot = scheduler.acquire(IpcClass::InteractiveControl);
+        recorder.request(IpcClass::BackgroundPolling);
+        recorder.request(IpcClass::InteractiveControl);
+        recorder.request(IpcClass::InteractiveControl);
+        recorder.request(IpcClass::InteractiveControl);
+    }
+
+    /* The polling IPC is overtaken twice, then granted before the last interactive one */
+    CHECK(recorder.getGrants() ==
+          std::vector<IpcClass>({IpcClass::InteractiveControl, IpcClass::InteractiveControl,
+                                 IpcClass::BackgroundPolling, IpcClass::InteractiveControl}));
+
+    CHECK(scheduler.getStatistics(IpcClass::BackgroundPolling).promotedCount == 1);
+    CHECK(scheduler.getStatistics(IpcClass::InteractiveControl).promotedCount == 0);
+}
+
+TEST_CASE("IPC scheduler: class names")
+{
+    CHECK(IpcScheduler::ipcClassHelper().toString(IpcClass::InteractiveControl) ==
+          "interactive_control");
+    CHECK(IpcScheduler::ipcClassHelper().toString(IpcClass::BackgroundPolling) ==
+          "background_polling");
+}
+
+TEST_CASE("IPC scheduler: raised IPCs are granted at their new class")
+{
+    IpcScheduler scheduler;
+    IpcScheduler::Urgency urgency;
+    std::mutex grantMutex;
+    std::vector<std::string> grants;
+    auto recordGrant = [&](const std::string &name) {
+        std::lock_guard<std::mutex> locker(grantMutex);
+        grants.push_back(name);
+    };
+
+    std::future<void> raised, streaming;
+    {
+        auto slot = scheduler.acquire(IpcClass::InteractiveControl);
+        raised = std::async(std::launch::async, [&] {
+            auto slot = scheduler.acquire(urgency);
+            recordGrant("raised");
+        });
+        while (scheduler.getStatistics(IpcClass::BackgroundPolling).queueDepth == 0) {
+            std::this_thread::yield();
+        }
+        streaming = std::async(std::launch::async, [&] {
+            auto slot = scheduler.acquire(IpcClass::StreamingControl);
+            recordGrant("streaming");
+        });
+        while (scheduler.getStatistics(IpcClass::StreamingControl).queueDepth == 0) {
+            std::this_thread::yield();
+        }
+
+        /* The waiting IPC moves from the polling queue to the interactive one */
+        scheduler.raise(urgency, IpcClass::InteractiveControl);
+        CHECK(scheduler.getStatistics(IpcClass::BackgroundPolling).queueDepth == 0);
+        CHECK(scheduler.getStatistics(IpcClass::InteractiveControl).queueDepth == 1);
+
+        /* An urgency is never lowered */
+        scheduler.raise(urgency, IpcClass::BulkIntrospection);
+        CHECK(scheduler.getStatistics(IpcClass::InteractiveControl).queueDepth == 1);
+    }
+    raised.get();
+    streaming.get();
+
+    CHECK(grants == std::vector<std::string>({"raised", "streaming"}));
+    CHECK(scheduler.getStatistics(IpcClass::InteractiveControl).requestCount == 2);
+    CHECK(scheduler.getStatistics(IpcClass::BackgroundPolling).requestCount == 0);
+}
@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) 2016, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "cAVS/Linux/AlsaControlElementCache.hpp"
+#include <catch.hpp>
+#include <cerrno>
+#include <deque>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace debug_agent::cavs::linux;
+
+namespace
+{
+/** Element recording the resolution which created it */
+struct ResolvedElement
+{
+    std::string name;
+    std::size_t resolution;
+};
+
+using Cache = AlsaControlElementCache<ResolvedElement>;
+
+/** Card event source replaying queued snd_ctl_read() results */
+class CardEvents
+{
+public:
+    struct Event
+    {
+        int result;
+        unsigned int mask;
+    };
+
+    void push(int result, unsigned int mask = 0) { mEvents.push_back({result, mask}); }
+
+    /** Reads the next event, as snd_ctl_read() does on a non blocking handle */
+    int operator()(unsigned int &mask)
+    {
+        if (mEvents.empty()) {
+            return -EAGAIN;
+        }
+        Event event = mEvents.front();
+        mEvents.pop_front();
+        mask = event.mask;
+        return event.result;
+    }
+
+    bool isEmpty() const { return mEvents.empty(); }
+
+private:
+    std::deque<Event> mEvents;
+};
+
+/** Cache client counting the element resolutions and listings */
+class CacheClient
+{
+public:
+    const ResolvedElement &getElement(const std::string &name)
+    {
+        return mCache.getElement(name, [this](const std::string &name) {
+            return ResolvedElement{name, ++mResolutionCount};
+        });
+    }
+
+    const std::vector<std::string> &getElementIds()
+    {
+        return mCache.getElementIds([this](std::vector<std::string> &ids) {
+            ++mListingCount;
+            ids = {"name='a'", "name='b'"};
+        });
+    }
+
+    /** Process the given element event, then check whether the cache has been invalidated */
+    bool isInvalidatedBy(int result, unsigned int mask)
+    {
+        getElement("a");
+        getElementIds();
+        std::size_t resolutionCount = mResolutionCount;
+        std::size_t listingCount = mListingCount;
+
+        mEvents.push(result, mask);
+        mCache.processEvents(std::ref(mEvents));
+        CHECK(mEvents.isEmpty());
+
+        getElement("a");
+        getElementIds();
+        bool resolved = mResolutionCount != resolutionCount;
+        bool listed = mListingCount != listingCount;
+        CHECK(resolved == listed);
+        return resolved;
+    }
+
+    Cache mCache;
+    CardEvents mEvents;
+    std::size_t mResolutionCount = 0;
+    std::size_t mListingCount = 0;
+};
+}
+
+TEST_CASE("AlsaControlElementCache: elements are resolved once", "[AlsaControlDevice]")
+{
+    CacheClient client;
+    CHECK(client.getElement("a").resolution == 1);
+    CHECK(client.getElement("b").resolution == 2);
+    CHECK(client.getElement("a").resolution == 1);
+    CHECK(client.getElement("a").name == "a");
+
+    CHECK(client.getElementIds() == (std::vector<std::string>{"name='a'", "name='b'"}));
+    CHECK(client.getElementIds().size() == 2);
+    CHECK(client.mListingCount == 1);
+}
+
+TEST_CASE("AlsaControlElementCache: card events", "[AlsaControlDevice]")
+{
+    using namespace private_driver;
+    CacheClient client;
+
+    SECTION ("Element addition invalidates the cache") {
+        CHECK(client.isInvalidatedBy(1, SND_CTL_EVENT_MASK_ADD));
+    }
+
+    SECTION ("Element information change invalidates the cache") {
+        CHECK(client.isInvalidatedBy(1, SND_CTL_EVENT_MASK_INFO));
+        CHECK(client.isInvalidatedBy(1, SND_CTL_EVENT_MASK_INFO | SND_CTL_EVENT_MASK_VALUE));
+    }
+
+    SECTION ("Element removal invalidates the cache") {
+        CHECK(client.isInvalidatedBy(1, SND_CTL_EVENT_MASK_REMOVE));
+    }
+
+    SECTION ("Value and tlv changes keep the cache") {
+        CHECK_FALSE(client.isInvalidatedBy(1, SND_CTL_EVENT_MASK_VALUE));
+        CHECK_FALSE(client.isInvalidatedBy(1, SND_CTL_EVENT_MASK_TLV));
+    }
+
+    SECTION ("Other events keep the cache") {
+        CHECK_FALSE(client.isInvalidatedBy(1, 0));
+    }
+
+    SECTION ("No pending event keeps the cache") {
+        CHECK_FALSE(client.isInvalidatedBy(-EAGAIN, 0));
+        CHECK_FALSE(client.isInvalidatedBy(0, SND_CTL_EVENT_MASK_ADD));
+    }
+
+    SECTION ("A read error invalidates the cache because events may have been lost") {
+        CHECK(client.isInvalidatedBy(-EIO, 0));
+    }
+
+    SECTION ("All pending events are read") {
+        client.getElement("a");
+        client.mEvents.push(1, SND_CTL_EVENT_MASK_VALUE);
+        client.mEvents.push(1, SND_CTL_EVENT_MASK_VALUE);
+        client.mEvents.push(1, SND_CTL_EVENT_MASK_ADD);
+        client.mCache.processEvents(std::ref(client.mEvents));
+        CHECK(client.mEvents.isEmpty());
+        CHECK(client.getElement("a").resolution == 2);
+    }
+}
+
+TEST_CASE("AlsaControlElementCache: access errors", "[AlsaControlDevice]")
+{
+    CacheClient client;
+    client.getElement("a");
+    client.getElement("b");
+
+    SECTION ("A successful access keeps the element") {
+        CHECK(client.mCache.access("a", [] { return 0; }) == 0);
+        CHECK(client.getElement("a").resolution == 1);
+    }
+
+    SECTION ("A failed access evicts the element only") {
+        CHECK(client.mCache.access("a", [] { return -ENOENT; }) == -ENOENT);
+        CHECK(client.getElement("a").resolution == 3);
+        CHECK(client.getElement("b").resolution == 2);
+    }
+}
+
+TEST_CASE("AlsaControlElementCache: resolution and listing failures", "[AlsaControlDevice]")
+{
+    Cache cache;
+
+    SECTION ("A failed resolution is not cached") {
+        CHECK_THROWS_AS(cache.getElement("a",
+                                         [](const std::string &) -> ResolvedElement {
+                                             throw std::runtime_error("not found");
+                                         }),
+                        std::runtime_error);
+        CHECK(cache.getElement("a", [](const std::string &name) {
+                       return ResolvedElement{name, 1};
+                   }).resolution == 1);
+    }
+
+    SECTION ("A failed listing is retried") {
+        CHECK_THROWS_AS(cache.getElementIds([](std::vector<std::string> &ids) {
+            ids.push_back("partial");
+            throw std::runtime_error("list failure");
+        }),
+                        std::runtime_error);
+        CHECK(cache.getElementIds([](std::vector<std::string> &ids) {
+            ids.push_back("name='a'");
+        }) == (std::vector<std::string>{"name='a'"}));
+    }
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2016, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "cAVS/Linux/ControlDeviceFactory.hpp"
+#include "Util/Buffer.hpp"
+#include <catch.hpp>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+using namespace debug_agent::cavs::linux;
+using namespace debug_agent::util;
+
+namespace
+{
+template <typename Operation>
+double measureLatency(std::size_t count, Operation operation)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < count; ++i) {
+        operation();
+    }
+    std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / count;
+}
+}
+
+/**
+ * This benchmark needs a real sound card, it measures the latency of the control device back-end
+ * selected at build time (MIXER_CONTROL_LIB_TO_USE), so that the Tinyalsa and Alsa-lib back-ends
+ * can be compared by running it with both builds. The card and the control to use are given by the
+ * DBGA_BENCHMARK_CARD and DBGA_BENCHMARK_CONTROL environment variables: the control shall be
+ * readable and writable, its current value is written back.
+ */
+TEST_CASE("ControlDevice: control access latency benchmark", "[.][benchmark]")
+{
+    const char *card = std::getenv("DBGA_BENCHMARK_CARD");
+    const char *control = std::getenv("DBGA_BENCHMARK_CONTROL");
+    if (card == nullptr || control == nullptr) {
+        WARN("DBGA_BENCHMARK_CARD and DBGA_BENCHMARK_CONTROL shall be set to run this benchmark");
+        return;
+    }
+
+    const std::size_t count = 1000;
+    ControlDeviceFactory factory;
+    std::unique_ptr<ControlDevice> device = factory.newControlDevice(card);
+
+    Buffer value;
+    double readLatency = measureLatency(count, [&] { device->ctlRead(control, value); });
+    double writeLatency = measureLatency(count, [&] { device->ctlWrite(control, value); });
+    double countLatency = measureLatency(count, [&] { device->getControlCountByTag(control); });
+
+    std::cout << "Control device mean latency over " << count << " accesses to " << control
+              << ":\n"
+              << "    ctlRead:              " << readLatency << " us\n"
+              << "    ctlWrite:             " << writeLatency << " us\n"
+              << "    getControlCountByTag: " << countLatency << " us" << std::endl;
+}
@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2016, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "cAVS/Linux/CorePowerVoter.hpp"
+#include "cAVS/Linux/DriverTypes.hpp"
+#include "Util/Exception.hpp"
+#include "TestCommon/TestHelpers.hpp"
+#include <catch.hpp>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace debug_agent::cavs::linux;
+using namespace debug_agent::util;
+
+namespace
+{
+struct CorePowerVoterTest;
+using VoterException = Exception<CorePowerVoterTest>;
+using Voter = CorePowerVoter<VoterException>;
+
+/** Device recording the core power commands it receives */
+class CorePowerDevice : public Device
+{
+public:
+    ssize_t commandWrite(const std::string &name, const Buffer &bufferInput) override
+    {
+        /* Catch assertions are not thread safe: reporting errors through exceptions */
+        if (name != driver::corePowerCtrl) {
+            throw Device::Exception("Unexpected debugfs entry: " + name);
+        }
+        std::lock_guard<std::mutex> locker(mMutex);
+        if (mFailing) {
+            throw Device::Exception("core power command failure");
+        }
+        mCommands.push_back(bufferInput);
+        return bufferInput.size();
+    }
+
+    void commandRead(const std::string &, const Buffer &, Buffer &) override
+    {
+        FAIL("Unexpected command read");
+    }
+
+    std::vector<Buffer> getCommands() const
+    {
+        std::lock_guard<std::mutex> locker(mMutex);
+        return mCommands;
+    }
+
+    void setFailing(bool failing)
+    {
+        std::lock_guard<std::mutex> locker(mMutex);
+        mFailing = failing;
+    }
+
+private:
+    mutable std::mutex mMutex;
+    std::vector<Buffer> mCommands;
+    bool mFailing = false;
+};
+
+const Buffer prevent = driver::CorePowerCommand(false, 0).getBuffer();
+const Buffer allow = driver::CorePowerCommand(true, 0).getBuffer();
+
+/** Wait until the device has received the expected command count, or a second has elapsed */
+void waitForCommandCount(const CorePowerDevice &device, std::size_t count)
+{
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    while (device.getCommands().size() < count && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+}
+
+TEST_CASE("CorePowerVoter: without idle timeout", "[CorePowerVoter]")
+{
+    CorePowerDevice device;
+    Voter voter(device);
+
+    SECTION ("Sequential votes are not coalesced") {
+        { Voter::Vote vote(voter); }
+        { Voter::Vote vote(voter); }
+        CHECK(device.getCommands() == (std::vector<Buffer>{prevent, allow, prevent, allow}));
+        CHECK(voter.getSavedToggleCount() == 0);
+    }
+
+    SECTION ("Overlapping votes are coalesced") {
+        {
+            Voter::Vote first(voter);
+            Voter::Vote second(voter);
+            Voter::Vote third(voter);
+            CHECK(device.getCommands() == (std::vector<Buffer>{prevent}));
+        }
+        CHECK(device.getCommands() == (std::vector<Buffer>{prevent, allow}));
+        CHECK(voter.getSavedToggleCount() == 4);
+    }
+
+    SECTION ("A failed vote is not counted") {
+        device.setFailing(true);
+        CHECK_THROWS_AS_MSG(Voter::Vote vote(voter), VoterException,
+                            "Error: could not set core power: core power command failure");
+        device.setFailing(false);
+
+        { Voter::Vote vote(voter); }
+        CHECK(device.getCommands() == (std::vector<Buffer>{prevent, allow}));
+    }
+}
+
+TEST_CASE("CorePowerVoter: with idle timeout", "[CorePowerVoter]")
+{
+    CorePowerDevice device;
+
+    SECTION ("The vote is held during a burst and released once idle") {
+        Voter voter(device, std::chrono::milliseconds(20));
+        for (int i = 0; i < 100; ++i) {
+            Voter::Vote vote(voter);
+        }
+        CHECK(voter.getSavedToggleCount() == 198);
+
+        waitForCommandCount(device, 2);
+        CHECK(device.getCommands() == (std::vector<Buffer>{prevent, allow}));
+
+        /* A new burst casts a new vote */
+        { Voter::Vote vote(voter); }
+        waitForCommandCount(device, 4);
+        CHECK(device.getCommands() == (std::vector<Buffer>{prevent, allow, prevent, allow}));
+    }
+
+    SECTION ("Votes are shared between threads") {
+        static const std::size_t threadCount = 4;
+        static const std::size_t voteCount = 1000;
+        {
+            Voter voter(device, std::chrono::seconds(10));
+            std::vector<std::thread> threads;
+            for (std::size_t i = 0; i < threadCount; ++i) {
+                threads.emplace_back([&voter] {
+                    for (std::size_t vote = 0; vote < voteCount; ++vote) {
+                        Voter::Vote scopedVote(voter);
+                    }
+                });
+            }
+            for (auto &thread : threads) {
+                thread.join();
+            }
+            CHECK(voter.getSavedToggleCount() == 2 * (threadCount * voteCount - 1));
+            CHECK(device.getCommands() == (std::vector<Buffer>{prevent}));
+        }
+        /* The pending vote is released on destruction */
+        CHECK(device.getCommands() == (std::vector<Buffer>{prevent, allow}));
+    }
+}
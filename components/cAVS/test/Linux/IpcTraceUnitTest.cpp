@@ -0,0 +1,243 @@
+/*
+ * Copyright (c) 2016, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "TestCommon/TestHelpers.hpp"
+#include "cAVS/Linux/IpcTrace.hpp"
+#include "cAVS/Linux/IpcTraceRecorder.hpp"
+#include "cAVS/Linux/TraceReplayDriverFactory.hpp"
+#include "cAVS/Linux/DeviceInjectionDriverFactory.hpp"
+#include "cAVS/Linux/MockedControlDeviceCommands.hpp"
+#include "cAVS/Linux/MockedDeviceCommands.hpp"
+#include "cAVS/Linux/MockedDeviceCatchHelper.hpp"
+#include "cAVS/Linux/MockedCompressDeviceFactory.hpp"
+#include "Util/FileHelper.hpp"
+#include <catch.hpp>
+#include <chrono>
+#include <unistd.h>
+
+using namespace debug_agent::cavs;
+using namespace debug_agent::util;
+using namespace debug_agent::cavs::linux;
+
+using Fixture = MockedDeviceFixture;
+
+/** Temporary trace file name, the file is removed on destruction */
+struct TemporaryTrace
+{
+    TemporaryTrace()
+    {
+        int fd = mkstemp(name);
+        REQUIRE(fd != -1);
+        ::close(fd);
+    }
+    ~TemporaryTrace() { unlink(name); }
+
+    char name[40] = "./tmpDbgaIpcTraceXXXXXX";
+};
+
+/** Add the config and module entries commands sent by the driver construction */
+static void addDriverConstructionCommands(MockedDeviceCommands &commands)
+{
+    const Buffer fwConfigTlvList{/* FW_VERSION: 1.2.3.4 */
+                                 0, 0, 0, 0, 8, 0, 0, 0, 1, 0, 2, 0, 3, 0, 4, 0,
+                                 /* MAX_PPL_CNT_FW_CFG: 3 */
+                                 9, 0, 0, 0, 4, 0, 0, 0, 3, 0, 0, 0,
+                                 /* MODULES_COUNT_FW_CFG: 2 */
+                                 12, 0, 0, 0, 4, 0, 0, 0, 2, 0, 0, 0,
+                                 /* MAX_MOD_INST_COUNT_FW_CFG: 3 */
+                                 13, 0, 0, 0, 4, 0, 0, 0, 3, 0, 0, 0};
+    const Buffer hwConfigTlvList{/* GATEWAY_COUNT_HW_CFG: 2 */
+                                 6, 0, 0, 0, 4, 0, 0, 0, 2, 0, 0, 0,
+                                 /* DSP_CORES_HW_CFG: 2 */
+                                 1, 0, 0, 0, 4, 0, 0, 0, 2, 0, 0, 0};
+
+    commands.addGetFwConfigCommand(dsp_fw::IxcStatus::ADSP_IPC_SUCCESS, fwConfigTlvList);
+    commands.addGetHwConfigCommand(dsp_fw::IxcStatus::ADSP_IPC_SUCCESS, hwConfigTlvList);
+
+    std::vector<dsp_fw::ModuleEntry> modules(2, dsp_fw::ModuleEntry{});
+    modules[1].module_id = 1;
+    commands.addGetModuleEntriesCommand(dsp_fw::IxcStatus::ADSP_IPC_SUCCESS, 2, modules);
+}
+
+/** Logging session, run on the recorded driver then on the replayed one */
+static void runLogSession(debug_agent::cavs::Driver &driver)
+{
+    using Logger = debug_agent::cavs::Logger;
+
+    Logger &logger = driver.getLogger();
+    Logger::Parameters inputParameters(true, Logger::Level::Verbose, Logger::Output::Sram);
+
+    CHECK_THROWS_AS_MSG(logger.setParameters(inputParameters), linux::Logger::Exception,
+                        "Failed to write the log level control: Control Device says that control "
+                        "Write has failed.");
+    CHECK_NOTHROW(logger.setParameters(inputParameters));
+
+    Logger::Parameters outputParameters;
+    CHECK_NOTHROW(outputParameters = logger.getParameters());
+    CHECK(outputParameters == inputParameters);
+}
+
+TEST_CASE("IPC trace: records are written then read back")
+{
+    TemporaryTrace trace;
+
+    IpcTraceRecord command(IpcTraceOperation::CommandRead, "/sys/kernel/debug/adsp/cmd");
+    command.timestamp = 12;
+    command.input = {1, 2, 3, 4};
+    command.output = Buffer(4096, 0);
+    command.output[0] = 7;
+    command.reply = Buffer(4096, 0);
+    command.reply[100] = 8;
+
+    IpcTraceRecord wait(IpcTraceOperation::CompressWait, "(0:5)");
+    wait.status = IpcTraceStatus::Interrupted;
+    wait.timestamp = 34;
+    wait.argument = CompressDevice::mInfiniteTimeout;
+
+    IpcTraceRecord loggers(IpcTraceOperation::LoggerDevices, "");
+    loggers.status = IpcTraceStatus::Failed;
+    loggers.devices = {{0, 5, 0}, {0, 6, 1}};
+
+    {
+        IpcTraceWriter writer(trace.name);
+        writer.write(command);
+        writer.write(wait);
+        writer.write(loggers);
+    }
+
+    IpcTraceReader reader(trace.name);
+    REQUIRE(reader.getRecords().size() == 3);
+    CHECK(reader.getRecords()[0] == command);
+    CHECK(reader.getRecords()[1] == wait);
+    CHECK(reader.getRecords()[2] == loggers);
+
+    /* The trailing zeros of the 4 KiB read buffers are not stored */
+    CHECK(file_helper::readAsBytes(trace.name).size() < 512);
+
+    /* A truncated last record is dropped */
+    Buffer content = file_helper::readAsBytes(trace.name);
+    content.resize(content.size() - 1);
+    file_helper::writeFromBytes(trace.name, content);
+    CHECK(IpcTraceReader(trace.name).getRecords().size() == 2);
+
+    file_helper::writeFromString(trace.name, "not a trace");
+    CHECK_THROWS_AS_MSG(IpcTraceReader{trace.name}, IpcTraceReader::Exception,
+                        "Not an IPC trace: " + std::string(trace.name));
+}
+
+TEST_CASE_METHOD(Fixture, "IPC trace: a recorded session is replayed")
+{
+    TemporaryTrace trace;
+
+    /* Recording a logging session on the mocked devices
+     * -------------------------------------------------- */
+    MockedDeviceCommands commands(*device);
+    addDriverConstructionCommands(commands);
+    commands.addSetCorePowerCommand(true, 0, false);
+    commands.addSetCorePowerCommand(true, 0, true);
+
+    MockedControlDeviceCommands controlCommands(*controlDevice);
+    controlCommands.addSetLogLevelCommand(false, mixer_ctl::LogPriority::Verbose);
+    controlCommands.addSetLogLevelCommand(true, mixer_ctl::LogPriority::Verbose);
+    controlCommands.addGetLogLevelCommand(true, mixer_ctl::LogPriority::Verbose);
+    /* The log is stopped on driver destruction */
+    controlCommands.addSetLogLevelCommand(true, mixer_ctl::LogPriority::Verbose);
+
+    auto compressDeviceFactory = std::make_unique<MockedCompressDeviceFactory>();
+    compressDevice->addSuccessfulCompressDeviceEntryOpen();
+    compressDevice->addSuccessfulCompressDeviceEntryStart();
+    compressDevice->addSuccessfulCompressDeviceEntryWait(CompressDevice::mInfiniteTimeout, false);
+    compressDevice->addSuccessfulCompressDeviceEntryStop();
+    compressDeviceFactory->addMockedDevice(std::move(compressDevice));
+
+    {
+        auto writer = std::make_shared<IpcTraceWriter>(trace.name);
+        DeviceInjectionDriverFactory recordingFactory(
+            std::make_unique<RecordingDevice>(std::move(device), writer),
+            std::make_unique<RecordingControlDevice>(std::move(controlDevice), writer),
+            std::make_unique<RecordingCompressDeviceFactory>(std::move(compressDeviceFactory),
+                                                             writer));
+        auto driver = recordingFactory.newDriver();
+        runLogSession(*driver);
+    }
+
+    /* The trace holds the config commands, the core power commands, the log level controls,
+     * the logger device queries and the compress operations */
+    const auto &records = IpcTraceReader(trace.name).getRecords();
+    CHECK(std::count_if(records.begin(), records.end(), [](const IpcTraceRecord &record) {
+              return record.operation == IpcTraceOperation::CommandRead;
+          }) == 3);
+    CHECK(std::count_if(records.begin(), records.end(), [](const IpcTraceRecord &record) {
+              return record.operation == IpcTraceOperation::CommandWrite;
+          }) == 8);
+    CHECK(std::count_if(records.begin(), records.end(), [](const IpcTraceRecord &record) {
+              return record.operation == IpcTraceOperation::ControlWrite &&
+                     record.status == IpcTraceStatus::Failed;
+          }) == 1);
+    CHECK(std::count_if(records.begin(), records.end(), [](const IpcTraceRecord &record) {
+              return record.operation == IpcTraceOperation::CompressCreate;
+          }) == 1);
+
+    /* Replaying the session
+     * --------------------- */
+    auto leftoverCheck = [] {
+        INFO("The trace has not been fully replayed");
+        CHECK(false);
+    };
+
+    SECTION ("As fast as possible") {
+        TraceReplayDriverFactory replayFactory(trace.name, 0, leftoverCheck);
+
+        /* Each driver replays the whole trace */
+        for (int run = 0; run < 2; ++run) {
+            auto driver = replayFactory.newDriver();
+            runLogSession(*driver);
+        }
+    }
+
+    SECTION ("At the original speed") {
+        TraceReplayDriverFactory replayFactory(trace.name, 1, leftoverCheck);
+        /* The compress operations of the log thread may be skipped by the stop, the last
+         * control access is always replayed */
+        uint64_t duration = 0;
+        for (const auto &record : records) {
+            if (record.operation == IpcTraceOperation::ControlWrite) {
+                duration = std::max(duration, record.timestamp);
+            }
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        {
+            auto driver = replayFactory.newDriver();
+            runLogSession(*driver);
+        }
+        CHECK(std::chrono::steady_clock::now() - start >= std::chrono::microseconds(duration));
+    }
+}
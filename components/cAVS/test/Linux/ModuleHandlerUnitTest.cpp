@@ -33,9 +33,16 @@
 #include "cAVS/Linux/MockedDeviceCommands.hpp"
 #include "cAVS/Linux/MockedDeviceCatchHelper.hpp"
 #include "cAVS/Linux/ModuleHandlerImpl.hpp"
+#include "cAVS/Linux/DriverTypes.hpp"
+#include "cAVS/Linux/Driver.hpp"
+#include "cAVS/Linux/SimulatedDevices.hpp"
 #include "cAVS/ModuleHandler.hpp"
 #include "Util/Buffer.hpp"
 #include <catch.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
 #include <memory>
 #include <iostream>
 #include <string.h>
@@ -270,6 +277,49 @@ TEST_CASE_METHOD(Fixture, "Module handler", "[module_handler]")
         CHECK(fwPipelineIdList == pipelineIds);
     }
 
+    SECTION ("Successive queries reuse the reply buffers") {
+        using ID = dsp_fw::PipeLineIdType;
+        static const std::vector<ID> fwPipelineIdList = {ID{1}, ID{2}, ID{3}};
+
+        commands.addGetPipelineListCommand(dsp_fw::IxcStatus::ADSP_IPC_SUCCESS,
+                                           fwPipelineIdList.size(), fwPipelineIdList);
+        commands.addGetPipelineListCommand(dsp_fw::IxcStatus::ADSP_IPC_SUCCESS,
+                                           fwPipelineIdList.size(), fwPipelineIdList);
+
+        CHECK(moduleHandler.getPipelineIdList() == fwPipelineIdList);
+        auto statistics = moduleHandler.getReplyPoolStatistics();
+
+        CHECK(moduleHandler.getPipelineIdList() == fwPipelineIdList);
+        CHECK(moduleHandler.getReplyPoolStatistics().allocationCount ==
+              statistics.allocationCount);
+        CHECK(moduleHandler.getReplyPoolStatistics().reuseCount == statistics.reuseCount + 1);
+    }
+
+    SECTION ("Failed queries give the reply buffers back") {
+        using ID = dsp_fw::PipeLineIdType;
+        static const std::vector<ID> fwPipelineIdList = {ID{1}, ID{2}, ID{3}};
+
+        commands.addGetPipelineListCommand(dsp_fw::IxcStatus::ADSP_IPC_SUCCESS,
+                                           fwPipelineIdList.size(), fwPipelineIdList);
+        /* A truncated reply cannot be decoded */
+        commands.addGetModuleParameterCommand(
+            dsp_fw::IxcStatus::ADSP_IPC_SUCCESS, dsp_fw::baseFirmwareModuleId,
+            dsp_fw::baseFirmwareInstanceId,
+            dsp_fw::ParameterId(dsp_fw::BaseFwParams::PIPELINE_LIST_INFO_GET),
+            dsp_fw::PipelinesListInfo::getAllocationSize(fwPipelineIdList.size()), Buffer{1});
+        commands.addGetPipelineListCommand(dsp_fw::IxcStatus::ADSP_IPC_SUCCESS,
+                                           fwPipelineIdList.size(), fwPipelineIdList);
+
+        CHECK(moduleHandler.getPipelineIdList() == fwPipelineIdList);
+        auto statistics = moduleHandler.getReplyPoolStatistics();
+
+        CHECK_THROWS_AS(moduleHandler.getPipelineIdList(), ModuleHandler::Exception);
+        CHECK(moduleHandler.getPipelineIdList() == fwPipelineIdList);
+        CHECK(moduleHandler.getReplyPoolStatistics().allocationCount ==
+              statistics.allocationCount);
+        CHECK(moduleHandler.getReplyPoolStatistics().reuseCount == statistics.reuseCount + 2);
+    }
+
     SECTION ("Getting pipeline props") {
         using PlID = dsp_fw::PipeLineIdType;
         static const PlID pipelineId{1};
@@ -400,3 +450,283 @@ TEST_CASE_METHOD(Fixture, "Module handler", "[module_handler]")
         CHECK(actualPerfItems == expectedPerfItems);
     }
 }
+
+/** The memory output stream as it was before the writers appended in place: the buffer is
+ * resized, i.e. zero-filled, before each value is copied, through a virtual call */
+class ResizingOutputStream : public OutputStream
+{
+public:
+    ResizingOutputStream(Buffer &buffer) : mBuffer(buffer) { buffer.clear(); }
+
+    void write(const StreamByte *src, std::size_t byteCount) override
+    {
+        std::size_t currentIndex = mBuffer.size();
+        mBuffer.resize(mBuffer.size() + byteCount);
+        std::copy(src, src + byteCount, mBuffer.begin() + currentIndex);
+    }
+
+private:
+    Buffer &mBuffer;
+};
+
+/** Measures the building of 'iterations' configGet requests using the supplied function, which
+ * serializes a request */
+template <typename WriteFunction>
+static double measureConfigGetRequest(std::size_t iterations, WriteFunction write)
+{
+    using driver::LargeConfigAccess;
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; ++i) {
+        LargeConfigAccess configAccess(LargeConfigAccess::CmdType::Get, 1, 2, 3, 1024);
+        write(configAccess);
+    }
+    std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+    return duration.count() * 1e9 / iterations;
+}
+
+TEST_CASE("Module handler: configGet request building benchmark", "[.][benchmark]")
+{
+    static const std::size_t iterations = 1000000;
+    std::size_t totalSize = 0;
+
+    double formerDuration =
+        measureConfigGetRequest(iterations, [&](const driver::LargeConfigAccess &configAccess) {
+            Buffer buffer;
+            ResizingOutputStream stream(buffer);
+            ByteStreamWriter writer(stream);
+            writer.write(configAccess);
+            totalSize += buffer.size();
+        });
+
+    double defaultDuration =
+        measureConfigGetRequest(iterations, [&](const driver::LargeConfigAccess &configAccess) {
+            MemoryByteStreamWriter writer;
+            writer.write(configAccess);
+            totalSize += writer.getBuffer().size();
+        });
+
+    double preallocatedDuration =
+        measureConfigGetRequest(iterations, [&](const driver::LargeConfigAccess &configAccess) {
+            MemoryByteStreamWriter writer(configAccess.getSerializedSize());
+            writer.write(configAccess);
+            totalSize += writer.getBuffer().size();
+        });
+
+    Buffer scratch;
+    double scratchDuration =
+        measureConfigGetRequest(iterations, [&](const driver::LargeConfigAccess &configAccess) {
+            BufferByteStreamWriter writer(scratch, configAccess.getSerializedSize());
+            writer.write(configAccess);
+            totalSize += scratch.size();
+        });
+
+    CHECK(totalSize == 4 * iterations * (4 + 8 + 8));
+    std::cout << "configGet request: former writer " << formerDuration << " ns, default writer "
+              << defaultDuration
+              << " ns, preallocated writer " << preallocatedDuration << " ns, scratch buffer "
+              << scratchDuration << " ns\n";
+}
+
+/** A driver on a simulated firmware, which is kept accessible to check its activity */
+struct SimulatedDriver
+{
+    SimulatedDriver(const SimulatedFirmware::Config &config,
+                    std::chrono::milliseconds corePowerIdleTimeout = std::chrono::milliseconds(0))
+        : firmware(std::make_shared<SimulatedFirmware>(config)),
+          driver(std::make_unique<SimulatedDevice>(firmware),
+                 std::make_unique<SimulatedControlDevice>(firmware),
+                 std::make_unique<SimulatedCompressDeviceFactory>(firmware), corePowerIdleTimeout)
+    {
+    }
+
+    std::shared_ptr<SimulatedFirmware> firmware;
+    linux::Driver driver;
+};
+
+/** Get the same module parameter from 'clientCount' concurrent clients, 'rounds' times each
+ * @return the payloads read by the clients */
+static std::vector<Buffer> getModuleParameterConcurrently(ModuleHandler &moduleHandler,
+                                                          std::size_t clientCount,
+                                                          std::size_t rounds)
+{
+    std::vector<std::future<Buffer>> clients;
+    for (std::size_t i = 0; i < clientCount; ++i) {
+        clients.push_back(std::async(std::launch::async, [&] {
+            Buffer payload;
+            for (std::size_t round = 0; round < rounds; ++round) {
+                payload = moduleHandler.getModuleParameter(2, 1, dsp_fw::ParameterId{42});
+            }
+            return payload;
+        }));
+    }
+    std::vector<Buffer> payloads;
+    for (auto &client : clients) {
+        payloads.push_back(client.get());
+    }
+    return payloads;
+}
+
+TEST_CASE("Module handler: concurrent identical config gets are merged", "[module_handler]")
+{
+    static const std::size_t clientCount = 4;
+    SimulatedFirmware::Config config;
+    /* Long enough for the clients to overlap */
+    config.ipcLatency = std::chrono::milliseconds(100);
+    SimulatedDriver simulated(config);
+    ModuleHandler &moduleHandler = simulated.driver.getModuleHandler();
+
+    const Buffer parameter{1, 2, 3, 4};
+    REQUIRE_NOTHROW(moduleHandler.setModuleParameter(2, 1, dsp_fw::ParameterId{42}, parameter));
+
+    /* Firmware ipcs of one get */
+    auto initialIpcCount = simulated.firmware->getStatistics().ipcCount;
+    CHECK(moduleHandler.getModuleParameter(2, 1, dsp_fw::ParameterId{42}) == parameter);
+    auto ipcPerGet = simulated.firmware->getStatistics().ipcCount - initialIpcCount;
+
+    auto initialStatistics = moduleHandler.getConfigGetStatistics();
+    initialIpcCount = simulated.firmware->getStatistics().ipcCount;
+
+    for (auto &payload : getModuleParameterConcurrently(moduleHandler, clientCount, 1)) {
+        CHECK(payload == parameter);
+    }
+
+    auto statistics = moduleHandler.getConfigGetStatistics();
+    std::size_t callCount = statistics.callCount - initialStatistics.callCount;
+    std::size_t mergedCount = statistics.mergedCount - initialStatistics.mergedCount;
+    CHECK(callCount + mergedCount == clientCount);
+    CHECK(mergedCount > 0);
+    /* Only the performed calls reach the firmware */
+    CHECK(simulated.firmware->getStatistics().ipcCount - initialIpcCount ==
+          callCount * ipcPerGet);
+
+    /* A get following a set returns the new value */
+    const Buffer newParameter{5, 6, 7, 8};
+    CHECK_NOTHROW(moduleHandler.setModuleParameter(2, 1, dsp_fw::ParameterId{42}, newParameter));
+    CHECK(moduleHandler.getModuleParameter(2, 1, dsp_fw::ParameterId{42}) == newParameter);
+
+    /* Failures are delivered to every merged request */
+    std::vector<std::future<void>> failing;
+    for (std::size_t i = 0; i < clientCount; ++i) {
+        failing.push_back(std::async(std::launch::async, [&] {
+            moduleHandler.getModuleParameter(2, 1, dsp_fw::ParameterId{43});
+        }));
+    }
+    for (auto &client : failing) {
+        CHECK_THROWS_AS(client.get(), ModuleHandler::Exception);
+    }
+}
+
+TEST_CASE("Module handler: multi-client config get benchmark", "[.][benchmark]")
+{
+    static const std::size_t rounds = 50;
+    SimulatedFirmware::Config config;
+    config.ipcLatency = std::chrono::microseconds(500);
+    SimulatedDriver simulated(config);
+    ModuleHandler &moduleHandler = simulated.driver.getModuleHandler();
+    moduleHandler.setModuleParameter(2, 1, dsp_fw::ParameterId{42}, Buffer(1024, 0xA5));
+
+    for (std::size_t clientCount : {1, 2, 4, 8, 16}) {
+        auto initialStatistics = moduleHandler.getConfigGetStatistics();
+        auto initialIpcCount = simulated.firmware->getStatistics().ipcCount;
+
+        auto start = std::chrono::steady_clock::now();
+        getModuleParameterConcurrently(moduleHandler, clientCount, rounds);
+        std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+
+        auto statistics = moduleHandler.getConfigGetStatistics();
+        std::size_t requestCount = clientCount * rounds;
+        CHECK(statistics.callCount + statistics.mergedCount - initialStatistics.callCount -
+                  initialStatistics.mergedCount ==
+              requestCount);
+        std::cout << clientCount << " clients: " << duration.count() * 1e6 / requestCount
+                  << " us per request, "
+                  << simulated.firmware->getStatistics().ipcCount - initialIpcCount
+                  << " firmware ipcs for " << requestCount << " requests, "
+                  << statistics.mergedCount - initialStatistics.mergedCount << " merged\n";
+    }
+}
+
+TEST_CASE("Module handler: IPCs are accounted to their scheduling class", "[module_handler]")
+{
+    SimulatedDriver simulated(SimulatedFirmware::Config{});
+    ModuleHandler &moduleHandler = simulated.driver.getModuleHandler();
+
+    /* The constructor reads the firmware and hardware configurations and the module entries */
+    CHECK(moduleHandler.getIpcStatistics(IpcClass::BulkIntrospection).requestCount == 3);
+    CHECK(moduleHandler.getIpcStatistics(IpcClass::InteractiveControl).requestCount == 0);
+
+    CHECK_NOTHROW(moduleHandler.getPipelineIdList());
+    CHECK(moduleHandler.getIpcStatistics(IpcClass::BulkIntrospection).requestCount == 4);
+
+    CHECK_NOTHROW(moduleHandler.setModuleParameter(2, 1, dsp_fw::ParameterId{42}, Buffer{1}));
+    CHECK_NOTHROW(moduleHandler.getModuleParameter(2, 1, dsp_fw::ParameterId{42}));
+    CHECK(moduleHandler.getIpcStatistics(IpcClass::InteractiveControl).requestCount == 2);
+
+    /* The class can be chosen by the caller */
+    CHECK_NOTHROW(moduleHandler.getPipelineIdList(IpcClass::BackgroundPolling));
+    CHECK(moduleHandler.getIpcStatistics(IpcClass::BackgroundPolling).requestCount == 1);
+    CHECK(moduleHandler.getIpcStatistics(IpcClass::BulkIntrospection).requestCount == 4);
+}
+
+TEST_CASE("Module handler: saved core power commands are reported", "[module_handler]")
+{
+    SECTION ("Without idle timeout, the votes of sequential commands are not coalesced") {
+        SimulatedDriver simulated(SimulatedFirmware::Config{});
+        ModuleHandler &moduleHandler = simulated.driver.getModuleHandler();
+        CHECK_NOTHROW(moduleHandler.getPipelineIdList());
+        CHECK(moduleHandler.getSavedCorePowerToggleCount() == 0);
+    }
+
+    SECTION ("Commands issued during the idle timeout reuse the vote") {
+        /* Long enough for the core to stay awake during the whole test */
+        SimulatedDriver simulated(SimulatedFirmware::Config{}, std::chrono::minutes(1));
+        ModuleHandler &moduleHandler = simulated.driver.getModuleHandler();
+
+        /* The constructor commands: the first one casts the vote, the two next ones reuse it */
+        CHECK(moduleHandler.getSavedCorePowerToggleCount() == 2 * 2);
+        CHECK_NOTHROW(moduleHandler.getPipelineIdList());
+        CHECK(moduleHandler.getSavedCorePowerToggleCount() == 3 * 2);
+    }
+}
+
+TEST_CASE("Module handler: interactive IPC latency under bulk load benchmark", "[.][benchmark]")
+{
+    static const std::size_t bulkClientCount = 4;
+    static const std::size_t interactiveCount = 50;
+    SimulatedFirmware::Config config;
+    config.ipcLatency = std::chrono::microseconds(500);
+    SimulatedDriver simulated(config);
+    ModuleHandler &moduleHandler = simulated.driver.getModuleHandler();
+
+    std::atomic<bool> loaded{true};
+    std::vector<std::future<void>> bulkClients;
+    for (std::size_t i = 0; i < bulkClientCount; ++i) {
+        bulkClients.push_back(std::async(std::launch::async, [&] {
+            while (loaded) {
+                moduleHandler.getPipelineIdList();
+            }
+        }));
+    }
+
+    std::chrono::duration<double> totalDuration{0};
+    std::chrono::duration<double> maxDuration{0};
+    for (std::size_t i = 0; i < interactiveCount; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        moduleHandler.setModuleParameter(2, 1, dsp_fw::ParameterId{42}, Buffer{1, 2, 3, 4});
+        std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+        totalDuration += duration;
+        maxDuration = std::max(maxDuration, duration);
+    }
+    loaded = false;
+    for (auto &client : bulkClients) {
+        client.get();
+    }
+
+    auto bulk = moduleHandler.getIpcStatistics(IpcClass::BulkIntrospection);
+    CHECK(moduleHandler.getIpcStatistics(IpcClass::InteractiveControl).requestCount ==
+          interactiveCount);
+    std::cout << "Parameter set under " << bulkClientCount << " bulk clients: mean "
+              << totalDuration.count() * 1e6 / interactiveCount << " us, max "
+              << maxDuration.count() * 1e6 << " us; bulk IPCs: " << bulk.requestCount
+              << ", mean wait " << bulk.totalWait.count() / bulk.requestCount << " us\n";
+}
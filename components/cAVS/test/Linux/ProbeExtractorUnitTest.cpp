@@ -0,0 +1,231 @@
+/*
+ * Copyright (c) 2016, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "TestCommon/TestHelpers.hpp"
+#include "cAVS/Linux/MockedCompressDevice.hpp"
+#include "cAVS/Linux/Probe/ExtractionInputStream.hpp"
+#include "cAVS/ProbeExtractor.hpp"
+#include <catch.hpp>
+#include <chrono>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <vector>
+
+using namespace debug_agent;
+using namespace debug_agent::cavs;
+using namespace debug_agent::cavs::linux;
+
+namespace
+{
+/** Size of the fragments read from the probe extraction compress device */
+const std::size_t fragmentSize = 4096;
+
+/** Synthetic extraction traffic: packets of several probes multiplexed in 4KiB fragments */
+struct ProbeTraffic
+{
+    struct ExpectedPacket
+    {
+        std::size_t probeIndex;
+        util::Buffer content;
+    };
+
+    /**
+     * @param[in] probeCount the count of multiplexed probes
+     * @param[in] packetCount the count of packets
+     * @param[in] corruptedPacket the index of a packet whose checksum is corrupted, if any
+     */
+    ProbeTraffic(std::size_t probeCount, std::size_t packetCount,
+                 std::size_t corruptedPacket = std::numeric_limits<std::size_t>::max())
+    {
+        util::Buffer stream;
+        for (std::size_t i = 0; i < packetCount; ++i) {
+            std::size_t probeIndex = i % probeCount;
+
+            dsp_fw::Packet packet;
+            packet.probePointId = {static_cast<uint32_t>(probeIndex), 0,
+                                   dsp_fw::ProbeType::Output, 0};
+            packet.format = 0;
+            packet.dspWallClockTsHw = 0;
+            packet.dspWallClockTsLw = static_cast<uint32_t>(i);
+            // Using various payload sizes to have packets spanning several fragments
+            packet.data.resize(64 + (i * 97) % 3000, static_cast<uint8_t>(i));
+
+            util::MemoryByteStreamWriter writer;
+            packet.toStream(writer);
+            stream.insert(stream.end(), writer.getBuffer().begin(), writer.getBuffer().end());
+
+            if (i == corruptedPacket) {
+                stream.back() ^= 0xFF;
+                corruptedPacketSize = writer.getBuffer().size();
+            } else {
+                util::MemoryByteStreamWriter expectedWriter;
+                packet.toStream<uint32_t>(expectedWriter);
+                expectedPackets.push_back({probeIndex, expectedWriter.getBuffer()});
+            }
+
+            probePointMap[packet.probePointId] = ProbeId(static_cast<uint32_t>(probeIndex));
+        }
+
+        for (std::size_t offset = 0; offset < stream.size(); offset += fragmentSize) {
+            std::size_t size = std::min(fragmentSize, stream.size() - offset);
+            fragments.emplace_back(stream.begin() + offset, stream.begin() + offset + size);
+        }
+        byteCount = stream.size();
+    }
+
+    /** Feed the mocked device with the fragments, then make the stream reach its end */
+    void feed(MockedCompressDevice &device) const
+    {
+        device.addSuccessfulCompressDeviceEntryOpen();
+        device.addSuccessfulCompressDeviceEntryStart();
+        for (const auto &fragment : fragments) {
+            device.addSuccessfulCompressDeviceEntryWait(0, true);
+            device.addSuccessfulCompressDeviceEntryRead(fragment, fragment.size());
+        }
+        device.addSuccessfulCompressDeviceEntryWait(0, false);
+        device.addSuccessfulCompressDeviceEntryStop();
+    }
+
+    ProbeExtractor::ProbePointMap probePointMap;
+    std::vector<util::Buffer> fragments;
+    std::vector<ExpectedPacket> expectedPackets;
+    std::size_t byteCount;
+    std::size_t corruptedPacketSize = 0;
+};
+
+std::unique_ptr<MockedCompressDevice> makeDevice()
+{
+    return std::make_unique<MockedCompressDevice>(compress::DeviceInfo{0, 7}, [] {
+        INFO("There are leftover test inputs");
+        CHECK(false);
+    });
+}
+}
+
+TEST_CASE("ProbeExtractor: demultiplexing packets from compress device fragments", "[prober]")
+{
+    const std::size_t probeCount = 3;
+    const ProbeTraffic traffic(probeCount, 50);
+
+    auto device = makeDevice();
+    traffic.feed(*device);
+
+    ProbeExtractor::BlockingExtractionQueues queues;
+    for (std::size_t i = 0; i < probeCount; ++i) {
+        queues.emplace_back(1024 * 1024, [](const util::Buffer &buffer) { return buffer.size(); });
+        queues.back().open();
+    }
+
+    {
+        ProbeExtractor extractor(queues, traffic.probePointMap,
+                                 std::make_unique<ExtractionInputStream>(std::move(device)));
+
+        // Each probe queue receives its packets in order
+        for (const auto &expected : traffic.expectedPackets) {
+            auto packet = queues[expected.probeIndex].remove();
+            REQUIRE(packet != nullptr);
+            CHECK(*packet == expected.content);
+        }
+    }
+
+    for (auto &queue : queues) {
+        CHECK(queue.getElementCount() == 0);
+    }
+}
+
+TEST_CASE("ProbeExtractor: resynchronization after a corrupted packet", "[prober]")
+{
+    const std::size_t probeCount = 3;
+    const std::size_t corruptedPacket = 20;
+    const ProbeTraffic traffic(probeCount, 50, corruptedPacket);
+
+    auto device = makeDevice();
+    traffic.feed(*device);
+
+    ProbeExtractor::BlockingExtractionQueues queues;
+    for (std::size_t i = 0; i < probeCount; ++i) {
+        queues.emplace_back(1024 * 1024, [](const util::Buffer &buffer) { return buffer.size(); });
+        queues.back().open();
+    }
+
+    ProbeExtractor extractor(queues, traffic.probePointMap,
+                             std::make_unique<ExtractionInputStream>(std::move(device)));
+
+    // The corrupted packet is dropped, the extraction goes on with the next packets
+    for (const auto &expected : traffic.expectedPackets) {
+        auto packet = queues[expected.probeIndex].remove();
+        REQUIRE(packet != nullptr);
+        CHECK(*packet == expected.content);
+    }
+
+    for (std::size_t probeIndex = 0; probeIndex < probeCount; ++probeIndex) {
+        auto statistics = extractor.getResyncStatistics(ProbeId(probeIndex));
+        if (probeIndex == corruptedPacket % probeCount) {
+            CHECK(statistics.resyncCount == 1);
+            CHECK(statistics.discardedByteCount == traffic.corruptedPacketSize);
+        } else {
+            CHECK(statistics.resyncCount == 0);
+            CHECK(statistics.discardedByteCount == 0);
+        }
+    }
+    CHECK(extractor.getUnattributedResyncStatistics().resyncCount == 0);
+}
+
+TEST_CASE("ProbeExtractor: throughput benchmark", "[.][benchmark]")
+{
+    const std::size_t probeCount = 8;
+    const ProbeTraffic traffic(probeCount, 20000);
+
+    auto device = makeDevice();
+    traffic.feed(*device);
+
+    ProbeExtractor::BlockingExtractionQueues queues;
+    for (std::size_t i = 0; i < probeCount; ++i) {
+        queues.emplace_back(traffic.byteCount,
+                            [](const util::Buffer &buffer) { return buffer.size(); });
+        queues.back().open();
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    {
+        ProbeExtractor extractor(queues, traffic.probePointMap,
+                                 std::make_unique<ExtractionInputStream>(std::move(device)));
+        for (const auto &expected : traffic.expectedPackets) {
+            REQUIRE(queues[expected.probeIndex].remove() != nullptr);
+        }
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::cout << "Probe extraction: " << traffic.byteCount << " bytes, "
+              << traffic.expectedPackets.size() << " packets, " << probeCount << " probes in "
+              << elapsed.count() << " s ("
+              << traffic.byteCount / elapsed.count() / (1024 * 1024) << " MiB/s)" << std::endl;
+}
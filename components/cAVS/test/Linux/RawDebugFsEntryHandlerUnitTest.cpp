@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2016, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "cAVS/Linux/RawDebugFsEntryHandler.hpp"
+#include "cAVS/Linux/DebugFsEntryHandler.hpp"
+#include "cAVS/Linux/SystemDevice.hpp"
+#include "TestCommon/TestHelpers.hpp"
+#include <catch.hpp>
+#include <chrono>
+#include <memory>
+#include <iostream>
+#include <string>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace debug_agent::cavs::linux;
+using namespace debug_agent::util;
+
+/** Temporary file standing for a debugfs entry, removed on destruction */
+struct TemporaryEntry
+{
+    TemporaryEntry(const std::string &content)
+    {
+        int fd = mkstemp(name);
+        REQUIRE(fd != -1);
+        REQUIRE(::write(fd, content.data(), content.size()) ==
+                static_cast<ssize_t>(content.size()));
+        ::close(fd);
+    }
+    ~TemporaryEntry() { unlink(name); }
+
+    std::string content() const
+    {
+        char buffer[64];
+        int fd = ::open(name, O_RDONLY);
+        REQUIRE(fd != -1);
+        ssize_t size = ::read(fd, buffer, sizeof(buffer));
+        ::close(fd);
+        REQUIRE(size >= 0);
+        return std::string(buffer, size);
+    }
+
+    char name[40] = "./tmpDbgaRawDebugFsEntryXXXXXX";
+};
+
+TEST_CASE("RawDebugFsEntryHandler: testing interface of the real RawDebugFsEntryHandler")
+{
+    RawDebugFsEntryHandler handler;
+    TemporaryEntry entry("0123456789");
+    ssize_t nbBytes = 0;
+    Buffer bufferRead(20, 0xff);
+
+    CHECK_THROWS_AS_MSG(handler.read(bufferRead, bufferRead.size()), FileEntryHandler::Exception,
+                        "Illegal read operation on closed file");
+    CHECK_THROWS_AS_MSG(handler.write(Buffer{1}), FileEntryHandler::Exception,
+                        "Illegal write operation on closed file");
+
+    CHECK_NOTHROW(handler.open(entry.name));
+    CHECK_THROWS_AS_MSG(handler.open(entry.name), FileEntryHandler::Exception,
+                        "Parallel operation not permitted on same debugfs entry: " +
+                            std::string(entry.name));
+
+    /* Reading less than requested is not an error */
+    CHECK_NOTHROW(nbBytes = handler.read(bufferRead, bufferRead.size()));
+    CHECK(nbBytes == 10);
+    CHECK(std::string(bufferRead.begin(), bufferRead.begin() + nbBytes) == "0123456789");
+
+    /* Commands are always written and read at the beginning of the entry */
+    CHECK(handler.write(Buffer{'a', 'b', 'c'}) == 3);
+    CHECK_NOTHROW(nbBytes = handler.read(bufferRead, 4));
+    CHECK(nbBytes == 4);
+    CHECK(std::string(bufferRead.begin(), bufferRead.begin() + nbBytes) == "abc3");
+    CHECK_NOTHROW(handler.close());
+
+    /* The entry stays open: it is still usable after having been removed */
+    std::string name(entry.name);
+    unlink(entry.name);
+    CHECK_NOTHROW(handler.open(name));
+    CHECK(handler.write(Buffer{'d'}) == 1);
+    CHECK_NOTHROW(handler.close());
+
+    /* But an unknown entry is opened on first use */
+    CHECK_THROWS_AS_MSG(handler.open(name + "unknown"), FileEntryHandler::Exception,
+                        "error while opening debugfs " + name + "unknown file.");
+}
+
+TEST_CASE("RawDebugFsEntryHandler: commands through SystemDevice")
+{
+    TemporaryEntry first("first entry");
+    TemporaryEntry second("second entry");
+    SystemDevice device(std::make_unique<RawDebugFsEntryHandler>());
+
+    Buffer answer(5);
+    CHECK(device.commandWrite(first.name, Buffer{'1', '1'}) == 2);
+    CHECK_NOTHROW(device.commandRead(second.name, Buffer{'2', '2'}, answer));
+    CHECK(answer == (Buffer{'2', '2', 'c', 'o', 'n'}));
+    CHECK_NOTHROW(device.commandRead(first.name, Buffer{'3'}, answer));
+    CHECK(answer == (Buffer{'3', '1', 'r', 's', 't'}));
+
+    CHECK(first.content() == "31rst entry");
+    CHECK(second.content() == "22cond entry");
+
+    CHECK_THROWS_AS_MSG(device.commandWrite("/nonexistent/debugfs/entry", Buffer{1}),
+                        Device::Exception, "DebugFs handler returns an exception: error while "
+                                           "opening debugfs /nonexistent/debugfs/entry file.");
+}
+
+namespace
+{
+/** @return the mean latency of a command read, in microseconds */
+double measureCommandLatency(std::unique_ptr<FileEntryHandler> handler, const char *name,
+                             std::size_t commandCount)
+{
+    SystemDevice device(std::move(handler));
+    const Buffer command(16, 0x42);
+    Buffer answer(16);
+
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < commandCount; ++i) {
+        device.commandRead(name, command, answer);
+    }
+    std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / commandCount;
+}
+}
+
+TEST_CASE("RawDebugFsEntryHandler: command latency benchmark", "[.][benchmark]")
+{
+    const std::size_t commandCount = 100000;
+    TemporaryEntry entry(std::string(64, '0'));
+
+    double fstreamLatency =
+        measureCommandLatency(std::make_unique<DebugFsEntryHandler>(), entry.name, commandCount);
+    double rawLatency =
+        measureCommandLatency(std::make_unique<RawDebugFsEntryHandler>(), entry.name, commandCount);
+
+    std::cout << "SystemDevice::commandRead mean latency over " << commandCount << " commands:\n"
+              << "    DebugFsEntryHandler:    " << fstreamLatency << " us\n"
+              << "    RawDebugFsEntryHandler: " << rawLatency << " us" << std::endl;
+}
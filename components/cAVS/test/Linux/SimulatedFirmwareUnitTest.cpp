@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2016, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "TestCommon/TestHelpers.hpp"
+#include "cAVS/Linux/SimulatedFirmware.hpp"
+#include "cAVS/Linux/SimulatedDevices.hpp"
+#include "cAVS/Linux/SimulatedDriverFactory.hpp"
+#include "cAVS/System.hpp"
+#include "Util/ByteStreamReader.hpp"
+#include <catch.hpp>
+#include <set>
+
+using namespace debug_agent::cavs;
+using namespace debug_agent::util;
+using namespace debug_agent::cavs::linux;
+
+TEST_CASE("Simulated firmware: configuration parsing")
+{
+    SimulatedFirmware::Config config;
+    CHECK_NOTHROW(config = SimulatedFirmware::Config::fromString(""));
+    CHECK(config.coreCount == 2);
+    CHECK(config.pipelineCount == 4);
+
+    CHECK_NOTHROW(config = SimulatedFirmware::Config::fromString(
+                      "cores=4,pipelines=16,modulesPerPipeline=5,latencyUs=100,jitterUs=20"));
+    CHECK(config.coreCount == 4);
+    CHECK(config.pipelineCount == 16);
+    CHECK(config.modulesPerPipeline == 5);
+    CHECK(config.ipcLatency == std::chrono::microseconds(100));
+    CHECK(config.jitter == std::chrono::microseconds(20));
+    CHECK(config.logRate == SimulatedFirmware::Config().logRate);
+
+    CHECK_THROWS_AS_MSG(SimulatedFirmware::Config::fromString("cores"),
+                        SimulatedFirmware::Exception,
+                        "Invalid simulation parameter 'cores': expecting key=value");
+    CHECK_THROWS_AS_MSG(SimulatedFirmware::Config::fromString("cores=two"),
+                        SimulatedFirmware::Exception,
+                        "Invalid value of simulation parameter 'cores': two");
+    CHECK_THROWS_AS_MSG(SimulatedFirmware::Config::fromString("dsps=2"),
+                        SimulatedFirmware::Exception, "Unknown simulation parameter: dsps");
+    CHECK_THROWS_AS_MSG(SimulatedFirmware::Config::fromString("cores=0"),
+                        SimulatedFirmware::Exception,
+                        "Simulation parameter cores out of range: 0 not in [1, 8]");
+    CHECK_THROWS_AS_MSG(SimulatedFirmware::Config::fromString("pipelines=100"),
+                        SimulatedFirmware::Exception,
+                        "Simulation parameter pipelines out of range: 100 not in [1, 80]");
+
+    /* Invalid configurations are reported by the driver factory */
+    config = SimulatedFirmware::Config();
+    config.coreCount = 0;
+    SimulatedDriverFactory factory(config);
+    CHECK_THROWS_AS_MSG(factory.newDriver(), DriverFactory::Exception,
+                        "Cannot simulate firmware: Simulation parameter cores out of range: 0 "
+                        "not in [1, 8]");
+}
+
+TEST_CASE("Simulated firmware: topology")
+{
+    SimulatedFirmware::Config config;
+    config.coreCount = 3;
+    config.pipelineCount = 5;
+    config.modulesPerPipeline = 4;
+    SimulatedDriverFactory factory(config);
+
+    std::unique_ptr<System> system;
+    REQUIRE_NOTHROW(system = std::make_unique<System>(factory));
+
+    Topology topology;
+    REQUIRE_NOTHROW(system->getTopology(topology));
+    CHECK(topology.pipelines.size() == 5);
+    CHECK(topology.schedulers.size() == 3);
+    CHECK(topology.gateways.size() == 10);
+    CHECK(topology.moduleInstances.size() == 20);
+    /* Each pipeline is a chain of modules */
+    CHECK(topology.links.size() == 15);
+
+    /* Module parameters are stored */
+    ModuleHandler &handler = system->getModuleHandler();
+    const Buffer parameter{1, 2, 3, 4, 5};
+    Buffer read;
+    CHECK_NOTHROW(handler.setModuleParameter(2, 1, dsp_fw::ParameterId{42}, parameter));
+    CHECK_NOTHROW(read = handler.getModuleParameter(2, 1, dsp_fw::ParameterId{42}));
+    CHECK(read == parameter);
+    CHECK_THROWS_AS(handler.getModuleParameter(2, 1, dsp_fw::ParameterId{43}),
+                    ModuleHandler::Exception);
+}
+
+TEST_CASE("Simulated firmware: log and probe streams")
+{
+    SimulatedFirmware::Config config;
+    config.logRate = 2000;
+    config.logFragmentSize = 512;
+    config.probeRate = 2000;
+    SimulatedDriverFactory factory(config);
+
+    std::unique_ptr<debug_agent::cavs::Driver> driver;
+    REQUIRE_NOTHROW(driver = factory.newDriver());
+
+    /* Log blocks are produced by each core */
+    using Logger = debug_agent::cavs::Logger;
+    Logger &logger = driver->getLogger();
+    REQUIRE_NOTHROW(logger.setParameters(
+        Logger::Parameters(true, Logger::Level::Verbose, Logger::Output::Sram)));
+
+    std::set<unsigned int> coreIds;
+    for (int i = 0; i < 100 && coreIds.size() < config.coreCount; ++i) {
+        std::unique_ptr<LogBlock> block = logger.readLogBlock();
+        REQUIRE(block != nullptr);
+        REQUIRE(block->getLogData().size() >= config.logFragmentSize);
+
+        /* Fragment header: wall clock then core id */
+        MemoryByteStreamReader reader(block->getLogData());
+        uint64_t wallClock;
+        uint32_t coreId;
+        reader.read(wallClock);
+        reader.read(coreId);
+        CHECK(coreId == block->getCoreId());
+        coreIds.insert(coreId);
+    }
+    CHECK(coreIds.size() == config.coreCount);
+    CHECK_NOTHROW(logger.setParameters(
+        Logger::Parameters(false, Logger::Level::Verbose, Logger::Output::Sram)));
+
+    /* Probe packets are extracted from the connected probe */
+    using Prober = debug_agent::cavs::Prober;
+    Prober &prober = driver->getProber();
+    Prober::SessionProbes probes(prober.getMaxProbeCount(),
+                                 {false, {0, 0, dsp_fw::ProbeType::Input, 0},
+                                  Prober::ProbePurpose::Extract});
+    probes[0] = {true, {1, 0, dsp_fw::ProbeType::Output, 0}, Prober::ProbePurpose::Extract};
+    CHECK_NOTHROW(prober.setProbesConfig(probes, {}));
+    REQUIRE_NOTHROW(prober.setState(true));
+
+    std::unique_ptr<Buffer> extracted;
+    REQUIRE_NOTHROW(extracted = prober.dequeueExtractionBlock(ProbeId{0}));
+    REQUIRE(extracted != nullptr);
+    CHECK(!extracted->empty());
+    CHECK_NOTHROW(prober.setState(false));
+}
+
+TEST_CASE("Simulated firmware: probe injection")
+{
+    SimulatedFirmware::Config config;
+    config.injectionRate = 1000 * 1000;
+    auto firmware = std::make_shared<SimulatedFirmware>(config);
+    SimulatedCompressDeviceFactory factory(firmware);
+
+    auto injectors = factory.getInjectionProbeDeviceInfoList();
+    REQUIRE(injectors.size() == config.injectionProbeCount);
+    std::unique_ptr<CompressDevice> device = factory.newCompressDevice(injectors[0]);
+
+    compress::Config deviceConfig(1024, 4);
+    CHECK_THROWS_AS(device->open(Mode::NonBlocking, compress::Role::Capture, deviceConfig),
+                    CompressDevice::Exception);
+    REQUIRE_NOTHROW(device->open(Mode::NonBlocking, compress::Role::Playback, deviceConfig));
+
+    /* The buffer is filled then drained by the firmware */
+    CHECK(device->getAvailable() == 4096);
+    CHECK(device->write(Buffer(5000, 0)) == 4096);
+    CHECK(device->getAvailable() == 0);
+    REQUIRE_NOTHROW(device->start());
+    CHECK(device->wait(CompressDevice::mInfiniteTimeout));
+    CHECK(device->getAvailable() >= 1024);
+    CHECK(firmware->getStatistics().injectedByteCount >= 1024);
+
+    /* A stopped device does not wait */
+    device->stop();
+    CHECK_THROWS_AS(device->wait(CompressDevice::mInfiniteTimeout), CompressDevice::IoException);
+    device->close();
+
+    /* Unknown devices are not simulated */
+    CHECK_THROWS_AS(factory.newCompressDevice(compress::DeviceInfo(0, 100)),
+                    CompressDeviceFactory::Exception);
+}
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2016, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cAVS/Linux/SimulatedDriverFactory.hpp"
+#include "cAVS/System.hpp"
+#include <catch.hpp>
+
+using namespace debug_agent::cavs;
+using namespace debug_agent::cavs::linux;
+
+/** @return the pipeline of the supplied id */
+static dsp_fw::PplProps &findPipeline(Topology &topology, uint32_t pipelineId)
+{
+    for (auto &pipeline : topology.pipelines) {
+        if (pipeline.id.getValue() == pipelineId) {
+            return pipeline;
+        }
+    }
+    throw std::logic_error("Unknown pipeline " + std::to_string(pipelineId));
+}
+
+/** @return the task of the supplied id, the simulated firmware has one scheduler per core */
+static dsp_fw::TaskProps &findTask(Topology &topology, uint32_t taskId)
+{
+    for (auto &info : topology.schedulers) {
+        for (auto &task : info.scheduler_info[0].task_info) {
+            if (task.task_id == taskId) {
+                return task;
+            }
+        }
+    }
+    throw std::logic_error("Unknown task " + std::to_string(taskId));
+}
+
+TEST_CASE("Topology refresh: only the module instances of changed pipelines and tasks are read")
+{
+    SimulatedFirmware::Config config;
+    config.coreCount = 2;
+    config.pipelineCount = 4;
+    config.modulesPerPipeline = 3;
+    SimulatedDriverFactory factory(config);
+    System system(factory);
+
+    Topology full;
+    REQUIRE_NOTHROW(system.getTopology(full));
+    std::size_t instanceCount = full.moduleInstances.size();
+    /* Gateways, pipeline list, pipelines, schedulers and module instances */
+    std::size_t fullIpcCount = 2 + config.pipelineCount + config.coreCount + instanceCount;
+
+    /* An empty topology is fully retrieved */
+    Topology topology;
+    System::TopologyRefreshStatistics statistics;
+    REQUIRE_NOTHROW(statistics = system.refreshTopology(topology));
+    CHECK(statistics.refreshCount == 1);
+    CHECK(statistics.ipcCount == fullIpcCount);
+    CHECK(statistics.savedIpcCount == 0);
+    CHECK(topology == full);
+
+    /* Unchanged topology: the module instances are kept */
+    REQUIRE_NOTHROW(statistics = system.refreshTopology(topology));
+    CHECK(statistics.ipcCount == fullIpcCount - instanceCount);
+    CHECK(statistics.savedIpcCount == instanceCount);
+    CHECK(topology == full);
+
+    /* Altering the previous topology to make the firmware one look changed */
+    auto &changedPipeline = findPipeline(topology, 0);
+    ++changedPipeline.priority;
+    auto changedPipelineInstance = changedPipeline.module_instances[0];
+    topology.moduleInstances[changedPipelineInstance].cpc = 0xDEAD;
+
+    auto &changedTask = findTask(topology, 1);
+    changedTask.module_instance_id.pop_back();
+    auto changedTaskInstance = findPipeline(topology, 1).module_instances[0];
+    topology.moduleInstances[changedTaskInstance].cpc = 0xDEAD;
+
+    /* Module instances of unchanged pipelines and tasks are assumed unchanged */
+    auto unchangedInstance = findPipeline(topology, 2).module_instances[0];
+    topology.moduleInstances[unchangedInstance].cpc = 0xDEAD;
+
+    REQUIRE_NOTHROW(statistics = system.refreshTopology(topology));
+    CHECK(statistics.savedIpcCount == instanceCount - 2 * config.modulesPerPipeline);
+    CHECK(statistics.ipcCount == fullIpcCount - statistics.savedIpcCount);
+    CHECK(topology.pipelines == full.pipelines);
+    CHECK(topology.schedulers == full.schedulers);
+    CHECK(topology.moduleInstances[changedPipelineInstance] ==
+          full.moduleInstances[changedPipelineInstance]);
+    CHECK(topology.moduleInstances[changedTaskInstance] ==
+          full.moduleInstances[changedTaskInstance]);
+    CHECK(topology.moduleInstances[unchangedInstance].cpc == 0xDEAD);
+
+    /* Cumulated statistics */
+    auto total = system.getTopologyRefreshStatistics();
+    CHECK(total.refreshCount == 4);
+    CHECK(total.savedIpcCount == 2 * instanceCount - 2 * config.modulesPerPipeline);
+}
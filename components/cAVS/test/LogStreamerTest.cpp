@@ -30,10 +30,17 @@
 #include <cAVS/LogStreamer.hpp>
 #include <System/IfdkStreamHeader.hpp>
 #include <TestCommon/TestHelpers.hpp>
+#include "Util/BlockingQueue.hpp"
 #include "catch.hpp"
 #include <ostream>
 #include <sstream>
+#include <streambuf>
 #include <string>
+#include <future>
+#include <thread>
+#include <chrono>
+#include <limits>
+#include <iostream>
 
 using namespace debug_agent::cavs;
 using namespace debug_agent::system;
@@ -86,6 +93,8 @@ public:
         }
     }
 
+    virtual debug_agent::util::QueueStatistics getQueueStatistics() const override { return {}; }
+
     virtual void stop() noexcept override {}
 
     static std::unique_ptr<LogBlock> generateLogBlock(size_t blockNumber)
@@ -105,6 +114,88 @@ public:
     Parameters mMockedParameter;
 };
 
+/** Logger whose blocks are queued in a util::BlockingQueue, like the Linux and Windows loggers.
+ * If batch reading is disabled, the default cavs::Logger::readLogBlocks() implementation, which
+ * returns one block per call, is used. Consumed blocks are given back to the pool. */
+class QueueLoggerMock : public Logger
+{
+public:
+    QueueLoggerMock(bool batchReading)
+        : mPool(queueMaxMemoryBytes),
+          mQueue(queueMaxMemoryBytes, [](const LogBlock &block) { return block.getLogSize(); }),
+          mBatchReading(batchReading)
+    {
+        mQueue.setRecycler(debug_agent::util::PoolRecycler<LogBlock>(mPool));
+        mQueue.open();
+    }
+
+    virtual void setParameters(const Parameters &) override {}
+
+    virtual Logger::Parameters getParameters() override { return {}; }
+
+    virtual std::unique_ptr<LogBlock> readLogBlock() override
+    {
+        ++mReadCount;
+        return mQueue.remove();
+    }
+
+    virtual std::vector<std::unique_ptr<LogBlock>> readLogBlocks(std::size_t maxByteSize) override
+    {
+        if (not mBatchReading) {
+            return Logger::readLogBlocks(maxByteSize);
+        }
+        ++mReadCount;
+        return mQueue.removeUpTo(maxByteSize, std::numeric_limits<std::size_t>::max());
+    }
+
+    virtual void recycleLogBlocks(std::vector<std::unique_ptr<LogBlock>> &blocks) override
+    {
+        mPool.release(blocks);
+    }
+
+    virtual debug_agent::util::QueueStatistics getQueueStatistics() const override
+    {
+        return mQueue.getStatistics();
+    }
+
+    virtual void stop() noexcept override { mQueue.close(); }
+
+    static const std::size_t queueMaxMemoryBytes = 10 * 1024 * 1024;
+
+    LogBlockPool mPool;
+    debug_agent::util::BlockingQueue<LogBlock, debug_agent::util::PoolRecycler<LogBlock>> mQueue;
+    const bool mBatchReading;
+    /** Count of blocking reads, i.e. of consumer wake-ups */
+    std::size_t mReadCount = 0;
+};
+
+/** Stream buffer that drops the written data, counting the flushes (i.e. the socket writes) */
+class FlushCountingStreamBuf : public std::streambuf
+{
+public:
+    std::size_t mFlushCount = 0;
+    std::size_t mByteCount = 0;
+
+protected:
+    int_type overflow(int_type c) override
+    {
+        ++mByteCount;
+        return traits_type::not_eof(c);
+    }
+
+    std::streamsize xsputn(const char_type *, std::streamsize count) override
+    {
+        mByteCount += count;
+        return count;
+    }
+
+    int sync() override
+    {
+        ++mFlushCount;
+        return 0;
+    }
+};
+
 void initFakeModuleEntries(std::vector<dsp_fw::ModuleEntry> &moduleEntries, size_t nbEntries)
 {
     for (size_t i = 0; i < nbEntries; ++i) {
@@ -215,3 +306,109 @@ TEST_CASE("Test module entries to stream", "[streaming]")
 
     CHECK(outStream.str() == expectedOutStream.str());
 }
+
+TEST_CASE("Test IFDK cAVS Log stream with batch reading", "[stream]")
+{
+    std::vector<dsp_fw::ModuleEntry> moduleEntries;
+    QueueLoggerMock logger(true);
+    LogStreamer logStreamer(logger, moduleEntries);
+
+    std::stringstream expectedOutStream;
+    const IfdkStreamHeader logIfdkHeader(systemType, formatType, majorVersion, minorVersion);
+    expectedOutStream << logIfdkHeader;
+    uint32_t moduleEntryCount = 0;
+    expectedOutStream.write(reinterpret_cast<const char *>(&moduleEntryCount),
+                            sizeof(moduleEntryCount));
+
+    // Queuing all blocks before streaming: they are read at once
+    for (size_t i = 0; i < 50; ++i) {
+        expectedOutStream << *TestLoggerMock::generateLogBlock(i);
+        REQUIRE(logger.mQueue.add(TestLoggerMock::generateLogBlock(i)));
+    }
+    logger.stop();
+
+    std::stringstream outStream;
+    outStream << logStreamer;
+
+    CHECK(outStream.str() == expectedOutStream.str());
+    // One read for the whole queue content, one read to detect the closing
+    CHECK(logger.mReadCount == 2);
+}
+
+TEST_CASE("Test IFDK cAVS Log stream with pooled log blocks", "[stream]")
+{
+    static const std::size_t blockCount = 50000;
+    static const std::size_t blockSize = 2048;
+
+    std::vector<dsp_fw::ModuleEntry> moduleEntries;
+    QueueLoggerMock logger(true);
+    LogStreamer logStreamer(logger, moduleEntries);
+
+    auto producer = std::async(std::launch::async, [&logger] {
+        for (std::size_t i = 0; i < blockCount; ++i) {
+            // Retrying while the queue is full, the rejected block is given back to the pool
+            while (!logger.mQueue.add(logger.mPool.acquire(i % 4, blockSize))) {
+                std::this_thread::yield();
+            }
+        }
+        logger.stop();
+    });
+
+    FlushCountingStreamBuf streamBuf;
+    std::ostream os(&streamBuf);
+    os << logStreamer;
+    producer.get();
+
+    CHECK(streamBuf.mByteCount > blockCount * (blockSize + sizeof(uint32_t)));
+
+    // Blocks are only allocated while the queue and the pool caches are being filled, i.e. the
+    // allocation count is bounded by the queue capacity, whatever the streamed block count
+    auto statistics = logger.mPool.getStatistics();
+    CHECK(statistics.allocationCount + statistics.reuseCount >= blockCount);
+    // Each thread cache holds up to 2 magazines
+    CHECK(statistics.allocationCount < QueueLoggerMock::queueMaxMemoryBytes / blockSize +
+                                           4 * LogBlockPool::magazineByteSize / blockSize);
+}
+
+/** Streams the log blocks of a producer thread that queues them as fast as possible. */
+static void measureLogStreaming(bool batchReading)
+{
+    static const std::size_t blockCount = 200000;
+    static const std::size_t minBlockSize = 2048;
+    static const std::size_t maxBlockSize = 4096;
+
+    std::vector<dsp_fw::ModuleEntry> moduleEntries;
+    QueueLoggerMock logger(batchReading);
+    LogStreamer logStreamer(logger, moduleEntries);
+
+    auto start = std::chrono::steady_clock::now();
+    auto producer = std::async(std::launch::async, [&logger] {
+        for (std::size_t i = 0; i < blockCount; ++i) {
+            std::size_t size = minBlockSize + i % (maxBlockSize - minBlockSize + 1);
+            auto block = std::make_unique<LogBlock>(0, size);
+            // Retrying while the queue is full
+            while (!logger.mQueue.add(std::move(block))) {
+                std::this_thread::yield();
+                block = std::make_unique<LogBlock>(0, size);
+            }
+        }
+        logger.stop();
+    });
+
+    FlushCountingStreamBuf streamBuf;
+    std::ostream os(&streamBuf);
+    os << logStreamer;
+    producer.get();
+    std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+
+    std::cout << (batchReading ? "batch reading:  " : "single reading: ") << blockCount
+              << " blocks, " << logger.mReadCount << " reads, " << streamBuf.mFlushCount
+              << " flushes, " << streamBuf.mByteCount / duration.count() / (1024 * 1024)
+              << " MiB/s\n";
+}
+
+TEST_CASE("Log streaming benchmark", "[.][benchmark]")
+{
+    measureLogStreaming(false);
+    measureLogStreaming(true);
+}
@@ -28,10 +28,74 @@
  * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #include <cAVS/DspFw/Probe.hpp>
+#include <cAVS/ProbePacketParser.hpp>
 #include "TestCommon/TestHelpers.hpp"
 #include <catch.hpp>
+#include <cstring>
+#include <vector>
 
+using namespace debug_agent;
 using namespace debug_agent::cavs::dsp_fw;
+using debug_agent::cavs::ProbePacketParser;
+
+namespace
+{
+Packet makePacket(const ProbePointId &probePointId, std::size_t payloadSize)
+{
+    Packet packet;
+    packet.probePointId = probePointId;
+    packet.format = 0x12345678;
+    packet.dspWallClockTsHw = 0xAABBCCDD;
+    packet.dspWallClockTsLw = static_cast<uint32_t>(payloadSize);
+    for (std::size_t i = 0; i < payloadSize; ++i) {
+        packet.data.push_back(static_cast<uint8_t>(i));
+    }
+    return packet;
+}
+
+template <typename ChecksumType>
+util::Buffer serialize(const Packet &packet)
+{
+    util::MemoryByteStreamWriter writer;
+    packet.toStream<ChecksumType>(writer);
+    return writer.getBuffer();
+}
+
+void append(util::Buffer &stream, const util::Buffer &content)
+{
+    stream.insert(stream.end(), content.begin(), content.end());
+}
+
+/** Result of a stream parsing in resync mode */
+struct ResyncResult
+{
+    std::vector<util::Buffer> packets;
+    std::size_t resyncCount = 0;
+    std::size_t discardedByteCount = 0;
+    std::vector<bool> attributed;
+};
+
+ResyncResult parseWithResync(const util::Buffer &stream, std::size_t blockSize)
+{
+    ResyncResult result;
+    ProbePacketParser parser(
+        [&result](const ProbePointId &, std::unique_ptr<util::Buffer> packet) {
+            result.packets.push_back(std::move(*packet));
+        },
+        [&result](const ProbePointId *probePointId, std::size_t discardedByteCount) {
+            ++result.resyncCount;
+            result.discardedByteCount += discardedByteCount;
+            result.attributed.push_back(probePointId != nullptr);
+        });
+
+    for (std::size_t offset = 0; offset < stream.size(); offset += blockSize) {
+        std::size_t size = std::min(blockSize, stream.size() - offset);
+        parser.parse(stream.data() + offset, size);
+    }
+    CHECK(parser.isIdle());
+    return result;
+}
+}
 
 TEST_CASE("ProbePointId validity")
 {
@@ -54,3 +118,184 @@ TEST_CASE("ProbePointId validity")
     CHECK_THROWS_AS_MSG(ProbePointId(0, 0, ProbeType::Input, illegalIndex), ProbePointId::Exception,
                         "Pin index too large (" + to_string(illegalIndex) + ")");
 }
+
+TEST_CASE("ProbePacketParser: packets spanning several blocks")
+{
+    std::vector<Packet> packets;
+    packets.push_back(makePacket({1, 2, ProbeType::Input, 0}, 0));
+    packets.push_back(makePacket({3, 4, ProbeType::Output, 1}, 1));
+    packets.push_back(makePacket({5, 6, ProbeType::Internal, 2}, 4000));
+    packets.push_back(makePacket({1, 2, ProbeType::Input, 0}, 17));
+
+    util::Buffer stream;
+    for (const auto &packet : packets) {
+        auto serialized = serialize<uint64_t>(packet);
+        stream.insert(stream.end(), serialized.begin(), serialized.end());
+    }
+
+    // Using several block sizes to split headers, payloads and checksums at any offset
+    for (std::size_t blockSize : {1, 3, 7, 24, 100, 4096, 10000}) {
+        std::vector<std::pair<ProbePointId, util::Buffer>> parsed;
+        ProbePacketParser parser(
+            [&parsed](const ProbePointId &probePointId, std::unique_ptr<util::Buffer> packet) {
+                parsed.emplace_back(probePointId, std::move(*packet));
+            });
+
+        for (std::size_t offset = 0; offset < stream.size(); offset += blockSize) {
+            std::size_t size = std::min(blockSize, stream.size() - offset);
+            parser.parse(stream.data() + offset, size);
+        }
+        CHECK(parser.isIdle());
+
+        // Checking that packets are re-serialized with a 32 bits checksum
+        REQUIRE(parsed.size() == packets.size());
+        for (std::size_t i = 0; i < packets.size(); ++i) {
+            CHECK(parsed[i].first == packets[i].probePointId);
+            CHECK(parsed[i].second == serialize<uint32_t>(packets[i]));
+        }
+    }
+}
+
+TEST_CASE("ProbePacketParser: corrupted stream")
+{
+    ProbePacketParser parser([](const ProbePointId &, std::unique_ptr<util::Buffer>) {});
+
+    auto serialized = serialize<uint64_t>(makePacket({1, 2, ProbeType::Input, 0}, 10));
+
+    SECTION ("Wrong sync word") {
+        serialized[0] = 0;
+        CHECK_THROWS_AS_MSG(parser.parse(serialized), ProbePacketParser::Exception,
+                            "Invalid sync word in extracted probe packet header. Expected " +
+                                std::to_string(packet::syncWord) + ", found " +
+                                std::to_string(packet::syncWord & 0xFFFFFF00));
+    }
+
+    SECTION ("Wrong checksum") {
+        serialized.back() ^= 0xFF;
+        CHECK_THROWS_AS(parser.parse(serialized), ProbePacketParser::Exception);
+    }
+}
+
+TEST_CASE("ProbePacketParser: resynchronization")
+{
+    auto first = makePacket({1, 2, ProbeType::Input, 0}, 10);
+    auto corrupted = makePacket({3, 4, ProbeType::Output, 1}, 300);
+    auto second = makePacket({5, 6, ProbeType::Internal, 2}, 20);
+
+    // The corrupted packet payload contains sync words, to check that the parser does not
+    // resynchronize on a packet that has a wrong checksum
+    for (std::size_t i = 0; i + sizeof(uint32_t) <= corrupted.data.size(); i += 50) {
+        std::memcpy(&corrupted.data[i], &packet::syncWord, sizeof(uint32_t));
+    }
+    auto corruptedBytes = serialize<uint64_t>(corrupted);
+
+    util::Buffer garbage(100, 0x55);
+    garbage[10] = static_cast<uint8_t>(packet::syncWord & 0xFF);
+
+    bool expectAttributed = true;
+    SECTION ("Wrong checksum") {
+        corruptedBytes.back() ^= 0xFF;
+    }
+    SECTION ("Wrong sync word") {
+        corruptedBytes[0] ^= 0xFF;
+        expectAttributed = false;
+    }
+    SECTION ("Too large payload size") {
+        uint32_t size = ProbePacketParser::maxPayloadSize + 1;
+        std::memcpy(&corruptedBytes[20], &size, sizeof(size));
+    }
+    SECTION ("Payload size overlapping the next packet") {
+        uint32_t size = static_cast<uint32_t>(corrupted.data.size() + 30);
+        std::memcpy(&corruptedBytes[20], &size, sizeof(size));
+    }
+    SECTION ("Garbage between packets") {
+        util::Buffer withGarbage = garbage;
+        append(withGarbage, corruptedBytes);
+        withGarbage.back() ^= 0xFF;
+        corruptedBytes = withGarbage;
+        expectAttributed = false;
+    }
+
+    util::Buffer stream = serialize<uint64_t>(first);
+    append(stream, corruptedBytes);
+    append(stream, serialize<uint64_t>(second));
+    append(stream, serialize<uint64_t>(first));
+
+    for (std::size_t blockSize : {1, 5, 64, 4096}) {
+        auto result = parseWithResync(stream, blockSize);
+
+        REQUIRE(result.packets.size() == 3);
+        CHECK(result.packets[0] == serialize<uint32_t>(first));
+        CHECK(result.packets[1] == serialize<uint32_t>(second));
+        CHECK(result.packets[2] == serialize<uint32_t>(first));
+
+        REQUIRE(result.resyncCount == 1);
+        CHECK(result.discardedByteCount == corruptedBytes.size());
+        CHECK(result.attributed[0] == expectAttributed);
+    }
+}
+
+TEST_CASE("ProbePacketParser: resynchronization cost is bounded")
+{
+    ProbePacketParser parser([](const ProbePointId &, std::unique_ptr<util::Buffer>) {},
+                             [](const ProbePointId *, std::size_t) {}, 100);
+
+    util::Buffer garbage(101, 0);
+    CHECK_THROWS_AS_MSG(
+        parser.parse(garbage), ProbePacketParser::Exception,
+        "Unable to resynchronize the probe extraction stream: 101 bytes discarded");
+}
+
+TEST_CASE("ProbePacketParser: replay is bounded per resynchronization")
+{
+    auto first = makePacket({1, 2, ProbeType::Input, 0}, 10);
+    auto corrupted = makePacket({3, 4, ProbeType::Output, 1}, 300);
+    auto second = makePacket({5, 6, ProbeType::Internal, 2}, 20);
+
+    // The corrupted payload size overlaps the second packet, which can only be recovered by
+    // replaying the end of the rejected candidate
+    auto corruptedBytes = serialize<uint64_t>(corrupted);
+    uint32_t size = static_cast<uint32_t>(corrupted.data.size() + 30);
+    std::memcpy(&corruptedBytes[20], &size, sizeof(size));
+    auto secondBytes = serialize<uint64_t>(second);
+
+    util::Buffer stream = serialize<uint64_t>(first);
+    append(stream, corruptedBytes);
+    append(stream, secondBytes);
+    append(stream, serialize<uint64_t>(first));
+
+    auto parse = [&stream](std::size_t maxReplayByteCount) {
+        ResyncResult result;
+        ProbePacketParser parser(
+            [&result](const ProbePointId &, std::unique_ptr<util::Buffer> packet) {
+                result.packets.push_back(std::move(*packet));
+            },
+            [&result](const ProbePointId *, std::size_t discardedByteCount) {
+                ++result.resyncCount;
+                result.discardedByteCount += discardedByteCount;
+            },
+            ProbePacketParser::defaultMaxResyncByteCount, maxReplayByteCount);
+        parser.parse(stream);
+        CHECK(parser.isIdle());
+        return result;
+    };
+
+    SECTION ("The candidate fits in the replay budget") {
+        auto result = parse(ProbePacketParser::defaultMaxReplayByteCount);
+        REQUIRE(result.packets.size() == 3);
+        CHECK(result.packets[1] == serialize<uint32_t>(second));
+        CHECK(result.resyncCount == 1);
+        CHECK(result.discardedByteCount == corruptedBytes.size());
+    }
+
+    SECTION ("The candidate exceeds the replay budget") {
+        // The end of the candidate is discarded without being scanned, the parsing resumes at
+        // the packet that follows it
+        auto result = parse(64);
+        REQUIRE(result.packets.size() == 2);
+        CHECK(result.packets[0] == serialize<uint32_t>(first));
+        CHECK(result.packets[1] == serialize<uint32_t>(first));
+        CHECK(result.resyncCount == 1);
+        CHECK(result.discardedByteCount == corruptedBytes.size() + secondBytes.size());
+    }
+}
@@ -0,0 +1,291 @@
+/*
+ * Copyright (c) 2016, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cAVS/Topology.hpp"
+#include <catch.hpp>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace debug_agent::cavs;
+
+using Link = Topology::Link;
+using Pin = std::pair<dsp_fw::CompoundModuleId, uint32_t>;
+
+/** Link computation as it was done before the queue id index, used as a reference: each
+ * unresolved output is linked to the first unresolved input found by a linear scan */
+static std::vector<Link> computeReferenceLinks(const Topology &topology)
+{
+    std::vector<Link> links;
+    std::vector<Pin> unresolvedInputs;
+    std::vector<Pin> unresolvedOutputs;
+
+    auto queueOf = [&](const dsp_fw::PinListInfo dsp_fw::ModuleInstanceProps::*pins,
+                       const Pin &pin) {
+        return (topology.moduleInstances.at(pin.first).*pins).pin_info[pin.second].phys_queue_id;
+    };
+    auto pinsOf = [&](const dsp_fw::CompoundModuleId &module, bool inputs) {
+        const dsp_fw::ModuleInstanceProps &props = topology.moduleInstances.at(module);
+        const dsp_fw::PinListInfo &pins = inputs ? props.input_pins : props.output_pins;
+        const dsp_fw::ConnectorNodeId &gateway = inputs ? props.input_gateway
+                                                        : props.output_gateway;
+        std::vector<Pin> result;
+        uint32_t pinId = gateway.val.dw == dsp_fw::ConnectorNodeId::kInvalidNodeId ? 0 : 1;
+        for (; pinId < pins.pin_info.size(); ++pinId) {
+            if (pins.pin_info[pinId].phys_queue_id != dsp_fw::PinProps::invalidQueueId) {
+                result.push_back(Pin(module, pinId));
+            }
+        }
+        return result;
+    };
+    auto link = [&](std::vector<Pin> &outputs, std::vector<Pin> &inputs,
+                    std::vector<Pin> &remainingOutputs) {
+        for (const Pin &output : outputs) {
+            auto queueId = queueOf(&dsp_fw::ModuleInstanceProps::output_pins, output);
+            auto input = std::find_if(inputs.begin(), inputs.end(), [&](const Pin &input) {
+                return queueOf(&dsp_fw::ModuleInstanceProps::input_pins, input) == queueId;
+            });
+            if (input == inputs.end()) {
+                remainingOutputs.push_back(output);
+            } else {
+                links.push_back(Link(output.first, output.second, input->first, input->second));
+                inputs.erase(input);
+            }
+        }
+    };
+
+    for (const dsp_fw::PplProps &pipe : topology.pipelines) {
+        if (pipe.module_instances.empty()) {
+            continue;
+        }
+        auto inputs = pinsOf(pipe.module_instances.front(), true);
+        unresolvedInputs.insert(unresolvedInputs.end(), inputs.begin(), inputs.end());
+        auto outputs = pinsOf(pipe.module_instances.back(), false);
+        unresolvedOutputs.insert(unresolvedOutputs.end(), outputs.begin(), outputs.end());
+
+        for (std::size_t index = 0; index + 1 < pipe.module_instances.size(); ++index) {
+            auto sourceOutputs = pinsOf(pipe.module_instances[index], false);
+            auto destinationInputs = pinsOf(pipe.module_instances[index + 1], true);
+            link(sourceOutputs, destinationInputs, unresolvedOutputs);
+            unresolvedInputs.insert(unresolvedInputs.end(), destinationInputs.begin(),
+                                    destinationInputs.end());
+        }
+    }
+
+    std::vector<Pin> remainingOutputs;
+    link(unresolvedOutputs, unresolvedInputs, remainingOutputs);
+    return links;
+}
+
+static void addPin(dsp_fw::PinListInfo &pins, uint32_t queueId)
+{
+    dsp_fw::PinProps pin{};
+    pin.phys_queue_id = queueId;
+    pins.pin_info.push_back(pin);
+}
+
+/** Build a random topology whose pins share a few queue ids, each queue id being used by as
+ * many outputs as inputs so that every pin is connected */
+static Topology makeRandomTopology(std::mt19937 &random)
+{
+    Topology topology;
+    std::vector<dsp_fw::CompoundModuleId> modules;
+
+    std::size_t pipelineCount = std::uniform_int_distribution<std::size_t>(1, 8)(random);
+    for (std::size_t pipelineId = 0; pipelineId < pipelineCount; ++pipelineId) {
+        dsp_fw::PplProps pipeline;
+        pipeline.id = dsp_fw::PipeLineIdType{static_cast<uint32_t>(pipelineId)};
+
+        std::size_t moduleCount = std::uniform_int_distribution<std::size_t>(0, 4)(random);
+        for (std::size_t position = 0; position < moduleCount; ++position) {
+            dsp_fw::ModuleInstanceProps instance{};
+            instance.id = {static_cast<uint16_t>(position + 1),
+                           static_cast<uint16_t>(pipelineId)};
+
+            /* A pin #0 connected to a gateway, whose queue id shall be ignored */
+            if (random() % 4 == 0) {
+                instance.input_gateway = dsp_fw::ConnectorNodeId(1);
+                addPin(instance.input_pins, 0);
+            }
+            if (random() % 4 == 0) {
+                instance.output_gateway = dsp_fw::ConnectorNodeId(2);
+                addPin(instance.output_pins, 0);
+            }
+
+            pipeline.module_instances.push_back(instance.id);
+            topology.moduleInstances[instance.id] = instance;
+            modules.push_back(instance.id);
+        }
+        topology.pipelines.push_back(pipeline);
+    }
+
+    if (modules.empty()) {
+        return topology;
+    }
+
+    std::uniform_int_distribution<std::size_t> moduleIndex(0, modules.size() - 1);
+    std::size_t linkCount = std::uniform_int_distribution<std::size_t>(0, 24)(random);
+    for (std::size_t link = 0; link < linkCount; ++link) {
+        uint32_t queueId = random() % 5;
+        addPin(topology.moduleInstances[modules[moduleIndex(random)]].output_pins, queueId);
+        addPin(topology.moduleInstances[modules[moduleIndex(random)]].input_pins, queueId);
+
+        /* Unused pins are ignored */
+        if (random() % 8 == 0) {
+            addPin(topology.moduleInstances[modules[moduleIndex(random)]].input_pins,
+                   dsp_fw::PinProps::invalidQueueId);
+        }
+    }
+    return topology;
+}
+
+TEST_CASE("Topology: links of a simple topology", "[topology]")
+{
+    /* Pipe 0: (1,0) -> (2,0), pipe 1: (1,1), the last module of pipe 0 feeding pipe 1 */
+    Topology topology;
+    dsp_fw::CompoundModuleId first{1, 0}, second{2, 0}, third{1, 1};
+
+    dsp_fw::ModuleInstanceProps instance{};
+    instance.id = first;
+    instance.input_gateway = dsp_fw::ConnectorNodeId(1);
+    addPin(instance.input_pins, 0);
+    addPin(instance.output_pins, 10);
+    addPin(instance.output_pins, 11);
+    topology.moduleInstances[first] = instance;
+
+    instance = {};
+    instance.id = second;
+    addPin(instance.input_pins, 11);
+    addPin(instance.input_pins, 10);
+    addPin(instance.output_pins, dsp_fw::PinProps::invalidQueueId);
+    addPin(instance.output_pins, 20);
+    topology.moduleInstances[second] = instance;
+
+    instance = {};
+    instance.id = third;
+    addPin(instance.input_pins, 20);
+    instance.output_gateway = dsp_fw::ConnectorNodeId(2);
+    addPin(instance.output_pins, 0);
+    topology.moduleInstances[third] = instance;
+
+    dsp_fw::PplProps pipeline;
+    pipeline.id = dsp_fw::PipeLineIdType{0};
+    pipeline.module_instances = {first, second};
+    topology.pipelines.push_back(pipeline);
+    pipeline.id = dsp_fw::PipeLineIdType{1};
+    pipeline.module_instances = {third};
+    topology.pipelines.push_back(pipeline);
+
+    topology.computeLinks();
+    CHECK(topology.links == std::vector<Link>({Link(first, 0, second, 1),
+                                               Link(first, 1, second, 0),
+                                               Link(second, 1, third, 0)}));
+}
+
+TEST_CASE("Topology: links are the ones of a linear scan", "[topology]")
+{
+    std::mt19937 random(42);
+    for (std::size_t iteration = 0; iteration < 500; ++iteration) {
+        Topology topology = makeRandomTopology(random);
+        topology.computeLinks();
+        CHECK(topology.links == computeReferenceLinks(topology));
+    }
+}
+
+/** Build a topology of chained pipelines of five module instances. The pipelines are listed
+ * odd ones first, so that a pipeline input is not found at the head of the unresolved list. */
+static Topology makeChainedTopology(std::size_t moduleCount)
+{
+    static const uint32_t modulesPerPipeline = 5;
+    static const uint32_t interPipeQueueBase = 0x10000;
+    const uint32_t pipelineCount = (moduleCount + modulesPerPipeline - 1) / modulesPerPipeline;
+
+    Topology topology;
+    for (uint32_t parity = 1; parity <= 2; ++parity) {
+        for (uint32_t pipelineId = parity % 2; pipelineId < pipelineCount; pipelineId += 2) {
+            dsp_fw::PplProps pipeline;
+            pipeline.id = dsp_fw::PipeLineIdType{pipelineId};
+
+            for (uint32_t position = 0; position < modulesPerPipeline; ++position) {
+                dsp_fw::ModuleInstanceProps instance{};
+                instance.id = {static_cast<uint16_t>(position + 1),
+                               static_cast<uint16_t>(pipelineId)};
+                if (position > 0) {
+                    addPin(instance.input_pins, pipelineId * modulesPerPipeline + position - 1);
+                } else if (pipelineId > 0) {
+                    addPin(instance.input_pins, interPipeQueueBase + pipelineId - 1);
+                }
+                if (position < modulesPerPipeline - 1) {
+                    addPin(instance.output_pins, pipelineId * modulesPerPipeline + position);
+                } else if (pipelineId < pipelineCount - 1) {
+                    addPin(instance.output_pins, interPipeQueueBase + pipelineId);
+                }
+                pipeline.module_instances.push_back(instance.id);
+                topology.moduleInstances[instance.id] = instance;
+            }
+            topology.pipelines.push_back(pipeline);
+        }
+    }
+    return topology;
+}
+
+template <typename Compute>
+static double measureLinkComputation(std::size_t iterations, Compute compute)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t iteration = 0; iteration < iterations; ++iteration) {
+        compute();
+    }
+    std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+    return duration.count() * 1e6 / iterations;
+}
+
+TEST_CASE("Topology: link computation scaling benchmark", "[.][benchmark]")
+{
+    for (std::size_t moduleCount : {10, 100, 1000, 10000}) {
+        Topology topology = makeChainedTopology(moduleCount);
+        const std::size_t iterations = 100000 / moduleCount;
+        std::size_t linkCount = 0;
+
+        double indexedDuration = measureLinkComputation(iterations, [&] {
+            topology.computeLinks();
+            linkCount += topology.links.size();
+        });
+        double referenceDuration = measureLinkComputation(iterations, [&] {
+            linkCount += computeReferenceLinks(topology).size();
+        });
+
+        CHECK(linkCount == 2 * iterations * (moduleCount - 1));
+        std::cout << moduleCount << " module instances: indexed " << indexedDuration
+                  << " us, linear scan " << referenceDuration << " us\n";
+    }
+}